@@ -66,6 +66,33 @@
 #define BT_BLE_DYNAMIC_ENV_MEMORY  FALSE
 #endif
 
+#if UC_BT_BUF_POOL_ENABLED
+#define BT_BUF_POOL_INCLUDED       TRUE
+#define BT_BUF_POOL_SMALL_NUM      UC_BT_BUF_POOL_SMALL_NUM
+#define BT_BUF_POOL_LARGE_NUM      UC_BT_BUF_POOL_LARGE_NUM
+#else
+#define BT_BUF_POOL_INCLUDED       FALSE
+#endif
+
+#if UC_BT_THREAD_STATS_ENABLED
+#define BT_THREAD_STATS_INCLUDED   TRUE
+#else
+#define BT_THREAD_STATS_INCLUDED   FALSE
+#endif
+
+#if UC_BT_HCI_QUEUE_WEIGHTS_ENABLED
+#define BT_HCI_QUEUE_WEIGHTS_INCLUDED   TRUE
+#else
+#define BT_HCI_QUEUE_WEIGHTS_INCLUDED   FALSE
+#endif
+
+#if UC_BT_ALARM_WHEEL_ENABLED
+#define BT_ALARM_WHEEL_INCLUDED    TRUE
+#define BT_ALARM_WHEEL_TICK_MS     UC_BT_ALARM_WHEEL_TICK_MS
+#else
+#define BT_ALARM_WHEEL_INCLUDED    FALSE
+#endif
+
 /* OS Configuration from User config (eg: sdkconfig) */
 #define TASK_PINNED_TO_CORE         UC_TASK_PINNED_TO_CORE
 #define BT_BTC_TASK_PINNED_TO_CORE  UC_BTC_TASK_PINNED_TO_CORE
@@ -37,6 +37,51 @@
 #define UC_BT_STACK_NO_LOG               FALSE
 #endif
 
+//PACKET BUFFER POOL
+#ifdef CONFIG_BT_BUF_POOL
+#define UC_BT_BUF_POOL_ENABLED                  CONFIG_BT_BUF_POOL
+#else
+#define UC_BT_BUF_POOL_ENABLED                  FALSE
+#endif
+
+#ifdef CONFIG_BT_BUF_POOL_SMALL_NUM
+#define UC_BT_BUF_POOL_SMALL_NUM                CONFIG_BT_BUF_POOL_SMALL_NUM
+#else
+#define UC_BT_BUF_POOL_SMALL_NUM                16
+#endif
+
+#ifdef CONFIG_BT_BUF_POOL_LARGE_NUM
+#define UC_BT_BUF_POOL_LARGE_NUM                CONFIG_BT_BUF_POOL_LARGE_NUM
+#else
+#define UC_BT_BUF_POOL_LARGE_NUM                8
+#endif
+
+//OSI THREAD STATISTICS
+#ifdef CONFIG_BT_THREAD_STATS
+#define UC_BT_THREAD_STATS_ENABLED              CONFIG_BT_THREAD_STATS
+#else
+#define UC_BT_THREAD_STATS_ENABLED              FALSE
+#endif
+
+#ifdef CONFIG_BT_HCI_QUEUE_WEIGHTS
+#define UC_BT_HCI_QUEUE_WEIGHTS_ENABLED         CONFIG_BT_HCI_QUEUE_WEIGHTS
+#else
+#define UC_BT_HCI_QUEUE_WEIGHTS_ENABLED         FALSE
+#endif
+
+//ALARM TIMER WHEEL
+#ifdef CONFIG_BT_ALARM_WHEEL
+#define UC_BT_ALARM_WHEEL_ENABLED               CONFIG_BT_ALARM_WHEEL
+#else
+#define UC_BT_ALARM_WHEEL_ENABLED               FALSE
+#endif
+
+#ifdef CONFIG_BT_ALARM_WHEEL_TICK_MS
+#define UC_BT_ALARM_WHEEL_TICK_MS               CONFIG_BT_ALARM_WHEEL_TICK_MS
+#else
+#define UC_BT_ALARM_WHEEL_TICK_MS               10
+#endif
+
 /**********************************************************
  * Thread/Task reference
  **********************************************************/
@@ -33,8 +33,51 @@ typedef struct alarm_t {
     osi_alarm_callback_t cb;
     void *cb_data;
     int64_t deadline_us;
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+    struct alarm_t *wheel_next;
+    struct alarm_t *wheel_prev;
+    int64_t wheel_tick;         // tick of the slot it is linked in
+    int64_t expire_us;          // when it is due, on the wheel
+    int64_t period_us;          // 0 for a one-shot alarm
+    const char *name;           // for the esp_timer of a short timeout
+    bool in_use;
+    bool on_wheel;
+#endif
 } osi_alarm_t;
 
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+// The alarms are hashed on a wheel of one tick slots by the tick they are due
+// at, a single esp_timer is kept on the first slot holding one. Setting and
+// cancelling an alarm only link and unlink it, and the alarms due within the
+// same tick run on the same wakeup. An alarm further away than a turn of the
+// wheel waits in its slot for its turn to come.
+#define ALARM_WHEEL_SLOTS       256
+#define ALARM_WHEEL_MASK        (ALARM_WHEEL_SLOTS - 1)
+#define ALARM_WHEEL_TICK_US     (BT_ALARM_WHEEL_TICK_MS * 1000LL)
+// Timeouts shorter than this many ticks would be stretched too much by the
+// rounding up to a tick, they get an esp_timer of their own.
+#define ALARM_WHEEL_MIN_TICKS   10
+
+typedef struct {
+    esp_timer_handle_t timer;
+    int64_t cur_tick;           // last tick run, every alarm is due after it
+    int64_t timer_tick;         // tick |timer| was started for, 0 if stopped
+    struct alarm_t *slots[ALARM_WHEEL_SLOTS];
+    uint32_t bitmap[ALARM_WHEEL_SLOTS / 32];    // slots holding an alarm
+} alarm_wheel_t;
+
+typedef struct {
+    osi_alarm_callback_t cb;
+    void *cb_data;
+} alarm_fired_t;
+
+static alarm_wheel_t *alarm_wheel;
+
+#define ALARM_IN_USE(alarm)     ((alarm)->in_use)
+#else
+#define ALARM_IN_USE(alarm)     ((alarm)->alarm_hdl != NULL)
+#endif /* BT_ALARM_WHEEL_INCLUDED == TRUE */
+
 enum {
     ALARM_STATE_IDLE,
     ALARM_STATE_OPEN,
@@ -51,6 +94,9 @@ static struct alarm_t *alarm_cbs;
 
 static osi_alarm_err_t alarm_free(osi_alarm_t *alarm);
 static osi_alarm_err_t alarm_set(osi_alarm_t *alarm, period_ms_t timeout, bool is_periodic);
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+static void alarm_wheel_handler(void *arg);
+#endif
 
 int osi_alarm_create_mux(void)
 {
@@ -89,8 +135,38 @@ void osi_alarm_init(void)
 #endif
 
     memset(alarm_cbs, 0x00, sizeof(osi_alarm_t) * ALARM_CBS_NUM);
+
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+    if ((alarm_wheel = (alarm_wheel_t *)osi_calloc(sizeof(alarm_wheel_t))) == NULL) {
+        OSI_TRACE_ERROR("%s, malloc failed\n", __func__);
+        goto err;
+    }
+
+    esp_timer_create_args_t tca = {0};
+    tca.callback = alarm_wheel_handler;
+    tca.dispatch_method = ESP_TIMER_TASK;
+    tca.name = "alarm_wheel";
+
+    esp_err_t stat = esp_timer_create(&tca, &alarm_wheel->timer);
+    if (stat != ESP_OK) {
+        OSI_TRACE_ERROR("%s failed to create timer, err 0x%x\n", __func__, stat);
+        osi_free(alarm_wheel);
+        alarm_wheel = NULL;
+        goto err;
+    }
+    alarm_wheel->cur_tick = esp_timer_get_time() / ALARM_WHEEL_TICK_US;
+#endif
+
     alarm_state = ALARM_STATE_OPEN;
+    goto end;
 
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+err:
+#if (BT_BLE_DYNAMIC_ENV_MEMORY == TRUE)
+    osi_free(alarm_cbs);
+    alarm_cbs = NULL;
+#endif
+#endif
 end:
     osi_mutex_unlock(&alarm_mutex);
 }
@@ -106,11 +182,18 @@ void osi_alarm_deinit(void)
     }
 
     for (int i = 0; i < ALARM_CBS_NUM; i++) {
-        if (alarm_cbs[i].alarm_hdl != NULL) {
+        if (ALARM_IN_USE(&alarm_cbs[i])) {
             alarm_free(&alarm_cbs[i]);
         }
     }
 
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+    esp_timer_stop(alarm_wheel->timer);
+    esp_timer_delete(alarm_wheel->timer);
+    osi_free(alarm_wheel);
+    alarm_wheel = NULL;
+#endif
+
 #if (BT_BLE_DYNAMIC_ENV_MEMORY == TRUE)
     osi_free(alarm_cbs);
     alarm_cbs = NULL;
@@ -127,7 +210,7 @@ static struct alarm_t *alarm_cbs_lookfor_available(void)
     int i;
 
     for (i = 0; i < ALARM_CBS_NUM; i++) {
-        if (alarm_cbs[i].alarm_hdl == NULL) { //available
+        if (!ALARM_IN_USE(&alarm_cbs[i])) { //available
             OSI_TRACE_DEBUG("%s %d %p\n", __func__, i, &alarm_cbs[i]);
             return &alarm_cbs[i];
         }
@@ -136,6 +219,17 @@ static struct alarm_t *alarm_cbs_lookfor_available(void)
     return NULL;
 }
 
+static void alarm_post(osi_alarm_callback_t cb, void *cb_data)
+{
+    btc_msg_t msg = {0};
+    btc_alarm_args_t arg;
+    msg.sig = BTC_SIG_API_CALL;
+    msg.pid = BTC_PID_ALARM;
+    arg.cb = cb;
+    arg.cb_data = cb_data;
+    btc_transfer_context(&msg, &arg, sizeof(btc_alarm_args_t), NULL);
+}
+
 static void alarm_cb_handler(struct alarm_t *alarm)
 {
     OSI_TRACE_DEBUG("TimerID %p\n", alarm);
@@ -143,13 +237,198 @@ static void alarm_cb_handler(struct alarm_t *alarm)
         OSI_TRACE_WARNING("%s, invalid state %d\n", __func__, alarm_state);
         return;
     }
-    btc_msg_t msg = {0};
-    btc_alarm_args_t arg;
-    msg.sig = BTC_SIG_API_CALL;
-    msg.pid = BTC_PID_ALARM;
-    arg.cb = alarm->cb;
-    arg.cb_data = alarm->cb_data;
-    btc_transfer_context(&msg, &arg, sizeof(btc_alarm_args_t), NULL);
+    alarm_post(alarm->cb, alarm->cb_data);
+}
+
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+// The functions of the wheel are called with |alarm_mutex| held.
+
+static void alarm_wheel_link(osi_alarm_t *alarm)
+{
+    // rounded up, an alarm never fires early
+    int64_t tick = (alarm->expire_us + ALARM_WHEEL_TICK_US - 1) / ALARM_WHEEL_TICK_US;
+    if (tick <= alarm_wheel->cur_tick) {
+        tick = alarm_wheel->cur_tick + 1;
+    }
+    int slot = (int)(tick & ALARM_WHEEL_MASK);
+
+    alarm->wheel_tick = tick;
+    alarm->wheel_prev = NULL;
+    alarm->wheel_next = alarm_wheel->slots[slot];
+    if (alarm->wheel_next != NULL) {
+        alarm->wheel_next->wheel_prev = alarm;
+    }
+    alarm_wheel->slots[slot] = alarm;
+    alarm_wheel->bitmap[slot >> 5] |= 1u << (slot & 31);
+    alarm->on_wheel = true;
+}
+
+static void alarm_wheel_unlink(osi_alarm_t *alarm)
+{
+    int slot = (int)(alarm->wheel_tick & ALARM_WHEEL_MASK);
+
+    if (alarm->wheel_prev != NULL) {
+        alarm->wheel_prev->wheel_next = alarm->wheel_next;
+    } else {
+        alarm_wheel->slots[slot] = alarm->wheel_next;
+    }
+    if (alarm->wheel_next != NULL) {
+        alarm->wheel_next->wheel_prev = alarm->wheel_prev;
+    }
+    if (alarm_wheel->slots[slot] == NULL) {
+        alarm_wheel->bitmap[slot >> 5] &= ~(1u << (slot & 31));
+    }
+    alarm->wheel_next = alarm->wheel_prev = NULL;
+    alarm->on_wheel = false;
+}
+
+// Returns the tick of the first slot holding an alarm after the current one,
+// 0 if the wheel is empty.
+static int64_t alarm_wheel_next_tick(void)
+{
+    int start = (int)((alarm_wheel->cur_tick + 1) & ALARM_WHEEL_MASK);
+
+    for (int d = 0; d < ALARM_WHEEL_SLOTS; ) {
+        int slot = (start + d) & ALARM_WHEEL_MASK;
+        uint32_t word = alarm_wheel->bitmap[slot >> 5] >> (slot & 31);
+        if (word != 0) {
+            return alarm_wheel->cur_tick + 1 + d + __builtin_ctz(word);
+        }
+        d += 32 - (slot & 31);
+    }
+    return 0;
+}
+
+static void alarm_wheel_start_timer(int64_t tick)
+{
+    // also when the timer has fired and the handler waits for the mutex, the
+    // handler then finds nothing due and sets it again
+    esp_timer_stop(alarm_wheel->timer);
+    alarm_wheel->timer_tick = tick;
+    if (tick == 0) {
+        return;
+    }
+
+    int64_t dt_us = tick * ALARM_WHEEL_TICK_US - esp_timer_get_time();
+    esp_err_t stat = esp_timer_start_once(alarm_wheel->timer, dt_us > 0 ? (uint64_t)dt_us : 0);
+    if (stat != ESP_OK) {
+        OSI_TRACE_ERROR("%s failed to start timer, err 0x%x\n", __func__, stat);
+        alarm_wheel->timer_tick = 0;
+    }
+}
+
+static void alarm_wheel_handler(void *arg)
+{
+    alarm_fired_t fired[ALARM_CBS_NUM];
+    osi_alarm_t *periodic = NULL;
+    int n_fired = 0;
+
+    osi_mutex_lock(&alarm_mutex, OSI_MUTEX_MAX_TIMEOUT);
+    if (alarm_state != ALARM_STATE_OPEN) {
+        OSI_TRACE_WARNING("%s, invalid state %d\n", __func__, alarm_state);
+        osi_mutex_unlock(&alarm_mutex);
+        return;
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    int64_t now_tick = now_us / ALARM_WHEEL_TICK_US;
+    int64_t last_tick = now_tick;
+    if (last_tick - alarm_wheel->cur_tick > ALARM_WHEEL_SLOTS) {
+        // a whole turn has passed, every slot is visited once
+        last_tick = alarm_wheel->cur_tick + ALARM_WHEEL_SLOTS;
+    }
+
+    for (int64_t tick = alarm_wheel->cur_tick + 1; tick <= last_tick; tick++) {
+        osi_alarm_t *alarm = alarm_wheel->slots[tick & ALARM_WHEEL_MASK];
+        osi_alarm_t *next;
+        for (; alarm != NULL; alarm = next) {
+            next = alarm->wheel_next;
+            if (alarm->wheel_tick > now_tick) {
+                // due on a later turn
+                continue;
+            }
+            alarm_wheel_unlink(alarm);
+            fired[n_fired].cb = alarm->cb;
+            fired[n_fired].cb_data = alarm->cb_data;
+            n_fired++;
+            if (alarm->period_us != 0) {
+                alarm->wheel_next = periodic;
+                periodic = alarm;
+            }
+        }
+    }
+    alarm_wheel->cur_tick = now_tick;
+
+    while (periodic != NULL) {
+        osi_alarm_t *alarm = periodic;
+        periodic = alarm->wheel_next;
+        alarm->expire_us += alarm->period_us;
+        if (alarm->expire_us <= now_us) {
+            // periods missed are dropped
+            alarm->expire_us = now_us + alarm->period_us;
+        }
+        alarm_wheel_link(alarm);
+    }
+
+    alarm_wheel_start_timer(alarm_wheel_next_tick());
+    osi_mutex_unlock(&alarm_mutex);
+
+    // posted without the mutex, the callbacks run on the BTC task
+    for (int i = 0; i < n_fired; i++) {
+        alarm_post(fired[i].cb, fired[i].cb_data);
+    }
+}
+#endif /* BT_ALARM_WHEEL_INCLUDED == TRUE */
+
+static esp_err_t alarm_start(osi_alarm_t *alarm, int64_t timeout_us, bool is_periodic)
+{
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+    if (timeout_us >= ALARM_WHEEL_MIN_TICKS * ALARM_WHEEL_TICK_US) {
+        alarm->expire_us = esp_timer_get_time() + timeout_us;
+        alarm->period_us = is_periodic ? timeout_us : 0;
+        alarm_wheel_link(alarm);
+        if (alarm_wheel->timer_tick == 0 || alarm->wheel_tick < alarm_wheel->timer_tick) {
+            alarm_wheel_start_timer(alarm->wheel_tick);
+        }
+        return ESP_OK;
+    }
+
+    if (alarm->alarm_hdl == NULL) {
+        esp_timer_create_args_t tca = {0};
+        tca.callback = (esp_timer_cb_t)alarm_cb_handler;
+        tca.arg = alarm;
+        tca.dispatch_method = ESP_TIMER_TASK;
+        tca.name = alarm->name;
+
+        esp_err_t stat = esp_timer_create(&tca, &alarm->alarm_hdl);
+        if (stat != ESP_OK) {
+            OSI_TRACE_ERROR("%s failed to create timer, err 0x%x\n", __func__, stat);
+            return stat;
+        }
+    }
+#endif
+
+    if (is_periodic) {
+        return esp_timer_start_periodic(alarm->alarm_hdl, (uint64_t)timeout_us);
+    }
+    return esp_timer_start_once(alarm->alarm_hdl, (uint64_t)timeout_us);
+}
+
+static esp_err_t alarm_stop(osi_alarm_t *alarm)
+{
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+    if (alarm->on_wheel) {
+        alarm_wheel_unlink(alarm);
+        if (alarm_wheel_next_tick() == 0) {
+            alarm_wheel_start_timer(0);
+        }
+        return ESP_OK;
+    }
+    if (alarm->alarm_hdl == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+#endif
+    return esp_timer_stop(alarm->alarm_hdl);
 }
 
 osi_alarm_t *osi_alarm_new(const char *alarm_name, osi_alarm_callback_t callback, void *data, period_ms_t timer_expire)
@@ -173,22 +452,28 @@ osi_alarm_t *osi_alarm_new(const char *alarm_name, osi_alarm_callback_t callback
         goto end;
     }
 
+    timer_id->cb = callback;
+    timer_id->cb_data = data;
+    timer_id->deadline_us = 0;
+
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+    // the esp_timer is only created if a short timeout needs one
+    timer_id->name = alarm_name;
+    timer_id->in_use = true;
+#else
     esp_timer_create_args_t tca = {0};
     tca.callback = (esp_timer_cb_t)alarm_cb_handler;
     tca.arg = timer_id;
     tca.dispatch_method = ESP_TIMER_TASK;
     tca.name = alarm_name;
 
-    timer_id->cb = callback;
-    timer_id->cb_data = data;
-    timer_id->deadline_us = 0;
-
     esp_err_t stat = esp_timer_create(&tca, &timer_id->alarm_hdl);
     if (stat != ESP_OK) {
         OSI_TRACE_ERROR("%s failed to create timer, err 0x%x\n", __func__, stat);
         timer_id = NULL;
         goto end;
     }
+#endif
 
 end:
     osi_mutex_unlock(&alarm_mutex);
@@ -197,15 +482,17 @@ end:
 
 static osi_alarm_err_t alarm_free(osi_alarm_t *alarm)
 {
-    if (!alarm || alarm->alarm_hdl == NULL) {
+    if (!alarm || !ALARM_IN_USE(alarm)) {
         OSI_TRACE_ERROR("%s null\n", __func__);
         return OSI_ALARM_ERR_INVALID_ARG;
     }
-    esp_timer_stop(alarm->alarm_hdl);
-    esp_err_t stat = esp_timer_delete(alarm->alarm_hdl);
-    if (stat != ESP_OK) {
-        OSI_TRACE_ERROR("%s failed to delete timer, err 0x%x\n", __func__, stat);
-        return OSI_ALARM_ERR_FAIL;
+    alarm_stop(alarm);
+    if (alarm->alarm_hdl != NULL) {
+        esp_err_t stat = esp_timer_delete(alarm->alarm_hdl);
+        if (stat != ESP_OK) {
+            OSI_TRACE_ERROR("%s failed to delete timer, err 0x%x\n", __func__, stat);
+            return OSI_ALARM_ERR_FAIL;
+        }
     }
 
     memset(alarm, 0, sizeof(osi_alarm_t));
@@ -240,19 +527,19 @@ static osi_alarm_err_t alarm_set(osi_alarm_t *alarm, period_ms_t timeout, bool i
         goto end;
     }
 
-    if (!alarm || alarm->alarm_hdl == NULL) {
+    if (!alarm || !ALARM_IN_USE(alarm)) {
         OSI_TRACE_ERROR("%s null\n", __func__);
         ret = OSI_ALARM_ERR_INVALID_ARG;
         goto end;
     }
 
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+    // setting an alarm again moves it
+    alarm_stop(alarm);
+#endif
+
     int64_t timeout_us = 1000 * (int64_t)timeout;
-    esp_err_t stat;
-    if (is_periodic) {
-        stat = esp_timer_start_periodic(alarm->alarm_hdl, (uint64_t)timeout_us);
-    } else {
-        stat = esp_timer_start_once(alarm->alarm_hdl, (uint64_t)timeout_us);
-    }
+    esp_err_t stat = alarm_start(alarm, timeout_us, is_periodic);
     if (stat != ESP_OK) {
         OSI_TRACE_ERROR("%s failed to start timer, err 0x%x\n", __func__, stat);
         ret = OSI_ALARM_ERR_FAIL;
@@ -285,13 +572,13 @@ osi_alarm_err_t osi_alarm_cancel(osi_alarm_t *alarm)
         goto end;
     }
 
-    if (!alarm || alarm->alarm_hdl == NULL) {
+    if (!alarm || !ALARM_IN_USE(alarm)) {
         OSI_TRACE_ERROR("%s null\n", __func__);
         ret = OSI_ALARM_ERR_INVALID_ARG;
         goto end;
     }
 
-    esp_err_t stat = esp_timer_stop(alarm->alarm_hdl);
+    esp_err_t stat = alarm_stop(alarm);
     if (stat != ESP_OK) {
         OSI_TRACE_DEBUG("%s failed to stop timer, err 0x%x\n", __func__, stat);
         ret = OSI_ALARM_ERR_FAIL;
@@ -323,6 +610,11 @@ bool osi_alarm_is_active(osi_alarm_t *alarm)
 {
     assert(alarm != NULL);
 
+#if (BT_ALARM_WHEEL_INCLUDED == TRUE)
+    if (alarm->on_wheel) {
+        return true;
+    }
+#endif
     if (alarm->alarm_hdl != NULL) {
         return esp_timer_is_active(alarm->alarm_hdl);
     }
@@ -253,6 +253,10 @@ void *osi_calloc_func(size_t size)
 
 void osi_free_func(void *ptr)
 {
+    if (osi_buf_pool_owns(ptr)) {
+        osi_buf_pool_free(ptr);
+        return;
+    }
 #if HEAP_MEMORY_DEBUG
     osi_mem_dbg_clean(ptr, __func__, __LINE__);
 #endif
@@ -0,0 +1,237 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "bt_common.h"
+#include "osi/allocator.h"
+#include "osi/buf_pool.h"
+#include "freertos/FreeRTOS.h"
+
+#if (BT_BUF_POOL_INCLUDED == TRUE)
+
+typedef struct osi_buf_pool_node {
+    struct osi_buf_pool_node *next;
+} osi_buf_pool_node_t;
+
+typedef struct {
+    uint8_t *base;                  // first buffer of the class
+    uint8_t *end;                   // end of the last buffer of the class
+    osi_buf_pool_node_t *free_list; // LIFO, so the buffer freed last is reused while still in cache
+    osi_buf_pool_stats_t stats;
+} osi_buf_pool_class_t;
+
+uint8_t *osi_buf_pool_start = NULL;
+uint8_t *osi_buf_pool_end = NULL;
+
+static osi_buf_pool_class_t pool_classes[OSI_BUF_POOL_CLASS_NUM];
+static uint32_t pool_oversize;
+static bool pool_closing;
+
+// The critical sections only pop or push one list node. They also stop the
+// memory of the pool from being released under a buffer being freed.
+static portMUX_TYPE pool_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const uint16_t pool_buf_size[OSI_BUF_POOL_CLASS_NUM] = {
+    OSI_BUF_POOL_SMALL_SIZE,
+    OSI_BUF_POOL_LARGE_SIZE,
+};
+
+static const uint16_t pool_buf_num[OSI_BUF_POOL_CLASS_NUM] = {
+    BT_BUF_POOL_SMALL_NUM,
+    BT_BUF_POOL_LARGE_NUM,
+};
+
+static bool pool_in_use(void)
+{
+    for (int i = 0; i < OSI_BUF_POOL_CLASS_NUM; i++) {
+        if (pool_classes[i].stats.in_use) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Called in the critical section once no buffer is left, returns the memory
+// to release after leaving it.
+static void *pool_detach(void)
+{
+    void *mem = osi_buf_pool_start;
+
+    // |end| first, so that a concurrent osi_buf_pool_owns() never sees an
+    // empty |start| with a valid |end| and claims a heap buffer.
+    osi_buf_pool_end = NULL;
+    osi_buf_pool_start = NULL;
+    memset(pool_classes, 0, sizeof(pool_classes));
+    pool_closing = false;
+    return mem;
+}
+
+bool osi_buf_pool_init(void)
+{
+    size_t total = 0;
+    uint8_t *mem;
+
+    portENTER_CRITICAL(&pool_lock);
+    if (osi_buf_pool_start != NULL) {
+        // still draining from a previous deinit, or already up
+        pool_closing = false;
+        portEXIT_CRITICAL(&pool_lock);
+        return true;
+    }
+    portEXIT_CRITICAL(&pool_lock);
+
+    for (int i = 0; i < OSI_BUF_POOL_CLASS_NUM; i++) {
+        total += (size_t)pool_buf_size[i] * pool_buf_num[i];
+    }
+
+    // not through osi_malloc(), the pool is not a heap buffer to osi_free()
+    mem = malloc(total);
+    if (mem == NULL) {
+        OSI_TRACE_ERROR("%s, no memory for %u bytes\n", __func__, (unsigned)total);
+        return false;
+    }
+
+    uint8_t *p = mem;
+    for (int i = 0; i < OSI_BUF_POOL_CLASS_NUM; i++) {
+        osi_buf_pool_class_t *cls = &pool_classes[i];
+
+        memset(cls, 0, sizeof(*cls));
+        cls->base = p;
+        cls->stats.buf_size = pool_buf_size[i];
+        cls->stats.buf_num = pool_buf_num[i];
+        // thread the free list in address order
+        for (int n = pool_buf_num[i] - 1; n >= 0; n--) {
+            osi_buf_pool_node_t *node = (osi_buf_pool_node_t *)(p + (size_t)n * pool_buf_size[i]);
+            node->next = cls->free_list;
+            cls->free_list = node;
+        }
+        p += (size_t)pool_buf_size[i] * pool_buf_num[i];
+        cls->end = p;
+    }
+    pool_oversize = 0;
+    pool_closing = false;
+
+    portENTER_CRITICAL(&pool_lock);
+    osi_buf_pool_start = mem;
+    osi_buf_pool_end = mem + total;
+    portEXIT_CRITICAL(&pool_lock);
+    return true;
+}
+
+void osi_buf_pool_deinit(void)
+{
+    void *mem = NULL;
+    bool closing = false;
+
+    portENTER_CRITICAL(&pool_lock);
+    if (osi_buf_pool_start != NULL) {
+        if (pool_in_use()) {
+            pool_closing = closing = true;
+        } else {
+            mem = pool_detach();
+        }
+    }
+    portEXIT_CRITICAL(&pool_lock);
+
+    if (closing) {
+        OSI_TRACE_WARNING("%s, buffers still in use, released on their last free\n", __func__);
+    }
+    free(mem);
+}
+
+void *osi_buf_pool_malloc(size_t size)
+{
+    osi_buf_pool_class_t *cls = NULL;
+    osi_buf_pool_node_t *node = NULL;
+    int i;
+
+    for (i = 0; i < OSI_BUF_POOL_CLASS_NUM; i++) {
+        if (size <= pool_buf_size[i]) {
+            cls = &pool_classes[i];
+            break;
+        }
+    }
+
+    portENTER_CRITICAL_SAFE(&pool_lock);
+    if (osi_buf_pool_start != NULL && !pool_closing) {
+        if (cls == NULL) {
+            pool_oversize++;
+        } else if ((node = cls->free_list) != NULL) {
+            cls->free_list = node->next;
+            cls->stats.allocs++;
+            if (++cls->stats.in_use > cls->stats.in_use_max) {
+                cls->stats.in_use_max = cls->stats.in_use;
+            }
+        } else {
+            cls->stats.exhausted++;
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&pool_lock);
+
+    if (node == NULL) {
+        return osi_malloc(size);
+    }
+    return node;
+}
+
+void osi_buf_pool_free(void *ptr)
+{
+    osi_buf_pool_node_t *node = (osi_buf_pool_node_t *)ptr;
+    osi_buf_pool_class_t *cls = &pool_classes[0];
+    void *mem = NULL;
+
+    while ((uint8_t *)ptr >= cls->end) {
+        cls++;
+    }
+
+    portENTER_CRITICAL_SAFE(&pool_lock);
+    node->next = cls->free_list;
+    cls->free_list = node;
+    cls->stats.in_use--;
+    if (pool_closing && !pool_in_use()) {
+        mem = pool_detach();
+    }
+    portEXIT_CRITICAL_SAFE(&pool_lock);
+
+    free(mem);
+}
+
+bool osi_buf_pool_get_stats(uint8_t cls, osi_buf_pool_stats_t *stats)
+{
+    bool ret = false;
+
+    if (cls >= OSI_BUF_POOL_CLASS_NUM || stats == NULL) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&pool_lock);
+    if (osi_buf_pool_start != NULL) {
+        *stats = pool_classes[cls].stats;
+        ret = true;
+    }
+    portEXIT_CRITICAL(&pool_lock);
+    return ret;
+}
+
+uint32_t osi_buf_pool_get_oversize(void)
+{
+    return pool_oversize;
+}
+
+void osi_buf_pool_show(void)
+{
+    osi_buf_pool_stats_t stats;
+
+    for (uint8_t i = 0; i < OSI_BUF_POOL_CLASS_NUM; i++) {
+        if (osi_buf_pool_get_stats(i, &stats)) {
+            OSI_TRACE_ERROR("--> buf pool %dB x %d, in use %d, max %d, allocs %u, exhausted %u\n",
+                            stats.buf_size, stats.buf_num, stats.in_use, stats.in_use_max,
+                            stats.allocs, stats.exhausted);
+        }
+    }
+    OSI_TRACE_ERROR("--> buf pool oversize %u\n", pool_oversize);
+}
+
+#endif /* BT_BUF_POOL_INCLUDED == TRUE */
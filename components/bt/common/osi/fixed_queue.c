@@ -16,6 +16,7 @@
  *
  ******************************************************************************/
 
+#include <stdatomic.h>
 #include "osi/allocator.h"
 #include "osi/fixed_queue.h"
 #include "osi/list.h"
@@ -23,6 +24,13 @@
 #include "osi/mutex.h"
 #include "osi/semaphore.h"
 
+// A cell of the ring of a lock-free queue. |seq| is the enqueue position the
+// cell is free for, or that position plus one once |data| is filled in.
+typedef struct {
+    atomic_uint_least32_t seq;
+    void *data;
+} fixed_queue_cell_t;
+
 typedef struct fixed_queue_t {
 
     list_t *list;
@@ -32,8 +40,173 @@ typedef struct fixed_queue_t {
     size_t capacity;
 
     fixed_queue_cb dequeue_ready;
+
+    // Lock-free queues only, |list| and |lock| are not used then. The
+    // semaphores are given only when the other side counts a waiter.
+    fixed_queue_cell_t *cells;
+    uint32_t mask;
+    atomic_uint_least32_t enqueue_pos;
+    atomic_uint_least32_t dequeue_pos;
+    atomic_uint_least32_t enqueue_waiters;
+    atomic_uint_least32_t dequeue_waiters;
 } fixed_queue_t;
 
+static bool fixed_queue_ring_push(fixed_queue_t *queue, void *data)
+{
+    uint32_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    fixed_queue_cell_t *cell;
+
+    for (;;) {
+        cell = &queue->cells[pos & queue->mask];
+        int32_t diff = (int32_t)(atomic_load_explicit(&cell->seq, memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // the cell still holds the element of the previous lap
+            return false;
+        } else {
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    cell->data = data;
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+    return true;
+}
+
+// Takes up to |max| elements in a single update of |dequeue_pos|.
+static size_t fixed_queue_ring_pop(fixed_queue_t *queue, void **data, size_t max)
+{
+    uint32_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    uint32_t seq = 0;
+    size_t n;
+
+    for (;;) {
+        for (n = 0; n < max; n++) {
+            seq = atomic_load_explicit(&queue->cells[(pos + n) & queue->mask].seq, memory_order_acquire);
+            if (seq != pos + n + 1) {
+                break;
+            }
+        }
+
+        if (n > 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + n,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if ((int32_t)(seq - (pos + 1)) < 0) {
+            // empty, or the element at |pos| is still being written
+            return 0;
+        } else {
+            pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        fixed_queue_cell_t *cell = &queue->cells[(pos + i) & queue->mask];
+        data[i] = cell->data;
+        atomic_store_explicit(&cell->seq, pos + i + queue->mask + 1, memory_order_release);
+    }
+    return n;
+}
+
+// Wakes up to |count| tasks waiting on |sem|. The fence pairs with the one of
+// fixed_queue_ring_wait(): either the waiter sees the ring change or we see it
+// counted.
+static void fixed_queue_ring_wake(atomic_uint_least32_t *waiters, osi_sem_t *sem, size_t count)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    uint32_t n = atomic_load_explicit(waiters, memory_order_relaxed);
+
+    while (n-- > 0 && count-- > 0) {
+        osi_sem_give(sem);
+    }
+}
+
+// Sleeps on |sem| until the other side wakes us or |timeout| runs out, unless
+// |retry| succeeds once we are counted. Returns true if woken, or if |retry|
+// succeeded, in which case |*done| is set.
+static bool fixed_queue_ring_wait(fixed_queue_t *queue, atomic_uint_least32_t *waiters, osi_sem_t *sem,
+                                  uint32_t timeout, bool (*retry)(fixed_queue_t *, void *), void *arg, bool *done)
+{
+    int ret = 0;
+
+    atomic_fetch_add_explicit(waiters, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    *done = retry(queue, arg);
+    if (!*done) {
+        ret = osi_sem_take(sem, timeout);
+    }
+    atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+
+    return ret == 0;
+}
+
+typedef struct {
+    void **data;
+    size_t max;
+    size_t n;
+} fixed_queue_pop_arg_t;
+
+static bool fixed_queue_ring_retry_push(fixed_queue_t *queue, void *arg)
+{
+    return fixed_queue_ring_push(queue, arg);
+}
+
+static bool fixed_queue_ring_retry_pop(fixed_queue_t *queue, void *arg)
+{
+    fixed_queue_pop_arg_t *pop = (fixed_queue_pop_arg_t *)arg;
+
+    pop->n = fixed_queue_ring_pop(queue, pop->data, pop->max);
+    return pop->n > 0;
+}
+
+// A wake-up may be left over from a waiter that found an element on its own,
+// so waking up does not guarantee success: the wait starts over then.
+static bool fixed_queue_ring_enqueue(fixed_queue_t *queue, void *data, uint32_t timeout)
+{
+    bool done = fixed_queue_ring_push(queue, data);
+
+    while (!done) {
+        if (timeout == 0 ||
+                !fixed_queue_ring_wait(queue, &queue->enqueue_waiters, &queue->enqueue_sem,
+                                       timeout, fixed_queue_ring_retry_push, data, &done)) {
+            return false;
+        }
+        if (!done) {
+            done = fixed_queue_ring_push(queue, data);
+        }
+    }
+
+    fixed_queue_ring_wake(&queue->dequeue_waiters, &queue->dequeue_sem, 1);
+    return true;
+}
+
+static size_t fixed_queue_ring_dequeue(fixed_queue_t *queue, void **data, size_t max, uint32_t timeout)
+{
+    fixed_queue_pop_arg_t pop = { .data = data, .max = max, .n = 0 };
+    bool done;
+
+    pop.n = fixed_queue_ring_pop(queue, data, max);
+    done = pop.n > 0;
+    while (!done) {
+        if (timeout == 0 ||
+                !fixed_queue_ring_wait(queue, &queue->dequeue_waiters, &queue->dequeue_sem,
+                                       timeout, fixed_queue_ring_retry_pop, &pop, &done)) {
+            return 0;
+        }
+        if (!done) {
+            done = fixed_queue_ring_retry_pop(queue, &pop);
+        }
+    }
+
+    fixed_queue_ring_wake(&queue->enqueue_waiters, &queue->enqueue_sem, pop.n);
+    return pop.n;
+}
+
 
 fixed_queue_t *fixed_queue_new(size_t capacity)
 {
@@ -68,6 +241,54 @@ error:;
     return NULL;
 }
 
+fixed_queue_t *fixed_queue_new_lockfree(size_t capacity)
+{
+    uint32_t size = 1;
+
+    assert(capacity > 0 && capacity <= 0x80000000);
+
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    fixed_queue_t *ret = osi_calloc(sizeof(fixed_queue_t));
+    if (!ret) {
+        goto error;
+    }
+
+    ret->capacity = size;
+    ret->mask = size - 1;
+
+    ret->cells = osi_malloc(sizeof(fixed_queue_cell_t) * size);
+    if (!ret->cells) {
+        goto error;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        atomic_init(&ret->cells[i].seq, i);
+        ret->cells[i].data = NULL;
+    }
+    atomic_init(&ret->enqueue_pos, 0);
+    atomic_init(&ret->dequeue_pos, 0);
+    atomic_init(&ret->enqueue_waiters, 0);
+    atomic_init(&ret->dequeue_waiters, 0);
+
+    osi_sem_new(&ret->enqueue_sem, size, 0);
+    if (!ret->enqueue_sem) {
+        goto error;
+    }
+
+    osi_sem_new(&ret->dequeue_sem, size, 0);
+    if (!ret->dequeue_sem) {
+        goto error;
+    }
+
+    return ret;
+
+error:;
+    fixed_queue_free(ret, NULL);
+    return NULL;
+}
+
 void fixed_queue_free(fixed_queue_t *queue, fixed_queue_free_cb free_cb)
 {
     const list_node_t *node;
@@ -78,16 +299,32 @@ void fixed_queue_free(fixed_queue_t *queue, fixed_queue_free_cb free_cb)
 
     fixed_queue_unregister_dequeue(queue);
 
-    if (free_cb) {
-        for (node = list_begin(queue->list); node != list_end(queue->list); node = list_next(node)) {
-            free_cb(list_node(node));
+    if (queue->cells) {
+        void *data;
+
+        while (free_cb && fixed_queue_ring_pop(queue, &data, 1)) {
+            free_cb(data);
+        }
+        osi_free(queue->cells);
+    } else {
+        if (free_cb) {
+            for (node = list_begin(queue->list); node != list_end(queue->list); node = list_next(node)) {
+                free_cb(list_node(node));
+            }
+        }
+
+        list_free(queue->list);
+        if (queue->lock) {
+            osi_mutex_free(&queue->lock);
         }
     }
 
-    list_free(queue->list);
-    osi_sem_free(&queue->enqueue_sem);
-    osi_sem_free(&queue->dequeue_sem);
-    osi_mutex_free(&queue->lock);
+    if (queue->enqueue_sem) {
+        osi_sem_free(&queue->enqueue_sem);
+    }
+    if (queue->dequeue_sem) {
+        osi_sem_free(&queue->dequeue_sem);
+    }
     osi_free(queue);
 }
 
@@ -99,6 +336,10 @@ bool fixed_queue_is_empty(fixed_queue_t *queue)
         return true;
     }
 
+    if (queue->cells) {
+        return fixed_queue_length(queue) == 0;
+    }
+
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
     is_empty = list_is_empty(queue->list);
     osi_mutex_unlock(&queue->lock);
@@ -114,6 +355,15 @@ size_t fixed_queue_length(fixed_queue_t *queue)
         return 0;
     }
 
+    if (queue->cells) {
+        // |dequeue_pos| first, it may only move towards |enqueue_pos| meanwhile
+        uint32_t tail = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+        uint32_t head = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+
+        length = head - tail;
+        return length > queue->capacity ? queue->capacity : length;
+    }
+
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
     length = list_length(queue->list);
     osi_mutex_unlock(&queue->lock);
@@ -134,6 +384,10 @@ bool fixed_queue_enqueue(fixed_queue_t *queue, void *data, uint32_t timeout)
     assert(queue != NULL);
     assert(data != NULL);
 
+    if (queue->cells) {
+        return fixed_queue_ring_enqueue(queue, data, timeout);
+    }
+
     if (osi_sem_take(&queue->enqueue_sem, timeout) != 0) {
         return false;
     }
@@ -154,6 +408,11 @@ void *fixed_queue_dequeue(fixed_queue_t *queue, uint32_t timeout)
 
     assert(queue != NULL);
 
+    if (queue->cells) {
+        fixed_queue_ring_dequeue(queue, &ret, 1, timeout);
+        return ret;
+    }
+
     if (osi_sem_take(&queue->dequeue_sem, timeout) != 0) {
         return NULL;
     }
@@ -168,6 +427,39 @@ void *fixed_queue_dequeue(fixed_queue_t *queue, uint32_t timeout)
     return ret;
 }
 
+size_t fixed_queue_dequeue_batch(fixed_queue_t *queue, void **data, size_t max, uint32_t timeout)
+{
+    size_t n = 1;
+
+    assert(queue != NULL);
+    assert(data != NULL);
+    assert(max > 0);
+
+    if (queue->cells) {
+        return fixed_queue_ring_dequeue(queue, data, max, timeout);
+    }
+
+    if (osi_sem_take(&queue->dequeue_sem, timeout) != 0) {
+        return 0;
+    }
+    while (n < max && osi_sem_take(&queue->dequeue_sem, 0) == 0) {
+        n++;
+    }
+
+    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
+    for (size_t i = 0; i < n; i++) {
+        data[i] = list_front(queue->list);
+        list_remove(queue->list, data[i]);
+    }
+    osi_mutex_unlock(&queue->lock);
+
+    for (size_t i = 0; i < n; i++) {
+        osi_sem_give(&queue->enqueue_sem);
+    }
+
+    return n;
+}
+
 void *fixed_queue_try_peek_first(fixed_queue_t *queue)
 {
     void *ret = NULL;
@@ -176,6 +468,13 @@ void *fixed_queue_try_peek_first(fixed_queue_t *queue)
         return NULL;
     }
 
+    if (queue->cells) {
+        uint32_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+        fixed_queue_cell_t *cell = &queue->cells[pos & queue->mask];
+
+        return atomic_load_explicit(&cell->seq, memory_order_acquire) == pos + 1 ? cell->data : NULL;
+    }
+
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
     ret = list_is_empty(queue->list) ? NULL : list_front(queue->list);
     osi_mutex_unlock(&queue->lock);
@@ -191,6 +490,13 @@ void *fixed_queue_try_peek_last(fixed_queue_t *queue)
         return NULL;
     }
 
+    if (queue->cells) {
+        uint32_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed) - 1;
+        fixed_queue_cell_t *cell = &queue->cells[pos & queue->mask];
+
+        return atomic_load_explicit(&cell->seq, memory_order_acquire) == pos + 1 ? cell->data : NULL;
+    }
+
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
     ret = list_is_empty(queue->list) ? NULL : list_back(queue->list);
     osi_mutex_unlock(&queue->lock);
@@ -202,7 +508,7 @@ void *fixed_queue_try_remove_from_queue(fixed_queue_t *queue, void *data)
 {
     bool removed = false;
 
-    if (queue == NULL) {
+    if (queue == NULL || queue->cells) {
         return NULL;
     }
 
@@ -226,6 +532,10 @@ list_t *fixed_queue_get_list(fixed_queue_t *queue)
 {
     assert(queue != NULL);
 
+    if (queue->cells) {
+        return NULL;
+    }
+
     // NOTE: This function is not thread safe, and there is no point for
     // calling osi_mutex_lock() / osi_mutex_unlock()
     return queue->list;
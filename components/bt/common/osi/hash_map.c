@@ -16,34 +16,45 @@
  *
  ******************************************************************************/
 
+#include <string.h>
 #include "bt_common.h"
-#include "osi/list.h"
 #include "osi/hash_map.h"
+#include "osi/hash_functions.h"
 #include "osi/allocator.h"
 
 struct hash_map_t;
 
-typedef struct hash_map_bucket_t {
-    list_t *list;
-} hash_map_bucket_t;
+// The entries are stored inline in an open addressing table with Robin Hood
+// probing: an entry being inserted takes the slot of any entry closer to its
+// home slot than itself, which keeps the probe sequences short and lets a
+// lookup stop at the first entry closer to home than the key would be.
+typedef struct hash_map_slot_t {
+    const void *key;
+    void *data;
+    uint16_t psl;           // probe sequence length + 1, 0 if the slot is empty
+    uint16_t tag;           // low bits of the mixed hash, checked before the keys
+} hash_map_slot_t;
 
 typedef struct hash_map_t {
-    hash_map_bucket_t *bucket;
-    size_t num_bucket;
+    hash_map_slot_t *slot;
+    size_t num_slot;        // a power of two
     size_t hash_size;
+    uint8_t shift;          // the top bits of the mixed hash index the slots
+    bool int_keys;          // the key is its own hash and compared by value
     hash_index_fn hash_fn;
     key_free_fn key_fn;
     data_free_fn data_fn;
     key_equality_fn keys_are_equal;
 } hash_map_t;
 
-// Hidden constructor for list, only to be used by us.
-list_t *list_new_internal(list_free_cb callback);
+#define HASH_MAP_MIN_SLOTS      8
+// grown past 7/8 full
+#define HASH_MAP_LOAD_NUM       7
+#define HASH_MAP_LOAD_DEN       8
+#define HASH_MAP_MIX            2654435769u
 
-static void bucket_free_(void *data);
 static bool default_key_equality(const void *x, const void *y);
-static hash_map_entry_t *find_bucket_entry_(list_t *hash_bucket_list,
-        const void *key);
+static bool resize_(hash_map_t *hash_map, size_t num_slot);
 
 // Hidden constructor, only to be used by the allocation tracker. Behaves the same as
 // |hash_map_new|, except you get to specify the allocator.
@@ -65,10 +76,17 @@ hash_map_t *hash_map_new_internal(
     hash_map->key_fn = key_fn;
     hash_map->data_fn = data_fn;
     hash_map->keys_are_equal = equality_fn ? equality_fn : default_key_equality;
-
-    hash_map->num_bucket = num_bucket;
-    hash_map->bucket = osi_calloc(sizeof(hash_map_bucket_t) * num_bucket);
-    if (hash_map->bucket == NULL) {
+    // integer and pointer keys are hashed and compared inline
+    hash_map->int_keys = equality_fn == NULL &&
+                         (hash_fn == hash_function_naive || hash_fn == hash_function_integer ||
+                          hash_fn == hash_function_pointer);
+
+    // |num_bucket| was sized for chaining, about one bucket per entry
+    size_t num_slot = HASH_MAP_MIN_SLOTS;
+    while (num_slot < num_bucket) {
+        num_slot <<= 1;
+    }
+    if (!resize_(hash_map, num_slot)) {
         osi_free(hash_map);
         return NULL;
     }
@@ -91,7 +109,7 @@ void hash_map_free(hash_map_t *hash_map)
         return;
     }
     hash_map_clear(hash_map);
-    osi_free(hash_map->bucket);
+    osi_free(hash_map->slot);
     osi_free(hash_map);
 }
 
@@ -108,90 +126,179 @@ size_t hash_map_size(const hash_map_t *hash_map) {
 
 size_t hash_map_num_buckets(const hash_map_t *hash_map) {
   assert(hash_map != NULL);
-  return hash_map->num_bucket;
+  return hash_map->num_slot;
 }
 */
 
-bool hash_map_has_key(const hash_map_t *hash_map, const void *key)
+static inline uint32_t mix_(const hash_map_t *hash_map, const void *key)
 {
-    assert(hash_map != NULL);
+    hash_index_t hash = hash_map->int_keys ? (hash_index_t)key : hash_map->hash_fn(key);
+    return (uint32_t)hash * HASH_MAP_MIX;
+}
+
+static hash_map_slot_t *find_slot_(const hash_map_t *hash_map, const void *key)
+{
+    uint32_t mix = mix_(hash_map, key);
+    size_t mask = hash_map->num_slot - 1;
+    size_t i = mix >> hash_map->shift;
+    uint16_t tag = (uint16_t)mix;
+
+    for (uint16_t psl = 1; ; psl++, i = (i + 1) & mask) {
+        hash_map_slot_t *slot = &hash_map->slot[i];
+        // empty, or an entry closer to home than |key| would be
+        if (slot->psl < psl) {
+            return NULL;
+        }
+        if (hash_map->int_keys) {
+            if (slot->key == key) {
+                return slot;
+            }
+        } else if (slot->tag == tag && hash_map->keys_are_equal(slot->key, key)) {
+            return slot;
+        }
+    }
+}
 
-    hash_index_t hash_key = hash_map->hash_fn(key) % hash_map->num_bucket;
-    list_t *hash_bucket_list = hash_map->bucket[hash_key].list;
+// Places |entry|, whose key is not in the map, from slot |i| on.
+static void place_(hash_map_t *hash_map, hash_map_slot_t entry, size_t i)
+{
+    size_t mask = hash_map->num_slot - 1;
 
-    hash_map_entry_t *hash_map_entry = find_bucket_entry_(hash_bucket_list, key);
-    return (hash_map_entry != NULL);
+    for (; ; i = (i + 1) & mask, entry.psl++) {
+        hash_map_slot_t *slot = &hash_map->slot[i];
+        if (slot->psl == 0) {
+            *slot = entry;
+            return;
+        }
+        if (slot->psl < entry.psl) {
+            hash_map_slot_t tmp = *slot;
+            *slot = entry;
+            entry = tmp;
+        }
+    }
 }
 
-bool hash_map_set(hash_map_t *hash_map, const void *key, void *data)
+static void insert_(hash_map_t *hash_map, const void *key, void *data)
 {
-    assert(hash_map != NULL);
-    assert(data != NULL);
+    uint32_t mix = mix_(hash_map, key);
+    hash_map_slot_t entry = {
+        .key = key,
+        .data = data,
+        .psl = 1,
+        .tag = (uint16_t)mix,
+    };
+    place_(hash_map, entry, mix >> hash_map->shift);
+}
 
-    hash_index_t hash_key = hash_map->hash_fn(key) % hash_map->num_bucket;
+// Moves the entries to a table of |num_slot| slots, the only allocation
+// made after |hash_map_new|.
+static bool resize_(hash_map_t *hash_map, size_t num_slot)
+{
+    hash_map_slot_t *old_slot = hash_map->slot;
+    size_t old_num_slot = hash_map->num_slot;
+    uint8_t shift = 32;
 
-    if (hash_map->bucket[hash_key].list == NULL) {
-        hash_map->bucket[hash_key].list = list_new_internal(bucket_free_);
-        if (hash_map->bucket[hash_key].list == NULL) {
-            return false;
-        }
+    hash_map_slot_t *slot = osi_calloc(sizeof(hash_map_slot_t) * num_slot);
+    if (slot == NULL) {
+        return false;
+    }
+    for (size_t n = num_slot; n > 1; n >>= 1) {
+        shift--;
     }
-    list_t *hash_bucket_list = hash_map->bucket[hash_key].list;
 
-    hash_map_entry_t *hash_map_entry = find_bucket_entry_(hash_bucket_list, key);
+    hash_map->slot = slot;
+    hash_map->num_slot = num_slot;
+    hash_map->shift = shift;
+    for (size_t i = 0; i < old_num_slot; i++) {
+        if (old_slot[i].psl != 0) {
+            insert_(hash_map, old_slot[i].key, old_slot[i].data);
+        }
+    }
+    osi_free(old_slot);
+    return true;
+}
 
-    if (hash_map_entry) {
-        // Calls hash_map callback to delete the hash_map_entry.
-        bool rc = list_remove(hash_bucket_list, hash_map_entry);
-        assert(rc == true);
-        (void)rc;
-    } else {
-        hash_map->hash_size++;
+static void free_entry_(const hash_map_t *hash_map, const void *key, void *data)
+{
+    if (hash_map->key_fn) {
+        hash_map->key_fn((void *)key);
     }
-    hash_map_entry = osi_calloc(sizeof(hash_map_entry_t));
-    if (hash_map_entry == NULL) {
-        return false;
+    if (hash_map->data_fn) {
+        hash_map->data_fn(data);
     }
+}
 
-    hash_map_entry->key = key;
-    hash_map_entry->data = data;
-    hash_map_entry->hash_map = hash_map;
+bool hash_map_has_key(const hash_map_t *hash_map, const void *key)
+{
+    assert(hash_map != NULL);
 
-    return list_append(hash_bucket_list, hash_map_entry);
+    return (find_slot_(hash_map, key) != NULL);
 }
 
-bool hash_map_erase(hash_map_t *hash_map, const void *key)
+bool hash_map_set(hash_map_t *hash_map, const void *key, void *data)
 {
     assert(hash_map != NULL);
+    assert(data != NULL);
 
-    hash_index_t hash_key = hash_map->hash_fn(key) % hash_map->num_bucket;
-    list_t *hash_bucket_list = hash_map->bucket[hash_key].list;
+    hash_map_slot_t *slot = find_slot_(hash_map, key);
+    if (slot != NULL) {
+        // The previous entry is released as if erased.
+        const void *old_key = slot->key;
+        void *old_data = slot->data;
+        slot->key = key;
+        slot->data = data;
+        free_entry_(hash_map, old_key, old_data);
+        return true;
+    }
 
-    hash_map_entry_t *hash_map_entry = find_bucket_entry_(hash_bucket_list, key);
-    if (hash_map_entry == NULL) {
+    if ((hash_map->hash_size + 1) * HASH_MAP_LOAD_DEN > hash_map->num_slot * HASH_MAP_LOAD_NUM &&
+            !resize_(hash_map, hash_map->num_slot << 1)) {
         return false;
     }
+    insert_(hash_map, key, data);
+    hash_map->hash_size++;
+    return true;
+}
 
-    hash_map->hash_size--;
-    bool remove = list_remove(hash_bucket_list, hash_map_entry);
-    if(list_is_empty(hash_map->bucket[hash_key].list)) {
-        list_free(hash_map->bucket[hash_key].list);
-        hash_map->bucket[hash_key].list = NULL;
+bool hash_map_erase(hash_map_t *hash_map, const void *key)
+{
+    assert(hash_map != NULL);
+
+    hash_map_slot_t *slot = find_slot_(hash_map, key);
+    if (slot == NULL) {
+        return false;
     }
 
-    return remove;
+    const void *old_key = slot->key;
+    void *old_data = slot->data;
+    size_t mask = hash_map->num_slot - 1;
+    size_t i = slot - hash_map->slot;
+
+    // Shifts back the entries that follow, up to an empty slot or one at home,
+    // so that no probe sequence crosses an empty slot.
+    for (;;) {
+        size_t next = (i + 1) & mask;
+        if (hash_map->slot[next].psl <= 1) {
+            break;
+        }
+        hash_map->slot[i] = hash_map->slot[next];
+        hash_map->slot[i].psl--;
+        i = next;
+    }
+    memset(&hash_map->slot[i], 0, sizeof(hash_map_slot_t));
+
+    hash_map->hash_size--;
+    free_entry_(hash_map, old_key, old_data);
+    return true;
 }
 
 void *hash_map_get(const hash_map_t *hash_map, const void *key)
 {
     assert(hash_map != NULL);
 
-    hash_index_t hash_key = hash_map->hash_fn(key) % hash_map->num_bucket;
-    list_t *hash_bucket_list = hash_map->bucket[hash_key].list;
-
-    hash_map_entry_t *hash_map_entry = find_bucket_entry_(hash_bucket_list, key);
-    if (hash_map_entry != NULL) {
-        return hash_map_entry->data;
+    hash_map_slot_t *slot = find_slot_(hash_map, key);
+    if (slot != NULL) {
+        return slot->data;
     }
 
     return NULL;
@@ -201,13 +308,15 @@ void hash_map_clear(hash_map_t *hash_map)
 {
     assert(hash_map != NULL);
 
-    for (hash_index_t i = 0; i < hash_map->num_bucket; i++) {
-        if (hash_map->bucket[i].list == NULL) {
+    for (size_t i = 0; i < hash_map->num_slot; i++) {
+        hash_map_slot_t slot = hash_map->slot[i];
+        if (slot.psl == 0) {
             continue;
         }
-        list_free(hash_map->bucket[i].list);
-        hash_map->bucket[i].list = NULL;
+        memset(&hash_map->slot[i], 0, sizeof(hash_map_slot_t));
+        free_entry_(hash_map, slot.key, slot.data);
     }
+    hash_map->hash_size = 0;
 }
 
 void hash_map_foreach(hash_map_t *hash_map, hash_map_iter_cb callback, void *context)
@@ -215,55 +324,22 @@ void hash_map_foreach(hash_map_t *hash_map, hash_map_iter_cb callback, void *con
     assert(hash_map != NULL);
     assert(callback != NULL);
 
-    for (hash_index_t i = 0; i < hash_map->num_bucket; ++i) {
-        if (hash_map->bucket[i].list == NULL) {
+    for (size_t i = 0; i < hash_map->num_slot; ++i) {
+        if (hash_map->slot[i].psl == 0) {
             continue;
         }
-        for (const list_node_t *iter = list_begin(hash_map->bucket[i].list);
-                iter != list_end(hash_map->bucket[i].list);
-                iter = list_next(iter)) {
-            hash_map_entry_t *hash_map_entry = (hash_map_entry_t *)list_node(iter);
-            if (!callback(hash_map_entry, context)) {
-                return;
-            }
+        // only valid for the call, the entries move within the table
+        hash_map_entry_t hash_map_entry = {
+            .key = hash_map->slot[i].key,
+            .data = hash_map->slot[i].data,
+            .hash_map = hash_map,
+        };
+        if (!callback(&hash_map_entry, context)) {
+            return;
         }
     }
 }
 
-static void bucket_free_(void *data)
-{
-    assert(data != NULL);
-    hash_map_entry_t *hash_map_entry = (hash_map_entry_t *)data;
-    const hash_map_t *hash_map = hash_map_entry->hash_map;
-
-    if (hash_map->key_fn) {
-        hash_map->key_fn((void *)hash_map_entry->key);
-    }
-    if (hash_map->data_fn) {
-        hash_map->data_fn(hash_map_entry->data);
-    }
-    osi_free(hash_map_entry);
-}
-
-static hash_map_entry_t *find_bucket_entry_(list_t *hash_bucket_list,
-        const void *key)
-{
-
-    if (hash_bucket_list == NULL) {
-        return NULL;
-    }
-
-    for (const list_node_t *iter = list_begin(hash_bucket_list);
-            iter != list_end(hash_bucket_list);
-            iter = list_next(iter)) {
-        hash_map_entry_t *hash_map_entry = (hash_map_entry_t *)list_node(iter);
-        if (hash_map_entry->hash_map->keys_are_equal(hash_map_entry->key, key)) {
-            return hash_map_entry;
-        }
-    }
-    return NULL;
-}
-
 static bool default_key_equality(const void *x, const void *y)
 {
     return x == y;
@@ -22,6 +22,7 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include "esp_heap_caps.h"
+#include "osi/buf_pool.h"
 
 char *osi_strdup(const char *str);
 
@@ -116,8 +117,12 @@ do {                                                    \
 #define osi_free(ptr)                                   \
 do {                                                    \
     void *tmp_point = (void *)(ptr);                    \
-    osi_mem_dbg_clean(tmp_point, __func__, __LINE__);   \
-    free(tmp_point);                                    \
+    if (osi_buf_pool_owns(tmp_point)) {                 \
+        osi_buf_pool_free(tmp_point);                   \
+    } else {                                            \
+        osi_mem_dbg_clean(tmp_point, __func__, __LINE__); \
+        free(tmp_point);                                \
+    }                                                   \
 } while (0)
 
 #else
@@ -129,7 +134,19 @@ do {                                                    \
 #define osi_malloc(size)                  malloc((size))
 #define osi_calloc(size)                  calloc(1, (size))
 #endif /* #if HEAP_ALLOCATION_FROM_SPIRAM_FIRST */
+#if (BT_BUF_POOL_INCLUDED == TRUE)
+#define osi_free(ptr)                                   \
+do {                                                    \
+    void *tmp_point = (void *)(ptr);                    \
+    if (osi_buf_pool_owns(tmp_point)) {                 \
+        osi_buf_pool_free(tmp_point);                   \
+    } else {                                            \
+        free(tmp_point);                                \
+    }                                                   \
+} while (0)
+#else
 #define osi_free(p)                       free((p))
+#endif /* BT_BUF_POOL_INCLUDED == TRUE */
 
 #endif /* HEAP_MEMORY_DEBUG */
 
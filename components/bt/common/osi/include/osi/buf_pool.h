@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _BUF_POOL_H_
+#define _BUF_POOL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "bt_common.h"
+
+// Size classes of the packet buffer pool. The small class holds an HCI event
+// or an LE ACL packet, the large class a BR/EDR ACL packet of the controller
+// (1021 bytes of payload), both with their BT_HDR and H4 packet type.
+#define OSI_BUF_POOL_SMALL              (0)
+#define OSI_BUF_POOL_LARGE              (1)
+#define OSI_BUF_POOL_CLASS_NUM          (2)
+
+#define OSI_BUF_POOL_SMALL_SIZE         (272)
+#define OSI_BUF_POOL_LARGE_SIZE         (1040)
+
+typedef struct {
+    uint16_t buf_size;      // bytes of each buffer of the class
+    uint16_t buf_num;       // buffers of the class
+    uint16_t in_use;        // buffers allocated now
+    uint16_t in_use_max;    // high-water mark of |in_use|
+    uint32_t allocs;        // allocations served by the class
+    uint32_t exhausted;     // allocations that found the class empty and went to the heap
+} osi_buf_pool_stats_t;
+
+#if (BT_BUF_POOL_INCLUDED == TRUE)
+
+// Bounds of the memory of the pool, for osi_buf_pool_owns().
+extern uint8_t *osi_buf_pool_start;
+extern uint8_t *osi_buf_pool_end;
+
+// Creates the pool with the number of buffers of each class set in the
+// configuration. Returns true on success or if the pool already exists.
+bool osi_buf_pool_init(void);
+
+// Releases the pool. Buffers still allocated stay valid and the memory of
+// the pool is released when the last one is freed.
+void osi_buf_pool_deinit(void);
+
+// Allocates |size| bytes, from the smallest class that fits or from the heap
+// if there is none or it is empty. Constant time, the memory is not zeroed.
+// The buffer is freed with osi_free() like any other.
+void *osi_buf_pool_malloc(size_t size);
+
+// Returns |ptr|, which must be owned by the pool, to its class. Called by
+// osi_free(), not meant to be called directly.
+void osi_buf_pool_free(void *ptr);
+
+// Returns true if |ptr| is a buffer of the pool.
+static inline bool osi_buf_pool_owns(const void *ptr)
+{
+    return (const uint8_t *)ptr >= osi_buf_pool_start && (const uint8_t *)ptr < osi_buf_pool_end;
+}
+
+// Copies the statistics of class |cls| to |stats|. The counters run from
+// osi_buf_pool_init(). Returns false if the pool or the class does not exist.
+bool osi_buf_pool_get_stats(uint8_t cls, osi_buf_pool_stats_t *stats);
+
+// Returns the number of allocations larger than the largest class.
+uint32_t osi_buf_pool_get_oversize(void);
+
+// Logs the statistics of every class.
+void osi_buf_pool_show(void);
+
+#else
+
+#define osi_buf_pool_init()             (true)
+#define osi_buf_pool_deinit()
+#define osi_buf_pool_malloc(size)       osi_malloc(size)
+#define osi_buf_pool_owns(ptr)          (false)
+#define osi_buf_pool_free(ptr)
+
+#endif /* BT_BUF_POOL_INCLUDED == TRUE */
+
+#endif /* _BUF_POOL_H_ */
@@ -43,6 +43,14 @@ typedef void (*fixed_queue_cb)(fixed_queue_t *queue);
 // the returned queue with |fixed_queue_free|.
 fixed_queue_t *fixed_queue_new(size_t capacity);
 
+// Creates a new fixed queue like |fixed_queue_new|, backed by a lock-free ring
+// of |capacity| slots rounded up to a power of two instead of a list. Any
+// number of tasks may enqueue and dequeue at the same time without taking a
+// mutex, the semaphores only put a task to sleep on a full or empty queue.
+// |fixed_queue_try_remove_from_queue| and |fixed_queue_get_list| are not
+// supported by such a queue and return NULL.
+fixed_queue_t *fixed_queue_new_lockfree(size_t capacity);
+
 // Freeing a queue that is currently in use (i.e. has waiters
 // blocked on it) results in undefined behaviour.
 void fixed_queue_free(fixed_queue_t *queue, fixed_queue_free_cb free_cb);
@@ -68,6 +76,12 @@ bool fixed_queue_enqueue(fixed_queue_t *queue, void *data, uint32_t timeout);
 // If dequeue failed, it will return NULL, otherwise return a point.
 void *fixed_queue_dequeue(fixed_queue_t *queue, uint32_t timeout);
 
+// Dequeues up to |max| elements from |queue| into |data|, oldest first. The
+// caller waits for the first element as with |fixed_queue_dequeue|, the
+// others are only taken if already queued. Returns the number of elements
+// dequeued, 0 on timeout. |max| must be at least 1.
+size_t fixed_queue_dequeue_batch(fixed_queue_t *queue, void **data, size_t max, uint32_t timeout);
+
 // Returns the first element from |queue|, if present, without dequeuing it.
 // This function will never block the caller. Returns NULL if there are no
 // elements in the queue or |queue| is NULL.
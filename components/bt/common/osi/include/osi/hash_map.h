@@ -44,8 +44,9 @@ typedef void (*data_free_fn)(void *data);
 
 // Returns a new, empty hash_map. Returns NULL if not enough memory could be allocated
 // for the hash_map structure. The returned hash_map must be freed with |hash_map_free|.
-// The |num_bucket| specifies the number of hashable buckets for the map and must not
-// be zero.  The |hash_fn| specifies a hash function to be used and must not be NULL.
+// The |num_bucket| is the number of entries expected in the map and must not be zero.
+// The entries are stored inline, and the map only allocates again when it grows past it.
+// The |hash_fn| specifies a hash function to be used and must not be NULL.
 // The |key_fn| and |data_fn| are called whenever a hash_map element is removed from
 // the hash_map. They can be used to release resources held by the hash_map element,
 // e.g.  memory or file descriptor.  |key_fn| and |data_fn| may be NULL if no cleanup
@@ -105,6 +106,7 @@ void hash_map_clear(hash_map_t *hash_map);
 // empty, |callback| will never be called. It is not safe to mutate the
 // hash_map inside the callback. Neither |hash_map| nor |callback| may be NULL.
 // If |callback| returns false, the iteration loop will immediately exit.
+// The |hash_entry| passed to |callback| is only valid during the call.
 void hash_map_foreach(hash_map_t *hash_map, hash_map_iter_cb callback, void *context);
 
 #endif /* _HASH_MAP_H_ */
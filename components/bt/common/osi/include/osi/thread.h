@@ -39,6 +39,19 @@ typedef enum {
     OSI_THREAD_CORE_AFFINITY,
 } osi_thread_core_t;
 
+typedef struct {
+    uint32_t wakeups;           /*!< Wake-ups that found work to run */
+    uint32_t items;             /*!< Work items run */
+    uint16_t batch_max;         /*!< Most work items run in a single wake-up */
+    uint32_t item_allocs;       /*!< Posts that found the preallocated work items used up */
+} osi_thread_stats_t;
+
+typedef struct {
+    uint32_t items;             /*!< Work items run from the queue */
+    uint32_t latency_max_us;    /*!< Longest time a work item waited in the queue */
+    uint64_t latency_sum_us;    /*!< Time all the work items waited, for the mean */
+} osi_thread_queue_stats_t;
+
 /*
  * brief: Create a thread or task
  * param name: thread name
@@ -81,6 +94,30 @@ bool osi_thread_set_priority(osi_thread_t *thread, int priority);
  */
 const char *osi_thread_name(osi_thread_t *thread);
 
+/*
+ * brief: Serve the work queues by weighted round robin instead of strict priority
+ * param thread: point of thread handler
+ * param weights: work items run from each queue in turn, one weight per queue, each at least 1;
+ *                NULL goes back to strict priority, where the queue[0] is always served first
+ * return : if set successfully, return true, otherwise return false
+ */
+bool osi_thread_set_queue_weights(osi_thread_t *thread, const uint8_t *weights);
+
+/*
+ * brief: Get the statistics of a thread, counted since it was created or reset
+ * param thread: point of thread handler
+ * param stats: thread statistics
+ * param queue_stats: statistics of each work queue, as many as the thread has; may be NULL
+ * return : true if the statistics are counted (CONFIG_BT_THREAD_STATS), otherwise false
+ */
+bool osi_thread_get_stats(osi_thread_t *thread, osi_thread_stats_t *stats, osi_thread_queue_stats_t *queue_stats);
+
+/*
+ * brief: Reset the statistics of a thread
+ * param thread: point of thread handler
+ */
+void osi_thread_reset_stats(osi_thread_t *thread);
+
 /* brief: Get the size of the specified queue
  * param thread: point of thread handler
  * param wq_idx: the queue index of the thread
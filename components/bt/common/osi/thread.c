@@ -16,12 +16,25 @@
  *
  ******************************************************************************/
 
+#include <stdatomic.h>
 #include <string.h>
 
 #include "osi/allocator.h"
 #include "osi/fixed_queue.h"
 #include "osi/semaphore.h"
 #include "osi/thread.h"
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+#include "esp_timer.h"
+#endif
+
+typedef struct {
+  osi_thread_func_t func;
+  void *context;
+  bool pooled;                          /*!< From the preallocated items of the thread, not the heap */
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+  uint32_t post_us;
+#endif
+} work_item_t;
 
 struct osi_thread {
   void *thread_handle;                  /*!< Store the thread object */
@@ -31,6 +44,16 @@ struct osi_thread {
   fixed_queue_t **work_queues;          /*!< Point to queue array, and the priority inverse array index */
   osi_sem_t work_sem;
   osi_sem_t stop_sem;
+  atomic_bool idle;                     /*!< Set while the thread may sleep on work_sem, only then posts give it */
+  work_item_t *items;                   /*!< Preallocated work items */
+  fixed_queue_t *free_items;            /*!< Those of |items| not posted */
+  uint8_t *weights;                     /*!< Weight of each queue */
+  bool weighted;                        /*!< Weighted round robin if set, strict priority otherwise */
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+  osi_thread_stats_t stats;
+  osi_thread_queue_stats_t *queue_stats;
+  atomic_uint_least32_t item_allocs;
+#endif
 };
 
 struct osi_thread_start_arg {
@@ -39,12 +62,110 @@ struct osi_thread_start_arg {
   int error;
 };
 
-typedef struct {
-  osi_thread_func_t func;
-  void *context;
-} work_item_t;
-
 static const size_t DEFAULT_WORK_QUEUE_CAPACITY = 100;
+// Work items preallocated per thread, posts beyond take them from the heap.
+static const size_t WORK_ITEM_POOL_SIZE = 32;
+// Most work items dequeued at once, and run before looking at the queues again.
+#define WORK_ITEM_BATCH_MAX 8
+
+static void osi_thread_item_free(void *ptr)
+{
+    work_item_t *item = (work_item_t *)ptr;
+
+    if (!item->pooled) {
+        osi_free(item);
+    }
+}
+
+// Runs up to |max| work items of queue |idx|, returns how many.
+static size_t osi_thread_run_queue(osi_thread_t *thread, int idx, size_t max)
+{
+    work_item_t *items[WORK_ITEM_BATCH_MAX];
+    size_t n;
+
+    if (max > WORK_ITEM_BATCH_MAX) {
+        max = WORK_ITEM_BATCH_MAX;
+    }
+    n = fixed_queue_dequeue_batch(thread->work_queues[idx], (void **)items, max, 0);
+
+    for (size_t i = 0; i < n; i++) {
+        work_item_t *item = items[i];
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+        osi_thread_queue_stats_t *stats = &thread->queue_stats[idx];
+        uint32_t latency_us = (uint32_t)esp_timer_get_time() - item->post_us;
+
+        stats->items++;
+        stats->latency_sum_us += latency_us;
+        if (latency_us > stats->latency_max_us) {
+            stats->latency_max_us = latency_us;
+        }
+#endif
+        item->func(item->context);
+        if (item->pooled) {
+            fixed_queue_enqueue(thread->free_items, item, 0);
+        } else {
+            osi_free(item);
+        }
+    }
+    return n;
+}
+
+// Runs the work queued until all the queues are empty, returns the number of
+// work items run.
+static size_t osi_thread_run_queues(osi_thread_t *thread)
+{
+    size_t total = 0;
+    size_t n;
+    int idx = 0;
+
+    if (!thread->weighted) {
+        // strict priority, back to the queue[0] after each batch
+        while (!thread->stop && idx < thread->work_queue_num) {
+            n = osi_thread_run_queue(thread, idx, WORK_ITEM_BATCH_MAX);
+            total += n;
+            idx = n ? 0 : idx + 1;
+        }
+        return total;
+    }
+
+    // weighted round robin, a round gives each queue up to its weight
+    do {
+        n = 0;
+        for (idx = 0; !thread->stop && idx < thread->work_queue_num; idx++) {
+            size_t quota = thread->weights[idx];
+            size_t ran;
+
+            do {
+                ran = osi_thread_run_queue(thread, idx, quota);
+                quota -= ran;
+                n += ran;
+            } while (ran && quota);
+        }
+        total += n;
+    } while (n && !thread->stop);
+
+    return total;
+}
+
+// Sleeps until a work item is posted, unless one is already queued. Posts only
+// give work_sem while |idle| is set, the fences pair with the one of
+// osi_thread_post() so that either a post sees |idle| or we see its item.
+static void osi_thread_wait(osi_thread_t *thread)
+{
+    atomic_store_explicit(&thread->idle, true, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    for (int i = 0; i < thread->work_queue_num; i++) {
+        // not fixed_queue_is_empty(), it counts an item still being written
+        if (fixed_queue_try_peek_first(thread->work_queues[i]) != NULL) {
+            atomic_store_explicit(&thread->idle, false, memory_order_relaxed);
+            return;
+        }
+    }
+
+    osi_sem_take(&thread->work_sem, OSI_SEM_MAX_TIMEOUT);
+    atomic_store_explicit(&thread->idle, false, memory_order_relaxed);
+}
 
 static void osi_thread_run(void *arg)
 {
@@ -54,25 +175,26 @@ static void osi_thread_run(void *arg)
     osi_sem_give(&start->start_sem);
 
     while (1) {
-        int idx = 0;
+        size_t n;
 
-        osi_sem_take(&thread->work_sem, OSI_SEM_MAX_TIMEOUT);
+        osi_thread_wait(thread);
 
         if (thread->stop) {
             break;
         }
 
-        while (!thread->stop && idx < thread->work_queue_num) {
-            work_item_t *item = fixed_queue_dequeue(thread->work_queues[idx], 0);
-            if (item) {
-                item->func(item->context);
-                osi_free(item);
-                idx = 0;
-                continue;
-            } else {
-                idx++;
+        n = osi_thread_run_queues(thread);
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+        if (n) {
+            thread->stats.wakeups++;
+            thread->stats.items += n;
+            if (n > thread->stats.batch_max) {
+                thread->stats.batch_max = n > UINT16_MAX ? UINT16_MAX : n;
             }
         }
+#else
+        (void)n;
+#endif
     }
 
     thread->thread_handle = NULL;
@@ -106,6 +228,46 @@ static void osi_thread_stop(osi_thread_t *thread)
     }
 }
 
+static void osi_thread_release(osi_thread_t *thread)
+{
+    if (thread->work_queues) {
+        for (int i = 0; i < thread->work_queue_num; i++) {
+            if (thread->work_queues[i]) {
+                fixed_queue_free(thread->work_queues[i], osi_thread_item_free);
+            }
+        }
+        osi_free(thread->work_queues);
+    }
+
+    if (thread->free_items) {
+        fixed_queue_free(thread->free_items, NULL);
+    }
+
+    if (thread->items) {
+        osi_free(thread->items);
+    }
+
+    if (thread->weights) {
+        osi_free(thread->weights);
+    }
+
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+    if (thread->queue_stats) {
+        osi_free(thread->queue_stats);
+    }
+#endif
+
+    if (thread->work_sem) {
+        osi_sem_free(&thread->work_sem);
+    }
+
+    if (thread->stop_sem) {
+        osi_sem_free(&thread->stop_sem);
+    }
+
+    osi_free(thread);
+}
+
 //in linux, the stack_size, priority and core may not be set here, the code will be ignore the arguments
 osi_thread_t *osi_thread_create(const char *name, size_t stack_size, int priority, osi_thread_core_t core, uint8_t work_queue_num)
 {
@@ -123,20 +285,45 @@ osi_thread_t *osi_thread_create(const char *name, size_t stack_size, int priorit
         goto _err;
     }
 
+    memset(thread, 0, sizeof(osi_thread_t));
     thread->stop = false;
+    atomic_init(&thread->idle, false);
     thread->work_queue_num = work_queue_num;
-    thread->work_queues = (fixed_queue_t **)osi_malloc(sizeof(fixed_queue_t *) * work_queue_num);
+    thread->work_queues = (fixed_queue_t **)osi_calloc(sizeof(fixed_queue_t *) * work_queue_num);
     if (thread->work_queues == NULL) {
         goto _err;
     }
 
     for (int i = 0; i < thread->work_queue_num; i++) {
-        thread->work_queues[i] = fixed_queue_new(DEFAULT_WORK_QUEUE_CAPACITY);
+        thread->work_queues[i] = fixed_queue_new_lockfree(DEFAULT_WORK_QUEUE_CAPACITY);
         if (thread->work_queues[i] == NULL) {
             goto _err;
         }
     }
 
+    thread->weights = (uint8_t *)osi_malloc(work_queue_num);
+    if (thread->weights == NULL) {
+        goto _err;
+    }
+
+    thread->items = (work_item_t *)osi_malloc(sizeof(work_item_t) * WORK_ITEM_POOL_SIZE);
+    thread->free_items = fixed_queue_new_lockfree(WORK_ITEM_POOL_SIZE);
+    if (thread->items == NULL || thread->free_items == NULL) {
+        goto _err;
+    }
+    for (size_t i = 0; i < WORK_ITEM_POOL_SIZE; i++) {
+        thread->items[i].pooled = true;
+        fixed_queue_enqueue(thread->free_items, &thread->items[i], 0);
+    }
+
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+    thread->queue_stats = (osi_thread_queue_stats_t *)osi_calloc(sizeof(osi_thread_queue_stats_t) * work_queue_num);
+    if (thread->queue_stats == NULL) {
+        goto _err;
+    }
+    atomic_init(&thread->item_allocs, 0);
+#endif
+
     ret = osi_sem_new(&thread->work_sem, 1, 0);
     if (ret != 0) {
         goto _err;
@@ -153,7 +340,8 @@ osi_thread_t *osi_thread_create(const char *name, size_t stack_size, int priorit
         goto _err;
     }
 
-    if (xTaskCreatePinnedToCore(osi_thread_run, name, stack_size, &start_arg, priority, &thread->thread_handle, core) != pdPASS) {
+    if (xTaskCreatePinnedToCore(osi_thread_run, name, stack_size, &start_arg, priority, &thread->thread_handle,
+                                core == OSI_THREAD_CORE_AFFINITY ? tskNO_AFFINITY : core) != pdPASS) {
         goto _err;
     }
 
@@ -173,25 +361,7 @@ _err:
             vTaskDelete(thread->thread_handle);
         }
 
-        for (int i = 0; i < thread->work_queue_num; i++) {
-            if (thread->work_queues[i]) {
-                fixed_queue_free(thread->work_queues[i], osi_free_func);
-            }
-        }
-
-        if (thread->work_queues) {
-            osi_free(thread->work_queues);
-        }
-
-        if (thread->work_sem) {
-            osi_sem_free(&thread->work_sem);
-        }
-
-        if (thread->stop_sem) {
-            osi_sem_free(&thread->stop_sem);
-        }
-
-        osi_free(thread);
+        osi_thread_release(thread);
     }
 
     return NULL;
@@ -204,26 +374,7 @@ void osi_thread_free(osi_thread_t *thread)
 
     osi_thread_stop(thread);
 
-    for (int i = 0; i < thread->work_queue_num; i++) {
-        if (thread->work_queues[i]) {
-            fixed_queue_free(thread->work_queues[i], osi_free_func);
-        }
-    }
-
-    if (thread->work_queues) {
-        osi_free(thread->work_queues);
-    }
-
-    if (thread->work_sem) {
-        osi_sem_free(&thread->work_sem);
-    }
-
-    if (thread->stop_sem) {
-        osi_sem_free(&thread->stop_sem);
-    }
-
-
-    osi_free(thread);
+    osi_thread_release(thread);
 }
 
 bool osi_thread_post(osi_thread_t *thread, osi_thread_func_t func, void *context, int queue_idx, uint32_t timeout)
@@ -235,23 +386,94 @@ bool osi_thread_post(osi_thread_t *thread, osi_thread_func_t func, void *context
         return false;
     }
 
-    work_item_t *item = (work_item_t *)osi_malloc(sizeof(work_item_t));
+    work_item_t *item = fixed_queue_dequeue(thread->free_items, 0);
     if (item == NULL) {
-        return false;
+        item = (work_item_t *)osi_malloc(sizeof(work_item_t));
+        if (item == NULL) {
+            return false;
+        }
+        item->pooled = false;
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+        atomic_fetch_add_explicit(&thread->item_allocs, 1, memory_order_relaxed);
+#endif
     }
     item->func = func;
     item->context = context;
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+    item->post_us = (uint32_t)esp_timer_get_time();
+#endif
 
     if (fixed_queue_enqueue(thread->work_queues[queue_idx], item, timeout) == false) {
-        osi_free(item);
+        if (item->pooled) {
+            fixed_queue_enqueue(thread->free_items, item, 0);
+        } else {
+            osi_free(item);
+        }
         return false;
     }
 
-    osi_sem_give(&thread->work_sem);
+    // wake the thread only if it may be sleeping, see osi_thread_wait()
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&thread->idle, memory_order_relaxed)) {
+        osi_sem_give(&thread->work_sem);
+    }
 
     return true;
 }
 
+bool osi_thread_set_queue_weights(osi_thread_t *thread, const uint8_t *weights)
+{
+    assert(thread != NULL);
+
+    if (weights == NULL) {
+        thread->weighted = false;
+        return true;
+    }
+
+    for (int i = 0; i < thread->work_queue_num; i++) {
+        if (weights[i] == 0) {
+            return false;
+        }
+    }
+
+    // the thread reads them without a lock, a round run meanwhile may mix old and new weights
+    memcpy(thread->weights, weights, thread->work_queue_num);
+    thread->weighted = true;
+    return true;
+}
+
+bool osi_thread_get_stats(osi_thread_t *thread, osi_thread_stats_t *stats, osi_thread_queue_stats_t *queue_stats)
+{
+    assert(thread != NULL);
+
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+    if (stats == NULL) {
+        return false;
+    }
+
+    // counted by the thread itself without a lock, a copy may be off by the items of one wake-up
+    *stats = thread->stats;
+    stats->item_allocs = atomic_load_explicit(&thread->item_allocs, memory_order_relaxed);
+    if (queue_stats) {
+        memcpy(queue_stats, thread->queue_stats, sizeof(osi_thread_queue_stats_t) * thread->work_queue_num);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void osi_thread_reset_stats(osi_thread_t *thread)
+{
+    assert(thread != NULL);
+
+#if (BT_THREAD_STATS_INCLUDED == TRUE)
+    memset(&thread->stats, 0, sizeof(thread->stats));
+    memset(thread->queue_stats, 0, sizeof(osi_thread_queue_stats_t) * thread->work_queue_num);
+    atomic_store_explicit(&thread->item_allocs, 0, memory_order_relaxed);
+#endif
+}
+
 bool osi_thread_set_priority(osi_thread_t *thread, int priority)
 {
     assert(thread != NULL);
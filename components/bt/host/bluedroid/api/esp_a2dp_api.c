@@ -19,6 +19,8 @@
 #include "esp_bt_main.h"
 #include "btc/btc_manage.h"
 #include "btc_av.h"
+#include "btc_a2dp_sink.h"
+#include "btc_a2dp_source.h"
 
 #if BTC_AV_INCLUDED
 
@@ -89,6 +91,97 @@ esp_err_t esp_a2d_sink_register_data_callback(esp_a2d_sink_data_cb_t callback)
     return (stat == BT_STATUS_SUCCESS) ? ESP_OK : ESP_FAIL;
 }
 
+esp_err_t esp_a2d_sink_get_stats(esp_a2d_sink_stats_t *stats)
+{
+    if (esp_bluedroid_get_status() != ESP_BLUEDROID_STATUS_ENABLED) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return btc_a2dp_sink_get_stats(stats) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t esp_a2d_sink_set_output_latency(uint16_t latency)
+{
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+    if (esp_bluedroid_get_status() != ESP_BLUEDROID_STATUS_ENABLED) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    btc_msg_t msg;
+    msg.sig = BTC_SIG_API_CALL;
+    msg.pid = BTC_PID_A2DP;
+    msg.act = BTC_AV_SINK_API_SET_OUTPUT_LATENCY_EVT;
+
+    btc_av_args_t arg;
+    memset(&arg, 0, sizeof(btc_av_args_t));
+    arg.output_latency = latency;
+
+    /* Switch to BTC context */
+    bt_status_t stat = btc_transfer_context(&msg, &arg, sizeof(btc_av_args_t), NULL);
+    return (stat == BT_STATUS_SUCCESS) ? ESP_OK : ESP_FAIL;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+}
+
+esp_err_t esp_a2d_sink_get_delay_value(uint16_t *delay_value)
+{
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+    if (esp_bluedroid_get_status() != ESP_BLUEDROID_STATUS_ENABLED) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (delay_value == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return btc_a2dp_sink_get_delay(delay_value) ? ESP_OK : ESP_ERR_INVALID_STATE;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+}
+
+esp_err_t esp_a2d_sink_set_pcm_format(esp_a2d_pcm_fmt_t fmt)
+{
+    if (esp_bluedroid_get_status() != ESP_BLUEDROID_STATUS_ENABLED) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (fmt > ESP_A2D_PCM_FMT_S32) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    btc_msg_t msg;
+    msg.sig = BTC_SIG_API_CALL;
+    msg.pid = BTC_PID_A2DP;
+    msg.act = BTC_AV_SINK_API_SET_PCM_FMT_EVT;
+
+    btc_av_args_t arg;
+    memset(&arg, 0, sizeof(btc_av_args_t));
+    arg.pcm_fmt = fmt;
+
+    /* Switch to BTC context */
+    bt_status_t stat = btc_transfer_context(&msg, &arg, sizeof(btc_av_args_t), NULL);
+    return (stat == BT_STATUS_SUCCESS) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_a2d_sink_read_pcm(uint8_t *buf, uint32_t len, esp_a2d_sink_pcm_info_t *info)
+{
+#if (BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE)
+    if (buf == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return btc_a2dp_sink_read_pcm(buf, len, info) ? ESP_OK : ESP_ERR_INVALID_STATE;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif /* BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE */
+}
+
 esp_err_t esp_a2d_sink_connect(esp_bd_addr_t remote_bda)
 {
     if (esp_bluedroid_get_status() != ESP_BLUEDROID_STATUS_ENABLED) {
@@ -304,6 +397,19 @@ esp_err_t esp_a2d_source_register_data_callback(esp_a2d_source_data_cb_t callbac
     return (stat == BT_STATUS_SUCCESS) ? ESP_OK : ESP_FAIL;
 }
 
+esp_err_t esp_a2d_source_get_stats(esp_a2d_source_stats_t *stats)
+{
+    if (esp_bluedroid_get_status() != ESP_BLUEDROID_STATUS_ENABLED) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return btc_a2dp_source_get_stats(stats) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
 #endif /* BTC_AV_SRC_INCLUDED */
 
 #endif /* #if BTC_AV_INCLUDED */
@@ -133,6 +133,11 @@ esp_err_t esp_bluedroid_init(void)
     osi_mem_dbg_init();
 #endif
 
+    if (!osi_buf_pool_init()) {
+        LOG_ERROR("Bluedroid packet buffer pool Initialize Fail");
+        return ESP_ERR_NO_MEM;
+    }
+
     /*
     * BTC Init
     */
@@ -207,6 +212,8 @@ esp_err_t esp_bluedroid_deinit(void)
 
     btc_deinit();
 
+    osi_buf_pool_deinit();
+
     bd_already_init = false;
 
     return ESP_OK;
@@ -55,6 +55,13 @@ typedef struct {
     } cie;                                     /*!< A2DP codec information element */
 } __attribute__((packed)) esp_a2d_mcc_t;
 
+/// A2DP sink decoded PCM sample formats, interleaved little endian samples
+typedef enum {
+    ESP_A2D_PCM_FMT_S16 = 0,                   /*!< 16 bit signed samples */
+    ESP_A2D_PCM_FMT_S24_32,                    /*!< 24 bit signed samples, MSB aligned in 32 bit slots */
+    ESP_A2D_PCM_FMT_S32,                       /*!< 32 bit signed samples */
+} esp_a2d_pcm_fmt_t;
+
 /// Bluetooth A2DP connection states
 typedef enum {
     ESP_A2D_CONNECTION_STATE_DISCONNECTED = 0, /*!< connection released  */
@@ -132,6 +139,8 @@ typedef union {
     struct a2d_audio_cfg_param {
         esp_bd_addr_t remote_bda;              /*!< remote bluetooth device address */
         esp_a2d_mcc_t mcc;                     /*!< A2DP media codec capability information */
+        esp_a2d_pcm_fmt_t pcm_fmt;             /*!< sample format of the decoded PCM */
+        uint32_t pcm_rate;                     /*!< sample rate of the decoded PCM in Hz, 0 if it is the one of mcc */
     } audio_cfg;                               /*!< media codec configuration information */
 
     /**
@@ -149,6 +158,42 @@ typedef union {
     } a2d_prof_stat;                           /*!< status to indicate a2d prof init or deinit */
 } esp_a2d_cb_param_t;
 
+/**
+ * @brief           A2DP sink jitter buffer and packet loss statistics
+ */
+typedef struct {
+    uint32_t depth_ms;                         /*!< media held in the jitter buffer, in ms of PCM */
+    uint32_t target_ms;                        /*!< adaptive depth the jitter buffer primes to, in ms of PCM */
+    uint32_t underruns;                        /*!< times the decoded audio ran out before new media arrived */
+    uint32_t overruns;                         /*!< media packets dropped because the jitter buffer was full */
+    uint32_t rx_pkts;                          /*!< media packets received */
+    uint32_t lost_pkts;                        /*!< media packets missing from the stream, overruns included */
+    uint32_t concealed_pkts;                   /*!< lost media packets concealed by the decoder */
+    uint32_t concealed_frames;                 /*!< PCM frames synthesized by packet loss concealment */
+} esp_a2d_sink_stats_t;
+
+/**
+ * @brief           A2DP source SBC bitpool adaptation and TX queue statistics
+ */
+typedef struct {
+    uint32_t bitpool;                          /*!< SBC bitpool in use, 0 if the stream is not SBC */
+    uint32_t max_bitpool;                      /*!< SBC bitpool selected for the stream, the adaptation stays at or below it */
+    uint32_t congested_ticks;                  /*!< media ticks the link was found congested on */
+    uint32_t bitpool_decreases;                /*!< times the SBC bitpool was lowered because of congestion */
+    uint32_t bitpool_increases;                /*!< times the SBC bitpool was raised again after the congestion cleared */
+    uint32_t dropped_pkts;                     /*!< media packets dropped because the TX queue was full */
+    uint32_t flushed_pkts;                     /*!< media packets discarded by flushing the TX queue */
+} esp_a2d_source_stats_t;
+
+/**
+ * @brief           Description of the audio returned by esp_a2d_sink_read_pcm()
+ */
+typedef struct {
+    uint32_t len;                              /*!< bytes of decoded audio read, the rest of the buffer is silence */
+    uint64_t pts_us;                           /*!< stream position of the first byte read, in us of audio since the stream was configured */
+    bool underrun;                             /*!< not enough audio was buffered to fill the whole buffer */
+} esp_a2d_sink_pcm_info_t;
+
 /**
  * @brief           A2DP profile callback function type
  *
@@ -213,6 +258,24 @@ esp_err_t esp_a2d_register_callback(esp_a2d_cb_t callback);
  */
 esp_err_t esp_a2d_sink_register_data_callback(esp_a2d_sink_data_cb_t callback);
 
+/**
+ * @brief           Request the sample format of the decoded PCM passed to the A2DP sink data callback and
+ *                  read by esp_a2d_sink_read_pcm(). The 32 bit formats are produced by aptX and LDAC without
+ *                  a conversion pass, so that the high resolution codecs can feed 32 bit I2S slots directly;
+ *                  SBC stays ESP_A2D_PCM_FMT_S16. Takes effect from the next codec configuration,
+ *                  ESP_A2D_AUDIO_CFG_EVT reports the format in use. The default is ESP_A2D_PCM_FMT_S16.
+ *
+ * @param[in]       fmt: requested sample format
+ *
+ * @return
+ *                  - ESP_OK: success
+ *                  - ESP_INVALID_STATE: if bluetooth stack is not yet enabled
+ *                  - ESP_ERR_INVALID_ARG: if fmt is not a valid format
+ *                  - ESP_FAIL: others
+ *
+ */
+esp_err_t esp_a2d_sink_set_pcm_format(esp_a2d_pcm_fmt_t fmt);
+
 
 /**
  *
@@ -246,6 +309,88 @@ esp_err_t esp_a2d_sink_init(void);
 esp_err_t esp_a2d_sink_deinit(void);
 
 
+/**
+ *
+ * @brief           Get the jitter buffer and packet loss statistics of the A2DP sink. The counters
+ *                  start from zero every time the sink module is initialized. This API must be called
+ *                  after esp_a2d_sink_init() and before esp_a2d_sink_deinit().
+ *
+ * @param[out]      stats: statistics of the A2DP sink
+ *
+ * @return
+ *                  - ESP_OK: success
+ *                  - ESP_INVALID_STATE: if bluetooth stack is not yet enabled or the sink is not running
+ *                  - ESP_ERR_INVALID_ARG: if stats is NULL
+ *
+ */
+esp_err_t esp_a2d_sink_get_stats(esp_a2d_sink_stats_t *stats);
+
+
+/**
+ *
+ * @brief           Set the latency of the audio output of the application, from the moment the decoded
+ *                  audio is passed to the data callback or read with esp_a2d_sink_read_pcm() until it is
+ *                  heard, e.g. I2S DMA buffers and the DAC. It is added to the delay the A2DP sink reports
+ *                  to the source. Available if CONFIG_BT_A2DP_SINK_DELAY_REPORT is enabled.
+ *
+ * @param[in]       latency: output latency in 1/10 ms
+ *
+ * @return
+ *                  - ESP_OK: success
+ *                  - ESP_INVALID_STATE: if bluetooth stack is not yet enabled
+ *                  - ESP_ERR_NOT_SUPPORTED: if delay reporting is disabled
+ *                  - ESP_FAIL: others
+ *
+ */
+esp_err_t esp_a2d_sink_set_output_latency(uint16_t latency);
+
+
+/**
+ *
+ * @brief           Get the playout delay of the A2DP sink: the media queued for decoding, the decoded audio
+ *                  not played yet and the output latency set with esp_a2d_sink_set_output_latency(). The
+ *                  source gets a delay report when the stream starts and whenever the delay moves by more
+ *                  than CONFIG_BT_A2DP_SINK_DELAY_REPORT_THRESHOLD_MS. Before the stream starts, this is the
+ *                  delay expected once the jitter buffer is primed. This API must be called after
+ *                  esp_a2d_sink_init() and before esp_a2d_sink_deinit().
+ *
+ * @param[out]      delay_value: playout delay in 1/10 ms
+ *
+ * @return
+ *                  - ESP_OK: success
+ *                  - ESP_INVALID_STATE: if bluetooth stack is not yet enabled or the sink is not running
+ *                  - ESP_ERR_INVALID_ARG: if delay_value is NULL
+ *                  - ESP_ERR_NOT_SUPPORTED: if delay reporting is disabled
+ *
+ */
+esp_err_t esp_a2d_sink_get_delay_value(uint16_t *delay_value);
+
+
+/**
+ *
+ * @brief           Read decoded audio of the A2DP sink from the PCM ring, the pull mode alternative to
+ *                  esp_a2d_sink_register_data_callback(). Whole PCM frames are read in the format reported
+ *                  by ESP_A2D_AUDIO_CFG_EVT, the part of buf that could not be filled is set to silence.
+ *                  This function never blocks and may be called from an ISR, e.g. to refill I2S DMA
+ *                  buffers, but only from one context at a time. Available if CONFIG_BT_A2DP_SINK_PCM_RING
+ *                  is enabled.
+ *
+ * @param[out]      buf: buffer to be filled with PCM data
+ *
+ * @param[in]       len: size(in bytes) of buf, should be a multiple of the PCM frame size
+ *
+ * @param[out]      info: amount and stream position of the audio read, may be NULL
+ *
+ * @return
+ *                  - ESP_OK: success, check info for underruns
+ *                  - ESP_ERR_INVALID_STATE: no stream is configured, buf is filled with silence
+ *                  - ESP_ERR_INVALID_ARG: if buf is NULL
+ *                  - ESP_ERR_NOT_SUPPORTED: if the PCM ring is disabled
+ *
+ */
+esp_err_t esp_a2d_sink_read_pcm(uint8_t *buf, uint32_t len, esp_a2d_sink_pcm_info_t *info);
+
+
 /**
  *
  * @brief           Connect to remote bluetooth A2DP source device. This API must be called after
@@ -373,6 +518,24 @@ esp_err_t esp_a2d_source_connect(esp_bd_addr_t remote_bda);
  */
 esp_err_t esp_a2d_source_disconnect(esp_bd_addr_t remote_bda);
 
+
+/**
+ *
+ * @brief           Get the SBC bitpool adaptation and TX queue statistics of the A2DP source. The
+ *                  counters start from zero every time the source module is initialized. The bitpool
+ *                  only adapts if CONFIG_BT_A2DP_SOURCE_RATE_CTRL is enabled. This API must be called
+ *                  after esp_a2d_source_init() and before esp_a2d_source_deinit().
+ *
+ * @param[out]      stats: statistics of the A2DP source
+ *
+ * @return
+ *                  - ESP_OK: success
+ *                  - ESP_INVALID_STATE: if bluetooth stack is not yet enabled or the source is not running
+ *                  - ESP_ERR_INVALID_ARG: if stats is NULL
+ *
+ */
+esp_err_t esp_a2d_source_get_stats(esp_a2d_source_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -578,8 +578,8 @@ void bta_av_stream_data_cback(UINT8 handle, BT_HDR *p_pkt, UINT32 time_stamp, UI
         return;
     }
     p_pkt->event = BTA_AV_MEDIA_DATA_EVT;
+    /* ownership of the packet is handed over to the application */
     p_scb->seps[p_scb->sep_idx].p_app_data_cback(BTA_AV_MEDIA_DATA_EVT, (tBTA_AV_MEDIA *)p_pkt);
-    osi_free(p_pkt);  /* a copy of packet had been delivered, we free this buffer */
 }
 
 /*******************************************************************************
@@ -874,6 +874,33 @@ void bta_av_delay_co (tBTA_AV_SCB *p_scb, tBTA_AV_DATA *p_data)
     p_scb->p_cos->delay(p_scb->hndl, p_data->str_msg.msg.delay_rpt_cmd.delay);
 }
 
+/*******************************************************************************
+**
+** Function         bta_av_api_delay_rpt
+**
+** Description      Send a delay report to the source, if delay reporting was
+**                  configured for the stream.
+**
+** Returns          void
+**
+*******************************************************************************/
+void bta_av_api_delay_rpt(tBTA_AV_DATA *p_data)
+{
+    tBTA_AV_SCB *p_scb = bta_av_hndl_to_scb(p_data->hdr.layer_specific);
+
+    if (p_scb == NULL || p_scb->state != BTA_AV_OPEN_SST) {
+        return;
+    }
+    if (!(p_scb->cur_psc_mask & AVDT_PSC_DELAY_RPT)) {
+        APPL_TRACE_DEBUG("%s delay reporting not configured", __func__);
+        return;
+    }
+
+    APPL_TRACE_DEBUG("%s delay %d", __func__, p_data->api_delay_rpt.delay);
+    AVDT_DelayReport(p_scb->avdt_handle, p_scb->sep_info[p_scb->sep_info_idx].seid,
+                     p_data->api_delay_rpt.delay);
+}
+
 /*******************************************************************************
 **
 ** Function         bta_av_do_disc_a2d
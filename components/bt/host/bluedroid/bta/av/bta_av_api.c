@@ -314,6 +314,52 @@ void BTA_AvReconfig(tBTA_AV_HNDL hndl, BOOLEAN suspend, UINT8 sep_info_idx,
     }
 }
 
+/*******************************************************************************
+**
+** Function         BTA_AvDelayReport
+**
+** Description      Send a delay report of the sink to the source.  This
+**                  function can only be used if AV is enabled with feature
+**                  BTA_AV_FEAT_DELAY_RPT. |delay| is in 1/10 ms.
+**
+** Returns          void
+**
+*******************************************************************************/
+void BTA_AvDelayReport(tBTA_AV_HNDL hndl, UINT16 delay)
+{
+    tBTA_AV_API_DELAY_RPT  *p_buf;
+
+    if ((p_buf = (tBTA_AV_API_DELAY_RPT *) osi_malloc(sizeof(tBTA_AV_API_DELAY_RPT))) != NULL) {
+        p_buf->hdr.layer_specific = hndl;
+        p_buf->hdr.event = BTA_AV_API_DELAY_RPT_EVT;
+        p_buf->delay = delay;
+        bta_sys_sendmsg(p_buf);
+    }
+}
+
+/*******************************************************************************
+**
+** Function         BTA_AvGetTxQueueLen
+**
+** Description      Get the number of media packets of an audio stream that
+**                  wait for transmission, in BTA and in L2CAP. The L2CAP part
+**                  is the count read on the last media data path, so this
+**                  function does not walk the queues and may be called from
+**                  the media task.
+**
+** Returns          Number of queued packets, 0 if the handle is not in use
+**
+*******************************************************************************/
+UINT16 BTA_AvGetTxQueueLen(tBTA_AV_HNDL hndl)
+{
+    tBTA_AV_SCB *p_scb = bta_av_hndl_to_scb(hndl);
+
+    if (p_scb == NULL || p_scb->a2d_list == NULL) {
+        return 0;
+    }
+    return p_scb->l2c_bufs + list_length(p_scb->a2d_list);
+}
+
 /*******************************************************************************
 **
 ** Function         BTA_AvProtectReq
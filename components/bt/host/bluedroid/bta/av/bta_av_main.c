@@ -178,6 +178,7 @@ const tBTA_AV_NSM_ACT bta_av_nsm_act[] = {
     bta_av_rc_closed,       /* BTA_AV_AVRC_CLOSE_EVT */
     bta_av_conn_chg,        /* BTA_AV_CONN_CHG_EVT */
     bta_av_dereg_comp,      /* BTA_AV_DEREG_COMP_EVT */
+    bta_av_api_delay_rpt,   /* BTA_AV_API_DELAY_RPT_EVT */
 #if (BTA_AV_SINK_INCLUDED == TRUE)
     bta_av_api_sink_enable, /* BTA_AV_API_SINK_ENABLE_EVT */
 #endif
@@ -259,6 +260,10 @@ static void bta_av_api_enable(tBTA_AV_DATA *p_data)
     /* store parameters */
     bta_av_cb.p_cback  = p_data->api_enable.p_cback;
     bta_av_cb.features = p_data->api_enable.features;
+
+    /* peers only see the delay reporting capability with GET ALL CAPABILITIES,
+       which they use from AVDTP 1.3 on */
+    A2D_SetAvdtSdpVer((bta_av_cb.features & BTA_AV_FEAT_DELAY_RPT) ? AVDT_VERSION_SYNC : AVDT_VERSION);
     bta_av_cb.sec_mask = p_data->api_enable.sec_mask;
 
     enable.features = bta_av_cb.features;
@@ -1322,6 +1327,7 @@ char *bta_av_evt_code(UINT16 evt_code)
     case BTA_AV_AVRC_CLOSE_EVT: return "AVRC_CLOSE";
     case BTA_AV_CONN_CHG_EVT: return "CONN_CHG";
     case BTA_AV_DEREG_COMP_EVT: return "DEREG_COMP";
+    case BTA_AV_API_DELAY_RPT_EVT: return "API_DELAY_RPT";
 #if (BTA_AV_SINK_INCLUDED == TRUE)
     case BTA_AV_API_SINK_ENABLE_EVT: return "SINK_ENABLE";
 #endif
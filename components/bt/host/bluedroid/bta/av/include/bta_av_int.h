@@ -97,6 +97,7 @@ enum {
     BTA_AV_AVRC_CLOSE_EVT,
     BTA_AV_CONN_CHG_EVT,
     BTA_AV_DEREG_COMP_EVT,
+    BTA_AV_API_DELAY_RPT_EVT,
 #if (BTA_AV_SINK_INCLUDED == TRUE)
     BTA_AV_API_SINK_ENABLE_EVT,
 #endif
@@ -207,6 +208,12 @@ typedef struct {
     BD_ADDR             bd_addr;
 } tBTA_AV_API_DISCNT;
 
+/* data type for BTA_AV_API_DELAY_RPT_EVT */
+typedef struct {
+    BT_HDR              hdr;
+    UINT16              delay;  /* in 1/10 ms */
+} tBTA_AV_API_DELAY_RPT;
+
 /* data type for BTA_AV_API_PROTECT_REQ_EVT */
 typedef struct {
     BT_HDR              hdr;
@@ -353,6 +360,7 @@ typedef union {
     tBTA_AV_API_OPEN        api_open;
     tBTA_AV_API_STOP        api_stop;
     tBTA_AV_API_DISCNT      api_discnt;
+    tBTA_AV_API_DELAY_RPT   api_delay_rpt;
     tBTA_AV_API_PROTECT_REQ api_protect_req;
     tBTA_AV_API_PROTECT_RSP api_protect_rsp;
     tBTA_AV_API_REMOTE_CMD  api_remote_cmd;
@@ -614,6 +622,7 @@ extern void bta_av_rc_closed(tBTA_AV_DATA *p_data);
 extern void bta_av_rc_disc(UINT8 disc);
 extern void bta_av_conn_chg(tBTA_AV_DATA *p_data);
 extern void bta_av_dereg_comp(tBTA_AV_DATA *p_data);
+extern void bta_av_api_delay_rpt(tBTA_AV_DATA *p_data);
 
 /* sm action functions */
 extern void bta_av_disable (tBTA_AV_CB *p_cb, tBTA_AV_DATA *p_data);
@@ -507,6 +507,9 @@ typedef union {
 
 /* AV callback */
 typedef void (tBTA_AV_CBACK)(tBTA_AV_EVT event, tBTA_AV *p_data);
+/* AV data callback. On BTA_AV_MEDIA_DATA_EVT p_data is the received BT_HDR
+** and the callback takes ownership of it, it must be freed with osi_free().
+*/
 typedef void (tBTA_AV_DATA_CBACK)(tBTA_AV_EVT event, tBTA_AV_MEDIA *p_data);
 
 /* type for stream state machine action functions */
@@ -693,6 +696,31 @@ void BTA_AvStop(BOOLEAN suspend);
 void BTA_AvReconfig(tBTA_AV_HNDL hndl, BOOLEAN suspend, UINT8 sep_info_idx,
                     UINT8 *p_codec_info, UINT8 num_protect, UINT8 *p_protect_info);
 
+/*******************************************************************************
+**
+** Function         BTA_AvDelayReport
+**
+** Description      Send a delay report of the sink to the source.  This
+**                  function can only be used if AV is enabled with feature
+**                  BTA_AV_FEAT_DELAY_RPT. |delay| is in 1/10 ms.
+**
+** Returns          void
+**
+*******************************************************************************/
+void BTA_AvDelayReport(tBTA_AV_HNDL hndl, UINT16 delay);
+
+/*******************************************************************************
+**
+** Function         BTA_AvGetTxQueueLen
+**
+** Description      Get the number of media packets of an audio stream that
+**                  wait for transmission, in BTA and in L2CAP.
+**
+** Returns          Number of queued packets, 0 if the handle is not in use
+**
+*******************************************************************************/
+UINT16 BTA_AvGetTxQueueLen(tBTA_AV_HNDL hndl);
+
 /*******************************************************************************
 **
 ** Function         BTA_AvProtectReq
@@ -732,13 +732,13 @@ void bta_av_co_audio_start(tBTA_AV_HNDL hndl,
                            UINT8 *p_codec_info, BOOLEAN *p_no_rtp_hdr)
 {
     UNUSED(hndl);
-    UNUSED(p_codec_info);
-    UNUSED(p_no_rtp_hdr);
 
     FUNC_TRACE();
 
     APPL_TRACE_DEBUG("bta_av_co_audio_start");
 
+    /* aptX media packets go without RTP header */
+    *p_no_rtp_hdr = !A2DP_UsesRtpHeader(p_codec_info);
 }
 
 /*******************************************************************************
@@ -797,6 +797,12 @@ void *bta_av_co_audio_src_data_path(const uint8_t* p_codec_info, UINT32 *p_len,
             bta_av_sbc_bld_hdr(p_buf, p_buf->layer_specific);
             break;
 
+        case BTA_AV_CODEC_VEND:
+            /* The vendor encoders build the whole media payload,
+             * p_buf->word[0] : timestamp
+             */
+            *p_timestamp = *((UINT32 *) (p_buf + 1));
+            break;
 
         default:
             APPL_TRACE_ERROR("bta_av_co_audio_src_data_path Unsupported codec type (%d)", codec_type);
@@ -873,7 +879,7 @@ static BOOLEAN bta_av_co_audio_codec_build_config(const UINT8 *p_codec_caps, UIN
     FUNC_TRACE();
 
     memset(p_codec_cfg, 0, AVDT_CODEC_SIZE);
-    return A2DP_BuildCodecConfig((UINT8 *)p_codec_caps, p_codec_cfg);
+    return A2DP_BuildSrcCodecConfig((UINT8 *)p_codec_caps, p_codec_cfg);
 }
 
 /*******************************************************************************
@@ -977,7 +983,9 @@ static BOOLEAN bta_av_co_audio_sink_supports_cp(const tBTA_AV_CO_SINK *p_sink)
  **
  ** Function         bta_av_co_audio_find_peer_sink
  **
- ** Description      Find a peer Sink SEP entry with a supported codec.
+ ** Description      Find a peer Sink SEP entry with a supported codec. The
+ **                  highest source codec index the local source can encode
+ **                  for the sink wins, that is aptX-HD, then aptX, then SBC.
  **
  ** Returns          the peer Sink SEP for the codec index if found, otherwise NULL
  **
@@ -985,16 +993,25 @@ static BOOLEAN bta_av_co_audio_sink_supports_cp(const tBTA_AV_CO_SINK *p_sink)
 static tBTA_AV_CO_SINK* bta_av_co_audio_find_peer_sink(tBTA_AV_CO_PEER *p_peer)
 {
     btav_a2dp_codec_index_t codec_index;
+    btav_a2dp_codec_index_t best_index = BTAV_A2DP_CODEC_INDEX_MAX;
+    tBTA_AV_CO_SINK *p_best = NULL;
+    UINT8 codec_cfg[AVDT_CODEC_SIZE];
 
     FUNC_TRACE();
 
     for (int index = p_peer->num_sup_snks - 1; index >= 0; index--) {
         tBTA_AV_CO_SINK* snk = &p_peer->snks[index];
-        codec_index = A2DP_SinkCodecIndex(snk->codec_caps);
-        if (codec_index != BTAV_A2DP_CODEC_INDEX_MAX)
-            return snk;
+        codec_index = A2DP_SourceCodecIndex(snk->codec_caps);
+        if (codec_index == BTAV_A2DP_CODEC_INDEX_MAX ||
+                (p_best != NULL && codec_index <= best_index)) {
+            continue;
+        }
+        if (bta_av_co_audio_codec_build_config(snk->codec_caps, codec_cfg)) {
+            p_best = snk;
+            best_index = codec_index;
+        }
     }
-    return NULL;
+    return p_best;
 }
 
 /*******************************************************************************
@@ -1203,7 +1220,24 @@ BOOLEAN bta_av_co_audio_set_codec(const tBTC_AV_MEDIA_FEEDINGS *p_feeding, tBTC_
 
     /* Check all devices support it */
     *p_status = BTC_AV_SUCCESS;
-    return bta_av_co_audio_codec_supported(p_status);
+    if (!bta_av_co_audio_codec_supported(p_status)) {
+        return FALSE;
+    }
+
+    /* Stream with the vendor codec negotiated with the peer if it has an encoder */
+    if (p_feeding->format == BTC_AV_CODEC_PCM) {
+        for (UINT8 index = 0; index < BTA_AV_CO_NUM_ELEMENTS(bta_av_co_cb.peers); index++) {
+            tBTA_AV_CO_PEER *p_peer = &bta_av_co_cb.peers[index];
+            if (p_peer->opened && p_peer->p_snk != NULL &&
+                    A2DP_GetCodecType(p_peer->codec_cfg) == A2D_MEDIA_CT_NON_A2DP &&
+                    A2DP_GetEncoderInterface(p_peer->codec_cfg) != NULL) {
+                APPL_TRACE_EVENT("bta_av_co_audio_set_codec %s", A2DP_CodecName(p_peer->codec_cfg));
+                memcpy(bta_av_co_cb.codec_cfg.info, p_peer->codec_cfg, AVDT_CODEC_SIZE);
+                break;
+            }
+        }
+    }
+    return TRUE;
 }
 
 /*******************************************************************************
@@ -1269,6 +1303,35 @@ BOOLEAN bta_av_co_audio_get_sbc_config(tA2D_SBC_CIE *p_sbc_config, UINT16 *p_min
     return result;
 }
 
+/*******************************************************************************
+ **
+ ** Function         bta_av_co_audio_get_codec_config
+ **
+ ** Description      Retrieves the codec configuration in use and the smallest
+ **                  MTU of the opened connections.
+ **
+ ** Returns          void
+ **
+ *******************************************************************************/
+void bta_av_co_audio_get_codec_config(UINT8 *p_codec_info, UINT16 *p_minmtu)
+{
+    UINT8 index;
+    tBTA_AV_CO_PEER *p_peer;
+
+    /* Minimum MTU is by default very large */
+    *p_minmtu = 0xFFFF;
+
+    osi_mutex_global_lock();
+    memcpy(p_codec_info, bta_av_co_cb.codec_cfg.info, AVDT_CODEC_SIZE);
+    for (index = 0; index < BTA_AV_CO_NUM_ELEMENTS(bta_av_co_cb.peers); index++) {
+        p_peer = &bta_av_co_cb.peers[index];
+        if (p_peer->opened && p_peer->mtu < *p_minmtu) {
+            *p_minmtu = p_peer->mtu;
+        }
+    }
+    osi_mutex_global_unlock();
+}
+
 /*******************************************************************************
  **
  ** Function         bta_av_co_audio_discard_config
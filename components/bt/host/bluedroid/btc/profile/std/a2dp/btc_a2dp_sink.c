@@ -21,13 +21,19 @@
 #include "common/bt_trace.h"
 #include <string.h>
 #include <stdint.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
 #include "common/bt_defs.h"
 #include "osi/allocator.h"
 #include "osi/mutex.h"
 #include "osi/semaphore.h"
 #include "osi/thread.h"
-#include "osi/fixed_queue.h"
+#include "osi/alarm.h"
 #include "stack/a2d_api.h"
+#include "stack/a2dp_sink_asrc.h"
+#include "stack/a2dp_sink_resample.h"
 #include "bta/bta_av_api.h"
 #include "bta/bta_av_ci.h"
 #include "btc_av_co.h"
@@ -44,7 +50,12 @@
 
 #if (BTC_AV_SINK_INCLUDED == TRUE)
 
+#if (BTC_A2DP_SINK_TASK_INCLUDED == TRUE)
+#define BTC_A2DP_SINK_TASK_NAME             "BtA2dSinkT"
+#define BTC_A2DP_SINK_TASK_STACK            (BTC_A2DP_SINK_TASK_STACK_SIZE + BT_TASK_EXTRA_STACK_SIZE)
+#else
 extern osi_thread_t *btc_thread;
+#endif /* BTC_A2DP_SINK_TASK_INCLUDED == TRUE */
 
 /*****************************************************************************
  **  Constants
@@ -78,48 +89,214 @@ enum {
  * towards the sinks codec.
  */
 
-/* fixme -- define this in pcm time instead of buffer count */
-
-/* The typical runlevel of the tx queue size is ~1 buffer
-   but due to link flow control or thread preemption in lower
-   layers we might need to temporarily buffer up data */
+/* The jitter buffer is sized in ms of PCM. Packet counts are only used until
+   the first packet has been decoded and its duration is known */
 
 /* 18 frames is equivalent to 6.89*18*2.9 ~= 360 ms @ 44.1 khz, 20 ms mediatick */
 #define MAX_OUTPUT_A2DP_SNK_FRAME_QUEUE_SZ     (25)
 #define JITTER_BUFFER_WATER_LEVEL (5)
 
+/* Hard limit on queued packets, bounds the heap used by short packet codecs.
+   This is also the slot count of the receive ring and must be a power of 2.
+   The large class of the packet buffer pool is sized for it, see
+   BT_BUF_POOL_LARGE_NUM in Kconfig.in */
+#define MAX_A2DP_SNK_QUEUE_PKTS             (64)
+
+/* Adaptive target depth: grows by a step on every underrun and shrinks by a
+   step after a stable period without underrun */
+#define A2DP_SNK_JITTER_STEP_MS             (20)
+#define A2DP_SNK_JITTER_STABLE_MS           (10000)
+
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+/* AVDTP carries the delay in 1/10 ms */
+#define A2DP_SNK_DELAY_RPT_UNIT_US          (100)
+#define A2DP_SNK_DELAY_RPT_THRESHOLD        (BTC_A2DP_SINK_DELAY_RPT_THRESHOLD_MS * 1000 / A2DP_SNK_DELAY_RPT_UNIT_US)
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+/* Clock drift tracking, see btc_a2dp_sink_drift_window() */
+#define A2DP_SNK_DRIFT_WINDOW_US            (2000000)
+#define A2DP_SNK_DRIFT_ACQ_WINDOWS          (10)
+#define A2DP_SNK_DRIFT_KP                   (32)    /* ppb per us of phase error */
+#define A2DP_SNK_DRIFT_KI                   (1)     /* ppb per us of phase error and window */
+#define A2DP_SNK_DRIFT_MAX_ERR_US           (50000)
+/* a larger drift means the timestamps do not count PCM frames */
+#define A2DP_SNK_DRIFT_SANE_PPB             (2000000)
+
+/* btc_a2dp_sink_drift.resync requests */
+#define A2DP_SNK_DRIFT_RESYNC               (1 << 0)    /* restart from the next packet */
+#define A2DP_SNK_DRIFT_RESET                (1 << 1)    /* new stream, forget the drift */
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+
+/* Longest run of lost packets that is concealed, the decoders have faded
+   out to silence long before this */
+#define MAX_A2DP_SNK_CONCEAL_PKTS   (8)
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+/* Decoder output buffer, grown to the largest chunk the decoder emits at once */
+#define A2DP_SNK_DECODE_BUF_SIZE    (4096)
+
+/* Decoded chunks up to A2DP_SNK_BATCH_MAX_CHUNK bytes are gathered in a batch
+   of A2DP_SNK_BATCH_BUF_SIZE bytes, so that small packets of low latency
+   codecs reach the application in one callback per decoding pass */
+#define A2DP_SNK_BATCH_BUF_SIZE     (4096)
+#define A2DP_SNK_BATCH_MAX_CHUNK    (1024)
+
 typedef struct {
     uint32_t sig;
     void *param;
 } a2dp_sink_task_evt_t;
 
+/* Packet loss concealment counters */
+typedef struct {
+    UINT32 rx_pkts;             /* media packets queued for decoding */
+    UINT32 dropped_pkts;        /* media packets dropped on a full queue */
+    UINT32 lost_pkts;           /* media packets missing from the stream, drops included */
+    UINT32 concealed_pkts;      /* lost packets the decoder concealed */
+    UINT32 concealed_frames;    /* PCM frames synthesized by the decoder */
+} tBTC_A2DP_SINK_PLC_STATS;
+
+/* Receive ring of media packets. The packets are the buffers handed up by
+   AVDT, owned by the ring until decoded. Filled from the BTU task only and
+   drained from the sink task only, so free running indices are enough */
+typedef struct {
+    BT_HDR *slots[MAX_A2DP_SNK_QUEUE_PKTS];
+    atomic_uint_least16_t head; /* next slot to fill */
+    atomic_uint_least16_t tail; /* next slot to drain */
+} tBTC_A2DP_SINK_RX_RING;
+
 typedef struct {
     BOOLEAN rx_flush; /* discards any incoming data when true */
     osi_sem_t post_sem;
-    fixed_queue_t *RxSbcQ;
+    tBTC_A2DP_SINK_RX_RING rx_ring;
+    UINT16 rx_drop_pending; /* packets dropped since the last queued one */
+    BOOLEAN rx_resync; /* ignore the sequence gap of the next packet */
+    tBTC_A2DP_SINK_PLC_STATS plc_stats;
 } tBTC_A2DP_SINK_CB;
 
+typedef struct {
+    UINT32 pcm_byte_rate;   /* decoded PCM bytes per second, 0 if unknown */
+    UINT32 pkt_us;          /* average media duration of a packet */
+    UINT32 pcm_bytes;       /* PCM delivered to the app by the current decode */
+    UINT32 play_end_ms;     /* when the audio delivered so far runs out */
+    UINT32 stable_since_ms; /* last underrun or target change */
+    UINT16 target_ms;       /* depth to prime before decoding */
+    BOOLEAN streaming;      /* primed, packets are decoded as they arrive */
+    UINT32 underruns;
+} tBTC_A2DP_SINK_JB;
+
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+/* Playout delay of the sink, reported to the source */
+typedef struct {
+    UINT32 avg_us;          /* smoothed delay inside the stack */
+    UINT16 value;           /* current delay, output latency included, 1/10 ms */
+    UINT16 reported;        /* last delay sent to the source, 1/10 ms */
+    BOOLEAN started;        /* the delay was reported since the stream started */
+} tBTC_A2DP_SINK_DELAY;
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+
 typedef struct {
     tBTC_A2DP_SINK_CB   btc_aa_snk_cb;
     osi_thread_t        *btc_aa_snk_task_hdl;
     const tA2DP_DECODER_INTERFACE* decoder;
-    unsigned char decode_buf[4096];
+    tBTC_A2DP_SINK_JB jb;
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+    tBTC_A2DP_SINK_DELAY delay;
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+    BOOLEAN asrc_on;
+    tA2DP_ASRC asrc;
+    int16_t asrc_buf[A2DP_ASRC_MAX_OUT_FRAMES * 2];
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+#if (BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE)
+    BOOLEAN resample_on;
+    btav_a2dp_codec_index_t resample_codec; /* codec the resampler was set up for */
+    tA2DP_RESAMPLER resampler;
+#endif /* BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE */
+    UINT8 *decode_buf;
+    UINT32 decode_buf_size;
+    UINT32 batch_len;
+    UINT8 batch_buf[A2DP_SNK_BATCH_BUF_SIZE];
 } a2dp_sink_local_param_t;
 
 static void btc_a2dp_sink_thread_init(UNUSED_ATTR void *context);
 static void btc_a2dp_sink_thread_cleanup(UNUSED_ATTR void *context);
-static void btc_a2dp_sink_flush_q(fixed_queue_t *p_q);
+static void btc_a2dp_sink_flush_q(void);
 static void btc_a2dp_sink_rx_flush(void);
 /* Handle incoming media packets A2DP SINK streaming*/
 static void btc_a2dp_sink_handle_inc_media(BT_HDR *p_msg);
 static void btc_a2dp_sink_handle_decoder_reset(tBTC_MEDIA_SINK_CFG_UPDATE *p_msg);
 static void btc_a2dp_sink_handle_clear_track(void);
+static void btc_a2dp_sink_conceal(size_t lost);
 static BOOLEAN btc_a2dp_sink_clear_track(void);
 
 static void btc_a2dp_sink_data_ready(void *context);
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+static void btc_a2dp_sink_drift_resync(void);
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+
+#if (BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE)
+/* Decoded audio for the pull mode. Filled by the decoding context and read
+   by the application, possibly from an ISR, so it lives outside of the sink
+   local parameters. Indices are free running byte counts. The buffer is
+   only touched while ready is set; the owner clears ready and waits for a
+   read in progress to finish before changing it */
+typedef struct {
+    UINT8 *buf;
+    UINT32 size;                    /* power of 2 */
+    UINT32 byte_rate;
+    UINT8 frame_bytes;
+    atomic_uint_least32_t head;     /* bytes written */
+    atomic_uint_least32_t tail;     /* bytes read */
+    atomic_bool ready;
+    atomic_bool reading;
+    uint64_t read_total;            /* bytes read since the ring was set up */
+} tBTC_A2DP_SINK_PCM_RING;
+
+static tBTC_A2DP_SINK_PCM_RING btc_a2dp_sink_pcm_ring;
+#endif /* BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE */
+
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+/* Clock drift of the source. Tracked as the media is received, in the BTU
+   task, and applied by the ASRC in the decoding context; the two only share
+   the atomics */
+typedef struct {
+    atomic_uint_least32_t sample_rate;  /* of the stream, 0 if not resampled */
+    atomic_uint_least32_t asrc_rate;    /* at the ASRC, after any fixed rate conversion */
+    atomic_uint_least8_t resync;        /* A2DP_SNK_DRIFT_RESYNC/RESET requests */
+    atomic_int_least32_t ratio_ppb;     /* correction applied by the ASRC */
+    atomic_int_least32_t advance;       /* frames the ASRC took over those it produced */
+    /* BTU task only */
+    UINT32 rate;
+    UINT32 out_rate;
+    BOOLEAN tracking;
+    UINT32 rtp_last;
+    int64_t media_frames;         /* media received since tracking started */
+    INT32 advance_start;
+    UINT64 start_us;
+    UINT64 window_end_us;
+    INT32 window_phase_us;      /* phase of the earliest packet of the window */
+    UINT64 first_us;            /* end of the first window */
+    INT32 ref_phase_us;         /* phase the loop holds */
+    INT32 integ_ppb;
+    UINT16 windows;
+} tBTC_A2DP_SINK_DRIFT;
+
+static tBTC_A2DP_SINK_DRIFT btc_a2dp_sink_drift;
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
 
 static int btc_a2dp_sink_state = BTC_A2DP_SINK_STATE_OFF;
+#if (BTC_A2DP_SINK_TASK_INCLUDED == TRUE)
+static future_t *btc_a2dp_sink_future = NULL;
+#endif /* BTC_A2DP_SINK_TASK_INCLUDED == TRUE */
 static esp_a2d_sink_data_cb_t bt_aa_snk_data_cb = NULL;
+static esp_a2d_pcm_fmt_t btc_a2dp_sink_pcm_fmt = ESP_A2D_PCM_FMT_S16;
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+static UINT16 btc_a2dp_sink_output_latency = 0; /* 1/10 ms */
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
 #if A2D_DYNAMIC_MEMORY == FALSE
 static a2dp_sink_local_param_t a2dp_sink_local_param;
 #else
@@ -133,14 +310,184 @@ void btc_a2dp_sink_reg_data_cb(esp_a2d_sink_data_cb_t callback)
     bt_aa_snk_data_cb = callback;
 }
 
-static inline void btc_a2d_data_cb_to_app(unsigned char *data, uint32_t len)
+void btc_a2dp_sink_set_pcm_format(esp_a2d_pcm_fmt_t fmt)
+{
+    btc_a2dp_sink_pcm_fmt = fmt;
+}
+
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+void btc_a2dp_sink_set_output_latency(uint16_t latency)
 {
+    btc_a2dp_sink_output_latency = latency;
+}
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+
+static void btc_a2dp_sink_pcm_fmt_to_format(esp_a2d_pcm_fmt_t fmt, tA2DP_PCM_FORMAT *p_format)
+{
+    memset(p_format, 0, sizeof(tA2DP_PCM_FORMAT));
+    switch (fmt) {
+    case ESP_A2D_PCM_FMT_S24_32:
+        p_format->bits_per_sample = 32;
+        p_format->valid_bits = 24;
+        break;
+    case ESP_A2D_PCM_FMT_S32:
+        p_format->bits_per_sample = 32;
+        p_format->valid_bits = 32;
+        break;
+    default:
+        p_format->bits_per_sample = 16;
+        p_format->valid_bits = 16;
+        break;
+    }
+}
+
+#if (BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE)
+static void btc_a2dp_sink_pcm_ring_write(const UINT8 *data, UINT32 len);
+#endif /* BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE */
+
+static void btc_a2dp_sink_pcm_deliver(const UINT8 *data, UINT32 len)
+{
+#if (BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE)
+    btc_a2dp_sink_pcm_ring_write(data, len);
+#endif /* BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE */
     // todo: critical section protection
     if (bt_aa_snk_data_cb) {
         bt_aa_snk_data_cb(data, len);
     }
 }
 
+static void btc_a2dp_sink_batch_flush(void)
+{
+    if (a2dp_sink_local_param.batch_len != 0) {
+        btc_a2dp_sink_pcm_deliver(a2dp_sink_local_param.batch_buf, a2dp_sink_local_param.batch_len);
+        a2dp_sink_local_param.batch_len = 0;
+    }
+}
+
+/* Small chunks are copied into the batch, larger ones are passed on in place */
+static void btc_a2dp_sink_pcm_out(const UINT8 *data, UINT32 len)
+{
+    if (len <= A2DP_SNK_BATCH_MAX_CHUNK) {
+        if (A2DP_SNK_BATCH_BUF_SIZE - a2dp_sink_local_param.batch_len < len) {
+            btc_a2dp_sink_batch_flush();
+        }
+        memcpy(a2dp_sink_local_param.batch_buf + a2dp_sink_local_param.batch_len, data, len);
+        a2dp_sink_local_param.batch_len += len;
+        return;
+    }
+    btc_a2dp_sink_batch_flush();
+    btc_a2dp_sink_pcm_deliver(data, len);
+}
+
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+static void btc_a2dp_sink_asrc_out(const UINT8 *data, UINT32 len)
+{
+    tA2DP_ASRC *p_asrc = &a2dp_sink_local_param.asrc;
+    UINT32 frame_bytes = p_asrc->channels * sizeof(int16_t);
+    UINT32 frames = len / frame_bytes;
+
+    a2dp_asrc_set_ratio(p_asrc, atomic_load(&btc_a2dp_sink_drift.ratio_ppb));
+    while (frames > 0) {
+        UINT32 n = MIN(frames, A2DP_ASRC_BLOCK_FRAMES);
+        size_t out = a2dp_asrc_process(p_asrc, (const int16_t *)data, n, a2dp_sink_local_param.asrc_buf);
+
+        if (out > 0) {
+            btc_a2dp_sink_pcm_out((const UINT8 *)a2dp_sink_local_param.asrc_buf, out * frame_bytes);
+        }
+        data += n * frame_bytes;
+        frames -= n;
+    }
+    atomic_store(&btc_a2dp_sink_drift.advance, p_asrc->advance);
+}
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+
+/* Audio at the output sample rate */
+static void btc_a2dp_sink_rate_out(const UINT8 *data, UINT32 len)
+{
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+    if (a2dp_sink_local_param.asrc_on) {
+        btc_a2dp_sink_asrc_out(data, len);
+        return;
+    }
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+    btc_a2dp_sink_pcm_out(data, len);
+}
+
+#if (BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE)
+static void btc_a2dp_sink_resample_out(const UINT8 *data, UINT32 len)
+{
+    tA2DP_RESAMPLER *p_rs = &a2dp_sink_local_param.resampler;
+    UINT32 frame_bytes = p_rs->channels * p_rs->sample_bytes;
+    UINT32 frames = len / frame_bytes;
+
+    while (frames > 0) {
+        UINT32 n = MIN(frames, A2DP_RESAMPLE_BLOCK_FRAMES);
+        const UINT8 *out;
+        size_t out_frames = a2dp_resample_process(p_rs, data, n, &out);
+
+        if (out_frames > 0) {
+            btc_a2dp_sink_rate_out(out, out_frames * frame_bytes);
+        }
+        data += n * frame_bytes;
+        frames -= n;
+    }
+}
+
+/*
+ * Set up the conversion of the audio decoded for the codec |index| to the
+ * output rate, |p_format| becomes the format delivered. The filter bank is
+ * kept while the codec and its format do not change, a stream restarted with
+ * the same configuration only clears the history.
+ */
+static void btc_a2dp_sink_resample_setup(btav_a2dp_codec_index_t index, tA2DP_PCM_FORMAT *p_format)
+{
+    tA2DP_RESAMPLER *p_rs = &a2dp_sink_local_param.resampler;
+
+    a2dp_sink_local_param.resample_on = FALSE;
+    if (p_format == NULL) {
+        a2dp_resample_cleanup(p_rs);
+        a2dp_sink_local_param.resample_codec = BTAV_A2DP_CODEC_INDEX_MAX;
+        return;
+    }
+    if (p_format->sample_rate == BTC_A2DP_SINK_RESAMPLE_RATE) {
+        return;
+    }
+
+    if (index == a2dp_sink_local_param.resample_codec && p_rs->in_rate == p_format->sample_rate &&
+            p_rs->channels == p_format->channels && p_rs->sample_bytes == p_format->bits_per_sample / 8) {
+        a2dp_resample_reset(p_rs);
+    } else {
+        a2dp_resample_cleanup(p_rs);
+        a2dp_sink_local_param.resample_codec = BTAV_A2DP_CODEC_INDEX_MAX;
+        if (!a2dp_resample_init(p_rs, p_format->sample_rate, BTC_A2DP_SINK_RESAMPLE_RATE,
+                                p_format->channels, p_format->bits_per_sample / 8)) {
+            APPL_TRACE_ERROR("%s: codec %d at %u Hz not converted to %u Hz", __func__, index,
+                             (unsigned int)p_format->sample_rate, BTC_A2DP_SINK_RESAMPLE_RATE);
+            return;
+        }
+        a2dp_sink_local_param.resample_codec = index;
+        APPL_TRACE_EVENT("a2dp sink codec %d resampled from %u Hz to %u Hz%s", index,
+                         (unsigned int)p_format->sample_rate, BTC_A2DP_SINK_RESAMPLE_RATE,
+                         p_rs->decimate ? ", decimated by 2" : "");
+    }
+    a2dp_sink_local_param.resample_on = TRUE;
+    p_format->sample_rate = BTC_A2DP_SINK_RESAMPLE_RATE;
+}
+#endif /* BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE */
+
+/* Decoder output, |data| is reused once this returned */
+static void btc_a2d_data_cb_to_app(unsigned char *data, uint32_t len)
+{
+    a2dp_sink_local_param.jb.pcm_bytes += len;
+#if (BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE)
+    if (a2dp_sink_local_param.resample_on) {
+        btc_a2dp_sink_resample_out(data, len);
+        return;
+    }
+#endif /* BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE */
+    btc_a2dp_sink_rate_out(data, len);
+}
+
 /*****************************************************************************
  **  Misc helper functions
  *****************************************************************************/
@@ -152,11 +499,510 @@ static inline void btc_a2d_cb_to_app(esp_a2d_cb_event_t event, esp_a2d_cb_param_
     }
 }
 
+/*****************************************************************************
+ **  Receive ring
+ *****************************************************************************/
+
+static size_t btc_a2dp_sink_rx_ring_len(void)
+{
+    tBTC_A2DP_SINK_RX_RING *p_ring = &a2dp_sink_local_param.btc_aa_snk_cb.rx_ring;
+
+    return (UINT16)(atomic_load_explicit(&p_ring->head, memory_order_acquire) -
+                    atomic_load_explicit(&p_ring->tail, memory_order_acquire));
+}
+
+/* producer side, the ring takes ownership of p_pkt on success */
+static BOOLEAN btc_a2dp_sink_rx_ring_put(BT_HDR *p_pkt)
+{
+    tBTC_A2DP_SINK_RX_RING *p_ring = &a2dp_sink_local_param.btc_aa_snk_cb.rx_ring;
+    UINT16 head = atomic_load_explicit(&p_ring->head, memory_order_relaxed);
+
+    if ((UINT16)(head - atomic_load_explicit(&p_ring->tail, memory_order_acquire)) >= MAX_A2DP_SNK_QUEUE_PKTS) {
+        return FALSE;
+    }
+    p_ring->slots[head % MAX_A2DP_SNK_QUEUE_PKTS] = p_pkt;
+    atomic_store_explicit(&p_ring->head, (UINT16)(head + 1), memory_order_release);
+    return TRUE;
+}
+
+/* consumer side, returns NULL when the ring is empty */
+static BT_HDR *btc_a2dp_sink_rx_ring_get(void)
+{
+    tBTC_A2DP_SINK_RX_RING *p_ring = &a2dp_sink_local_param.btc_aa_snk_cb.rx_ring;
+    UINT16 tail = atomic_load_explicit(&p_ring->tail, memory_order_relaxed);
+    BT_HDR *p_pkt;
+
+    if (tail == atomic_load_explicit(&p_ring->head, memory_order_acquire)) {
+        return NULL;
+    }
+    p_pkt = p_ring->slots[tail % MAX_A2DP_SNK_QUEUE_PKTS];
+    atomic_store_explicit(&p_ring->tail, (UINT16)(tail + 1), memory_order_release);
+    return p_pkt;
+}
+
+#if (BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE)
+/*****************************************************************************
+ **  PCM ring
+ *****************************************************************************/
+
+static void btc_a2dp_sink_pcm_ring_release(void)
+{
+    tBTC_A2DP_SINK_PCM_RING *p_ring = &btc_a2dp_sink_pcm_ring;
+
+    atomic_store(&p_ring->ready, false);
+    while (atomic_load(&p_ring->reading)) {
+        vTaskDelay(1);
+    }
+    if (p_ring->buf) {
+        osi_free(p_ring->buf);
+        p_ring->buf = NULL;
+    }
+}
+
+static void btc_a2dp_sink_pcm_ring_setup(const tA2DP_PCM_FORMAT *p_format)
+{
+    tBTC_A2DP_SINK_PCM_RING *p_ring = &btc_a2dp_sink_pcm_ring;
+    UINT32 frame_bytes = p_format->channels * (p_format->bits_per_sample / 8);
+    UINT32 min_size = (UINT32)(((uint64_t)p_format->sample_rate * frame_bytes * BTC_A2DP_SINK_PCM_RING_MS) / 1000);
+    UINT32 size = 1;
+
+    btc_a2dp_sink_pcm_ring_release();
+    if (frame_bytes == 0 || min_size == 0) {
+        return;
+    }
+    while (size < min_size) {
+        size <<= 1;
+    }
+    if ((p_ring->buf = (UINT8 *)osi_malloc(size)) == NULL) {
+        APPL_TRACE_ERROR("%s no memory for %d bytes", __func__, size);
+        return;
+    }
+    p_ring->size = size;
+    p_ring->byte_rate = p_format->sample_rate * frame_bytes;
+    p_ring->frame_bytes = frame_bytes;
+    p_ring->read_total = 0;
+    atomic_store(&p_ring->head, 0);
+    atomic_store(&p_ring->tail, 0);
+    atomic_store(&p_ring->ready, true);
+}
+
+/* the ring can take the audio of the next packet */
+static BOOLEAN btc_a2dp_sink_pcm_ring_has_room(void)
+{
+    tBTC_A2DP_SINK_PCM_RING *p_ring = &btc_a2dp_sink_pcm_ring;
+    UINT32 used, need;
+
+    if (!atomic_load(&p_ring->ready)) {
+        return TRUE;
+    }
+    used = atomic_load_explicit(&p_ring->head, memory_order_relaxed) -
+           atomic_load_explicit(&p_ring->tail, memory_order_acquire);
+    need = a2dp_sink_local_param.decode_buf_size;
+    if (a2dp_sink_local_param.jb.pkt_us != 0) {
+        need = (UINT32)(((uint64_t)a2dp_sink_local_param.jb.pkt_us * p_ring->byte_rate) / 1000000) * 2;
+    }
+    /* the batch is not in the ring yet */
+    need += a2dp_sink_local_param.batch_len;
+    return p_ring->size - used >= need;
+}
+
+static void btc_a2dp_sink_pcm_ring_write(const UINT8 *data, UINT32 len)
+{
+    tBTC_A2DP_SINK_PCM_RING *p_ring = &btc_a2dp_sink_pcm_ring;
+    UINT32 head, space, offset, first;
+
+    if (!atomic_load(&p_ring->ready)) {
+        return;
+    }
+    head = atomic_load_explicit(&p_ring->head, memory_order_relaxed);
+    space = p_ring->size - (head - atomic_load_explicit(&p_ring->tail, memory_order_acquire));
+    if (len > space) {
+        APPL_TRACE_WARNING("%s %d bytes dropped", __func__, len - space);
+        len = space - space % p_ring->frame_bytes;
+    }
+    offset = head & (p_ring->size - 1);
+    first = MIN(len, p_ring->size - offset);
+    memcpy(p_ring->buf + offset, data, first);
+    memcpy(p_ring->buf, data + first, len - first);
+    atomic_store_explicit(&p_ring->head, head + len, memory_order_release);
+}
+
+BOOLEAN btc_a2dp_sink_read_pcm(UINT8 *p_buf, UINT32 len, esp_a2d_sink_pcm_info_t *p_info)
+{
+    tBTC_A2DP_SINK_PCM_RING *p_ring = &btc_a2dp_sink_pcm_ring;
+    UINT32 tail, avail, offset, first, n = 0;
+    uint64_t pts_us = 0;
+    BOOLEAN ready;
+
+    atomic_store(&p_ring->reading, true);
+    ready = atomic_load(&p_ring->ready);
+    if (ready) {
+        tail = atomic_load_explicit(&p_ring->tail, memory_order_relaxed);
+        avail = atomic_load_explicit(&p_ring->head, memory_order_acquire) - tail;
+        n = MIN(len, avail);
+        n -= n % p_ring->frame_bytes;
+        offset = tail & (p_ring->size - 1);
+        first = MIN(n, p_ring->size - offset);
+        memcpy(p_buf, p_ring->buf + offset, first);
+        memcpy(p_buf + first, p_ring->buf, n - first);
+        atomic_store_explicit(&p_ring->tail, tail + n, memory_order_release);
+        pts_us = (p_ring->read_total * 1000000) / p_ring->byte_rate;
+        p_ring->read_total += n;
+    }
+    atomic_store(&p_ring->reading, false);
+
+    memset(p_buf + n, 0, len - n);
+    if (p_info) {
+        p_info->len = n;
+        p_info->pts_us = pts_us;
+        p_info->underrun = n < len;
+    }
+    return ready;
+}
+#endif /* BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE */
+
+/*****************************************************************************
+ **  Jitter buffer
+ *****************************************************************************/
+
+static void btc_a2dp_sink_jb_reset(void)
+{
+    tBTC_A2DP_SINK_JB *p_jb = &a2dp_sink_local_param.jb;
+
+    p_jb->streaming = FALSE;
+    p_jb->pcm_bytes = 0;
+    p_jb->stable_since_ms = osi_time_get_os_boottime_ms();
+    if (p_jb->target_ms == 0) {
+        p_jb->target_ms = BTC_A2DP_SINK_JITTER_MIN_MS;
+    }
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+    /* report again once the stream restarts */
+    a2dp_sink_local_param.delay.started = FALSE;
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+    btc_a2dp_sink_drift_resync();
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+}
+
+/* ms of media held in the RX queue */
+static UINT32 btc_a2dp_sink_jb_depth_ms(size_t pkts)
+{
+    return (UINT32)(((uint64_t)pkts * a2dp_sink_local_param.jb.pkt_us) / 1000);
+}
+
+/* the RX queue holds enough media to start decoding */
+static BOOLEAN btc_a2dp_sink_jb_primed(size_t pkts)
+{
+    tBTC_A2DP_SINK_JB *p_jb = &a2dp_sink_local_param.jb;
+
+    if (p_jb->streaming) {
+        return TRUE;
+    }
+    if (p_jb->pkt_us == 0) {
+        return pkts >= JITTER_BUFFER_WATER_LEVEL;
+    }
+    return btc_a2dp_sink_jb_depth_ms(pkts) >= p_jb->target_ms ||
+           pkts >= MAX_A2DP_SNK_QUEUE_PKTS / 2;
+}
+
+/* the RX queue cannot take another packet */
+static BOOLEAN btc_a2dp_sink_jb_full(size_t pkts)
+{
+    if (a2dp_sink_local_param.jb.pkt_us == 0) {
+        return pkts >= MAX_OUTPUT_A2DP_SNK_FRAME_QUEUE_SZ;
+    }
+    return btc_a2dp_sink_jb_depth_ms(pkts) >= 2 * BTC_A2DP_SINK_JITTER_MAX_MS ||
+           pkts >= MAX_A2DP_SNK_QUEUE_PKTS;
+}
+
+/* fold the duration of a decoded packet into the average */
+static void btc_a2dp_sink_jb_packet_decoded(UINT32 pcm_bytes)
+{
+    tBTC_A2DP_SINK_JB *p_jb = &a2dp_sink_local_param.jb;
+    UINT32 us;
+
+    if (p_jb->pcm_byte_rate == 0 || pcm_bytes == 0) {
+        return;
+    }
+    us = (UINT32)(((uint64_t)pcm_bytes * 1000000) / p_jb->pcm_byte_rate);
+    if (p_jb->pkt_us == 0) {
+        p_jb->pkt_us = us;
+    } else {
+        p_jb->pkt_us = (UINT32)((INT32)p_jb->pkt_us + ((INT32)us - (INT32)p_jb->pkt_us) / 8);
+    }
+}
+
+/*
+ * Track when the audio handed to the app runs out, assuming it is played in
+ * real time from the moment it is delivered. Running out is an underrun:
+ * the target grows and the buffer primes again. A long stable period lets
+ * the target shrink back.
+ */
+static void btc_a2dp_sink_jb_delivered(UINT32 pcm_bytes)
+{
+    tBTC_A2DP_SINK_JB *p_jb = &a2dp_sink_local_param.jb;
+    UINT32 now = osi_time_get_os_boottime_ms();
+
+    if (p_jb->pcm_byte_rate == 0 || pcm_bytes == 0) {
+        return;
+    }
+
+    if (!p_jb->streaming) {
+        p_jb->streaming = TRUE;
+        p_jb->play_end_ms = now;
+    } else if ((INT32)(now - p_jb->play_end_ms) > 0) {
+        p_jb->underruns++;
+        p_jb->streaming = FALSE;
+        p_jb->stable_since_ms = now;
+        if (p_jb->target_ms + A2DP_SNK_JITTER_STEP_MS <= BTC_A2DP_SINK_JITTER_MAX_MS) {
+            p_jb->target_ms += A2DP_SNK_JITTER_STEP_MS;
+        }
+        APPL_TRACE_WARNING("a2dp sink underrun, target %d ms", p_jb->target_ms);
+        p_jb->play_end_ms = now;
+    } else if (now - p_jb->stable_since_ms >= A2DP_SNK_JITTER_STABLE_MS) {
+        p_jb->stable_since_ms = now;
+        if (p_jb->target_ms >= BTC_A2DP_SINK_JITTER_MIN_MS + A2DP_SNK_JITTER_STEP_MS) {
+            p_jb->target_ms -= A2DP_SNK_JITTER_STEP_MS;
+        }
+    }
+
+    p_jb->play_end_ms += (UINT32)(((uint64_t)pcm_bytes * 1000) / p_jb->pcm_byte_rate);
+}
+
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+/*****************************************************************************
+ **  Delay reporting
+ *****************************************************************************/
+
+/*
+ * Work out the playout delay after a decoding pass: the media queued for
+ * decoding, one packet that has to be received whole before it is decoded,
+ * the decoded audio not played yet and the output latency of the
+ * application. The part inside the stack jumps by a packet on every pass,
+ * so it is smoothed. The source gets a report when the stream starts and
+ * whenever the delay moved by more than the threshold since the last one.
+ */
+static void btc_a2dp_sink_delay_update(void)
+{
+    tBTC_A2DP_SINK_JB *p_jb = &a2dp_sink_local_param.jb;
+    tBTC_A2DP_SINK_DELAY *p_delay = &a2dp_sink_local_param.delay;
+    UINT32 now = osi_time_get_os_boottime_ms();
+    UINT32 us, value, diff;
+
+    if (!p_jb->streaming || p_jb->pkt_us == 0) {
+        return;
+    }
+
+    us = (UINT32)((btc_a2dp_sink_rx_ring_len() + 1) * p_jb->pkt_us);
+    if ((INT32)(p_jb->play_end_ms - now) > 0) {
+        us += (p_jb->play_end_ms - now) * 1000;
+    }
+    if (!p_delay->started) {
+        p_delay->avg_us = us;
+    } else {
+        p_delay->avg_us = (UINT32)((INT32)p_delay->avg_us + ((INT32)us - (INT32)p_delay->avg_us) / 8);
+    }
+
+    value = p_delay->avg_us / A2DP_SNK_DELAY_RPT_UNIT_US + btc_a2dp_sink_output_latency;
+    p_delay->value = (UINT16)MIN(value, 0xFFFF);
+
+    diff = (p_delay->value > p_delay->reported) ? p_delay->value - p_delay->reported :
+           p_delay->reported - p_delay->value;
+    if (p_delay->started && diff < A2DP_SNK_DELAY_RPT_THRESHOLD) {
+        return;
+    }
+    APPL_TRACE_EVENT("a2dp sink delay %d.%d ms", p_delay->value / 10, p_delay->value % 10);
+    p_delay->started = TRUE;
+    p_delay->reported = p_delay->value;
+    btc_av_sink_delay_report(p_delay->value);
+}
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+/*****************************************************************************
+ **  Clock drift tracking
+ *****************************************************************************/
+
+static UINT64 btc_a2dp_sink_time_now_us(void)
+{
+#if _POSIX_TIMERS
+    struct timespec ts_now;
+    clock_gettime(CLOCK_MONOTONIC, &ts_now);
+    return ((UINT64)ts_now.tv_sec * 1000000L) + ((UINT64)ts_now.tv_nsec / 1000);
+#else
+    struct timeval ts_now;
+    gettimeofday(&ts_now, NULL);
+    return ((UINT64)ts_now.tv_sec * 1000000L) + ((UINT64)ts_now.tv_usec);
+#endif
+}
+
+static INT32 btc_a2dp_sink_drift_clamp(int64_t ppb, INT32 max)
+{
+    if (ppb > max) {
+        return max;
+    }
+    if (ppb < -max) {
+        return -max;
+    }
+    return (INT32)ppb;
+}
+
+/* Restart the tracking, keeping the drift found so far. Used when the audio
+   played out no longer follows the media received: an underrun, a drop or
+   a flush */
+static void btc_a2dp_sink_drift_resync(void)
+{
+    atomic_fetch_or(&btc_a2dp_sink_drift.resync, A2DP_SNK_DRIFT_RESYNC);
+}
+
+/*
+ * Called at the end of each window with the phase of its earliest packet,
+ * the least delayed by the link. The phase holds still once the ASRC makes
+ * up for the whole drift, so it runs a PI loop:
+ * - the first windows only measure, their slope gives a coarse drift and
+ *   the phase from then on is the reference;
+ * - then each window corrects the drift by the phase error, a loop of about
+ *   5 minutes, well damped, slow enough to ride over the link jitter.
+ * A phase far off the reference means the stream jumped, tracking restarts.
+ */
+static void btc_a2dp_sink_drift_window(tBTC_A2DP_SINK_DRIFT *p_drift, UINT64 now)
+{
+    INT32 err;
+    int64_t ppb;
+
+    p_drift->windows++;
+    if (p_drift->windows == 1) {
+        p_drift->ref_phase_us = p_drift->window_phase_us;
+        p_drift->first_us = now;
+        return;
+    }
+
+    err = p_drift->window_phase_us - p_drift->ref_phase_us;
+    if (err > A2DP_SNK_DRIFT_MAX_ERR_US || err < -A2DP_SNK_DRIFT_MAX_ERR_US) {
+        APPL_TRACE_WARNING("a2dp sink drift phase off by %d us, restart", err);
+        p_drift->tracking = FALSE;
+        return;
+    }
+
+    if (p_drift->windows < A2DP_SNK_DRIFT_ACQ_WINDOWS) {
+        return;
+    }
+    if (p_drift->windows == A2DP_SNK_DRIFT_ACQ_WINDOWS) {
+        ppb = (int64_t)err * 1000000000 / (int64_t)(now - p_drift->first_us);
+        if (ppb > A2DP_SNK_DRIFT_SANE_PPB || ppb < -A2DP_SNK_DRIFT_SANE_PPB) {
+            APPL_TRACE_WARNING("a2dp sink media timestamps unusable, drift not compensated");
+            p_drift->rate = 0;
+            p_drift->integ_ppb = 0;
+            atomic_store(&p_drift->ratio_ppb, 0);
+            return;
+        }
+        p_drift->integ_ppb = btc_a2dp_sink_drift_clamp(p_drift->integ_ppb + ppb, A2DP_ASRC_MAX_PPB);
+        p_drift->ref_phase_us = p_drift->window_phase_us;
+        err = 0;
+    } else {
+        p_drift->integ_ppb = btc_a2dp_sink_drift_clamp(p_drift->integ_ppb + (int64_t)err * A2DP_SNK_DRIFT_KI,
+                                                       A2DP_ASRC_MAX_PPB);
+    }
+    ppb = p_drift->integ_ppb + (int64_t)err * A2DP_SNK_DRIFT_KP;
+    atomic_store(&p_drift->ratio_ppb, btc_a2dp_sink_drift_clamp(ppb, A2DP_ASRC_MAX_PPB));
+    APPL_TRACE_DEBUG("a2dp sink drift %d ppb, phase error %d us", p_drift->integ_ppb, err);
+}
+
+/*
+ * A media packet was received, before it is queued. Its phase is how far
+ * the media received so far, less the frames the ASRC skipped (or plus
+ * those it repeated), runs ahead of the local clock. The local clock
+ * stands for the consumption of the audio output, clocked from the same
+ * crystal.
+ */
+static void btc_a2dp_sink_drift_rx(const BT_HDR *p_pkt)
+{
+    tBTC_A2DP_SINK_DRIFT *p_drift = &btc_a2dp_sink_drift;
+    const tA2DP_DECODER_INTERFACE *decoder = a2dp_sink_local_param.decoder;
+    UINT8 resync = atomic_exchange(&p_drift->resync, 0);
+    UINT64 now = btc_a2dp_sink_time_now_us();
+    UINT32 ts;
+    INT32 advance;
+    int64_t phase;
+
+    if (resync & A2DP_SNK_DRIFT_RESET) {
+        p_drift->rate = atomic_load(&p_drift->sample_rate);
+        p_drift->out_rate = atomic_load(&p_drift->asrc_rate);
+        p_drift->integ_ppb = 0;
+        atomic_store(&p_drift->ratio_ppb, 0);
+    }
+    if (resync != 0) {
+        p_drift->tracking = FALSE;
+    }
+    if (p_drift->rate == 0 || decoder == NULL || decoder->decoder_get_media_timestamp == NULL ||
+            !decoder->decoder_get_media_timestamp(p_pkt, &ts)) {
+        return;
+    }
+
+    advance = atomic_load(&p_drift->advance);
+    if (p_drift->tracking) {
+        INT32 delta = (INT32)(ts - p_drift->rtp_last);
+        if (delta < 0 && delta >= -(INT32)p_drift->rate) {
+            /* reordered */
+            return;
+        }
+        /* a jump of over a second either way, timestamps that wrap early included */
+        if (delta > (INT32)p_drift->rate || delta < 0) {
+            p_drift->tracking = FALSE;
+        }
+    }
+    if (!p_drift->tracking) {
+        p_drift->tracking = TRUE;
+        p_drift->media_frames = 0;
+        p_drift->advance_start = advance;
+        p_drift->start_us = now;
+        p_drift->window_end_us = now + A2DP_SNK_DRIFT_WINDOW_US;
+        p_drift->window_phase_us = INT32_MIN;
+        p_drift->windows = 0;
+    } else {
+        p_drift->media_frames += (INT32)(ts - p_drift->rtp_last);
+    }
+    p_drift->rtp_last = ts;
+
+    phase = p_drift->media_frames * 1000000 / p_drift->rate -
+            (int64_t)(advance - p_drift->advance_start) * 1000000 / p_drift->out_rate -
+            (int64_t)(now - p_drift->start_us);
+    if (phase > p_drift->window_phase_us) {
+        p_drift->window_phase_us = (INT32)phase;
+    }
+    if (now >= p_drift->window_end_us) {
+        btc_a2dp_sink_drift_window(p_drift, now);
+        p_drift->window_end_us = now + A2DP_SNK_DRIFT_WINDOW_US;
+        p_drift->window_phase_us = INT32_MIN;
+    }
+}
+
+/* Set up the ASRC for the PCM format it is fed with, 16-bit samples only.
+   The decoded media, before any fixed rate conversion, comes at
+   |media_byte_rate| */
+static void btc_a2dp_sink_asrc_setup(const tA2DP_PCM_FORMAT *p_format, UINT32 media_byte_rate)
+{
+    tBTC_A2DP_SINK_DRIFT *p_drift = &btc_a2dp_sink_drift;
+    UINT32 media_rate = 0;
+
+    a2dp_sink_local_param.asrc_on = p_format != NULL && p_format->bits_per_sample == 16 &&
+                                    a2dp_asrc_init(&a2dp_sink_local_param.asrc, p_format->channels);
+    if (a2dp_sink_local_param.asrc_on) {
+        media_rate = media_byte_rate / (p_format->channels * sizeof(int16_t));
+    }
+    atomic_store(&p_drift->ratio_ppb, 0);
+    atomic_store(&p_drift->advance, 0);
+    atomic_store(&p_drift->asrc_rate, a2dp_sink_local_param.asrc_on ? p_format->sample_rate : 0);
+    atomic_store(&p_drift->sample_rate, media_rate);
+    atomic_fetch_or(&p_drift->resync, A2DP_SNK_DRIFT_RESET);
+}
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+
 /*****************************************************************************
  **  BTC ADAPTATION
  *****************************************************************************/
 
-static bool btc_a2dp_sink_ctrl(uint32_t sig, void *param)
+static void btc_a2dp_sink_ctrl_handler(uint32_t sig, void *param)
 {
     switch (sig) {
     case BTC_MEDIA_TASK_SINK_INIT:
@@ -181,6 +1027,46 @@ static bool btc_a2dp_sink_ctrl(uint32_t sig, void *param)
     if (param != NULL) {
         osi_free(param);
     }
+}
+
+#if (BTC_A2DP_SINK_TASK_INCLUDED == TRUE)
+static void btc_a2dp_sink_task_handler(void *arg)
+{
+    a2dp_sink_task_evt_t *e = (a2dp_sink_task_evt_t *)arg;
+
+    btc_a2dp_sink_ctrl_handler(e->sig, e->param);
+    osi_free(e);
+}
+#endif /* BTC_A2DP_SINK_TASK_INCLUDED == TRUE */
+
+/* Control events run in the context decoding the media, so they are
+   serialized with it: posted to the sink task if there is one, run
+   in place on the BTC task otherwise */
+static bool btc_a2dp_sink_ctrl(uint32_t sig, void *param)
+{
+#if (BTC_A2DP_SINK_TASK_INCLUDED == TRUE)
+    a2dp_sink_task_evt_t *evt = (a2dp_sink_task_evt_t *)osi_malloc(sizeof(a2dp_sink_task_evt_t));
+
+    if (evt == NULL) {
+        if (param != NULL) {
+            osi_free(param);
+        }
+        return false;
+    }
+
+    evt->sig = sig;
+    evt->param = param;
+
+    if (!osi_thread_post(a2dp_sink_local_param.btc_aa_snk_task_hdl, btc_a2dp_sink_task_handler, evt, 0, OSI_THREAD_MAX_TIMEOUT)) {
+        osi_free(evt);
+        if (param != NULL) {
+            osi_free(param);
+        }
+        return false;
+    }
+#else
+    btc_a2dp_sink_ctrl_handler(sig, param);
+#endif /* BTC_A2DP_SINK_TASK_INCLUDED == TRUE */
 
     return true;
 }
@@ -202,7 +1088,15 @@ bool btc_a2dp_sink_startup(void)
 
     APPL_TRACE_EVENT("## A2DP SINK START MEDIA THREAD ##");
 
+#if (BTC_A2DP_SINK_TASK_INCLUDED == TRUE)
+    a2dp_sink_local_param.btc_aa_snk_task_hdl = osi_thread_create(BTC_A2DP_SINK_TASK_NAME, BTC_A2DP_SINK_TASK_STACK,
+                                                                  BTC_A2DP_SINK_TASK_PRIO, BTC_A2DP_SINK_TASK_PINNED_TO_CORE, 2);
+    if (a2dp_sink_local_param.btc_aa_snk_task_hdl == NULL) {
+        goto error_exit;
+    }
+#else
     a2dp_sink_local_param.btc_aa_snk_task_hdl = btc_thread;
+#endif /* BTC_A2DP_SINK_TASK_INCLUDED == TRUE */
 
     if (btc_a2dp_sink_ctrl(BTC_MEDIA_TASK_SINK_INIT, NULL) == false) {
         goto error_exit;
@@ -214,6 +1108,11 @@ bool btc_a2dp_sink_startup(void)
 
 error_exit:;
     APPL_TRACE_ERROR("%s unable to start up media thread\n", __func__);
+#if (BTC_A2DP_SINK_TASK_INCLUDED == TRUE)
+    if (a2dp_sink_local_param.btc_aa_snk_task_hdl != NULL) {
+        osi_thread_free(a2dp_sink_local_param.btc_aa_snk_task_hdl);
+    }
+#endif /* BTC_A2DP_SINK_TASK_INCLUDED == TRUE */
     a2dp_sink_local_param.btc_aa_snk_task_hdl = NULL;
 
 #if A2D_DYNAMIC_MEMORY == TRUE
@@ -231,7 +1130,22 @@ void btc_a2dp_sink_shutdown(void)
     // Exit thread
     btc_a2dp_sink_state = BTC_A2DP_SINK_STATE_SHUTTING_DOWN;
 
+#if (BTC_A2DP_SINK_TASK_INCLUDED == TRUE)
+    /* pending decodes are skipped once the state left ON, wait for the
+       clean up to run on the sink task before stopping it */
+    btc_a2dp_sink_future = future_new();
+    assert(btc_a2dp_sink_future);
+    if (btc_a2dp_sink_ctrl(BTC_MEDIA_TASK_SINK_CLEAN_UP, NULL)) {
+        future_await(btc_a2dp_sink_future);
+    } else {
+        future_free(btc_a2dp_sink_future);
+    }
+    btc_a2dp_sink_future = NULL;
+
+    osi_thread_free(a2dp_sink_local_param.btc_aa_snk_task_hdl);
+#else
     btc_a2dp_sink_ctrl(BTC_MEDIA_TASK_SINK_CLEAN_UP, NULL);
+#endif /* BTC_A2DP_SINK_TASK_INCLUDED == TRUE */
 
     a2dp_sink_local_param.btc_aa_snk_task_hdl = NULL;
 
@@ -311,8 +1225,73 @@ void btc_a2dp_sink_set_rx_flush(BOOLEAN enable)
 {
     APPL_TRACE_EVENT("## DROP RX %d ##\n", enable);
     a2dp_sink_local_param.btc_aa_snk_cb.rx_flush = enable;
+    if (enable) {
+        /* the stream restarts after a flush, it is not a loss */
+        a2dp_sink_local_param.btc_aa_snk_cb.rx_drop_pending = 0;
+        a2dp_sink_local_param.btc_aa_snk_cb.rx_resync = TRUE;
+        if (btc_a2dp_sink_state == BTC_A2DP_SINK_STATE_ON) {
+            btc_a2dp_sink_ctrl(BTC_MEDIA_FLUSH_AA_RX, NULL);
+        }
+    }
 }
 
+/*******************************************************************************
+ **
+ ** Function         btc_a2dp_sink_get_stats
+ **
+ ** Description      Get the jitter buffer and packet loss statistics
+ **
+ ** Returns          TRUE if the sink is running
+ **
+ *******************************************************************************/
+BOOLEAN btc_a2dp_sink_get_stats(esp_a2d_sink_stats_t *p_stats)
+{
+    if (btc_a2dp_sink_state != BTC_A2DP_SINK_STATE_ON) {
+        return FALSE;
+    }
+
+    tBTC_A2DP_SINK_PLC_STATS *p_plc = &a2dp_sink_local_param.btc_aa_snk_cb.plc_stats;
+    tBTC_A2DP_SINK_JB *p_jb = &a2dp_sink_local_param.jb;
+
+    p_stats->depth_ms = btc_a2dp_sink_jb_depth_ms(btc_a2dp_sink_rx_ring_len());
+    p_stats->target_ms = p_jb->target_ms;
+    p_stats->underruns = p_jb->underruns;
+    p_stats->overruns = p_plc->dropped_pkts;
+    p_stats->rx_pkts = p_plc->rx_pkts;
+    p_stats->lost_pkts = p_plc->lost_pkts;
+    p_stats->concealed_pkts = p_plc->concealed_pkts;
+    p_stats->concealed_frames = p_plc->concealed_frames;
+    return TRUE;
+}
+
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+/*******************************************************************************
+ **
+ ** Function         btc_a2dp_sink_get_delay
+ **
+ ** Description      Get the current playout delay of the sink
+ **
+ ** Returns          TRUE if the sink is running
+ **
+ *******************************************************************************/
+BOOLEAN btc_a2dp_sink_get_delay(UINT16 *p_delay)
+{
+    if (btc_a2dp_sink_state != BTC_A2DP_SINK_STATE_ON) {
+        return FALSE;
+    }
+
+    if (a2dp_sink_local_param.delay.started) {
+        *p_delay = a2dp_sink_local_param.delay.value;
+    } else {
+        /* not streaming, the delay to expect once primed */
+        UINT32 value = a2dp_sink_local_param.jb.target_ms * 1000 / A2DP_SNK_DELAY_RPT_UNIT_US +
+                       btc_a2dp_sink_output_latency;
+        *p_delay = (UINT16)MIN(value, 0xFFFF);
+    }
+    return TRUE;
+}
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+
 /*****************************************************************************
 **
 ** Function        btc_a2dp_sink_reset_decoder
@@ -323,21 +1302,35 @@ void btc_a2dp_sink_set_rx_flush(BOOLEAN enable)
 **
 *******************************************************************************/
 
-void btc_a2dp_sink_reset_decoder(UINT8 *p_av)
+esp_a2d_pcm_fmt_t btc_a2dp_sink_reset_decoder(UINT8 *p_av)
 {
     APPL_TRACE_EVENT("btc reset decoder");
     APPL_TRACE_DEBUG("btc reset decoder p_codec_info[%x:%x:%x:%x:%x:%x]\n",
                      p_av[1], p_av[2], p_av[3],
                      p_av[4], p_av[5], p_av[6]);
 
+    /* fall back to 16 bit samples if the codec cannot produce the
+       requested format */
+    const tA2DP_DECODER_INTERFACE *decoder = A2DP_GetDecoderInterface(p_av);
+    esp_a2d_pcm_fmt_t pcm_fmt = btc_a2dp_sink_pcm_fmt;
+    tA2DP_PCM_FORMAT format;
+    btc_a2dp_sink_pcm_fmt_to_format(pcm_fmt, &format);
+    if (pcm_fmt != ESP_A2D_PCM_FMT_S16 &&
+        (!decoder || !decoder->decoder_supports_pcm_format ||
+         !decoder->decoder_supports_pcm_format(&format))) {
+        pcm_fmt = ESP_A2D_PCM_FMT_S16;
+    }
+
     tBTC_MEDIA_SINK_CFG_UPDATE *p_buf;
     if (NULL == (p_buf = osi_malloc(sizeof(tBTC_MEDIA_SINK_CFG_UPDATE)))) {
         APPL_TRACE_ERROR("btc reset decoder No Buffer ");
-        return;
+        return pcm_fmt;
     }
 
     memcpy(p_buf->codec_info, p_av, AVDT_CODEC_SIZE);
+    p_buf->pcm_fmt = pcm_fmt;
     btc_a2dp_sink_ctrl(BTC_MEDIA_AUDIO_SINK_CFG_UPDATE, p_buf);
+    return pcm_fmt;
 }
 
 static void btc_a2dp_sink_data_ready(UNUSED_ATTR void *context)
@@ -346,28 +1339,44 @@ static void btc_a2dp_sink_data_ready(UNUSED_ATTR void *context)
     int nb_of_msgs_to_process = 0;
 
     osi_sem_give(&a2dp_sink_local_param.btc_aa_snk_cb.post_sem);
-    if (fixed_queue_is_empty(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ)) {
+    if (btc_a2dp_sink_rx_ring_len() == 0) {
         APPL_TRACE_DEBUG("  QUE  EMPTY ");
     } else {
         if (a2dp_sink_local_param.btc_aa_snk_cb.rx_flush == TRUE) {
-            btc_a2dp_sink_flush_q(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ);
+            btc_a2dp_sink_flush_q();
             return;
         }
-        nb_of_msgs_to_process = fixed_queue_length(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ);
+        nb_of_msgs_to_process = btc_a2dp_sink_rx_ring_len();
         APPL_TRACE_DEBUG("nb:%d", nb_of_msgs_to_process);
+        UINT32 pcm_bytes = 0;
         while (nb_of_msgs_to_process > 0) {
             if (btc_a2dp_sink_state != BTC_A2DP_SINK_STATE_ON){
+                a2dp_sink_local_param.batch_len = 0;
                 return;
             }
-            p_msg = (BT_HDR *)fixed_queue_dequeue(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ, 0);
+#if (BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE)
+            /* keep the media queued until the reader made room, the next
+               packet received posts the decoding again */
+            if (!btc_a2dp_sink_pcm_ring_has_room()) {
+                break;
+            }
+#endif /* BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE */
+            p_msg = btc_a2dp_sink_rx_ring_get();
             if ( p_msg == NULL ) {
                 APPL_TRACE_DEBUG("Insufficient data in que ");
                 break;
             }
+            a2dp_sink_local_param.jb.pcm_bytes = 0;
             btc_a2dp_sink_handle_inc_media(p_msg);
+            pcm_bytes += a2dp_sink_local_param.jb.pcm_bytes;
             osi_free(p_msg);
             nb_of_msgs_to_process--;
         }
+        btc_a2dp_sink_batch_flush();
+        btc_a2dp_sink_jb_delivered(pcm_bytes);
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+        btc_a2dp_sink_delay_update();
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
         APPL_TRACE_DEBUG(" Process Frames - ");
     }
 }
@@ -409,9 +1418,62 @@ static void btc_a2dp_sink_handle_decoder_reset(tBTC_MEDIA_SINK_CFG_UPDATE *p_msg
         }
     }
 
+    tA2DP_PCM_FORMAT format;
+    if (a2dp_sink_local_param.decoder->decoder_set_pcm_format) {
+        btc_a2dp_sink_pcm_fmt_to_format(p_msg->pcm_fmt, &format);
+#if (BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE)
+        /* nothing above the output rate is needed, high rate codecs may
+           decode at a lower one */
+        format.sample_rate = BTC_A2DP_SINK_RESAMPLE_RATE;
+#endif /* BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE */
+        a2dp_sink_local_param.decoder->decoder_set_pcm_format(&format);
+    }
+
     if (a2dp_sink_local_param.decoder->decoder_configure){
         a2dp_sink_local_param.decoder->decoder_configure(p_msg->codec_info);
     }
+
+    size_t buf_size = A2DP_SNK_DECODE_BUF_SIZE;
+    if (a2dp_sink_local_param.decoder->decoder_get_max_output_size &&
+        a2dp_sink_local_param.decoder->decoder_get_max_output_size() > buf_size) {
+        buf_size = a2dp_sink_local_param.decoder->decoder_get_max_output_size();
+    }
+    if (buf_size != a2dp_sink_local_param.decode_buf_size) {
+        osi_free(a2dp_sink_local_param.decode_buf);
+        a2dp_sink_local_param.decode_buf_size = 0;
+        a2dp_sink_local_param.decode_buf = osi_malloc(buf_size);
+        if (a2dp_sink_local_param.decode_buf == NULL) {
+            APPL_TRACE_ERROR("%s: no memory for the decoded audio", __func__);
+            return;
+        }
+        a2dp_sink_local_param.decode_buf_size = buf_size;
+    }
+    a2dp_sink_local_param.batch_len = 0;
+
+    tBTC_A2DP_SINK_JB *p_jb = &a2dp_sink_local_param.jb;
+    p_jb->pcm_byte_rate = 0;
+    p_jb->pkt_us = 0;
+    if (a2dp_sink_local_param.decoder->decoder_get_pcm_format &&
+        a2dp_sink_local_param.decoder->decoder_get_pcm_format(&format)) {
+        /* the jitter buffer counts the decoded audio, before any rate conversion */
+        p_jb->pcm_byte_rate = format.sample_rate * format.channels * (format.bits_per_sample / 8);
+#if (BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE)
+        btc_a2dp_sink_resample_setup(A2DP_SinkCodecIndex(p_msg->codec_info), &format);
+    } else {
+        btc_a2dp_sink_resample_setup(BTAV_A2DP_CODEC_INDEX_MAX, NULL);
+#endif /* BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE */
+    }
+#if (BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE)
+    if (p_jb->pcm_byte_rate != 0) {
+        btc_a2dp_sink_pcm_ring_setup(&format);
+    } else {
+        btc_a2dp_sink_pcm_ring_release();
+    }
+#endif /* BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE */
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+    btc_a2dp_sink_asrc_setup(p_jb->pcm_byte_rate != 0 ? &format : NULL, p_jb->pcm_byte_rate);
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+    btc_a2dp_sink_jb_reset();
 }
 
 /*******************************************************************************
@@ -437,14 +1499,66 @@ static void btc_a2dp_sink_handle_inc_media(BT_HDR *p_msg)
         return;
     }
 
+    // no decoder output buffer, the decoder reset failed
+    if (a2dp_sink_local_param.decode_buf == NULL) {
+        return;
+    }
+
+    size_t lost = 0;
     if (a2dp_sink_local_param.decoder->decode_packet_header) {
-        a2dp_sink_local_param.decoder->decode_packet_header(p_msg);
+        lost = a2dp_sink_local_param.decoder->decode_packet_header(p_msg);
+    }
+
+    /* packets dropped on a full queue also show up as a sequence gap */
+    if (p_msg->event > lost) {
+        lost = p_msg->event;
+    }
+    if (a2dp_sink_local_param.btc_aa_snk_cb.rx_resync) {
+        a2dp_sink_local_param.btc_aa_snk_cb.rx_resync = FALSE;
+        lost = 0;
+    }
+    if (lost > 0) {
+        btc_a2dp_sink_conceal(lost);
     }
 
     if (a2dp_sink_local_param.decoder->decode_packet) {
         unsigned char* buf = a2dp_sink_local_param.decode_buf;
-        size_t buf_len = sizeof(a2dp_sink_local_param.decode_buf);
+        size_t buf_len = a2dp_sink_local_param.decode_buf_size;
+        UINT32 pcm_bytes = a2dp_sink_local_param.jb.pcm_bytes;
         a2dp_sink_local_param.decoder->decode_packet(p_msg, buf, buf_len);
+        btc_a2dp_sink_jb_packet_decoded(a2dp_sink_local_param.jb.pcm_bytes - pcm_bytes);
+    }
+}
+
+/*******************************************************************************
+ **
+ ** Function         btc_a2dp_sink_conceal
+ **
+ ** Description      Let the decoder fill in for |lost| missing media packets
+ **
+ ** Returns          void
+ **
+ *******************************************************************************/
+static void btc_a2dp_sink_conceal(size_t lost)
+{
+    tBTC_A2DP_SINK_PLC_STATS *p_stats = &a2dp_sink_local_param.btc_aa_snk_cb.plc_stats;
+
+    p_stats->lost_pkts += lost;
+    APPL_TRACE_DEBUG("%s lost %d", __func__, (int)lost);
+
+    if (!a2dp_sink_local_param.decoder->decoder_conceal) {
+        return;
+    }
+    if (lost > MAX_A2DP_SNK_CONCEAL_PKTS) {
+        lost = MAX_A2DP_SNK_CONCEAL_PKTS;
+    }
+
+    unsigned char* buf = a2dp_sink_local_param.decode_buf;
+    size_t buf_len = a2dp_sink_local_param.decode_buf_size;
+    size_t frames = a2dp_sink_local_param.decoder->decoder_conceal(lost, buf, buf_len);
+    if (frames > 0) {
+        p_stats->concealed_pkts += lost;
+        p_stats->concealed_frames += frames;
     }
 }
 
@@ -459,7 +1573,7 @@ static void btc_a2dp_sink_handle_inc_media(BT_HDR *p_msg)
  *******************************************************************************/
 BOOLEAN btc_a2dp_sink_rx_flush_req(void)
 {
-    if (fixed_queue_is_empty(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ) == TRUE) { /*  Que is already empty */
+    if (btc_a2dp_sink_rx_ring_len() == 0) { /*  Que is already empty */
         return TRUE;
     }
 
@@ -480,52 +1594,60 @@ static void btc_a2dp_sink_rx_flush(void)
     /* Flush all enqueued SBC  buffers (encoded) */
     APPL_TRACE_DEBUG("btc_a2dp_sink_rx_flush");
 
-    btc_a2dp_sink_flush_q(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ);
+    btc_a2dp_sink_flush_q();
+    btc_a2dp_sink_jb_reset();
 }
 
 /*******************************************************************************
  **
  ** Function         btc_a2dp_sink_enque_buf
  **
- ** Description      This function is called by the av_co to fill A2DP Sink Queue
- **
+ ** Description      This function is called by the av_co to fill A2DP Sink Queue.
+ **                  The queue takes ownership of p_pkt, it is freed once
+ **                  decoded or dropped.
  **
  ** Returns          size of the queue
  *******************************************************************************/
 UINT8 btc_a2dp_sink_enque_buf(BT_HDR *p_pkt)
 {
-    BT_HDR *p_msg;
-
     if (btc_a2dp_sink_state != BTC_A2DP_SINK_STATE_ON){
+        osi_free(p_pkt);
         return 0;
     }
 
     if (a2dp_sink_local_param.btc_aa_snk_cb.rx_flush == TRUE) { /* Flush enabled, do not enque*/
-        return fixed_queue_length(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ);
+        osi_free(p_pkt);
+        return btc_a2dp_sink_rx_ring_len();
     }
 
-    if (fixed_queue_length(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ) >= MAX_OUTPUT_A2DP_SNK_FRAME_QUEUE_SZ) {
+    APPL_TRACE_DEBUG("btc_a2dp_sink_enque_buf + ");
+
+    /* event is free once the packet left BTA, carry the drops in front of it */
+    p_pkt->event = a2dp_sink_local_param.btc_aa_snk_cb.rx_drop_pending;
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+    /* the packet belongs to the decoding context once queued */
+    btc_a2dp_sink_drift_rx(p_pkt);
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+    if (btc_a2dp_sink_jb_full(btc_a2dp_sink_rx_ring_len()) ||
+            !btc_a2dp_sink_rx_ring_put(p_pkt)) {
         APPL_TRACE_WARNING("Pkt dropped\n");
-        return fixed_queue_length(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ);
+        osi_free(p_pkt);
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+        btc_a2dp_sink_drift_resync();
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+        a2dp_sink_local_param.btc_aa_snk_cb.rx_drop_pending++;
+        a2dp_sink_local_param.btc_aa_snk_cb.plc_stats.dropped_pkts++;
+        return btc_a2dp_sink_rx_ring_len();
     }
+    a2dp_sink_local_param.btc_aa_snk_cb.rx_drop_pending = 0;
+    a2dp_sink_local_param.btc_aa_snk_cb.plc_stats.rx_pkts++;
 
-    APPL_TRACE_DEBUG("btc_a2dp_sink_enque_buf + ");
-
-    /* allocate and Queue this buffer */
-    if ((p_msg = (BT_HDR *) osi_malloc(sizeof(BT_HDR) +
-                                            p_pkt->offset + p_pkt->len)) != NULL) {
-        memcpy(p_msg, p_pkt, (sizeof(BT_HDR) + p_pkt->offset + p_pkt->len));
-        fixed_queue_enqueue(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ, p_msg, FIXED_QUEUE_MAX_TIMEOUT);
-        if (fixed_queue_length(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ) >= JITTER_BUFFER_WATER_LEVEL) {
-            if (osi_sem_take(&a2dp_sink_local_param.btc_aa_snk_cb.post_sem, 0) == 0) {
-                btc_a2dp_sink_data_post();
-            }
+    if (btc_a2dp_sink_jb_primed(btc_a2dp_sink_rx_ring_len())) {
+        if (osi_sem_take(&a2dp_sink_local_param.btc_aa_snk_cb.post_sem, 0) == 0) {
+            btc_a2dp_sink_data_post();
         }
-    } else {
-        /* let caller deal with a failed allocation */
-        APPL_TRACE_WARNING("btc_a2dp_sink_enque_buf No Buffer left - ");
     }
-    return fixed_queue_length(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ);
+    return btc_a2dp_sink_rx_ring_len();
 }
 
 static void btc_a2dp_sink_handle_clear_track (void)
@@ -542,10 +1664,12 @@ static void btc_a2dp_sink_handle_clear_track (void)
  ** Returns          void
  **
  *******************************************************************************/
-static void btc_a2dp_sink_flush_q(fixed_queue_t *p_q)
+static void btc_a2dp_sink_flush_q(void)
 {
-    while (! fixed_queue_is_empty(p_q)) {
-        osi_free(fixed_queue_dequeue(p_q, 0));
+    BT_HDR *p_pkt;
+
+    while ((p_pkt = btc_a2dp_sink_rx_ring_get()) != NULL) {
+        osi_free(p_pkt);
     }
 }
 
@@ -553,12 +1677,13 @@ static void btc_a2dp_sink_thread_init(UNUSED_ATTR void *context)
 {
     APPL_TRACE_EVENT("%s\n", __func__);
     memset(&a2dp_sink_local_param.btc_aa_snk_cb, 0, sizeof(a2dp_sink_local_param.btc_aa_snk_cb));
+    memset(&a2dp_sink_local_param.jb, 0, sizeof(a2dp_sink_local_param.jb));
+    btc_a2dp_sink_jb_reset();
 
     btc_a2dp_sink_state = BTC_A2DP_SINK_STATE_ON;
     if (!a2dp_sink_local_param.btc_aa_snk_cb.post_sem) {
         osi_sem_new(&a2dp_sink_local_param.btc_aa_snk_cb.post_sem, 1, 1);
     }
-    a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ = fixed_queue_new(QUEUE_SIZE_MAX);
 
     btc_a2dp_control_init();
 }
@@ -571,14 +1696,29 @@ static void btc_a2dp_sink_thread_cleanup(UNUSED_ATTR void *context)
 
     btc_a2dp_control_cleanup();
 
-    fixed_queue_free(a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ, osi_free_func);
-
-    a2dp_sink_local_param.btc_aa_snk_cb.RxSbcQ = NULL;
+    btc_a2dp_sink_flush_q();
+#if (BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE)
+    btc_a2dp_sink_pcm_ring_release();
+#endif /* BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE */
+#if (BTC_A2DP_SINK_ASRC_INCLUDED == TRUE)
+    btc_a2dp_sink_asrc_setup(NULL, 0);
+#endif /* BTC_A2DP_SINK_ASRC_INCLUDED == TRUE */
+#if (BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE)
+    btc_a2dp_sink_resample_setup(BTAV_A2DP_CODEC_INDEX_MAX, NULL);
+#endif /* BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE */
+    osi_free(a2dp_sink_local_param.decode_buf);
+    a2dp_sink_local_param.decode_buf = NULL;
+    a2dp_sink_local_param.decode_buf_size = 0;
+    a2dp_sink_local_param.batch_len = 0;
 
     if (a2dp_sink_local_param.btc_aa_snk_cb.post_sem) {
         osi_sem_free(&a2dp_sink_local_param.btc_aa_snk_cb.post_sem);
         a2dp_sink_local_param.btc_aa_snk_cb.post_sem = NULL;
     }
+
+#if (BTC_A2DP_SINK_TASK_INCLUDED == TRUE)
+    future_ready(btc_a2dp_sink_future, FUTURE_SUCCESS);
+#endif /* BTC_A2DP_SINK_TASK_INCLUDED == TRUE */
 }
 
 #endif /* BTC_AV_SINK_INCLUDED */
@@ -32,6 +32,8 @@
 #include "osi/fixed_queue.h"
 #include "stack/a2d_api.h"
 #include "stack/a2d_sbc.h"
+#include "stack/a2dp_codec_api.h"
+#include "stack/l2c_api.h"
 #include "bta/bta_av_api.h"
 #include "bta/bta_av_sbc.h"
 #include "bta/bta_av_ci.h"
@@ -86,6 +88,10 @@ enum {
 
 #define BTC_MEDIA_AA_BUF_SIZE                  (4096+16)
 
+/* SBC frames in one media packet, the count of the media payload header has 4 bits */
+#define BTC_MEDIA_AA_MAX_SBC_FRAMES            (15)
+#define BTC_MEDIA_AA_SBC_FRAME_SAMPLES         (SBC_MAX_NUM_OF_BLOCKS * SBC_MAX_NUM_OF_CHANNELS * SBC_MAX_NUM_OF_SUBBANDS)
+
 #if (BTA_AV_CO_CP_SCMS_T == TRUE)
 #define BTC_MEDIA_AA_SBC_OFFSET (AVDT_MEDIA_OFFSET + BTA_AV_SBC_HDR_SIZE + 1)
 #else
@@ -126,6 +132,42 @@ enum {
 #define MAX_OUTPUT_A2DP_FRAME_QUEUE_SZ         (5)
 #define MAX_OUTPUT_A2DP_SRC_FRAME_QUEUE_SZ     (27) // 18 for 20ms tick
 
+/*
+ * SBC BITPOOL ADAPTATION ::
+ *
+ * Each media tick the packets waiting in the TX queue, in BTA and in L2CAP
+ * are counted. The link is congested from BTC_A2DP_SRC_RC_CONG_PKTS packets
+ * on, or when the controller has no ACL buffer left while more than
+ * BTC_A2DP_SRC_RC_CLEAR_PKTS packets wait, and clear at or below
+ * BTC_A2DP_SRC_RC_CLEAR_PKTS. In between neither count moves.
+ * The bitpool steps down after BTC_A2DP_SRC_RC_DOWN_TICKS congested ticks
+ * in a row (60 ms) and up again after BTC_A2DP_SRC_RC_UP_TICKS clear ticks
+ * in a row (3 s), so it settles quickly and recovers slowly.
+ */
+#ifndef BTC_A2DP_SRC_RC_CONG_PKTS
+#define BTC_A2DP_SRC_RC_CONG_PKTS              (4)
+#endif
+
+#ifndef BTC_A2DP_SRC_RC_CLEAR_PKTS
+#define BTC_A2DP_SRC_RC_CLEAR_PKTS             (1)
+#endif
+
+#ifndef BTC_A2DP_SRC_RC_DOWN_TICKS
+#define BTC_A2DP_SRC_RC_DOWN_TICKS             (2)
+#endif
+
+#ifndef BTC_A2DP_SRC_RC_UP_TICKS
+#define BTC_A2DP_SRC_RC_UP_TICKS               (100)
+#endif
+
+#ifndef BTC_A2DP_SRC_RC_BITPOOL_DOWN_STEP
+#define BTC_A2DP_SRC_RC_BITPOOL_DOWN_STEP      (6)
+#endif
+
+#ifndef BTC_A2DP_SRC_RC_BITPOOL_UP_STEP
+#define BTC_A2DP_SRC_RC_BITPOOL_UP_STEP        (2)
+#endif
+
 typedef struct {
     uint32_t sig;
     void *param;
@@ -150,6 +192,24 @@ typedef union {
     tBTC_AV_MEDIA_FEEDINGS_PCM_STATE pcm;
 } tBTC_AV_MEDIA_FEEDINGS_STATE;
 
+#if (BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE)
+typedef struct {
+    SINT16 max_bitpool;     /* bitpool selected for the stream, 0 until it is known */
+    SINT16 min_bitpool;     /* lowest bitpool the adaptation steps down to */
+    UINT8  peer_min_bitpool; /* minimum bitpool of the peer */
+    UINT16 congested_ticks; /* congested media ticks in a row */
+    UINT16 clear_ticks;     /* clear media ticks in a row */
+} tBTC_A2DP_SOURCE_RATE_CTRL;
+#endif /* BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE */
+
+typedef struct {
+    UINT32 congested_ticks;
+    UINT32 bitpool_decreases;
+    UINT32 bitpool_increases;
+    UINT32 dropped_pkts;
+    UINT32 flushed_pkts;
+} tBTC_A2DP_SOURCE_TX_STATS;
+
 typedef struct {
     UINT8 TxTranscoding;
     BOOLEAN tx_flush; /* discards any outgoing data when true */
@@ -161,7 +221,13 @@ typedef struct {
     tBTC_AV_MEDIA_FEEDINGS_STATE media_feeding_state;
     tBTC_AV_MEDIA_FEEDINGS media_feeding;
     SBC_ENC_PARAMS encoder;
+    SINT16 *pcm_frames; /* PCM of the SBC frames of one media packet */
+    const tA2DP_ENCODER_INTERFACE *encoder_interface; /* NULL for SBC */
     osi_alarm_t *media_alarm;
+#if (BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE)
+    tBTC_A2DP_SOURCE_RATE_CTRL rate_ctrl;
+#endif
+    tBTC_A2DP_SOURCE_TX_STATS tx_stats;
 } tBTC_A2DP_SOURCE_CB;
 
 typedef struct {
@@ -185,6 +251,10 @@ static void btc_a2dp_source_aa_tx_flush(void);
 static void btc_a2dp_source_prep_2_send(UINT8 nb_frame);
 static void btc_a2dp_source_handle_timer(UNUSED_ATTR void *context);
 static void btc_a2dp_source_encoder_init(void);
+#if (BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE)
+static void btc_a2dp_source_rate_ctrl_reset(void);
+static void btc_a2dp_source_rate_ctrl(void);
+#endif
 
 static int btc_a2dp_source_state = BTC_A2DP_SOURCE_STATE_OFF;
 static esp_a2d_source_data_cb_t btc_aa_src_data_cb = NULL;
@@ -211,6 +281,29 @@ static inline uint32_t btc_aa_src_data_read(uint8_t *data, int32_t len)
     }
 }
 
+static uint32_t btc_a2dp_source_read_pcm(uint8_t *data, uint32_t len)
+{
+    return btc_aa_src_data_read(data, (int32_t)len);
+}
+
+static bool btc_a2dp_source_enqueue(BT_HDR *p_buf, size_t frames_n)
+{
+    if (a2dp_source_local_param.btc_aa_src_cb.tx_flush) {
+        APPL_TRACE_DEBUG("### tx suspended, discarded frame ###");
+        osi_free(p_buf);
+        return false;
+    }
+
+    while (fixed_queue_length(a2dp_source_local_param.btc_aa_src_cb.TxAaQ) >= MAX_OUTPUT_A2DP_SRC_FRAME_QUEUE_SZ) {
+        APPL_TRACE_WARNING("TX Q overflow, dropping the oldest packet");
+        osi_free(fixed_queue_dequeue(a2dp_source_local_param.btc_aa_src_cb.TxAaQ, 0));
+        a2dp_source_local_param.btc_aa_src_cb.tx_stats.dropped_pkts++;
+    }
+
+    fixed_queue_enqueue(a2dp_source_local_param.btc_aa_src_cb.TxAaQ, p_buf, FIXED_QUEUE_MAX_TIMEOUT);
+    return true;
+}
+
 /*****************************************************************************
  **  Misc helper functions
  *****************************************************************************/
@@ -423,6 +516,42 @@ void btc_a2dp_source_set_tx_flush(BOOLEAN enable)
     a2dp_source_local_param.btc_aa_src_cb.tx_flush = enable;
 }
 
+/*******************************************************************************
+ **
+ ** Function         btc_a2dp_source_get_stats
+ **
+ ** Description      Get the bitpool adaptation and TX queue statistics
+ **
+ ** Returns          TRUE if the source is running
+ **
+ *******************************************************************************/
+BOOLEAN btc_a2dp_source_get_stats(esp_a2d_source_stats_t *p_stats)
+{
+    if (btc_a2dp_source_state != BTC_A2DP_SOURCE_STATE_ON) {
+        return FALSE;
+    }
+
+    tBTC_A2DP_SOURCE_CB *p_cb = &a2dp_source_local_param.btc_aa_src_cb;
+
+    if (p_cb->TxTranscoding == BTC_MEDIA_TRSCD_PCM_2_SBC) {
+        p_stats->bitpool = p_cb->encoder.s16BitPool;
+#if (BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE)
+        p_stats->max_bitpool = p_cb->rate_ctrl.max_bitpool;
+#else
+        p_stats->max_bitpool = p_cb->encoder.s16BitPool;
+#endif
+    } else {
+        p_stats->bitpool = 0;
+        p_stats->max_bitpool = 0;
+    }
+    p_stats->congested_ticks = p_cb->tx_stats.congested_ticks;
+    p_stats->bitpool_decreases = p_cb->tx_stats.bitpool_decreases;
+    p_stats->bitpool_increases = p_cb->tx_stats.bitpool_increases;
+    p_stats->dropped_pkts = p_cb->tx_stats.dropped_pkts;
+    p_stats->flushed_pkts = p_cb->tx_stats.flushed_pkts;
+    return TRUE;
+}
+
 /*****************************************************************************
 **
 ** Function        btc_a2dp_source_setup_codec
@@ -666,6 +795,12 @@ static void btc_a2dp_source_encoder_init(void)
     msg.SamplingFreq = freq_block_tbl[sbc_config.samp_freq >> 5];
     msg.MtuSize = minmtu;
 
+    /* A vendor codec in use is encoded through its encoder interface */
+    bta_av_co_audio_get_codec_config(msg.codec_info, &minmtu);
+    if (A2DP_GetCodecType(msg.codec_info) != A2D_MEDIA_CT_SBC) {
+        msg.MtuSize = minmtu;
+    }
+
     APPL_TRACE_EVENT("msg.ChannelMode %x", msg.ChannelMode);
 
     /* Init the media task to encode SBC properly */
@@ -741,6 +876,27 @@ static void btc_a2dp_source_enc_init(BT_HDR *p_msg)
 
     a2dp_source_local_param.btc_aa_src_cb.timestamp = 0;
 
+    if (a2dp_source_local_param.btc_aa_src_cb.encoder_interface != NULL) {
+        a2dp_source_local_param.btc_aa_src_cb.encoder_interface->encoder_cleanup();
+        a2dp_source_local_param.btc_aa_src_cb.encoder_interface = NULL;
+    }
+
+    if (A2DP_GetCodecType(pInitAudio->codec_info) != A2D_MEDIA_CT_SBC) {
+        const tA2DP_ENCODER_INTERFACE *encoder_interface = A2DP_GetEncoderInterface(pInitAudio->codec_info);
+        if (encoder_interface == NULL ||
+                !encoder_interface->encoder_init(pInitAudio->codec_info, pInitAudio->MtuSize,
+                                                 btc_a2dp_source_read_pcm, btc_a2dp_source_enqueue)) {
+            APPL_TRACE_ERROR("%s no encoder for codec %s", __func__, A2DP_CodecName(pInitAudio->codec_info));
+            a2dp_source_local_param.btc_aa_src_cb.TxTranscoding = BTC_MEDIA_TRSCD_OFF;
+            return;
+        }
+        a2dp_source_local_param.btc_aa_src_cb.encoder_interface = encoder_interface;
+        a2dp_source_local_param.btc_aa_src_cb.TxTranscoding = BTC_MEDIA_TRSCD_PCM_2_VENDOR;
+        APPL_TRACE_EVENT("btc_a2dp_source_enc_init %s, peer mtu %d",
+                         A2DP_CodecName(pInitAudio->codec_info), pInitAudio->MtuSize);
+        return;
+    }
+
     /* SBC encoder config (enforced even if not used) */
     a2dp_source_local_param.btc_aa_src_cb.encoder.sbc_mode = SBC_MODE_STD;
     a2dp_source_local_param.btc_aa_src_cb.encoder.s16ChannelMode = pInitAudio->ChannelMode;
@@ -794,6 +950,11 @@ static void btc_a2dp_source_enc_update(BT_HDR *p_msg)
     APPL_TRACE_DEBUG("%s : minmtu %d, maxbp %d minbp %d", __FUNCTION__,
                      pUpdateAudio->MinMtuSize, pUpdateAudio->MaxBitPool, pUpdateAudio->MinBitPool);
 
+    /* The bitpool only applies to SBC */
+    if (a2dp_source_local_param.btc_aa_src_cb.encoder_interface != NULL) {
+        return;
+    }
+
     /* Only update the bitrate and MTU size while timer is running to make sure it has been initialized */
     //if (a2dp_source_local_param.btc_aa_src_cb.is_tx_timer)
     {
@@ -909,6 +1070,12 @@ static void btc_a2dp_source_enc_update(BT_HDR *p_msg)
 
         /* make sure we reinitialize encoder with new settings */
         SBC_Encoder_Init(&(a2dp_source_local_param.btc_aa_src_cb.encoder));
+
+#if (BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE)
+        a2dp_source_local_param.btc_aa_src_cb.rate_ctrl.peer_min_bitpool = pUpdateAudio->MinBitPool;
+        a2dp_source_local_param.btc_aa_src_cb.rate_ctrl.max_bitpool = 0;
+        btc_a2dp_source_rate_ctrl_reset();
+#endif
     }
 }
 
@@ -979,6 +1146,10 @@ static void btc_a2dp_source_pcm2sbc_init(tBTC_MEDIA_INIT_AUDIO_FEEDING *p_feedin
                          a2dp_source_local_param.btc_aa_src_cb.encoder.s16SamplingFreq);
 
         SBC_Encoder_Init(&(a2dp_source_local_param.btc_aa_src_cb.encoder));
+#if (BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE)
+        a2dp_source_local_param.btc_aa_src_cb.rate_ctrl.max_bitpool = 0;
+        btc_a2dp_source_rate_ctrl_reset();
+#endif
     } else {
         APPL_TRACE_DEBUG("%s no SBC reconfig needed", __FUNCTION__);
     }
@@ -1006,6 +1177,10 @@ static void btc_a2dp_source_audio_feeding_init(BT_HDR *p_msg)
     /* Handle different feeding formats */
     switch (p_feeding->feeding.format) {
     case BTC_AV_CODEC_PCM:
+        if (a2dp_source_local_param.btc_aa_src_cb.encoder_interface != NULL) {
+            a2dp_source_local_param.btc_aa_src_cb.TxTranscoding = BTC_MEDIA_TRSCD_PCM_2_VENDOR;
+            break;
+        }
         a2dp_source_local_param.btc_aa_src_cb.TxTranscoding = BTC_MEDIA_TRSCD_PCM_2_SBC;
         btc_a2dp_source_pcm2sbc_init(p_feeding);
         break;
@@ -1033,6 +1208,12 @@ static void btc_a2dp_source_aa_tx_flush(void)
     a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.counter = 0;
     a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.aa_feed_residue = 0;
 
+    if (a2dp_source_local_param.btc_aa_src_cb.encoder_interface != NULL) {
+        a2dp_source_local_param.btc_aa_src_cb.encoder_interface->feeding_flush();
+    }
+
+    a2dp_source_local_param.btc_aa_src_cb.tx_stats.flushed_pkts +=
+        fixed_queue_length(a2dp_source_local_param.btc_aa_src_cb.TxAaQ);
     btc_a2dp_source_flush_q(a2dp_source_local_param.btc_aa_src_cb.TxAaQ);
 
     btc_aa_src_data_read(NULL, -1);
@@ -1108,13 +1289,13 @@ static UINT8 btc_get_num_aa_frame(void)
  **
  ** Function         btc_media_aa_read_feeding
  **
- ** Description
+ ** Description      Reads the PCM of one SBC frame into pcm, upsampled if needed
  **
- ** Returns          void
+ ** Returns          TRUE if a whole frame was read
  **
  *******************************************************************************/
 
-BOOLEAN btc_media_aa_read_feeding(void)
+static BOOLEAN btc_media_aa_read_feeding(SINT16 *pcm)
 {
     UINT16 blocm_x_subband = a2dp_source_local_param.btc_aa_src_cb.encoder.s16NumOfSubBands * \
                              a2dp_source_local_param.btc_aa_src_cb.encoder.s16NumOfBlocks;
@@ -1151,9 +1332,12 @@ BOOLEAN btc_media_aa_read_feeding(void)
     }
 
     if (sbc_sampling == a2dp_source_local_param.btc_aa_src_cb.media_feeding.cfg.pcm.sampling_freq) {
+        /* the start of a frame cut short by an underflow waits in the encoder's PCM buffer */
+        memcpy((UINT8 *)pcm, (UINT8 *)a2dp_source_local_param.btc_aa_src_cb.encoder.as16PcmBuffer,
+               a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.aa_feed_residue);
         read_size = bytes_needed - a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.aa_feed_residue;
         nb_byte_read = btc_aa_src_data_read(
-                           ((uint8_t *)a2dp_source_local_param.btc_aa_src_cb.encoder.as16PcmBuffer) +
+                           ((uint8_t *)pcm) +
                            a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.aa_feed_residue,
                            read_size);
         if (nb_byte_read == read_size) {
@@ -1163,6 +1347,8 @@ BOOLEAN btc_media_aa_read_feeding(void)
             APPL_TRACE_WARNING("### UNDERFLOW :: ONLY READ %d BYTES OUT OF %d ###",
                                nb_byte_read, read_size);
             a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.aa_feed_residue += nb_byte_read;
+            memcpy((UINT8 *)a2dp_source_local_param.btc_aa_src_cb.encoder.as16PcmBuffer, (UINT8 *)pcm,
+                   a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.aa_feed_residue);
             return FALSE;
         }
     }
@@ -1245,9 +1431,7 @@ BOOLEAN btc_media_aa_read_feeding(void)
     /* only copy the pcm sample when we have up-sampled enough PCM */
     if (a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.aa_feed_residue >= bytes_needed) {
         /* Copy the output pcm samples in SBC encoding buffer */
-        memcpy((UINT8 *)a2dp_source_local_param.btc_aa_src_cb.encoder.as16PcmBuffer,
-               (UINT8 *)up_sampled_buffer,
-               bytes_needed);
+        memcpy((UINT8 *)pcm, (UINT8 *)up_sampled_buffer, bytes_needed);
         /* update the residue */
         a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.aa_feed_residue -= bytes_needed;
 
@@ -1262,11 +1446,39 @@ BOOLEAN btc_media_aa_read_feeding(void)
     return FALSE;
 }
 
+/*******************************************************************************
+ **
+ ** Function         btc_media_aa_sbc_frame_len
+ **
+ ** Description      Length of the SBC frames the encoder makes with its
+ **                  current settings, see the A2DP specification
+ **
+ ** Returns          length in bytes
+ **
+ *******************************************************************************/
+static UINT16 btc_media_aa_sbc_frame_len(const SBC_ENC_PARAMS *p_enc)
+{
+    /* scale factors */
+    UINT32 bits = 4 * p_enc->s16NumOfSubBands * p_enc->s16NumOfChannels;
+
+    if (p_enc->s16ChannelMode == SBC_MONO || p_enc->s16ChannelMode == SBC_DUAL) {
+        bits += p_enc->s16NumOfBlocks * p_enc->s16NumOfChannels * p_enc->s16BitPool;
+    } else {
+        bits += p_enc->s16NumOfBlocks * p_enc->s16BitPool;
+        if (p_enc->s16ChannelMode == SBC_JOINT_STEREO) {
+            bits += p_enc->s16NumOfSubBands;
+        }
+    }
+    /* header and CRC */
+    return 4 + (bits + 7) / 8;
+}
+
 /*******************************************************************************
  **
  ** Function         btc_media_aa_prep_sbc_2_send
  **
- ** Description
+ ** Description      Reads the PCM of as many frames as fit in a media packet
+ **                  and encodes them with one SBC_Encoder_Batch call
  **
  ** Returns          void
  **
@@ -1274,8 +1486,18 @@ BOOLEAN btc_media_aa_read_feeding(void)
 static void btc_media_aa_prep_sbc_2_send(UINT8 nb_frame)
 {
     BT_HDR *p_buf;
-    UINT16 blocm_x_subband = a2dp_source_local_param.btc_aa_src_cb.encoder.s16NumOfSubBands *
-                             a2dp_source_local_param.btc_aa_src_cb.encoder.s16NumOfBlocks;
+    SBC_ENC_PARAMS *p_enc = &a2dp_source_local_param.btc_aa_src_cb.encoder;
+    SINT16 *pcm_frames = a2dp_source_local_param.btc_aa_src_cb.pcm_frames;
+    UINT16 blocm_x_subband = p_enc->s16NumOfSubBands * p_enc->s16NumOfBlocks;
+    UINT16 frame_samples = blocm_x_subband * p_enc->s16NumOfChannels;
+    UINT16 frame_len;
+    UINT16 max_frames;
+    UINT8 nb_read;
+    BOOLEAN underflow = FALSE;
+
+    if (pcm_frames == NULL) {
+        return;
+    }
 
     while (nb_frame) {
         if (NULL == (p_buf = osi_malloc(BTC_MEDIA_AA_BUF_SIZE))) {
@@ -1289,42 +1511,50 @@ static void btc_media_aa_prep_sbc_2_send(UINT8 nb_frame)
         p_buf->len = 0;
         p_buf->layer_specific = 0;
 
-        do {
-            /* Write @ of allocated buffer in encoder.pu8Packet */
-            a2dp_source_local_param.btc_aa_src_cb.encoder.pu8Packet = (UINT8 *) (p_buf + 1) + p_buf->offset + p_buf->len;
-            /* Fill allocated buffer with 0 */
-            memset(a2dp_source_local_param.btc_aa_src_cb.encoder.as16PcmBuffer, 0, blocm_x_subband
-                   * a2dp_source_local_param.btc_aa_src_cb.encoder.s16NumOfChannels);
+        /* As many frames as the MTU takes, at least one. The bitpool may have changed since the last packet */
+        frame_len = btc_media_aa_sbc_frame_len(p_enc);
+        max_frames = (a2dp_source_local_param.btc_aa_src_cb.TxAaMtuSize - 1) / frame_len;
+        if (max_frames > BTC_MEDIA_AA_MAX_SBC_FRAMES) {
+            max_frames = BTC_MEDIA_AA_MAX_SBC_FRAMES;
+        }
+        if (max_frames > nb_frame) {
+            max_frames = nb_frame;
+        }
+        if (max_frames == 0) {
+            max_frames = 1;
+        }
 
+        for (nb_read = 0; nb_read < max_frames; nb_read++) {
+            SINT16 *pcm = pcm_frames + nb_read * frame_samples;
+
+            memset(pcm, 0, frame_samples * sizeof(SINT16));
             /* Read PCM data and upsample them if needed */
-            if (btc_media_aa_read_feeding()) {
-                /* SBC encode and descramble frame */
-                SBC_Encoder(&(a2dp_source_local_param.btc_aa_src_cb.encoder));
-
-                /* Update SBC frame length */
-                p_buf->len += a2dp_source_local_param.btc_aa_src_cb.encoder.u16PacketLength;
-                nb_frame--;
-                p_buf->layer_specific++;
-            } else {
+            if (!btc_media_aa_read_feeding(pcm)) {
                 APPL_TRACE_WARNING("btc_media_aa_prep_sbc_2_send underflow %d, %d",
-                                   nb_frame, a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.aa_feed_residue);
-                a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.counter += nb_frame *
-                        a2dp_source_local_param.btc_aa_src_cb.encoder.s16NumOfSubBands *
-                        a2dp_source_local_param.btc_aa_src_cb.encoder.s16NumOfBlocks *
+                                   nb_frame - nb_read, a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.aa_feed_residue);
+                a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.counter += (nb_frame - nb_read) *
+                        p_enc->s16NumOfSubBands *
+                        p_enc->s16NumOfBlocks *
                         a2dp_source_local_param.btc_aa_src_cb.media_feeding.cfg.pcm.num_channel *
                         a2dp_source_local_param.btc_aa_src_cb.media_feeding.cfg.pcm.bit_per_sample / 8;
-                /* no more pcm to read */
-                nb_frame = 0;
-
-                /* break read loop if timer was stopped (media task stopped) */
-                if ( a2dp_source_local_param.btc_aa_src_cb.is_tx_timer == FALSE ) {
-                    osi_free(p_buf);
-                    return;
-                }
+                underflow = TRUE;
+                break;
             }
+        }
+
+        /* break read loop if timer was stopped (media task stopped) */
+        if (underflow && a2dp_source_local_param.btc_aa_src_cb.is_tx_timer == FALSE) {
+            osi_free(p_buf);
+            return;
+        }
 
-        } while (((p_buf->len + a2dp_source_local_param.btc_aa_src_cb.encoder.u16PacketLength) < a2dp_source_local_param.btc_aa_src_cb.TxAaMtuSize)
-                 && (p_buf->layer_specific < 0x0F) && nb_frame);
+        if (nb_read) {
+            /* SBC encode the frames of the packet */
+            p_buf->len = SBC_Encoder_Batch(p_enc, pcm_frames, (UINT8 *)(p_buf + 1) + p_buf->offset, nb_read);
+            p_buf->layer_specific = nb_read;
+        }
+        /* no more pcm to read after an underflow */
+        nb_frame = underflow ? 0 : nb_frame - nb_read;
 
         if (p_buf->len) {
             /* timestamp of the media packet header represent the TS of the first SBC frame
@@ -1352,6 +1582,102 @@ static void btc_media_aa_prep_sbc_2_send(UINT8 nb_frame)
     }
 }
 
+#if (BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE)
+/*******************************************************************************
+ **
+ ** Function         btc_a2dp_source_rate_ctrl_reset
+ **
+ ** Description      Go back to the SBC bitpool selected for the stream, or
+ **                  take the current one as selected if none is known yet.
+ **                  The adaptation only moves below it.
+ **
+ ** Returns          void
+ **
+ *******************************************************************************/
+static void btc_a2dp_source_rate_ctrl_reset(void)
+{
+    tBTC_A2DP_SOURCE_RATE_CTRL *p_rc = &a2dp_source_local_param.btc_aa_src_cb.rate_ctrl;
+    SBC_ENC_PARAMS *p_enc = &a2dp_source_local_param.btc_aa_src_cb.encoder;
+
+    if (p_rc->max_bitpool != 0) {
+        /* same stream configuration, drop what was adapted */
+        p_enc->s16BitPool = p_rc->max_bitpool;
+    }
+    p_rc->max_bitpool = p_enc->s16BitPool;
+
+    /* never below half of the selected bitpool, whatever the peer accepts */
+    p_rc->min_bitpool = p_rc->max_bitpool / 2;
+    if (p_rc->min_bitpool < p_rc->peer_min_bitpool) {
+        p_rc->min_bitpool = p_rc->peer_min_bitpool;
+    }
+    p_rc->congested_ticks = 0;
+    p_rc->clear_ticks = 0;
+}
+
+/*******************************************************************************
+ **
+ ** Function         btc_a2dp_source_rate_ctrl
+ **
+ ** Description      Step the SBC bitpool down while the link is congested and
+ **                  back up once it has been clear for a while. Called once a
+ **                  media tick, before the packets of the tick are built, so a
+ **                  new bitpool always starts with a new media packet. The
+ **                  bitpool is written in every SBC frame header, the encoder
+ **                  needs no reset and the sink follows it frame by frame.
+ **
+ ** Returns          void
+ **
+ *******************************************************************************/
+static void btc_a2dp_source_rate_ctrl(void)
+{
+    tBTC_A2DP_SOURCE_RATE_CTRL *p_rc = &a2dp_source_local_param.btc_aa_src_cb.rate_ctrl;
+    tBTC_A2DP_SOURCE_TX_STATS *p_stats = &a2dp_source_local_param.btc_aa_src_cb.tx_stats;
+    SBC_ENC_PARAMS *p_enc = &a2dp_source_local_param.btc_aa_src_cb.encoder;
+    UINT16 acl_bufs;
+    UINT16 acl_credits;
+    UINT16 queued;
+    SINT16 bitpool;
+
+    if (p_rc->max_bitpool == 0) {
+        return;
+    }
+
+    acl_credits = L2CA_GetAclTxCredits(&acl_bufs);
+    queued = fixed_queue_length(a2dp_source_local_param.btc_aa_src_cb.TxAaQ) + btc_av_get_tx_queue_len();
+
+    if (queued >= BTC_A2DP_SRC_RC_CONG_PKTS ||
+            (acl_bufs != 0 && acl_credits == 0 && queued > BTC_A2DP_SRC_RC_CLEAR_PKTS)) {
+        p_stats->congested_ticks++;
+        p_rc->clear_ticks = 0;
+        if (++p_rc->congested_ticks < BTC_A2DP_SRC_RC_DOWN_TICKS) {
+            return;
+        }
+        p_rc->congested_ticks = 0;
+        if (p_enc->s16BitPool <= p_rc->min_bitpool) {
+            return;
+        }
+        bitpool = p_enc->s16BitPool - BTC_A2DP_SRC_RC_BITPOOL_DOWN_STEP;
+        p_enc->s16BitPool = (bitpool < p_rc->min_bitpool) ? p_rc->min_bitpool : bitpool;
+        p_stats->bitpool_decreases++;
+        APPL_TRACE_EVENT("%s congested, %d packets queued, %d/%d ACL credits, bitpool %d",
+                         __func__, queued, acl_credits, acl_bufs, p_enc->s16BitPool);
+    } else if (queued <= BTC_A2DP_SRC_RC_CLEAR_PKTS) {
+        p_rc->congested_ticks = 0;
+        if (p_enc->s16BitPool >= p_rc->max_bitpool) {
+            return;
+        }
+        if (++p_rc->clear_ticks < BTC_A2DP_SRC_RC_UP_TICKS) {
+            return;
+        }
+        p_rc->clear_ticks = 0;
+        bitpool = p_enc->s16BitPool + BTC_A2DP_SRC_RC_BITPOOL_UP_STEP;
+        p_enc->s16BitPool = (bitpool > p_rc->max_bitpool) ? p_rc->max_bitpool : bitpool;
+        p_stats->bitpool_increases++;
+        APPL_TRACE_EVENT("%s link clear, bitpool %d", __func__, p_enc->s16BitPool);
+    }
+}
+#endif /* BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE */
+
 /*******************************************************************************
  **
  ** Function         btc_a2dp_source_prep_2_send
@@ -1375,6 +1701,7 @@ static void btc_a2dp_source_prep_2_send(UINT8 nb_frame)
 
     while (fixed_queue_length(a2dp_source_local_param.btc_aa_src_cb.TxAaQ) > (MAX_OUTPUT_A2DP_SRC_FRAME_QUEUE_SZ - nb_frame)) {
         osi_free(fixed_queue_dequeue(a2dp_source_local_param.btc_aa_src_cb.TxAaQ, 0));
+        a2dp_source_local_param.btc_aa_src_cb.tx_stats.dropped_pkts++;
     }
 
     // Transcode frame
@@ -1403,6 +1730,18 @@ static void btc_a2dp_source_send_aa_frame(void)
 {
     UINT8 nb_frame_2_send;
 
+    if (a2dp_source_local_param.btc_aa_src_cb.TxTranscoding == BTC_MEDIA_TRSCD_PCM_2_VENDOR) {
+        /* the encoder works out the PCM due itself */
+        a2dp_source_local_param.btc_aa_src_cb.encoder_interface->send_frames(time_now_us());
+        bta_av_ci_src_data_ready(BTA_AV_CHNL_AUDIO);
+        return;
+    }
+
+#if (BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE)
+    /* adapt the bitpool before the packets of this tick are built */
+    btc_a2dp_source_rate_ctrl();
+#endif
+
     /* get the number of frame to send */
     nb_frame_2_send = btc_get_num_aa_frame();
 
@@ -1456,6 +1795,8 @@ static void btc_a2dp_source_feeding_state_reset(void)
 
         APPL_TRACE_EVENT("pcm bytes per tick %d",
                            (int)a2dp_source_local_param.btc_aa_src_cb.media_feeding_state.pcm.bytes_per_tick);
+    } else if (a2dp_source_local_param.btc_aa_src_cb.TxTranscoding == BTC_MEDIA_TRSCD_PCM_2_VENDOR) {
+        a2dp_source_local_param.btc_aa_src_cb.encoder_interface->feeding_reset();
     }
 }
 
@@ -1532,6 +1873,11 @@ static void btc_a2dp_source_aa_start_tx(void)
     a2dp_source_local_param.btc_aa_src_cb.is_tx_timer = TRUE;
     a2dp_source_local_param.last_frame_us = 0;
 
+#if (BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED == TRUE)
+    /* every stream starts at the bitpool selected for it */
+    btc_a2dp_source_rate_ctrl_reset();
+#endif
+
     /* Reset the media feeding state */
     btc_a2dp_source_feeding_state_reset();
 
@@ -1572,7 +1918,12 @@ static void btc_a2dp_source_thread_init(UNUSED_ATTR void *context)
 
     btc_a2dp_source_state = BTC_A2DP_SOURCE_STATE_ON;
 
-    a2dp_source_local_param.btc_aa_src_cb.TxAaQ = fixed_queue_new(QUEUE_SIZE_MAX);
+    a2dp_source_local_param.btc_aa_src_cb.TxAaQ = fixed_queue_new_lockfree(QUEUE_SIZE_MAX);
+    a2dp_source_local_param.btc_aa_src_cb.pcm_frames = osi_malloc(BTC_MEDIA_AA_MAX_SBC_FRAMES *
+                                                                  BTC_MEDIA_AA_SBC_FRAME_SAMPLES * sizeof(SINT16));
+    if (a2dp_source_local_param.btc_aa_src_cb.pcm_frames == NULL) {
+        APPL_TRACE_ERROR("%s no memory for the SBC frames of a packet", __func__);
+    }
 
     btc_a2dp_control_init();
 }
@@ -1584,9 +1935,17 @@ static void btc_a2dp_source_thread_cleanup(UNUSED_ATTR void *context)
 
     btc_a2dp_control_cleanup();
 
+    if (a2dp_source_local_param.btc_aa_src_cb.encoder_interface != NULL) {
+        a2dp_source_local_param.btc_aa_src_cb.encoder_interface->encoder_cleanup();
+        a2dp_source_local_param.btc_aa_src_cb.encoder_interface = NULL;
+    }
+
     fixed_queue_free(a2dp_source_local_param.btc_aa_src_cb.TxAaQ, osi_free_func);
 
     a2dp_source_local_param.btc_aa_src_cb.TxAaQ = NULL;
+
+    osi_free(a2dp_source_local_param.btc_aa_src_cb.pcm_frames);
+    a2dp_source_local_param.btc_aa_src_cb.pcm_frames = NULL;
 }
 
 #endif /* BTC_AV_INCLUDED */
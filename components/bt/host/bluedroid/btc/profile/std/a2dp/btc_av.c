@@ -413,7 +413,9 @@ static BOOLEAN btc_av_state_idle_handler(btc_sm_event_t event, void *p_data)
         if (btc_av_cb.peer_sep == AVDT_TSEP_SRC) {
             esp_a2d_cb_param_t param;
             memcpy(param.audio_cfg.remote_bda, &btc_av_cb.peer_bda, sizeof(esp_bd_addr_t));
-            memcpy(&param.audio_cfg.mcc, p_data, sizeof(esp_a2d_mcc_t));
+            memcpy(&param.audio_cfg.mcc, &((btc_av_args_t *)p_data)->sink_cfg.mcc, sizeof(esp_a2d_mcc_t));
+            param.audio_cfg.pcm_fmt = ((btc_av_args_t *)p_data)->sink_cfg.pcm_fmt;
+            param.audio_cfg.pcm_rate = ((btc_av_args_t *)p_data)->sink_cfg.pcm_rate;
             btc_a2d_cb_to_app(ESP_A2D_AUDIO_CFG_EVT, &param);
         }
     } break;
@@ -503,7 +505,9 @@ static BOOLEAN btc_av_state_opening_handler(btc_sm_event_t event, void *p_data)
         if (btc_av_cb.peer_sep == AVDT_TSEP_SRC) {
             esp_a2d_cb_param_t param;
             memcpy(param.audio_cfg.remote_bda, &btc_av_cb.peer_bda, sizeof(esp_bd_addr_t));
-            memcpy(&param.audio_cfg.mcc, p_data, sizeof(esp_a2d_mcc_t));
+            memcpy(&param.audio_cfg.mcc, &((btc_av_args_t *)p_data)->sink_cfg.mcc, sizeof(esp_a2d_mcc_t));
+            param.audio_cfg.pcm_fmt = ((btc_av_args_t *)p_data)->sink_cfg.pcm_fmt;
+            param.audio_cfg.pcm_rate = ((btc_av_args_t *)p_data)->sink_cfg.pcm_rate;
             btc_a2d_cb_to_app(ESP_A2D_AUDIO_CFG_EVT, &param);
         }
     } break;
@@ -770,7 +774,9 @@ static BOOLEAN btc_av_state_opened_handler(btc_sm_event_t event, void *p_data)
         if (btc_av_cb.peer_sep == AVDT_TSEP_SRC) {
             esp_a2d_cb_param_t param;
             memcpy(param.audio_cfg.remote_bda, &btc_av_cb.peer_bda, sizeof(esp_bd_addr_t));
-            memcpy(&param.audio_cfg.mcc, p_data, sizeof(esp_a2d_mcc_t));
+            memcpy(&param.audio_cfg.mcc, &((btc_av_args_t *)p_data)->sink_cfg.mcc, sizeof(esp_a2d_mcc_t));
+            param.audio_cfg.pcm_fmt = ((btc_av_args_t *)p_data)->sink_cfg.pcm_fmt;
+            param.audio_cfg.pcm_rate = ((btc_av_args_t *)p_data)->sink_cfg.pcm_rate;
             btc_a2d_cb_to_app(ESP_A2D_AUDIO_CFG_EVT, &param);
         }
     } break;
@@ -1335,16 +1341,18 @@ static void bte_av_media_callback(tBTA_AV_EVT event, tBTA_AV_MEDIA *p_data)
         state = btc_sm_get_state(btc_av_cb.sm_handle);
         if ( (state == BTC_AV_STATE_STARTED) || /* send SBC packets only in Started State */
                 (state == BTC_AV_STATE_OPENED) ) {
+            /* the sink queue takes ownership of the packet */
             que_len = btc_a2dp_sink_enque_buf((BT_HDR *)p_data);
             BTC_TRACE_DEBUG(" Packets in Que %d\n", que_len);
         } else {
-            return;
+            osi_free(p_data);
         }
+        return;
     }
 
     if (event == BTA_AV_MEDIA_SINK_CFG_EVT) {
         /* send a command to BT Media Task */
-        btc_a2dp_sink_reset_decoder(p_data->codec_info);
+        esp_a2d_pcm_fmt_t pcm_fmt = btc_a2dp_sink_reset_decoder(p_data->codec_info);
 
 
         if (A2DP_IsPeerSourceCodecSupported(p_data->codec_info)) {
@@ -1355,8 +1363,12 @@ static void bte_av_media_callback(tBTA_AV_EVT event, tBTA_AV_MEDIA *p_data)
             msg.pid = BTC_PID_A2DP;
             msg.act = BTC_AV_SINK_CONFIG_REQ_EVT;
 
-            memset(&arg.mcc, 0, sizeof(esp_a2d_mcc_t));
-            arg.mcc.type = A2DP_GetCodecType(p_data->codec_info);
+            memset(&arg.sink_cfg, 0, sizeof(arg.sink_cfg));
+            arg.sink_cfg.mcc.type = A2DP_GetCodecType(p_data->codec_info);
+            arg.sink_cfg.pcm_fmt = pcm_fmt;
+#if (BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE)
+            arg.sink_cfg.pcm_rate = BTC_A2DP_SINK_RESAMPLE_RATE;
+#endif /* BTC_A2DP_SINK_RESAMPLE_INCLUDED == TRUE */
 
             /*
              * codec_info is valid here. The first byte is the size of the array.
@@ -1366,7 +1378,7 @@ static void bte_av_media_callback(tBTA_AV_EVT event, tBTA_AV_MEDIA *p_data)
             size_t len = (p_data->codec_info[0] + 1) - AVDT_CODEC_HEADER_SIZE;
             len = len < (AVDT_CODEC_SIZE - AVDT_CODEC_HEADER_SIZE) ?
                   len : (AVDT_CODEC_SIZE - AVDT_CODEC_HEADER_SIZE);
-            memcpy(&arg.mcc.cie, p_data->codec_info + AVDT_CODEC_HEADER_SIZE, len);
+            memcpy(&arg.sink_cfg.mcc.cie, p_data->codec_info + AVDT_CODEC_HEADER_SIZE, len);
 
             btc_transfer_context(&msg, &arg, sizeof(btc_av_args_t), NULL);
         } else {
@@ -1396,6 +1408,13 @@ static void bte_av_media_callback(tBTA_AV_EVT event, tBTA_AV_MEDIA *p_data)
 *******************************************************************************/
 bt_status_t btc_av_execute_service(BOOLEAN b_enable, UINT8 tsep)
 {
+    tBTA_AV_FEAT features = BTA_AV_FEAT_NO_SCO_SSPD;
+
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+    if (tsep == AVDT_TSEP_SNK) {
+        features |= BTA_AV_FEAT_DELAY_RPT;
+    }
+#endif
     if (b_enable) {
         /* TODO: Removed BTA_SEC_AUTHORIZE since the Java/App does not
          * handle this request in order to allow incoming connections to succeed.
@@ -1406,14 +1425,14 @@ bt_status_t btc_av_execute_service(BOOLEAN b_enable, UINT8 tsep)
          * be initiated by the app/audioflinger layers */
         if (g_av_with_rc) {
             BTC_TRACE_WARNING("A2DP Enable with AVRC")
-            BTA_AvEnable(BTA_SEC_AUTHENTICATE, BTA_AV_FEAT_NO_SCO_SSPD |
+            BTA_AvEnable(BTA_SEC_AUTHENTICATE, features |
                         BTA_AV_FEAT_RCTG | BTA_AV_FEAT_METADATA | BTA_AV_FEAT_VENDOR |
                         BTA_AV_FEAT_RCCT | BTA_AV_FEAT_ADV_CTRL,
                         bte_av_callback);
             BTA_AvRegister(BTA_AV_CHNL_AUDIO, BTC_AV_SERVICE_NAME, 0, bte_av_media_callback, &bta_av_a2d_cos, &bta_avrc_cos, tsep);
         } else {
             BTC_TRACE_WARNING("A2DP Enable without AVRC")
-            BTA_AvEnable(BTA_SEC_AUTHENTICATE, BTA_AV_FEAT_NO_SCO_SSPD, bte_av_callback);
+            BTA_AvEnable(BTA_SEC_AUTHENTICATE, features, bte_av_callback);
             BTA_AvRegister(BTA_AV_CHNL_AUDIO, BTC_AV_SERVICE_NAME, 0, bte_av_media_callback, &bta_av_a2d_cos, NULL, tsep);
         }
     } else {
@@ -1503,6 +1522,38 @@ uint8_t btc_av_get_peer_sep(void)
 {
     return btc_av_cb.peer_sep;
 }
+
+/*******************************************************************************
+ *
+ * Function         btc_av_sink_delay_report
+ *
+ * Description      Send the playout delay of the sink, in 1/10 ms, to the
+ *                  source.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+
+void btc_av_sink_delay_report(UINT16 delay)
+{
+    BTA_AvDelayReport(btc_av_cb.bta_handle, delay);
+}
+
+/*******************************************************************************
+ *
+ * Function         btc_av_get_tx_queue_len
+ *
+ * Description      Get the number of media packets of the stream that wait
+ *                  for transmission below BTC, in BTA and in L2CAP.
+ *
+ * Returns          Number of queued packets
+ *
+ ******************************************************************************/
+
+UINT16 btc_av_get_tx_queue_len(void)
+{
+    return BTA_AvGetTxQueueLen(btc_av_cb.bta_handle);
+}
 /*******************************************************************************
 **
 ** Function         btc_av_is_peer_edr
@@ -1575,6 +1626,16 @@ void btc_a2dp_call_handler(btc_msg_t *msg)
         btc_a2dp_sink_reg_data_cb(arg->data_cb);
         break;
     }
+    case BTC_AV_SINK_API_SET_PCM_FMT_EVT: {
+        btc_a2dp_sink_set_pcm_format(arg->pcm_fmt);
+        break;
+    }
+    case BTC_AV_SINK_API_SET_OUTPUT_LATENCY_EVT: {
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+        btc_a2dp_sink_set_output_latency(arg->output_latency);
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+        break;
+    }
 #endif /* BTC_AV_SINK_INCLUDED */
 #if BTC_AV_SRC_INCLUDED
     case BTC_AV_SRC_API_INIT_EVT: {
@@ -26,22 +26,22 @@
 enum {
     BTC_SV_AV_AA_SOURCE_MIN = 0,
     BTC_SV_AV_AA_SBC_INDEX = 0,
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
     BTC_SV_AV_AA_APTX_INDEX,
     BTC_SV_AV_AA_APTX_HD_INDEX,
     BTC_SV_AV_AA_APTX_LL_INDEX,
-#endif /* APTX_DEC_INCLUDED */
+#endif /* APTX_INCLUDED */
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
     BTC_SV_AV_AA_LDAC_INDEX,
 #endif /* LDAC_DEC_INCLUDED */
     BTC_SV_AV_AA_SOURCE_MAX,
     BTC_SV_AV_AA_SINK_MIN = BTC_SV_AV_AA_SOURCE_MAX,
     BTC_SV_AV_AA_SBC_SINK_INDEX = BTC_SV_AV_AA_SINK_MIN,
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
     BTC_SV_AV_AA_APTX_SINK_INDEX,
     BTC_SV_AV_AA_APTX_HD_SINK_INDEX,
     BTC_SV_AV_AA_APTX_LL_SINK_INDEX,
-#endif /* APTX_DEC_INCLUDED */
+#endif /* APTX_INCLUDED */
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
     BTC_SV_AV_AA_LDAC_SINK_INDEX,
 #endif /* LDAC_DEC_INCLUDED */
@@ -199,6 +199,18 @@ BOOLEAN bta_av_co_audio_set_codec(const tBTC_AV_MEDIA_FEEDINGS *p_feeding, tBTC_
  *******************************************************************************/
 BOOLEAN bta_av_co_audio_get_sbc_config(tA2D_SBC_CIE *p_sbc_config, UINT16 *p_minmtu);
 
+/*******************************************************************************
+ **
+ ** Function         bta_av_co_audio_get_codec_config
+ **
+ ** Description      Retrieves the codec configuration in use and the smallest
+ **                  MTU of the opened connections.
+ **
+ ** Returns          void
+ **
+ *******************************************************************************/
+void bta_av_co_audio_get_codec_config(UINT8 *p_codec_info, UINT16 *p_minmtu);
+
 /*******************************************************************************
  **
  ** Function         bta_av_co_audio_discard_config
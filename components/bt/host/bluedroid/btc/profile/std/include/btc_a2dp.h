@@ -48,6 +48,7 @@
 /* Transcoding definition for TxTranscoding and RxTranscoding */
 #define BTC_MEDIA_TRSCD_OFF                        0
 #define BTC_MEDIA_TRSCD_PCM_2_SBC                  1       /* Tx */
+#define BTC_MEDIA_TRSCD_PCM_2_VENDOR               2       /* Tx, through the encoder interface of the codec */
 
 
 /*******************************************************************************
@@ -34,6 +34,7 @@
 typedef struct {
     BT_HDR hdr;
     UINT8 codec_info[AVDT_CODEC_SIZE];
+    esp_a2d_pcm_fmt_t pcm_fmt;
 } tBTC_MEDIA_SINK_CFG_UPDATE;
 
 /*******************************************************************************
@@ -78,6 +79,7 @@ BOOLEAN btc_a2dp_sink_rx_flush_req(void);
  ** Function         btc_a2dp_sink_enque_buf
  **
  ** Description      Enqueue a Advance Audio media buffer to be processed by btc media task.
+ **                  Ownership of p_buf is transferred, it is freed by the sink.
  **
  ** Returns          size of the queue
  **
@@ -131,8 +133,49 @@ void btc_a2dp_sink_set_rx_flush(BOOLEAN enable);
  ** Description      Reset decoder parameters according to configuration from remote
  **                  device
  **
+ ** Returns          the PCM sample format the decoder is set up for
+ **
+ *******************************************************************************/
+esp_a2d_pcm_fmt_t btc_a2dp_sink_reset_decoder(UINT8 *p_av);
+
+/*******************************************************************************
+ **
+ ** Function         btc_a2dp_sink_get_stats
+ **
+ ** Description      Get the jitter buffer and packet loss statistics of the
+ **                  current sink session
+ **
+ ** Returns          TRUE if the sink is running
+ **
+ *******************************************************************************/
+BOOLEAN btc_a2dp_sink_get_stats(esp_a2d_sink_stats_t *p_stats);
+
+#if (BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE)
+/*******************************************************************************
+ **
+ ** Function         btc_a2dp_sink_get_delay
+ **
+ ** Description      Get the current playout delay of the sink, in 1/10 ms
+ **
+ ** Returns          TRUE if the sink is running
+ **
+ *******************************************************************************/
+BOOLEAN btc_a2dp_sink_get_delay(UINT16 *p_delay);
+#endif /* BTC_A2DP_SINK_DELAY_RPT_INCLUDED == TRUE */
+
+#if (BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE)
+/*******************************************************************************
+ **
+ ** Function         btc_a2dp_sink_read_pcm
+ **
+ ** Description      Read decoded audio from the PCM ring, the rest of p_buf
+ **                  is filled with silence. Never blocks, safe from an ISR.
+ **
+ ** Returns          TRUE if the ring is set up for a configured stream
+ **
  *******************************************************************************/
-void btc_a2dp_sink_reset_decoder(UINT8 *p_av);
+BOOLEAN btc_a2dp_sink_read_pcm(UINT8 *p_buf, UINT32 len, esp_a2d_sink_pcm_info_t *p_info);
+#endif /* BTC_A2DP_SINK_PCM_RING_INCLUDED == TRUE */
 
 #endif /* #if BTC_AV_SINK_INCLUDED */
 
@@ -41,6 +41,7 @@ typedef struct {
     UINT8 NumOfBlocks; /* 4, 8, 12 or 16*/
     UINT8 AllocationMethod; /* loudness or SNR*/
     UINT16 MtuSize; /* peer mtu size */
+    UINT8 codec_info[AVDT_CODEC_SIZE]; /* codec configuration in use */
 } tBTC_MEDIA_INIT_AUDIO;
 
 /* tBTC_MEDIA_UPDATE_AUDIO msg structure */
@@ -239,6 +240,17 @@ void btc_a2dp_source_set_tx_flush(BOOLEAN enable);
  *******************************************************************************/
 void btc_a2dp_source_encoder_update(void);
 
+/*******************************************************************************
+ **
+ ** Function         btc_a2dp_source_get_stats
+ **
+ ** Description      Get the bitpool adaptation and TX queue statistics
+ **
+ ** Returns          TRUE if the source is running
+ **
+ *******************************************************************************/
+BOOLEAN btc_a2dp_source_get_stats(esp_a2d_source_stats_t *p_stats);
+
 #endif /* #if BTC_AV_SRC_INCLUDED */
 
 #endif /* __BTC_A2DP_SOURCE_H__ */
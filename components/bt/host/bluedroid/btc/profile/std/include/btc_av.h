@@ -70,6 +70,8 @@ typedef enum {
     BTC_AV_SINK_API_CONNECT_EVT,
     BTC_AV_SINK_API_DISCONNECT_EVT,
     BTC_AV_SINK_API_REG_DATA_CB_EVT,
+    BTC_AV_SINK_API_SET_PCM_FMT_EVT,
+    BTC_AV_SINK_API_SET_OUTPUT_LATENCY_EVT,
 #endif  /* BTC_AV_SINK_INCLUDED */
 #if BTC_AV_SRC_INCLUDED
     BTC_AV_SRC_API_INIT_EVT,
@@ -85,13 +87,21 @@ typedef enum {
 typedef union {
 #if BTC_AV_SINK_INCLUDED
     // BTC_AV_SINK_CONFIG_REQ_EVT -- internal event
-    esp_a2d_mcc_t mcc;
+    struct {
+        esp_a2d_mcc_t mcc;
+        esp_a2d_pcm_fmt_t pcm_fmt;
+        uint32_t pcm_rate;
+    } sink_cfg;
     // BTC_AV_SINK_API_CONNECT_EVT
     bt_bdaddr_t connect;
     // BTC_AV_SINK_API_DISCONNECT_EVT
     bt_bdaddr_t disconn;
     // BTC_AV_SINK_API_REG_DATA_CB_EVT
     esp_a2d_sink_data_cb_t data_cb;
+    // BTC_AV_SINK_API_SET_PCM_FMT_EVT
+    esp_a2d_pcm_fmt_t pcm_fmt;
+    // BTC_AV_SINK_API_SET_OUTPUT_LATENCY_EVT
+    uint16_t output_latency;
 #endif  /* BTC_AV_SINK_INCLUDED */
 #if BTC_AV_SRC_INCLUDED
     // BTC_AV_SRC_API_REG_DATA_CB_EVT
@@ -115,6 +125,10 @@ void btc_a2dp_cb_handler(btc_msg_t *msg);
 
 void btc_a2dp_sink_reg_data_cb(esp_a2d_sink_data_cb_t callback);
 
+void btc_a2dp_sink_set_pcm_format(esp_a2d_pcm_fmt_t fmt);
+
+void btc_a2dp_sink_set_output_latency(uint16_t latency);
+
 void btc_a2dp_src_reg_data_cb(esp_a2d_source_data_cb_t callback);
 /*******************************************************************************
 **
@@ -191,6 +205,32 @@ BOOLEAN btc_av_is_connected(void);
 
 uint8_t btc_av_get_peer_sep(void);
 
+/*******************************************************************************
+ *
+ * Function         btc_av_sink_delay_report
+ *
+ * Description      Send the playout delay of the sink, in 1/10 ms, to the
+ *                  source.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+
+void btc_av_sink_delay_report(UINT16 delay);
+
+/*******************************************************************************
+ *
+ * Function         btc_av_get_tx_queue_len
+ *
+ * Description      Get the number of media packets of the stream that wait
+ *                  for transmission below BTC, in BTA and in L2CAP.
+ *
+ * Returns          Number of queued packets
+ *
+ ******************************************************************************/
+
+UINT16 btc_av_get_tx_queue_len(void);
+
 /*******************************************************************************
 **
 ** Function         btc_av_is_peer_edr
@@ -52,12 +52,102 @@
 #define UC_BT_A2DP_APTX_DECODER_ENABLED    FALSE
 #endif
 
+#ifdef CONFIG_BT_A2DP_APTX_ENCODER
+#define UC_BT_A2DP_APTX_ENCODER_ENABLED    CONFIG_BT_A2DP_APTX_ENCODER
+#else
+#define UC_BT_A2DP_APTX_ENCODER_ENABLED    FALSE
+#endif
+
 #ifdef CONFIG_BT_A2DP_LDAC_DECODER
 #define UC_BT_A2DP_LDAC_DECODER_ENABLED    CONFIG_BT_A2DP_LDAC_DECODER
 #else
 #define UC_BT_A2DP_LDAC_DECODER_ENABLED    FALSE
 #endif
 
+#ifdef CONFIG_BT_A2DP_SINK_JITTER_MIN_MS
+#define UC_BT_A2DP_SINK_JITTER_MIN_MS      CONFIG_BT_A2DP_SINK_JITTER_MIN_MS
+#else
+#define UC_BT_A2DP_SINK_JITTER_MIN_MS      60
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_JITTER_MAX_MS
+#define UC_BT_A2DP_SINK_JITTER_MAX_MS      CONFIG_BT_A2DP_SINK_JITTER_MAX_MS
+#else
+#define UC_BT_A2DP_SINK_JITTER_MAX_MS      300
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_DELAY_REPORT
+#define UC_BT_A2DP_SINK_DELAY_REPORT_ENABLED   CONFIG_BT_A2DP_SINK_DELAY_REPORT
+#else
+#define UC_BT_A2DP_SINK_DELAY_REPORT_ENABLED   FALSE
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_DELAY_REPORT_THRESHOLD_MS
+#define UC_BT_A2DP_SINK_DELAY_REPORT_THRESHOLD_MS  CONFIG_BT_A2DP_SINK_DELAY_REPORT_THRESHOLD_MS
+#else
+#define UC_BT_A2DP_SINK_DELAY_REPORT_THRESHOLD_MS  10
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_TASK_ENABLE
+#define UC_BT_A2DP_SINK_TASK_ENABLED       CONFIG_BT_A2DP_SINK_TASK_ENABLE
+#else
+#define UC_BT_A2DP_SINK_TASK_ENABLED       FALSE
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_TASK_PINNED_TO_CORE
+#define UC_BT_A2DP_SINK_TASK_PINNED_TO_CORE (CONFIG_BT_A2DP_SINK_TASK_PINNED_TO_CORE < portNUM_PROCESSORS ? CONFIG_BT_A2DP_SINK_TASK_PINNED_TO_CORE : OSI_THREAD_CORE_AFFINITY)
+#else
+#define UC_BT_A2DP_SINK_TASK_PINNED_TO_CORE 0
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_TASK_PRIO
+#define UC_BT_A2DP_SINK_TASK_PRIO          CONFIG_BT_A2DP_SINK_TASK_PRIO
+#else
+#define UC_BT_A2DP_SINK_TASK_PRIO          19
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_TASK_STACK_SIZE
+#define UC_BT_A2DP_SINK_TASK_STACK_SIZE    CONFIG_BT_A2DP_SINK_TASK_STACK_SIZE
+#else
+#define UC_BT_A2DP_SINK_TASK_STACK_SIZE    4096
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_PCM_RING
+#define UC_BT_A2DP_SINK_PCM_RING_ENABLED   CONFIG_BT_A2DP_SINK_PCM_RING
+#else
+#define UC_BT_A2DP_SINK_PCM_RING_ENABLED   FALSE
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_PCM_RING_MS
+#define UC_BT_A2DP_SINK_PCM_RING_MS        CONFIG_BT_A2DP_SINK_PCM_RING_MS
+#else
+#define UC_BT_A2DP_SINK_PCM_RING_MS        200
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_ASRC
+#define UC_BT_A2DP_SINK_ASRC_ENABLED       CONFIG_BT_A2DP_SINK_ASRC
+#else
+#define UC_BT_A2DP_SINK_ASRC_ENABLED       FALSE
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_RESAMPLE
+#define UC_BT_A2DP_SINK_RESAMPLE_ENABLED   CONFIG_BT_A2DP_SINK_RESAMPLE
+#else
+#define UC_BT_A2DP_SINK_RESAMPLE_ENABLED   FALSE
+#endif
+
+#ifdef CONFIG_BT_A2DP_SINK_RESAMPLE_RATE
+#define UC_BT_A2DP_SINK_RESAMPLE_RATE      CONFIG_BT_A2DP_SINK_RESAMPLE_RATE
+#else
+#define UC_BT_A2DP_SINK_RESAMPLE_RATE      44100
+#endif
+
+#ifdef CONFIG_BT_A2DP_SOURCE_RATE_CTRL
+#define UC_BT_A2DP_SOURCE_RATE_CTRL_ENABLED CONFIG_BT_A2DP_SOURCE_RATE_CTRL
+#else
+#define UC_BT_A2DP_SOURCE_RATE_CTRL_ENABLED FALSE
+#endif
+
 //SPP
 #ifdef CONFIG_BT_SPP_ENABLED
 #define UC_BT_SPP_ENABLED                   CONFIG_BT_SPP_ENABLED
@@ -76,6 +76,12 @@
 #if (UC_BT_A2DP_APTX_DECODER_ENABLED == TRUE)
 #define APTX_DEC_INCLUDED         TRUE
 #endif /* (UC_BT_A2DP_APTX_DECODER_ENABLED == TRUE) */
+#if (UC_BT_A2DP_APTX_ENCODER_ENABLED == TRUE)
+#define APTX_ENC_INCLUDED           TRUE
+#endif /* (UC_BT_A2DP_APTX_ENCODER_ENABLED == TRUE) */
+#if (UC_BT_A2DP_APTX_DECODER_ENABLED == TRUE) || (UC_BT_A2DP_APTX_ENCODER_ENABLED == TRUE)
+#define APTX_INCLUDED               TRUE
+#endif
 #if (UC_BT_A2DP_LDAC_DECODER_ENABLED == TRUE)
 #define LDAC_DEC_INCLUDED           TRUE
 #endif /* (UC_BT_A2DP_LDAC_DECODER_ENABLED == TRUE) */
@@ -1960,6 +1966,63 @@ Range: 2 octets
 #define A2D_INCLUDED            FALSE
 #endif
 
+/* Bounds of the adaptive A2DP sink jitter buffer, in ms of PCM */
+#ifndef BTC_A2DP_SINK_JITTER_MIN_MS
+#define BTC_A2DP_SINK_JITTER_MIN_MS     UC_BT_A2DP_SINK_JITTER_MIN_MS
+#endif
+
+#ifndef BTC_A2DP_SINK_JITTER_MAX_MS
+#define BTC_A2DP_SINK_JITTER_MAX_MS     UC_BT_A2DP_SINK_JITTER_MAX_MS
+#endif
+
+/* The A2DP sink reports its playout delay to the source */
+#if (UC_BT_A2DP_SINK_DELAY_REPORT_ENABLED == TRUE)
+#define BTC_A2DP_SINK_DELAY_RPT_INCLUDED        TRUE
+#define BTC_A2DP_SINK_DELAY_RPT_THRESHOLD_MS    UC_BT_A2DP_SINK_DELAY_REPORT_THRESHOLD_MS
+#else
+#define BTC_A2DP_SINK_DELAY_RPT_INCLUDED        FALSE
+#endif
+
+/* A2DP sink media is decoded in a dedicated task instead of the BTC task */
+#if (UC_BT_A2DP_SINK_TASK_ENABLED == TRUE)
+#define BTC_A2DP_SINK_TASK_INCLUDED         TRUE
+#define BTC_A2DP_SINK_TASK_PINNED_TO_CORE   UC_BT_A2DP_SINK_TASK_PINNED_TO_CORE
+#define BTC_A2DP_SINK_TASK_PRIO             UC_BT_A2DP_SINK_TASK_PRIO
+#define BTC_A2DP_SINK_TASK_STACK_SIZE       UC_BT_A2DP_SINK_TASK_STACK_SIZE
+#else
+#define BTC_A2DP_SINK_TASK_INCLUDED         FALSE
+#endif
+
+/* Decoded A2DP sink audio is kept in a ring pulled by the application */
+#if (UC_BT_A2DP_SINK_PCM_RING_ENABLED == TRUE)
+#define BTC_A2DP_SINK_PCM_RING_INCLUDED     TRUE
+#define BTC_A2DP_SINK_PCM_RING_MS           UC_BT_A2DP_SINK_PCM_RING_MS
+#else
+#define BTC_A2DP_SINK_PCM_RING_INCLUDED     FALSE
+#endif
+
+/* Decoded A2DP sink audio is resampled to follow the clock of the source */
+#if (UC_BT_A2DP_SINK_ASRC_ENABLED == TRUE)
+#define BTC_A2DP_SINK_ASRC_INCLUDED         TRUE
+#else
+#define BTC_A2DP_SINK_ASRC_INCLUDED         FALSE
+#endif
+
+/* Decoded A2DP sink audio is converted to one fixed sample rate */
+#if (UC_BT_A2DP_SINK_RESAMPLE_ENABLED == TRUE)
+#define BTC_A2DP_SINK_RESAMPLE_INCLUDED     TRUE
+#define BTC_A2DP_SINK_RESAMPLE_RATE         UC_BT_A2DP_SINK_RESAMPLE_RATE
+#else
+#define BTC_A2DP_SINK_RESAMPLE_INCLUDED     FALSE
+#endif
+
+/* The SBC bitpool of the A2DP source follows the congestion of the link */
+#if (UC_BT_A2DP_SOURCE_RATE_CTRL_ENABLED == TRUE)
+#define BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED  TRUE
+#else
+#define BTC_A2DP_SOURCE_RATE_CTRL_INCLUDED  FALSE
+#endif
+
 /******************************************************************************
 **
 ** AVCTP
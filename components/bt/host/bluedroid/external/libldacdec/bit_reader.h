@@ -2,16 +2,83 @@
 
 #include <stdint.h>
 
+/*
+ * Big endian bit reader with a 32 bit reservoir.
+ *
+ * Cache holds CacheBits not yet consumed bits, left aligned, starting at bit Position of
+ * Buffer. Bytes are pulled in one at a time only when a read needs them, so every input
+ * byte is loaded once and a peek never touches more than 4 bytes past Position.
+ */
 typedef struct {
 	const uint8_t * Buffer;
 	int Position;
+	uint32_t Cache;
+	int CacheBits;
+	int NextByte;
 } BitReaderCxt;
 
+/* Largest bit count PeekInt()/ReadInt() serve from the reservoir */
+#define BIT_READER_MAX_CACHED_BITS (25)
+
 // Make MSVC compiler happy. Leave const in for value parameters
 
 void InitBitReaderCxt(BitReaderCxt* br, const void * buffer);
-uint32_t PeekInt(BitReaderCxt* br, const int bits);
-uint32_t ReadInt(BitReaderCxt* br, const int bits);
-int32_t ReadSignedInt(BitReaderCxt* br, const int bits);
+uint32_t PeekIntFallback(BitReaderCxt* br, const int bits);
 int32_t ReadOffsetBinary(BitReaderCxt* br, const int bits);
 void AlignPosition(BitReaderCxt* br, const unsigned int multiple);
+
+static inline void FillBitCache(BitReaderCxt* br, const int bits)
+{
+	while (br->CacheBits < bits)
+	{
+		br->Cache |= (uint32_t)br->Buffer[br->NextByte++] << (24 - br->CacheBits);
+		br->CacheBits += 8;
+	}
+}
+
+static inline uint32_t PeekInt(BitReaderCxt* br, const int bits)
+{
+	if (bits > BIT_READER_MAX_CACHED_BITS)
+	{
+		return PeekIntFallback(br, bits);
+	}
+	if (bits == 0)
+	{
+		return 0;
+	}
+	FillBitCache(br, bits);
+	return br->Cache >> (32 - bits);
+}
+
+static inline void SkipBits(BitReaderCxt* br, const int bits)
+{
+	if (bits > BIT_READER_MAX_CACHED_BITS)
+	{
+		/* only reachable through PeekIntFallback() sized reads, resync the reservoir */
+		br->Position += bits;
+		br->Cache = 0;
+		br->CacheBits = 0;
+		br->NextByte = br->Position / 8;
+		FillBitCache(br, br->Position % 8);
+		br->Cache <<= br->Position % 8;
+		br->CacheBits -= br->Position % 8;
+		return;
+	}
+	FillBitCache(br, bits);
+	br->Cache <<= bits;
+	br->CacheBits -= bits;
+	br->Position += bits;
+}
+
+static inline uint32_t ReadInt(BitReaderCxt* br, const int bits)
+{
+	const uint32_t value = PeekInt(br, bits);
+	SkipBits(br, bits);
+	return value;
+}
+
+static inline int32_t ReadSignedInt(BitReaderCxt* br, const int bits)
+{
+	const int shift = 32 - bits;
+	return (int32_t)(ReadInt(br, bits) << shift) >> shift;
+}
@@ -0,0 +1,146 @@
+#!/usr/bin/env python
+#
+# Generates the constant IMDCT and Huffman lookup tables of the LDAC decoder
+# (tables.c) so they can live in flash instead of being computed into RAM by
+# ldacdecInit().
+#
+# Values are bit identical to what InitMdct()/InitHuffmanCodebooks() used to
+# compute at run time with single precision floats.
+#
+# SPDX-License-Identifier: Apache-2.0
+from __future__ import division, print_function
+
+import argparse
+import math
+import os
+import re
+import struct
+
+MIN_TRIG_BITS = 0
+MAX_TRIG_BITS = 8
+WINDOW_BITS = (7, 8)
+
+
+def f32(value):
+    return struct.unpack('<f', struct.pack('<f', value))[0]
+
+
+def float_to_fixed(value, frac_bits):
+    scaled = value * (1 << frac_bits)
+    if scaled >= 2147483647.0:
+        return 2147483647
+    if scaled <= -2147483648.0:
+        return -2147483648
+    # lround() rounds half away from zero
+    return int(math.floor(abs(scaled) + 0.5)) * (1 if scaled >= 0 else -1)
+
+
+def bit_reverse(value, bits):
+    result = 0
+    for _ in range(bits):
+        result = (result << 1) | (value & 1)
+        value >>= 1
+    return result
+
+
+def trig_tables():
+    sin_tab, cos_tab = [], []
+    for bits in range(MIN_TRIG_BITS, MAX_TRIG_BITS + 1):
+        size = 1 << bits
+        for i in range(size):
+            value = f32(math.pi * (4 * i + 1) / (4 * size))
+            sin_tab.append(f32(math.sin(value)))
+            cos_tab.append(f32(math.cos(value)))
+    return sin_tab, cos_tab
+
+
+def shuffle_tables():
+    table = []
+    for bits in WINDOW_BITS:
+        table += [bit_reverse(i ^ (i // 2), bits) for i in range(1 << bits)]
+    return table
+
+
+def imdct_windows():
+    table = []
+    for bits in WINDOW_BITS:
+        size = 1 << bits
+        mdct = [f32((math.sin(((i + 0.5) / size - 0.5) * math.pi) + 1.0) * 0.5) for i in range(size)]
+        for i in range(size):
+            a = mdct[i]
+            b = mdct[size - 1 - i]
+            table.append(f32(a / f32(f32(b * b) + f32(a * a))))
+    return table
+
+
+def huffman_lookups(source):
+    """ Expands the ScaleFactors*Bits/Codes tables of huffCodes.c into direct lookup tables.
+        Every entry holds the decoded value in the low byte and the code length above it. """
+    def parse(name):
+        match = re.search(r'%s\[\d+\]\s*=\s*\{([^}]*)\}' % name, source)
+        if not match:
+            raise RuntimeError('table %s not found in huffCodes.c' % name)
+        return [int(v, 0) for v in match.group(1).replace('\n', ' ').split(',') if v.strip()]
+
+    lookups = []
+    for name in re.findall(r'ScaleFactors(\w\d)Bits\[', source):
+        bits = parse('ScaleFactors%sBits' % name)
+        codes = parse('ScaleFactors%sCodes' % name)
+        max_bits = max(bits)
+        table = [0] * (1 << max_bits)
+        for value, (length, code) in enumerate(zip(bits, codes)):
+            if length == 0:
+                continue
+            unused = max_bits - length
+            start = code << unused
+            for j in range(start, start + (1 << unused)):
+                table[j] = (length << 8) | value
+        lookups.append(('ScaleFactors%sLookup' % name, table))
+    return lookups
+
+
+def format_array(decl, values, fmt, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ' '.join(fmt(v) + ',' for v in values[i:i + per_line]))
+    return '%s = {\n%s\n};\n' % (decl, '\n'.join(lines))
+
+
+def format_float(value):
+    return '%.9ef' % value
+
+
+def main():
+    here = os.path.dirname(os.path.realpath(__file__))
+    parser = argparse.ArgumentParser(description='LDAC decoder table generator')
+    parser.add_argument('--output', default=os.path.join(here, 'tables.c'))
+    args = parser.parse_args()
+
+    with open(os.path.join(here, 'huffCodes.c')) as f:
+        huff_source = f.read()
+
+    sin_tab, cos_tab = trig_tables()
+    shuffle = shuffle_tables()
+    window = imdct_windows()
+
+    out = ['/* Generated by gen_tables.py, do not edit */\n',
+           '#include "tables.h"\n']
+    out.append(format_array('const float SinTables[LDAC_TRIG_TABLE_LEN]', sin_tab, format_float, 4))
+    out.append(format_array('const float CosTables[LDAC_TRIG_TABLE_LEN]', cos_tab, format_float, 4))
+    out.append(format_array('const float ImdctWindows[LDAC_WINDOW_TABLE_LEN]', window, format_float, 4))
+    out.append(format_array('const uint8_t ShuffleTables[LDAC_WINDOW_TABLE_LEN]', shuffle, lambda v: '%3d' % v, 16))
+    out.append(format_array('const int32_t SinTablesFixed[LDAC_TRIG_TABLE_LEN]',
+                            [float_to_fixed(v, 31) for v in sin_tab], lambda v: '%11d' % v, 8))
+    out.append(format_array('const int32_t CosTablesFixed[LDAC_TRIG_TABLE_LEN]',
+                            [float_to_fixed(v, 31) for v in cos_tab], lambda v: '%11d' % v, 8))
+    out.append(format_array('const int32_t ImdctWindowsFixed[LDAC_WINDOW_TABLE_LEN]',
+                            [float_to_fixed(v, 30) for v in window], lambda v: '%11d' % v, 8))
+    for name, table in huffman_lookups(huff_source):
+        out.append(format_array('const uint16_t %s[%d]' % (name, len(table)), table, lambda v: '0x%03X' % v, 12))
+
+    with open(args.output, 'w') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
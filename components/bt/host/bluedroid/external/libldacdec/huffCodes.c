@@ -1,16 +1,8 @@
 #include "huffCodes.h"
 #include "utility.h"
+#include "tables.h"
 #include <stdint.h>
 
-int ReadHuffmanValue(const HuffmanCodebook* huff, BitReaderCxt* br, int isSigned)
-{
-	const int code = PeekInt(br, huff->MaxBitSize);
-	const unsigned char value = huff->Lookup[code];
-	const int bits = huff->Bits[value];
-	br->Position += bits;
-	return isSigned ? SignExtend32(value, huff->ValueBits) : value;
-}
-
 void DecodeHuffmanValues(int* spectrum, int index, int bandCount, const HuffmanCodebook* huff, const int* values)
 {
 	const int valueCount = bandCount >> huff->ValueCountPower;
@@ -27,29 +19,6 @@ void DecodeHuffmanValues(int* spectrum, int index, int bandCount, const HuffmanC
 	}
 }
 
-void InitHuffmanCodebook(const HuffmanCodebook* codebook)
-{
-	const int huffLength = codebook->Length;
-	if (huffLength == 0) return;
-
-	unsigned char* dest = codebook->Lookup;
-
-	for (int i = 0; i < huffLength; i++)
-	{
-		if (codebook->Bits[i] == 0) continue;
-		const int unusedBits = codebook->MaxBitSize - codebook->Bits[i];
-
-		const int start = codebook->Codes[i] << unusedBits;
-		const int length = 1 << unusedBits;
-		const int end = start + length;
-
-		for (int j = start; j < end; j++)
-		{
-			dest[j] = i;
-		}
-	}
-}
-
 static const uint8_t ScaleFactorsA3Bits[8] =
 {
 	2, 2, 4, 6, 6, 5, 3, 2
@@ -140,17 +109,8 @@ static const uint16_t ScaleFactorsB5Codes[32] =
 	0x62, 0x61, 0x63, 0x64, 0x6F, 0x6D, 0x6C, 0x6B, 0x6A, 0x68, 0x69, 0x45, 0x44, 0x37, 0x1A, 0x07
 };
 
-static uint8_t ScaleFactorsA3Lookup[64];
-static uint8_t ScaleFactorsA4Lookup[256];
-static uint8_t ScaleFactorsA5Lookup[256];
-static uint8_t ScaleFactorsA6Lookup[256];
-
-static uint8_t ScaleFactorsB2Lookup[4];
-static uint8_t ScaleFactorsB3Lookup[64];
-static uint8_t ScaleFactorsB4Lookup[256];
-static uint8_t ScaleFactorsB5Lookup[256];
-
-HuffmanCodebook HuffmanScaleFactorsUnsigned[7] = {
+/* Lookup tables are expanded from the codes above by gen_tables.py */
+const HuffmanCodebook HuffmanScaleFactorsUnsigned[7] = {
 	{0},
     {0},
     {0},
@@ -160,7 +120,7 @@ HuffmanCodebook HuffmanScaleFactorsUnsigned[7] = {
 	{ScaleFactorsA6Bits, ScaleFactorsA6Codes, ScaleFactorsA6Lookup, 64, 1, 0, 6, 64, 8},
 };
 
-HuffmanCodebook HuffmanScaleFactorsSigned[6] = {
+const HuffmanCodebook HuffmanScaleFactorsSigned[6] = {
 	{0},
 	{0},
 	{ScaleFactorsB2Bits, ScaleFactorsB2Codes, ScaleFactorsB2Lookup,  4, 1, 0, 2,  4, 2},
@@ -168,19 +128,3 @@ HuffmanCodebook HuffmanScaleFactorsSigned[6] = {
 	{ScaleFactorsB4Bits, ScaleFactorsB4Codes, ScaleFactorsB4Lookup, 16, 1, 0, 4, 16, 8},
 	{ScaleFactorsB5Bits, ScaleFactorsB5Codes, ScaleFactorsB5Lookup, 32, 1, 0, 5, 32, 8},
 };
-
-static void InitHuffmanSet(const HuffmanCodebook* codebooks, int count)
-{
-	for (int i = 0; i < count; i++)
-	{
-		InitHuffmanCodebook(&codebooks[i]);
-	}
-}
-
-void InitHuffmanCodebooks()
-{
-	InitHuffmanSet(HuffmanScaleFactorsUnsigned, sizeof(HuffmanScaleFactorsUnsigned) / sizeof(HuffmanCodebook));
-	InitHuffmanSet(HuffmanScaleFactorsSigned, sizeof(HuffmanScaleFactorsSigned) / sizeof(HuffmanCodebook));
-}
-
-
@@ -1,12 +1,14 @@
 #pragma once
 
+#include <stdint.h>
+
 #include "bit_reader.h"
 
 typedef struct
 {
 	const unsigned char* Bits;
 	const unsigned short* Codes;
-	unsigned char* Lookup;
+	const uint16_t* Lookup;
 	const int Length;
 	const int ValueCount;
 	const int ValueCountPower;
@@ -15,13 +17,22 @@ typedef struct
 	const int MaxBitSize;
 } HuffmanCodebook;
 
-int ReadHuffmanValue(const HuffmanCodebook* huff, BitReaderCxt* br, int isSigned);
-void DecodeHuffmanValues(int* spectrum, int index, int bandCount, const HuffmanCodebook* huff, const int* values);
-void InitHuffmanCodebook(const HuffmanCodebook* codebook);
+/* Single lookup decode, the table entry carries both the value and the code length */
+static inline int ReadHuffmanValue(const HuffmanCodebook* huff, BitReaderCxt* br, int isSigned)
+{
+	const uint16_t entry = huff->Lookup[PeekInt(br, huff->MaxBitSize)];
+	const int value = entry & 0xFF;
+	SkipBits(br, entry >> 8);
+	if (isSigned)
+	{
+		const int shift = 32 - huff->ValueBits;
+		return (int32_t)((uint32_t)value << shift) >> shift;
+	}
+	return value;
+}
 
-extern HuffmanCodebook HuffmanScaleFactorsUnsigned[7];
-extern HuffmanCodebook HuffmanScaleFactorsSigned[6];
-extern HuffmanCodebook HuffmanSpectrum[2][8][4];
+void DecodeHuffmanValues(int* spectrum, int index, int bandCount, const HuffmanCodebook* huff, const int* values);
 
-void InitHuffmanCodebooks();
+extern const HuffmanCodebook HuffmanScaleFactorsUnsigned[7];
+extern const HuffmanCodebook HuffmanScaleFactorsSigned[6];
 
@@ -3,225 +3,267 @@
 
 #include "ldacdec.h"
 #include "utility.h"
+#include "tables.h"
 
 
-#define DEF_MDCTWINDOW(i) float* MdctWindow_##i;
-#define DEF_IMDCTWINDOW(i) float ImdctWindow_##i[1<<i];
-#define DEF_SHUFFLETABLE(i) int ShuffleTable_##i[1<<i];
+static inline const float* GetSinTable(int i) { return &SinTables[LDAC_TRIG_OFFSET(i)]; }
+static inline const float* GetCosTable(int i) { return &CosTables[LDAC_TRIG_OFFSET(i)]; }
+static inline const float* GetImdctWindow(int i) { return &ImdctWindows[LDAC_WINDOW_OFFSET(i)]; }
+static inline const uint8_t* GetShuffleTable(int i) { return &ShuffleTables[LDAC_WINDOW_OFFSET(i)]; }
 
-#define DEF_GET_WINDOW_FUNC(table, type) inline type* Get##table(int i) {	\
-	switch(i) {																\
-		case 7: return table##_7;											\
-		case 8: return table##_8;											\
-		default:															\
-			break;															\
-	}																		\
-	return NULL;															\
-}
+static inline const int32_t* GetSinTableFixed(int i) { return &SinTablesFixed[LDAC_TRIG_OFFSET(i)]; }
+static inline const int32_t* GetCosTableFixed(int i) { return &CosTablesFixed[LDAC_TRIG_OFFSET(i)]; }
+static inline const int32_t* GetImdctWindowFixed(int i) { return &ImdctWindowsFixed[LDAC_WINDOW_OFFSET(i)]; }
 
-#define DEF_SINTABLE(i) float SinTable_##i[1<<i]
-#define DEF_COSTABLE(i) float CosTable_##i[1<<i]
-
-#define DEF_GET_TABLE_FUNC(table) inline float* Get##table(int i) {		\
-	switch(i) {															\
-		case 0: return table##_0;										\
-		case 1: return table##_1;										\
-		case 2: return table##_2;										\
-		case 3: return table##_3;										\
-		case 4: return table##_4;										\
-		case 5: return table##_5;										\
-		case 6: return table##_6;										\
-		case 7: return table##_7;										\
-		case 8: return table##_8;										\
-		default:														\
-			break;														\
-	}																	\
-	return NULL;														\
-}
 
-DEF_MDCTWINDOW(7);
-DEF_MDCTWINDOW(8);
-DEF_IMDCTWINDOW(7);
-DEF_IMDCTWINDOW(8);
-DEF_SHUFFLETABLE(7);
-DEF_SHUFFLETABLE(8);
-
-DEF_SINTABLE(0);
-DEF_SINTABLE(1);
-DEF_SINTABLE(2);
-DEF_SINTABLE(3);
-DEF_SINTABLE(4);
-DEF_SINTABLE(5);
-DEF_SINTABLE(6);
-DEF_SINTABLE(7);
-DEF_SINTABLE(8);
-
-DEF_COSTABLE(0);
-DEF_COSTABLE(1);
-DEF_COSTABLE(2);
-DEF_COSTABLE(3);
-DEF_COSTABLE(4);
-DEF_COSTABLE(5);
-DEF_COSTABLE(6);
-DEF_COSTABLE(7);
-DEF_COSTABLE(8);
-
-DEF_GET_WINDOW_FUNC(MdctWindow, float);
-DEF_GET_WINDOW_FUNC(ImdctWindow, float);
-DEF_GET_WINDOW_FUNC(ShuffleTable, int);
-
-DEF_GET_TABLE_FUNC(SinTable);
-DEF_GET_TABLE_FUNC(CosTable);
-
-
-static void GenerateTrigTables(int sizeBits)
-{
-	const int size = 1 << sizeBits;
-	float* sinTab = GetSinTable(sizeBits);
-	float* cosTab = GetCosTable(sizeBits);
+/*
+ * The DCT-IV is computed as a pre-rotation into MdctSize/2 complex values, a decimation in
+ * frequency complex transform and a bit reversed read-out (ShuffleTables).
+ *
+ * Two consecutive radix-2 stages are fused into one radix-2^2 pass so every complex value
+ * is loaded and stored once per two stages; an odd stage count ends with a radix-2 pass.
+ * Each value sees exactly the same operations as in a plain radix-2 implementation, so
+ * the result is unchanged. The transform runs in place in one scratch buffer and the
+ * shuffle is folded into the windowing loop instead of copying into a separate output.
+ */
 
-	for (int i = 0; i < size; i++)
-	{
-		const float value = M_PI * (4 * i + 1) / (4 * size);
-		sinTab[i] = sin(value);
-		cosTab[i] = cos(value);
-	}
+#define LDAC_ALWAYS_INLINE inline __attribute__((always_inline))
+
+static LDAC_ALWAYS_INLINE void Butterfly(float* re0, float* im0, float* re1, float* im1, float sin, float cos)
+{
+	const float a = *re0 - *re1;
+	const float b = *im0 - *im1;
+	*re0 += *re1;
+	*im0 += *im1;
+	*re1 = a * cos + b * sin;
+	*im1 = a * sin - b * cos;
 }
 
-static void GenerateShuffleTable(int sizeBits)
+static LDAC_ALWAYS_INLINE void Dct4(const int bits, const float* input, float* x)
 {
-	const int size = 1 << sizeBits;
-	int* table = GetShuffleTable(sizeBits);
+	const int size = 1 << bits;
+	const int lastIndex = size - 1;
+	const int halfSize = size / 2;
+	const int stageCount = bits - 1;
+	const float* sinTable = GetSinTable(bits);
+	const float* cosTable = GetCosTable(bits);
+	int stage;
 
-	for (int i = 0; i < size; i++)
+	for (int i = 0; i < halfSize; i++)
 	{
-		table[i] = BitReverse32(i ^ (i / 2), sizeBits);
+		const int i2 = i * 2;
+		const float a = input[i2];
+		const float b = input[lastIndex - i2];
+		x[i2] = a * cosTable[i] + b * sinTable[i];
+		x[i2 + 1] = a * sinTable[i] - b * cosTable[i];
 	}
-}
 
-static void GenerateMdctWindow(int frameSizePower)
-{
-	const int frameSize = 1 << frameSizePower;
-	float* mdct = GetMdctWindow(frameSizePower);
+	for (stage = 0; stage + 1 < stageCount; stage += 2)
+	{
+		const int halfBits = stageCount - stage - 1;
+		const int half = 1 << halfBits;
+		const int quarter = half / 2;
+		const float* sinA = GetSinTable(halfBits);
+		const float* cosA = GetCosTable(halfBits);
+		const float* sinB = GetSinTable(halfBits - 1);
+		const float* cosB = GetCosTable(halfBits - 1);
+
+		for (int block = 0; block < (1 << stage); block++)
+		{
+			float* p = x + block * half * 4;
+			for (int i = 0; i < quarter; i++)
+			{
+				float* p0 = p + i * 2;
+				float* p1 = p0 + quarter * 2;
+				float* p2 = p0 + half * 2;
+				float* p3 = p2 + quarter * 2;
+				float re0 = p0[0], im0 = p0[1];
+				float re1 = p1[0], im1 = p1[1];
+				float re2 = p2[0], im2 = p2[1];
+				float re3 = p3[0], im3 = p3[1];
+
+				Butterfly(&re0, &im0, &re2, &im2, sinA[i], cosA[i]);
+				Butterfly(&re1, &im1, &re3, &im3, sinA[i + quarter], cosA[i + quarter]);
+				Butterfly(&re0, &im0, &re1, &im1, sinB[i], cosB[i]);
+				Butterfly(&re2, &im2, &re3, &im3, sinB[i], cosB[i]);
+
+				p0[0] = re0; p0[1] = im0;
+				p1[0] = re1; p1[1] = im1;
+				p2[0] = re2; p2[1] = im2;
+				p3[0] = re3; p3[1] = im3;
+			}
+		}
+	}
 
-	for (int i = 0; i < frameSize; i++)
+	if (stage < stageCount)
 	{
-		mdct[i] = (sin(((i + 0.5) / frameSize - 0.5) * M_PI) + 1.0) * 0.5;
+		/* remaining radix-2 stage, blocks of two complex values */
+		const float sin = GetSinTable(0)[0];
+		const float cos = GetCosTable(0)[0];
+		for (int i = 0; i < size; i += 4)
+		{
+			Butterfly(&x[i], &x[i + 1], &x[i + 2], &x[i + 3], sin, cos);
+		}
 	}
 }
 
-static void GenerateImdctWindow(int frameSizePower)
+static LDAC_ALWAYS_INLINE void RunImdctSized(const int bits, Mdct* mdct, const float* input, float* output)
 {
-	const int frameSize = 1 << frameSizePower;
-	float* imdct = GetImdctWindow(frameSizePower);
-	float* mdct = GetMdctWindow(frameSizePower);
+	const int size = 1 << bits;
+	const int half = size / 2;
+	const float* window = GetImdctWindow(bits);
+	const uint8_t* shuffle = GetShuffleTable(bits);
+	float* previous = mdct->ImdctPrevious;
+	float dct[MAX_FRAME_SAMPLES];
 
-	for (int i = 0; i < frameSize; i++)
+	Dct4(bits, input, dct);
+
+	for (int i = 0; i < half; i++)
 	{
-		imdct[i] = mdct[i] / (mdct[frameSize - 1 - i] * mdct[frameSize - 1 - i] + mdct[i] * mdct[i]);
+		output[i] = window[i] * dct[shuffle[i + half]] + previous[i];
+		output[i + half] = window[i + half] * -dct[shuffle[size - 1 - i]] - previous[i + half];
+		previous[i] = window[size - 1 - i] * -dct[shuffle[half - i - 1]];
+		previous[i + half] = window[half - i - 1] * dct[shuffle[i]];
 	}
 }
 
-void InitMdct()
+void RunImdct(Mdct* mdct, float* input, float* output)
 {
-	for (int i = 0; i < 9; i++)
+	switch (mdct->Bits)
 	{
-		GenerateTrigTables(i);
-	}		
-
-	GenerateShuffleTable(7);
-	GenerateShuffleTable(8);
-
-	MdctWindow_7 = malloc(sizeof(float) * (1<<7));
-	MdctWindow_8 = malloc(sizeof(float) * (1<<8));
-	GenerateMdctWindow(7);
-	GenerateMdctWindow(8);
-
-	GenerateImdctWindow(7);
-	GenerateImdctWindow(8);
-
-	free(MdctWindow_7);
-	free(MdctWindow_8);
+		case 7:
+			RunImdctSized(7, mdct, input, output);
+			break;
+		case 8:
+			RunImdctSized(8, mdct, input, output);
+			break;
+		default:
+			break;
+	}
 }
 
 
-static void Dct4(Mdct* mdct, float* input, float* output);
-
-void RunImdct(Mdct* mdct, float* input, float* output)
+static inline int32_t MulQ31(int32_t a, int32_t b)
 {
-	const int size = 1 << mdct->Bits;
-	const int half = size / 2;
-	float dctOut[MAX_FRAME_SAMPLES] = { 0.f };
-	const float* window = GetImdctWindow(mdct->Bits);
-	float* previous = mdct->ImdctPrevious;
-
-    Dct4(mdct, input, dctOut);
-	
-    for (int i = 0; i < half; i++)
-	{
-		output[i] = window[i] * dctOut[i + half] + previous[i];
-		output[i + half] = window[i + half] * -dctOut[size - 1 - i] - previous[i + half];
-		previous[i] = window[size - 1 - i] * -dctOut[half - i - 1];
-		previous[i + half] = window[half - i - 1] * dctOut[i];
-    }
+	return (int32_t)(((int64_t)a * b + (1 << 30)) >> 31);
 }
 
+static inline int32_t MulQ30(int32_t a, int32_t b)
+{
+	return (int32_t)(((int64_t)a * b + (1 << 29)) >> 30);
+}
 
-static void Dct4(Mdct* mdct, float* input, float* output)
+static LDAC_ALWAYS_INLINE void ButterflyFixed(int32_t* re0, int32_t* im0, int32_t* re1, int32_t* im1, int32_t sin, int32_t cos)
 {
-	int MdctBits = mdct->Bits;
-	int MdctSize = 1 << MdctBits;
-	const int* shuffleTable = GetShuffleTable(MdctBits);
-	const float* sinTable = GetSinTable(MdctBits);
-	const float* cosTable = GetCosTable(MdctBits);
-	float dctTemp[MAX_FRAME_SAMPLES];
+	const int32_t a = *re0 - *re1;
+	const int32_t b = *im0 - *im1;
+	*re0 += *re1;
+	*im0 += *im1;
+	*re1 = MulQ31(a, cos) + MulQ31(b, sin);
+	*im1 = MulQ31(a, sin) - MulQ31(b, cos);
+}
 
-	int size = MdctSize;
-	int lastIndex = size - 1;
-	int halfSize = size / 2;
+/* Same decomposition as Dct4(). Every stage is orthogonal up to a factor of sqrt(2),
+ * so intermediate values never exceed the L2 norm of the output frame and the
+ * LDAC_FIXED_FRAC_BITS format keeps enough headroom without per-stage scaling. */
+static LDAC_ALWAYS_INLINE void Dct4Fixed(const int bits, const int32_t* input, int32_t* x)
+{
+	const int size = 1 << bits;
+	const int lastIndex = size - 1;
+	const int halfSize = size / 2;
+	const int stageCount = bits - 1;
+	const int32_t* sinTable = GetSinTableFixed(bits);
+	const int32_t* cosTable = GetCosTableFixed(bits);
+	int stage;
 
 	for (int i = 0; i < halfSize; i++)
 	{
-		int i2 = i * 2;
-		float a = input[i2];
-		float b = input[lastIndex - i2];
-		float sin = sinTable[i];
-		float cos = cosTable[i];
-		dctTemp[i2] = a * cos + b * sin;
-		dctTemp[i2 + 1] = a * sin - b * cos;
+		const int i2 = i * 2;
+		const int32_t a = input[i2];
+		const int32_t b = input[lastIndex - i2];
+		x[i2] = MulQ31(a, cosTable[i]) + MulQ31(b, sinTable[i]);
+		x[i2 + 1] = MulQ31(a, sinTable[i]) - MulQ31(b, cosTable[i]);
 	}
-	int stageCount = MdctBits - 1;
 
-	for (int stage = 0; stage < stageCount; stage++)
+	for (stage = 0; stage + 1 < stageCount; stage += 2)
 	{
-		int blockCount = 1 << stage;
-		int blockSizeBits = stageCount - stage;
-		int blockHalfSizeBits = blockSizeBits - 1;
-		int blockSize = 1 << blockSizeBits;
-		int blockHalfSize = 1 << blockHalfSizeBits;
-		sinTable = GetSinTable(blockHalfSizeBits);
-		cosTable = GetCosTable(blockHalfSizeBits);
-
-		for (int block = 0; block < blockCount; block++)
+		const int halfBits = stageCount - stage - 1;
+		const int half = 1 << halfBits;
+		const int quarter = half / 2;
+		const int32_t* sinA = GetSinTableFixed(halfBits);
+		const int32_t* cosA = GetCosTableFixed(halfBits);
+		const int32_t* sinB = GetSinTableFixed(halfBits - 1);
+		const int32_t* cosB = GetCosTableFixed(halfBits - 1);
+
+		for (int block = 0; block < (1 << stage); block++)
 		{
-			for (int i = 0; i < blockHalfSize; i++)
+			int32_t* p = x + block * half * 4;
+			for (int i = 0; i < quarter; i++)
 			{
-				int frontPos = (block * blockSize + i) * 2;
-				int backPos = frontPos + blockSize;
-				float a = dctTemp[frontPos] - dctTemp[backPos];
-				float b = dctTemp[frontPos + 1] - dctTemp[backPos + 1];
-				float sin = sinTable[i];
-				float cos = cosTable[i];
-				dctTemp[frontPos] += dctTemp[backPos];
-				dctTemp[frontPos + 1] += dctTemp[backPos + 1];
-				dctTemp[backPos] = a * cos + b * sin;
-				dctTemp[backPos + 1] = a * sin - b * cos;
+				int32_t* p0 = p + i * 2;
+				int32_t* p1 = p0 + quarter * 2;
+				int32_t* p2 = p0 + half * 2;
+				int32_t* p3 = p2 + quarter * 2;
+				int32_t re0 = p0[0], im0 = p0[1];
+				int32_t re1 = p1[0], im1 = p1[1];
+				int32_t re2 = p2[0], im2 = p2[1];
+				int32_t re3 = p3[0], im3 = p3[1];
+
+				ButterflyFixed(&re0, &im0, &re2, &im2, sinA[i], cosA[i]);
+				ButterflyFixed(&re1, &im1, &re3, &im3, sinA[i + quarter], cosA[i + quarter]);
+				ButterflyFixed(&re0, &im0, &re1, &im1, sinB[i], cosB[i]);
+				ButterflyFixed(&re2, &im2, &re3, &im3, sinB[i], cosB[i]);
+
+				p0[0] = re0; p0[1] = im0;
+				p1[0] = re1; p1[1] = im1;
+				p2[0] = re2; p2[1] = im2;
+				p3[0] = re3; p3[1] = im3;
 			}
 		}
 	}
 
-	for (int i = 0; i < MdctSize; i++)
+	if (stage < stageCount)
+	{
+		const int32_t sin = GetSinTableFixed(0)[0];
+		const int32_t cos = GetCosTableFixed(0)[0];
+		for (int i = 0; i < size; i += 4)
+		{
+			ButterflyFixed(&x[i], &x[i + 1], &x[i + 2], &x[i + 3], sin, cos);
+		}
+	}
+}
+
+static LDAC_ALWAYS_INLINE void RunImdctFixedSized(const int bits, MdctFixed* mdct, const int32_t* input, int32_t* output)
+{
+	const int size = 1 << bits;
+	const int half = size / 2;
+	const int32_t* window = GetImdctWindowFixed(bits);
+	const uint8_t* shuffle = GetShuffleTable(bits);
+	int32_t* previous = mdct->ImdctPrevious;
+	int32_t dct[MAX_FRAME_SAMPLES];
+
+	Dct4Fixed(bits, input, dct);
+
+	for (int i = 0; i < half; i++)
+	{
+		output[i] = MulQ30(window[i], dct[shuffle[i + half]]) + previous[i];
+		output[i + half] = MulQ30(window[i + half], -dct[shuffle[size - 1 - i]]) - previous[i + half];
+		previous[i] = MulQ30(window[size - 1 - i], -dct[shuffle[half - i - 1]]);
+		previous[i + half] = MulQ30(window[half - i - 1], dct[shuffle[i]]);
+	}
+}
+
+void RunImdctFixed(MdctFixed* mdct, const int32_t* input, int32_t* output)
+{
+	switch (mdct->Bits)
 	{
-		output[i] = dctTemp[shuffleTable[i]];
+		case 7:
+			RunImdctFixedSized(7, mdct, input, output);
+			break;
+		case 8:
+			RunImdctFixedSized(8, mdct, input, output);
+			break;
+		default:
+			break;
 	}
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 typedef struct {
 	int Bits;
 	int Size;
@@ -10,6 +12,13 @@ typedef struct {
 	float* CosTable;
 } Mdct;
 
-void InitMdct();
+/* Fixed point IMDCT state. Samples are int32_t with LDAC_FIXED_FRAC_BITS fractional bits
+ * relative to the 16 bit PCM scale. */
+typedef struct {
+	int Bits;
+	int32_t ImdctPrevious[MAX_FRAME_SAMPLES];
+} MdctFixed;
+
 void RunImdct(Mdct* mdct, float* input, float* output);
+void RunImdctFixed(MdctFixed* mdct, const int32_t* input, int32_t* output);
 
@@ -4,6 +4,11 @@
 #define MAX_QUANT_UNITS     (34)
 #define MAX_FRAME_SAMPLES   (256)
 
+/* Define LDAC_FIXED_POINT to decode with the integer engine instead of float.
+ * Spectra and PCM are then int32_t with LDAC_FIXED_FRAC_BITS fractional bits
+ * on top of the 16 bit output scale. */
+#define LDAC_FIXED_FRAC_BITS (8)
+
 #include "log.h"
 #include "imdct.h"
 
@@ -41,9 +46,15 @@ struct Channel {
     int quantizedSpectra[MAX_FRAME_SAMPLES];
     int quantizedSpectraFine[MAX_FRAME_SAMPLES];
 
+#ifdef LDAC_FIXED_POINT
+    int32_t spectra[MAX_FRAME_SAMPLES];
+    int32_t pcm[MAX_FRAME_SAMPLES];
+    MdctFixed mdct;
+#else
     float spectra[MAX_FRAME_SAMPLES];
     float pcm[MAX_FRAME_SAMPLES];
     Mdct mdct;
+#endif
 };
 
 struct Frame {
@@ -51,8 +62,9 @@ struct Frame {
     int channelConfigId;
     int frameLength;
     int frameStatus;
-    int frameSamplesPower;
+    int frameSamplesPower;  // of the synthesized frame, see ldacdecSetHalfRate()
     int frameSamples;
+    int halfRate;
 
     int nbrBands;
     
@@ -73,12 +85,21 @@ struct Frame {
 
 typedef struct {
     frame_t frame;
+    int sampleBits;     // valid bits of the output samples, see ldacdecSetSampleBits()
 
 } ldacdec_t;
 
 int ldacdecInit( ldacdec_t *this );
-int ldacDecode( ldacdec_t *this, uint8_t *stream, int16_t *pcm, int *bytesUsed );
+/* 16 gives int16_t samples, 24 and 32 give int32_t samples with that many
+ * valid bits, MSB aligned. ldacdecInit() selects 16. */
+int ldacdecSetSampleBits( ldacdec_t *this, int sampleBits );
+/* Non zero synthesizes 88.2 and 96 kHz frames at 44.1 and 48 kHz, from the
+ * lower half of their spectrum through a half size IMDCT. ldacdecInit()
+ * selects the full rate. */
+int ldacdecSetHalfRate( ldacdec_t *this, int halfRate );
+int ldacDecode( ldacdec_t *this, uint8_t *stream, void *pcm, int *bytesUsed );
 int ldacNullPacket( ldacdec_t *this, uint8_t *output, int *bytesUsed );
+int ldacdecConceal( ldacdec_t *this, void *pcm );
 int ldacdecGetSampleRate( ldacdec_t *this );
 int ldacdecGetChannelCount( ldacdec_t *this );
 
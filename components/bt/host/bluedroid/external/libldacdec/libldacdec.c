@@ -113,15 +113,36 @@ static const uint8_t ga_nqus_ldac[LDAC_MAXNBANDS+1] = {
 
 int ldacdecInit( ldacdec_t *this )
 {
-    InitHuffmanCodebooks();
-    InitMdct();
-
-    memset( &this->frame.channels[0].mdct, 0, sizeof( Mdct ) ); 
-    memset( &this->frame.channels[1].mdct, 0, sizeof( Mdct ) );
+    memset( &this->frame.channels[0].mdct, 0, sizeof( this->frame.channels[0].mdct ) );
+    memset( &this->frame.channels[1].mdct, 0, sizeof( this->frame.channels[1].mdct ) );
     
     this->frame.channels[0].frame = &this->frame;
     this->frame.channels[1].frame = &this->frame;
+    this->frame.frameLength = 0;
+    this->frame.halfRate = 0;
+    this->sampleBits = 16;
+
+    return 0;
+}
 
+int ldacdecSetSampleBits( ldacdec_t *this, int sampleBits )
+{
+    if( sampleBits != 16 && sampleBits != 24 && sampleBits != 32 )
+        return -1;
+    this->sampleBits = sampleBits;
+    return 0;
+}
+
+int ldacdecSetHalfRate( ldacdec_t *this, int halfRate )
+{
+    halfRate = halfRate != 0;
+    if( halfRate != this->frame.halfRate )
+    {
+        // the overlap of the other IMDCT size is of no use
+        memset( &this->frame.channels[0].mdct, 0, sizeof( this->frame.channels[0].mdct ) );
+        memset( &this->frame.channels[1].mdct, 0, sizeof( this->frame.channels[1].mdct ) );
+        this->frame.halfRate = halfRate;
+    }
     return 0;
 }
 
@@ -392,6 +413,39 @@ static const char gaa_block_setting_ldac[4][4]=
     {0, 0, 0},
 };
 
+#ifdef LDAC_FIXED_POINT
+static void pcmFixedToShort( frame_t *this, int16_t *pcmOut )
+{
+    const int32_t rounding = 1 << (LDAC_FIXED_FRAC_BITS - 1);
+    int i=0;
+    for(int smpl=0; smpl<this->frameSamples; ++smpl )
+    {
+        for( int ch=0; ch<this->channelCount; ++ch, ++i )
+        {
+            const int32_t sample = this->channels[ch].pcm[smpl];
+            pcmOut[i] = Clamp16((int)(((int64_t)sample + rounding) >> LDAC_FIXED_FRAC_BITS));
+        }
+    }
+}
+
+// the engine carries 16 + LDAC_FIXED_FRAC_BITS bits, dropped below sampleBits
+static void pcmFixedToInt32( frame_t *this, int32_t *pcmOut, int sampleBits )
+{
+    const int engineBits = 16 + LDAC_FIXED_FRAC_BITS;
+    const int drop = engineBits > sampleBits ? engineBits - sampleBits : 0;
+    const int32_t rounding = drop ? 1 << (drop - 1) : 0;
+    const int bits = engineBits - drop;
+    int i=0;
+    for(int smpl=0; smpl<this->frameSamples; ++smpl )
+    {
+        for( int ch=0; ch<this->channelCount; ++ch, ++i )
+        {
+            const int32_t sample = this->channels[ch].pcm[smpl];
+            pcmOut[i] = (int32_t)((uint32_t)ClampBits(((int64_t)sample + rounding) >> drop, bits) << (32 - bits));
+        }
+    }
+}
+#else
 static void pcmFloatToShort( frame_t *this, int16_t *pcmOut )
 {
     int i=0;
@@ -404,6 +458,36 @@ static void pcmFloatToShort( frame_t *this, int16_t *pcmOut )
     }
 }
 
+static void pcmFloatToInt32( frame_t *this, int32_t *pcmOut, int sampleBits )
+{
+    const float scale = (float)(1 << (sampleBits - 16));
+    int i=0;
+    for(int smpl=0; smpl<this->frameSamples; ++smpl )
+    {
+        for( int ch=0; ch<this->channelCount; ++ch, ++i )
+        {
+            const int32_t sample = ClampBits(Round64(this->channels[ch].pcm[smpl] * scale), sampleBits);
+            pcmOut[i] = (int32_t)((uint32_t)sample << (32 - sampleBits));
+        }
+    }
+}
+#endif
+
+static void writePcm( ldacdec_t *this, void *pcm )
+{
+#ifdef LDAC_FIXED_POINT
+    if( this->sampleBits == 16 )
+        pcmFixedToShort( &this->frame, pcm );
+    else
+        pcmFixedToInt32( &this->frame, pcm, this->sampleBits );
+#else
+    if( this->sampleBits == 16 )
+        pcmFloatToShort( &this->frame, pcm );
+    else
+        pcmFloatToInt32( &this->frame, pcm, this->sampleBits );
+#endif
+}
+
 static const int channelConfigIdToChannelCount[] = { 1, 2, 2 };
 
 int ldacdecGetChannelCount( ldacdec_t *this )
@@ -417,9 +501,15 @@ static const unsigned short sampleRateIdToSamplesPower[] = {
 
 static const int sampleRateIdToFrequency[] = { 44100, 48000, 88200, 96000 };
 
+// 256 sample frames are synthesized as 128 samples at half rate
+static int halvedFrame( const frame_t *this )
+{
+    return this->halfRate && sampleRateIdToSamplesPower[this->sampleRateId] > 7;
+}
+
 int ldacdecGetSampleRate( ldacdec_t *this )
 {
-    return sampleRateIdToFrequency[this->frame.sampleRateId];
+    return sampleRateIdToFrequency[this->frame.sampleRateId] >> halvedFrame( &this->frame );
 }
 
 static int decodeFrame( frame_t *this, BitReaderCxt *br )
@@ -434,7 +524,10 @@ static int decodeFrame( frame_t *this, BitReaderCxt *br )
     this->frameStatus = ReadInt( br, LDAC_FRAMESTATBITS );
     
     this->channelCount = channelConfigIdToChannelCount[this->channelConfigId];
-    this->frameSamplesPower = sampleRateIdToSamplesPower[this->sampleRateId];
+    // The lower half of the spectrum of a frame is the spectrum of the frame
+    // decimated by 2, and the IMDCT keeps the same gain at half the size.
+    // The spectral lines above are dropped, see synthesizedUnitCount().
+    this->frameSamplesPower = sampleRateIdToSamplesPower[this->sampleRateId] - halvedFrame( this );
     this->frameSamples = 1<<this->frameSamplesPower;
 
     this->channels[0].mdct.Bits = this->frameSamplesPower;
@@ -450,7 +543,7 @@ static int decodeFrame( frame_t *this, BitReaderCxt *br )
     return 0;
 }
 
-int ldacDecode( ldacdec_t *this, uint8_t *stream, int16_t *pcm, int *bytesUsed )
+int ldacDecode( ldacdec_t *this, uint8_t *stream, void *pcm, int *bytesUsed )
 {
     BitReaderCxt brObject;
     BitReaderCxt *br = &brObject;
@@ -477,14 +570,20 @@ int ldacDecode( ldacdec_t *this, uint8_t *stream, int16_t *pcm, int *bytesUsed )
 
             decodeSpectrum( channel, br );
             decodeSpectrumFine( channel, br );
+#ifdef LDAC_FIXED_POINT
+            dequantizeSpectraFixed( channel );
+
+            RunImdctFixed( &channel->mdct, channel->spectra, channel->pcm );
+#else
             dequantizeSpectra( channel );
             scaleSpectrum( channel );
 
             RunImdct( &channel->mdct, channel->spectra, channel->pcm );
+#endif
         }
         AlignPosition( br, 8 );
 
-        pcmFloatToShort( frame, pcm );
+        writePcm( this, pcm );
     }
     AlignPosition( br, (frame->frameLength)*8 + 24 );
 
@@ -520,3 +619,26 @@ int ldacNullPacket( ldacdec_t *this, uint8_t *output, int *bytesUsed )
 
     return 0;
 }
+
+// 3 header bytes, the longest frame payload and the bit reader look ahead
+#define LDAC_CONCEAL_STREAM_BYTES ( 3 + ( 1 << LDAC_FRAMELEN2BITS ) + 4 )
+
+int ldacdecConceal( ldacdec_t *this, void *pcm )
+{
+    frame_t *frame = &this->frame;
+    uint8_t stream[LDAC_CONCEAL_STREAM_BYTES];
+    const int frameLength = frame->frameLength - 1;
+    int bytesUsed;
+
+    if( frame->frameLength == 0 )   // no frame decoded yet, format unknown
+        return -1;
+
+    // null frame with the header of the last good one, decodes to the IMDCT tail fading out
+    memset( stream, 0, sizeof( stream ) );
+    stream[0] = LDAC_SYNCWORD;
+    stream[1] = ( frame->sampleRateId << 5 ) | ( frame->channelConfigId << 3 ) | ( frameLength >> 6 );
+    stream[2] = ( ( frameLength & 0x3f ) << 2 ) | frame->frameStatus;
+    ldacNullPacket( this, stream + 3, &bytesUsed );
+
+    return ldacDecode( this, stream, pcm, &bytesUsed );
+}
@@ -91,6 +91,46 @@ static const float QuantizerFineStepSize[16] =
 };
 
 
+#ifdef LDAC_FIXED_POINT
+/* QuantizerFineStepSize[i] == QuantizerStepSize[i] / 65535, stored as a normalized Q31 mantissa
+ * and the extra right shift needed to get back to the real value */
+static const int32_t QuantizerFineStepMantissa[16] = {
+    0x40004000, 0x5555AAAB, 0x4924DB6E, 0x44448889, 0x4210C632, 0x41045145, 0x40814285, 0x40408081,
+    0x40205028, 0x40104411, 0x40084108, 0x40044044, 0x40024012, 0x40014005, 0x4000C002, 0x40008001,
+};
+
+static const uint8_t QuantizerFineStepShift[16] = {
+    14, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+};
+#endif
+
+/* Reads count fixed width signed values, as many per reservoir peek as fit */
+static void readSignedValues( BitReaderCxt *br, int wl, int *dst, int count )
+{
+    const int perPeek = BIT_READER_MAX_CACHED_BITS / wl;
+    const int shift = 32 - wl;
+
+    while( count > 0 )
+    {
+        const int n = count < perPeek ? count : perPeek;
+        uint32_t bits = ReadInt( br, n * wl ) << (32 - n * wl);
+        for( int k=0; k<n; ++k, bits <<= wl )
+        {
+            *dst++ = (int32_t)bits >> shift;
+        }
+        count -= n;
+    }
+}
+
+static inline void unpack4DSpectrum( int *dst, int index )
+{
+    const int value = decode4DSpectrum[index];
+    dst[0] = ((value>>6)&3) - 1;
+    dst[1] = ((value>>4)&3) - 1;
+    dst[2] = ((value>>2)&3) - 1;
+    dst[3] =  (value&3)     - 1;
+}
+
 int decodeSpectrum( channel_t *this, BitReaderCxt *br )
 {
     frame_t *frame = this->frame;
@@ -103,27 +143,30 @@ int decodeSpectrum( channel_t *this, BitReaderCxt *br )
         
         if( this->precisions[i] == 1 )
         {
-            int idxSpectrum = startSubband;
+            int *dst = &this->quantizedSpectra[startSubband];
             if( nsps == 2 )
             {
                 int value = decode2DSpectrum[ReadInt( br, LDAC_2DIMSPECBITS )];
-                this->quantizedSpectra[idxSpectrum]   = ((value>>2)&3) - 1;
-                this->quantizedSpectra[idxSpectrum+1] =  (value&3)     - 1;
+                dst[0] = ((value>>2)&3) - 1;
+                dst[1] =  (value&3)     - 1;
             } else
             {
-                for (int j = 0; j < nsps/4; j++, idxSpectrum+=4)
+                /* two 7 bit 4D codes per peek */
+                int groups = nsps/4;
+                for( ; groups >= 2; groups -= 2, dst += 8 )
                 {
-                    int value = decode4DSpectrum[ReadInt( br, LDAC_4DIMSPECBITS )];
-                    this->quantizedSpectra[idxSpectrum]   = ((value>>6)&3) - 1;
-                    this->quantizedSpectra[idxSpectrum+1] = ((value>>4)&3) - 1;
-                    this->quantizedSpectra[idxSpectrum+2] = ((value>>2)&3) - 1;
-                    this->quantizedSpectra[idxSpectrum+3] =  (value&3)     - 1;
+                    uint32_t pair = ReadInt( br, 2*LDAC_4DIMSPECBITS );
+                    unpack4DSpectrum( dst,   pair >> LDAC_4DIMSPECBITS );
+                    unpack4DSpectrum( dst+4, pair & ((1<<LDAC_4DIMSPECBITS)-1) );
+                }
+                if( groups > 0 )
+                {
+                    unpack4DSpectrum( dst, ReadInt( br, LDAC_4DIMSPECBITS ) );
                 }
             }
         } else
         {
-            for( int j = startSubband; j<endSubband; ++j )
-                this->quantizedSpectra[j] = ReadSignedInt( br, wl );
+            readSignedValues( br, wl, &this->quantizedSpectra[startSubband], endSubband - startSubband );
         }
     }
 
@@ -142,10 +185,7 @@ int decodeSpectrumFine( channel_t *this, BitReaderCxt *br )
             int startSubband = ga_isp_ldac[i];
             int endSubband   = ga_isp_ldac[i+1];
             int wl = ga_wl_ldac[this->precisionsFine[i]];
-            for( int j=startSubband; j<endSubband; ++j )
-            {
-                this->quantizedSpectraFine[j] = ReadSignedInt( br, wl );
-            }
+            readSignedValues( br, wl, &this->quantizedSpectraFine[startSubband], endSubband - startSubband );
         }
     }
 
@@ -153,6 +193,17 @@ int decodeSpectrumFine( channel_t *this, BitReaderCxt *br )
     return 0;
 }
 
+// quantization units the synthesis uses, those past the frame size carry
+// the upper half of a frame synthesized at half rate
+static int synthesizedUnitCount( const frame_t *frame )
+{
+    int count = frame->quantizationUnitCount;
+    while( count > 0 && ga_isp_ldac[count-1] >= frame->frameSamples )
+        --count;
+    return count;
+}
+
+#ifndef LDAC_FIXED_POINT
 static void dequantizeQuantUnit( channel_t* this, int band )
 {
     const int subBandIndex = ga_isp_ldac[band];
@@ -172,9 +223,11 @@ void dequantizeSpectra( channel_t *this )
 {
     frame_t *frame = this->frame;
     
+    const int unitCount = synthesizedUnitCount( frame );
+
     memset( this->spectra, 0, sizeof(this->spectra) );
     
-    for( int i=0; i<frame->quantizationUnitCount; ++i )
+    for( int i=0; i<unitCount; ++i )
     {
         dequantizeQuantUnit( this, i );
     }
@@ -197,7 +250,7 @@ static const float spectrumScale[32] =
 void scaleSpectrum(channel_t* this)
 {
     const frame_t *frame = this->frame;
-	const int quantUnitCount = frame->quantizationUnitCount;
+	const int quantUnitCount = synthesizedUnitCount( frame );
 	float  * const spectra = this->spectra;
 
 	for (int i = 0; i < quantUnitCount; i++)
@@ -216,4 +269,49 @@ void scaleSpectrum(channel_t* this)
     LOG_ARRAY_LEN( this->spectra, "%e, ", ga_isp_ldac[frame->quantizationUnitCount-1] + ga_nsps_ldac[frame->quantizationUnitCount-1] );
 }
 
+#else
+
+/*
+ * Integer equivalent of dequantizeSpectra() followed by scaleSpectrum().
+ *
+ *   spectra = step * (coarse + fine / 65535) * 2^(scaleFactor - 15)
+ *           = (coarse * 65535 + fine) * fineStep * 2^(scaleFactor - 15)
+ *
+ * The product is formed in 64 bits and shifted once into LDAC_FIXED_FRAC_BITS.
+ */
+void dequantizeSpectraFixed( channel_t *this )
+{
+    frame_t *frame = this->frame;
+    const int unitCount = synthesizedUnitCount( frame );
+
+    memset( this->spectra, 0, sizeof(this->spectra) );
+
+    for( int i=0; i<unitCount; ++i )
+    {
+        const int subBandIndex = ga_isp_ldac[i];
+        const int subBandCount = ga_nsps_ldac[i];
+        const int64_t mantissa = QuantizerFineStepMantissa[this->precisions[i]];
+        int scaleFactor = this->scaleFactors[i] > 0 ? this->scaleFactors[i] : 15;
+        if( scaleFactor > 31 )
+            scaleFactor = 31;
+        const int shift = 31 + QuantizerFineStepShift[this->precisions[i]] + 15 - scaleFactor - LDAC_FIXED_FRAC_BITS;
+        const int64_t rounding = (int64_t)1 << (shift - 1);
+
+        for( int sb=0; sb<subBandCount; ++sb )
+        {
+            const int64_t value = (int64_t)this->quantizedSpectra[subBandIndex+sb] * 65535
+                                + this->quantizedSpectraFine[subBandIndex+sb];
+            int64_t scaled = ( value * mantissa + rounding ) >> shift;
+            if( scaled > INT32_MAX )
+                scaled = INT32_MAX;
+            else if( scaled < INT32_MIN )
+                scaled = INT32_MIN;
+            this->spectra[subBandIndex+sb] = (int32_t)scaled;
+        }
+    }
+
+    LOG_ARRAY_LEN( this->spectra, "%d, ", ga_isp_ldac[frame->quantizationUnitCount-1] + ga_nsps_ldac[frame->quantizationUnitCount-1] );
+}
+
+#endif // LDAC_FIXED_POINT
 
@@ -9,5 +9,8 @@ int decodeSpectrumFine( channel_t *this, BitReaderCxt *br );
 
 void dequantizeSpectra( channel_t *this );
 void scaleSpectrum(channel_t* this);
+#ifdef LDAC_FIXED_POINT
+void dequantizeSpectraFixed( channel_t *this );
+#endif
 
 #endif // _SPECTRUM_H_
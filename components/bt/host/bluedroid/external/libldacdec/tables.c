@@ -0,0 +1,723 @@
+/* Generated by gen_tables.py, do not edit */
+
+#include "tables.h"
+
+const float SinTables[LDAC_TRIG_TABLE_LEN] = {
+    7.071067691e-01f, 3.826834559e-01f, 9.238795638e-01f, 1.950903237e-01f,
+    8.314695954e-01f, 9.807852507e-01f, 5.555701852e-01f, 9.801714122e-02f,
+    4.713967144e-01f, 7.730104327e-01f, 9.569403529e-01f, 9.951847196e-01f,
+    8.819212914e-01f, 6.343932748e-01f, 2.902847230e-01f, 4.906767607e-02f,
+    2.429801822e-01f, 4.275550842e-01f, 5.956993103e-01f, 7.409511209e-01f,
+    8.577286005e-01f, 9.415440559e-01f, 9.891765118e-01f, 9.987954497e-01f,
+    9.700312614e-01f, 9.039893150e-01f, 8.032075167e-01f, 6.715590358e-01f,
+    5.141027570e-01f, 3.368898034e-01f, 1.467305720e-01f, 2.454122901e-02f,
+    1.224106699e-01f, 2.191012353e-01f, 3.136817515e-01f, 4.052413106e-01f,
+    4.928981662e-01f, 5.758082271e-01f, 6.531728506e-01f, 7.242470384e-01f,
+    7.883464098e-01f, 8.448535800e-01f, 8.932242990e-01f, 9.329927564e-01f,
+    9.637760520e-01f, 9.852776527e-01f, 9.972904325e-01f, 9.996988177e-01f,
+    9.924795032e-01f, 9.757021666e-01f, 9.495281577e-01f, 9.142097235e-01f,
+    8.700870275e-01f, 8.175848126e-01f, 7.572088242e-01f, 6.895405054e-01f,
+    6.152315140e-01f, 5.349977016e-01f, 4.496113658e-01f, 3.598950505e-01f,
+    2.667127252e-01f, 1.709618121e-01f, 7.356444746e-02f, 1.227153838e-02f,
+    6.132073700e-02f, 1.102222055e-01f, 1.588581502e-01f, 2.071113735e-01f,
+    2.548656464e-01f, 3.020059466e-01f, 3.484186828e-01f, 3.939920366e-01f,
+    4.386162460e-01f, 4.821837544e-01f, 5.245897174e-01f, 5.657317638e-01f,
+    6.055110097e-01f, 6.438315511e-01f, 6.806010008e-01f, 7.157308459e-01f,
+    7.491363883e-01f, 7.807372212e-01f, 8.104571700e-01f, 8.382247090e-01f,
+    8.639728427e-01f, 8.876396418e-01f, 9.091680050e-01f, 9.285060763e-01f,
+    9.456073642e-01f, 9.604305029e-01f, 9.729399681e-01f, 9.831054807e-01f,
+    9.909026623e-01f, 9.963126183e-01f, 9.993224144e-01f, 9.999247193e-01f,
+    9.981181026e-01f, 9.939069748e-01f, 9.873014092e-01f, 9.783173800e-01f,
+    9.669764638e-01f, 9.533060789e-01f, 9.373390079e-01f, 9.191138744e-01f,
+    8.986744285e-01f, 8.760701418e-01f, 8.513551354e-01f, 8.245893121e-01f,
+    7.958368659e-01f, 7.651672363e-01f, 7.326543331e-01f, 6.983762383e-01f,
+    6.624158025e-01f, 6.248594522e-01f, 5.857978463e-01f, 5.453251004e-01f,
+    5.035383701e-01f, 4.605387747e-01f, 4.164294899e-01f, 3.713172376e-01f,
+    3.253102005e-01f, 2.785196900e-01f, 2.310581952e-01f, 1.830398440e-01f,
+    1.345807612e-01f, 8.579722792e-02f, 3.680723906e-02f, 6.135884672e-03f,
+    3.067480214e-02f, 5.519524589e-02f, 7.968243957e-02f, 1.041216329e-01f,
+    1.284981072e-01f, 1.527971923e-01f, 1.770042181e-01f, 2.011046261e-01f,
+    2.250839174e-01f, 2.489276081e-01f, 2.726213634e-01f, 2.961508632e-01f,
+    3.195020258e-01f, 3.426607251e-01f, 3.656129837e-01f, 3.883450329e-01f,
+    4.108431935e-01f, 4.330938160e-01f, 4.550835788e-01f, 4.767992496e-01f,
+    4.982276559e-01f, 5.193560123e-01f, 5.401715040e-01f, 5.606616139e-01f,
+    5.808140039e-01f, 6.006164551e-01f, 6.200572252e-01f, 6.391244531e-01f,
+    6.578066945e-01f, 6.760927439e-01f, 6.939714551e-01f, 7.114321589e-01f,
+    7.284643650e-01f, 7.450577617e-01f, 7.612023950e-01f, 7.768884897e-01f,
+    7.921065688e-01f, 8.068475127e-01f, 8.211025000e-01f, 8.348628879e-01f,
+    8.481203318e-01f, 8.608669043e-01f, 8.730949759e-01f, 8.847970963e-01f,
+    8.959662914e-01f, 9.065957069e-01f, 9.166790247e-01f, 9.262102246e-01f,
+    9.351835251e-01f, 9.435934424e-01f, 9.514350295e-01f, 9.587034583e-01f,
+    9.653944373e-01f, 9.715038538e-01f, 9.770281315e-01f, 9.819638729e-01f,
+    9.863080978e-01f, 9.900581837e-01f, 9.932119250e-01f, 9.957674146e-01f,
+    9.977230430e-01f, 9.990777373e-01f, 9.998306036e-01f, 9.999811649e-01f,
+    9.995294213e-01f, 9.984756112e-01f, 9.968202710e-01f, 9.945645928e-01f,
+    9.917097688e-01f, 9.882575870e-01f, 9.842100739e-01f, 9.795697331e-01f,
+    9.743393660e-01f, 9.685220718e-01f, 9.621214271e-01f, 9.551411867e-01f,
+    9.475855827e-01f, 9.394592643e-01f, 9.307669401e-01f, 9.215140343e-01f,
+    9.117060304e-01f, 9.013488293e-01f, 8.904486895e-01f, 8.790122867e-01f,
+    8.670462370e-01f, 8.545579910e-01f, 8.415549397e-01f, 8.280450702e-01f,
+    8.140363097e-01f, 7.995372415e-01f, 7.845566273e-01f, 7.691033483e-01f,
+    7.531867623e-01f, 7.368166447e-01f, 7.200025320e-01f, 7.027547359e-01f,
+    6.850836277e-01f, 6.669999957e-01f, 6.485143900e-01f, 6.296381950e-01f,
+    6.103829145e-01f, 5.907597542e-01f, 5.707806945e-01f, 5.504578948e-01f,
+    5.298036933e-01f, 5.088301301e-01f, 4.875501096e-01f, 4.659765661e-01f,
+    4.441221654e-01f, 4.220002294e-01f, 3.996241093e-01f, 3.770074546e-01f,
+    3.541634977e-01f, 3.311062157e-01f, 3.078497350e-01f, 2.844075561e-01f,
+    2.607940733e-01f, 2.370237112e-01f, 2.131103575e-01f, 1.890686452e-01f,
+    1.649130285e-01f, 1.406583190e-01f, 1.163186356e-01f, 9.190889448e-02f,
+    6.744402647e-02f, 4.293829203e-02f, 1.840669475e-02f, 3.067956772e-03f,
+    1.533920597e-02f, 2.760814503e-02f, 3.987292945e-02f, 5.213170499e-02f,
+    6.438262761e-02f, 7.662386447e-02f, 8.885355294e-02f, 1.010698602e-01f,
+    1.132709533e-01f, 1.254549772e-01f, 1.376201212e-01f, 1.497645229e-01f,
+    1.618863940e-01f, 1.739838719e-01f, 1.860551387e-01f, 1.980984062e-01f,
+    2.101118416e-01f, 2.220936120e-01f, 2.340419590e-01f, 2.459550500e-01f,
+    2.578310966e-01f, 2.696683109e-01f, 2.814649343e-01f, 2.932191789e-01f,
+    3.049292564e-01f, 3.165933788e-01f, 3.282098472e-01f, 3.397768736e-01f,
+    3.512927592e-01f, 3.627557456e-01f, 3.741640747e-01f, 3.855160475e-01f,
+    3.968099952e-01f, 4.080441594e-01f, 4.192169011e-01f, 4.303264916e-01f,
+    4.413712919e-01f, 4.523495734e-01f, 4.632597864e-01f, 4.741002023e-01f,
+    4.848692417e-01f, 4.955652356e-01f, 5.061866641e-01f, 5.167317986e-01f,
+    5.271991491e-01f, 5.375871062e-01f, 5.478940606e-01f, 5.581185222e-01f,
+    5.682589412e-01f, 5.783138275e-01f, 5.882815719e-01f, 5.981606841e-01f,
+    6.079497933e-01f, 6.176472902e-01f, 6.272518039e-01f, 6.367618442e-01f,
+    6.461760402e-01f, 6.554928422e-01f, 6.647109389e-01f, 6.738290191e-01f,
+    6.828455329e-01f, 6.917592883e-01f, 7.005687952e-01f, 7.092728019e-01f,
+    7.178700566e-01f, 7.263591290e-01f, 7.347388864e-01f, 7.430079579e-01f,
+    7.511651516e-01f, 7.592092156e-01f, 7.671388984e-01f, 7.749531269e-01f,
+    7.826505899e-01f, 7.902302146e-01f, 7.976908684e-01f, 8.050312996e-01f,
+    8.122506142e-01f, 8.193475008e-01f, 8.263210654e-01f, 8.331701756e-01f,
+    8.398938179e-01f, 8.464909196e-01f, 8.529606462e-01f, 8.593018055e-01f,
+    8.655136228e-01f, 8.715950847e-01f, 8.775452971e-01f, 8.833633065e-01f,
+    8.890483379e-01f, 8.945994973e-01f, 9.000158906e-01f, 9.052967429e-01f,
+    9.104412794e-01f, 9.154486656e-01f, 9.203182459e-01f, 9.250492454e-01f,
+    9.296408892e-01f, 9.340925217e-01f, 9.384035468e-01f, 9.425731897e-01f,
+    9.466009140e-01f, 9.504860640e-01f, 9.542281032e-01f, 9.578264356e-01f,
+    9.612804651e-01f, 9.645897746e-01f, 9.677538276e-01f, 9.707721472e-01f,
+    9.736442566e-01f, 9.763697386e-01f, 9.789481759e-01f, 9.813792109e-01f,
+    9.836624265e-01f, 9.857975245e-01f, 9.877841473e-01f, 9.896219969e-01f,
+    9.913108349e-01f, 9.928504229e-01f, 9.942404628e-01f, 9.954807758e-01f,
+    9.965711236e-01f, 9.975114465e-01f, 9.983015656e-01f, 9.989413023e-01f,
+    9.994305968e-01f, 9.997693896e-01f, 9.999576211e-01f, 9.999952912e-01f,
+    9.998823404e-01f, 9.996188283e-01f, 9.992047548e-01f, 9.986402392e-01f,
+    9.979252815e-01f, 9.970600605e-01f, 9.960446954e-01f, 9.948793054e-01f,
+    9.935641289e-01f, 9.920992851e-01f, 9.904850721e-01f, 9.887216687e-01f,
+    9.868093729e-01f, 9.847484827e-01f, 9.825392962e-01f, 9.801821113e-01f,
+    9.776773453e-01f, 9.750253558e-01f, 9.722265005e-01f, 9.692812562e-01f,
+    9.661900401e-01f, 9.629532695e-01f, 9.595714808e-01f, 9.560452104e-01f,
+    9.523749948e-01f, 9.485613704e-01f, 9.446048141e-01f, 9.405061007e-01f,
+    9.362656474e-01f, 9.318842292e-01f, 9.273625016e-01f, 9.227011204e-01f,
+    9.179008007e-01f, 9.129621983e-01f, 9.078861475e-01f, 9.026733041e-01f,
+    8.973245621e-01f, 8.918406963e-01f, 8.862224817e-01f, 8.804709315e-01f,
+    8.745867014e-01f, 8.685707450e-01f, 8.624239564e-01f, 8.561472893e-01f,
+    8.497417569e-01f, 8.432081938e-01f, 8.365477920e-01f, 8.297612667e-01f,
+    8.228498101e-01f, 8.158144355e-01f, 8.086561561e-01f, 8.013761044e-01f,
+    7.939754128e-01f, 7.864552736e-01f, 7.788165212e-01f, 7.710605264e-01f,
+    7.631884217e-01f, 7.552013397e-01f, 7.471005321e-01f, 7.388872504e-01f,
+    7.305628061e-01f, 7.221282125e-01f, 7.135848999e-01f, 7.049340606e-01f,
+    6.961771250e-01f, 6.873152852e-01f, 6.783499718e-01f, 6.692826748e-01f,
+    6.601144075e-01f, 6.508467197e-01f, 6.414809823e-01f, 6.320186853e-01f,
+    6.224611998e-01f, 6.128101945e-01f, 6.030666828e-01f, 5.932323337e-01f,
+    5.833086371e-01f, 5.732971430e-01f, 5.631992817e-01f, 5.530166030e-01f,
+    5.427508950e-01f, 5.324031711e-01f, 5.219753385e-01f, 5.114688277e-01f,
+    5.008853674e-01f, 4.902264178e-01f, 4.794936776e-01f, 4.686889052e-01f,
+    4.578133523e-01f, 4.468688667e-01f, 4.358570874e-01f, 4.247796535e-01f,
+    4.136382341e-01f, 4.024345577e-01f, 3.911704719e-01f, 3.798472583e-01f,
+    3.684668541e-01f, 3.570309579e-01f, 3.455412984e-01f, 3.339995742e-01f,
+    3.224075735e-01f, 3.107672334e-01f, 2.990798950e-01f, 2.873474956e-01f,
+    2.755718231e-01f, 2.637546360e-01f, 2.518977523e-01f, 2.400029153e-01f,
+    2.280721664e-01f, 2.161068469e-01f, 2.041089833e-01f, 1.920803785e-01f,
+    1.800228506e-01f, 1.679382175e-01f, 1.558285207e-01f, 1.436951160e-01f,
+    1.315400749e-01f, 1.193652302e-01f, 1.071724072e-01f, 9.496343881e-02f,
+    8.274017274e-02f, 7.050468773e-02f, 5.825834349e-02f, 4.600322619e-02f,
+    3.374117985e-02f, 2.147405408e-02f, 9.203693829e-03f,
+};
+
+const float CosTables[LDAC_TRIG_TABLE_LEN] = {
+    7.071067691e-01f, 9.238795042e-01f, -3.826833963e-01f, 9.807852507e-01f,
+    5.555702448e-01f, -1.950903237e-01f, -8.314696550e-01f, 9.951847196e-01f,
+    8.819212914e-01f, 6.343932748e-01f, 2.902846336e-01f, -9.801710397e-02f,
+    -4.713966250e-01f, -7.730104923e-01f, -9.569403529e-01f, 9.987954497e-01f,
+    9.700312614e-01f, 9.039893150e-01f, 8.032075167e-01f, 6.715589762e-01f,
+    5.141028166e-01f, 3.368898332e-01f, 1.467304975e-01f, -4.906762019e-02f,
+    -2.429801971e-01f, -4.275550842e-01f, -5.956993699e-01f, -7.409510612e-01f,
+    -8.577286005e-01f, -9.415441155e-01f, -9.891765118e-01f, 9.996988177e-01f,
+    9.924795628e-01f, 9.757021070e-01f, 9.495281577e-01f, 9.142097831e-01f,
+    8.700870275e-01f, 8.175848126e-01f, 7.572088242e-01f, 6.895405650e-01f,
+    6.152315736e-01f, 5.349976420e-01f, 4.496113062e-01f, 3.598950803e-01f,
+    2.667127550e-01f, 1.709618568e-01f, 7.356461138e-02f, -2.454122342e-02f,
+    -1.224107072e-01f, -2.191011906e-01f, -3.136817217e-01f, -4.052413404e-01f,
+    -4.928981662e-01f, -5.758081675e-01f, -6.531728506e-01f, -7.242471576e-01f,
+    -7.883464694e-01f, -8.448535204e-01f, -8.932242990e-01f, -9.329928160e-01f,
+    -9.637760520e-01f, -9.852776527e-01f, -9.972904921e-01f, 9.999247193e-01f,
+    9.981181026e-01f, 9.939069748e-01f, 9.873014092e-01f, 9.783173800e-01f,
+    9.669764638e-01f, 9.533060193e-01f, 9.373390079e-01f, 9.191138744e-01f,
+    8.986744881e-01f, 8.760700822e-01f, 8.513551950e-01f, 8.245893121e-01f,
+    7.958369255e-01f, 7.651672363e-01f, 7.326542735e-01f, 6.983762383e-01f,
+    6.624157429e-01f, 6.248595119e-01f, 5.857978463e-01f, 5.453249812e-01f,
+    5.035384297e-01f, 4.605387151e-01f, 4.164295495e-01f, 3.713171482e-01f,
+    3.253102303e-01f, 2.785197198e-01f, 2.310581356e-01f, 1.830398887e-01f,
+    1.345806867e-01f, 8.579727262e-02f, 3.680716455e-02f, -1.227149740e-02f,
+    -6.132071465e-02f, -1.102222055e-01f, -1.588581651e-01f, -2.071114182e-01f,
+    -2.548657060e-01f, -3.020059168e-01f, -3.484186530e-01f, -3.939920366e-01f,
+    -4.386162460e-01f, -4.821836948e-01f, -5.245897174e-01f, -5.657317638e-01f,
+    -6.055111289e-01f, -6.438315511e-01f, -6.806009412e-01f, -7.157308459e-01f,
+    -7.491363287e-01f, -7.807372808e-01f, -8.104571700e-01f, -8.382246494e-01f,
+    -8.639728427e-01f, -8.876395822e-01f, -9.091680050e-01f, -9.285060763e-01f,
+    -9.456073642e-01f, -9.604305029e-01f, -9.729399085e-01f, -9.831054807e-01f,
+    -9.909026027e-01f, -9.963126183e-01f, -9.993223548e-01f, 9.999811649e-01f,
+    9.995294213e-01f, 9.984755516e-01f, 9.968202710e-01f, 9.945645928e-01f,
+    9.917097688e-01f, 9.882575870e-01f, 9.842100739e-01f, 9.795697927e-01f,
+    9.743393660e-01f, 9.685220718e-01f, 9.621214271e-01f, 9.551411867e-01f,
+    9.475855827e-01f, 9.394592047e-01f, 9.307669401e-01f, 9.215140343e-01f,
+    9.117060304e-01f, 9.013488293e-01f, 8.904487491e-01f, 8.790122271e-01f,
+    8.670462370e-01f, 8.545579910e-01f, 8.415549994e-01f, 8.280450106e-01f,
+    8.140363097e-01f, 7.995373011e-01f, 7.845566273e-01f, 7.691033483e-01f,
+    7.531868219e-01f, 7.368165851e-01f, 7.200024724e-01f, 7.027547359e-01f,
+    6.850836873e-01f, 6.669999361e-01f, 6.485143900e-01f, 6.296381950e-01f,
+    6.103827953e-01f, 5.907596946e-01f, 5.707807541e-01f, 5.504579544e-01f,
+    5.298036337e-01f, 5.088301897e-01f, 4.875501394e-01f, 4.659765065e-01f,
+    4.441221058e-01f, 4.220002592e-01f, 3.996242583e-01f, 3.770073950e-01f,
+    3.541635573e-01f, 3.311062753e-01f, 3.078496456e-01f, 2.844075859e-01f,
+    2.607941031e-01f, 2.370236367e-01f, 2.131102830e-01f, 1.890686899e-01f,
+    1.649130732e-01f, 1.406582445e-01f, 1.163186803e-01f, 9.190893918e-02f,
+    6.744394451e-02f, 4.293821752e-02f, 1.840673760e-02f, -6.135826465e-03f,
+    -3.067481518e-02f, -5.519520491e-02f, -7.968246937e-02f, -1.041216180e-01f,
+    -1.284981668e-01f, -1.527971923e-01f, -1.770041734e-01f, -2.011046559e-01f,
+    -2.250838876e-01f, -2.489276528e-01f, -2.726213336e-01f, -2.961508334e-01f,
+    -3.195020556e-01f, -3.426606953e-01f, -3.656130135e-01f, -3.883450329e-01f,
+    -4.108432233e-01f, -4.330938160e-01f, -4.550836384e-01f, -4.767991304e-01f,
+    -4.982276559e-01f, -5.193560123e-01f, -5.401715636e-01f, -5.606615543e-01f,
+    -5.808139443e-01f, -6.006165743e-01f, -6.200571656e-01f, -6.391244531e-01f,
+    -6.578067541e-01f, -6.760926247e-01f, -6.939714551e-01f, -7.114322186e-01f,
+    -7.284644246e-01f, -7.450577617e-01f, -7.612023950e-01f, -7.768884897e-01f,
+    -7.921065092e-01f, -8.068475127e-01f, -8.211025596e-01f, -8.348629475e-01f,
+    -8.481203318e-01f, -8.608669639e-01f, -8.730950356e-01f, -8.847970366e-01f,
+    -8.959662318e-01f, -9.065957069e-01f, -9.166790843e-01f, -9.262102246e-01f,
+    -9.351835251e-01f, -9.435935020e-01f, -9.514349699e-01f, -9.587034583e-01f,
+    -9.653944373e-01f, -9.715038538e-01f, -9.770281315e-01f, -9.819638729e-01f,
+    -9.863080978e-01f, -9.900581837e-01f, -9.932119250e-01f, -9.957674146e-01f,
+    -9.977230430e-01f, -9.990777373e-01f, -9.998306036e-01f, 9.999952912e-01f,
+    9.998823404e-01f, 9.996188283e-01f, 9.992047548e-01f, 9.986402392e-01f,
+    9.979252815e-01f, 9.970600605e-01f, 9.960446954e-01f, 9.948793054e-01f,
+    9.935641289e-01f, 9.920992851e-01f, 9.904850721e-01f, 9.887216687e-01f,
+    9.868093729e-01f, 9.847484827e-01f, 9.825392962e-01f, 9.801821113e-01f,
+    9.776773453e-01f, 9.750253558e-01f, 9.722265005e-01f, 9.692812562e-01f,
+    9.661899805e-01f, 9.629532695e-01f, 9.595715404e-01f, 9.560452700e-01f,
+    9.523749948e-01f, 9.485613704e-01f, 9.446048141e-01f, 9.405060410e-01f,
+    9.362656474e-01f, 9.318842888e-01f, 9.273625016e-01f, 9.227011204e-01f,
+    9.179008007e-01f, 9.129621983e-01f, 9.078860879e-01f, 9.026733041e-01f,
+    8.973245621e-01f, 8.918406963e-01f, 8.862225413e-01f, 8.804708719e-01f,
+    8.745866418e-01f, 8.685707450e-01f, 8.624239564e-01f, 8.561473489e-01f,
+    8.497417569e-01f, 8.432082534e-01f, 8.365477324e-01f, 8.297612071e-01f,
+    8.228498101e-01f, 8.158143759e-01f, 8.086561561e-01f, 8.013761640e-01f,
+    7.939754725e-01f, 7.864552140e-01f, 7.788165212e-01f, 7.710605264e-01f,
+    7.631884217e-01f, 7.552013993e-01f, 7.471006513e-01f, 7.388873100e-01f,
+    7.305628061e-01f, 7.221281528e-01f, 7.135848999e-01f, 7.049341202e-01f,
+    6.961771250e-01f, 6.873153448e-01f, 6.783500314e-01f, 6.692826152e-01f,
+    6.601143479e-01f, 6.508466601e-01f, 6.414810419e-01f, 6.320187449e-01f,
+    6.224613190e-01f, 6.128100753e-01f, 6.030666232e-01f, 5.932323337e-01f,
+    5.833086371e-01f, 5.732972026e-01f, 5.631993413e-01f, 5.530167222e-01f,
+    5.427507758e-01f, 5.324031115e-01f, 5.219752789e-01f, 5.114688873e-01f,
+    5.008853674e-01f, 4.902264774e-01f, 4.794937074e-01f, 4.686888456e-01f,
+    4.578132927e-01f, 4.468688071e-01f, 4.358571172e-01f, 4.247796834e-01f,
+    4.136382937e-01f, 4.024347067e-01f, 3.911704123e-01f, 3.798471987e-01f,
+    3.684667945e-01f, 3.570309877e-01f, 3.455413282e-01f, 3.339996338e-01f,
+    3.224077225e-01f, 3.107671738e-01f, 2.990798056e-01f, 2.873474061e-01f,
+    2.755718529e-01f, 2.637546659e-01f, 2.518977821e-01f, 2.400030643e-01f,
+    2.280720919e-01f, 2.161067724e-01f, 2.041089088e-01f, 1.920804232e-01f,
+    1.800228953e-01f, 1.679382473e-01f, 1.558284461e-01f, 1.436950415e-01f,
+    1.315400004e-01f, 1.193652749e-01f, 1.071724445e-01f, 9.496348351e-02f,
+    8.274021745e-02f, 7.050461322e-02f, 5.825826526e-02f, 4.600314796e-02f,
+    3.374122456e-02f, 2.147409692e-02f, 9.203737602e-03f, -3.068009159e-03f,
+    -1.533917431e-02f, -2.760814875e-02f, -3.987296671e-02f, -5.213165656e-02f,
+    -6.438262016e-02f, -7.662388682e-02f, -8.885361254e-02f, -1.010698378e-01f,
+    -1.132709607e-01f, -1.254550219e-01f, -1.376200765e-01f, -1.497645229e-01f,
+    -1.618864238e-01f, -1.739838123e-01f, -1.860551238e-01f, -1.980984211e-01f,
+    -2.101118863e-01f, -2.220935822e-01f, -2.340419590e-01f, -2.459550798e-01f,
+    -2.578310668e-01f, -2.696683109e-01f, -2.814649642e-01f, -2.932192087e-01f,
+    -3.049291968e-01f, -3.165933788e-01f, -3.282098770e-01f, -3.397768438e-01f,
+    -3.512927592e-01f, -3.627557456e-01f, -3.741641045e-01f, -3.855160177e-01f,
+    -3.968099952e-01f, -4.080441892e-01f, -4.192168415e-01f, -4.303264618e-01f,
+    -4.413712919e-01f, -4.523496330e-01f, -4.632598758e-01f, -4.741001129e-01f,
+    -4.848691821e-01f, -4.955652356e-01f, -5.061866641e-01f, -5.167317986e-01f,
+    -5.271992087e-01f, -5.375871658e-01f, -5.478940010e-01f, -5.581184626e-01f,
+    -5.682589412e-01f, -5.783138275e-01f, -5.882815719e-01f, -5.981607437e-01f,
+    -6.079498529e-01f, -6.176472306e-01f, -6.272517443e-01f, -6.367618442e-01f,
+    -6.461760402e-01f, -6.554929018e-01f, -6.647110581e-01f, -6.738290787e-01f,
+    -6.828454733e-01f, -6.917592287e-01f, -7.005687952e-01f, -7.092728615e-01f,
+    -7.178700566e-01f, -7.263591886e-01f, -7.347389460e-01f, -7.430078983e-01f,
+    -7.511650920e-01f, -7.592091560e-01f, -7.671388984e-01f, -7.749531269e-01f,
+    -7.826506495e-01f, -7.902301550e-01f, -7.976908088e-01f, -8.050312996e-01f,
+    -8.122505546e-01f, -8.193475604e-01f, -8.263211250e-01f, -8.331702352e-01f,
+    -8.398937583e-01f, -8.464909196e-01f, -8.529605865e-01f, -8.593018055e-01f,
+    -8.655136228e-01f, -8.715951443e-01f, -8.775453568e-01f, -8.833633065e-01f,
+    -8.890483379e-01f, -8.945994973e-01f, -9.000158906e-01f, -9.052968025e-01f,
+    -9.104413390e-01f, -9.154487848e-01f, -9.203182459e-01f, -9.250492454e-01f,
+    -9.296408892e-01f, -9.340925813e-01f, -9.384035468e-01f, -9.425732493e-01f,
+    -9.466009736e-01f, -9.504860640e-01f, -9.542281032e-01f, -9.578264356e-01f,
+    -9.612804651e-01f, -9.645898342e-01f, -9.677538872e-01f, -9.707721472e-01f,
+    -9.736442566e-01f, -9.763697386e-01f, -9.789481759e-01f, -9.813792109e-01f,
+    -9.836624265e-01f, -9.857975245e-01f, -9.877841473e-01f, -9.896219969e-01f,
+    -9.913108349e-01f, -9.928504229e-01f, -9.942404628e-01f, -9.954807758e-01f,
+    -9.965711236e-01f, -9.975114465e-01f, -9.983015656e-01f, -9.989413023e-01f,
+    -9.994305968e-01f, -9.997693896e-01f, -9.999576211e-01f,
+};
+
+const float ImdctWindows[LDAC_WINDOW_TABLE_LEN] = {
+    3.765191650e-05f, 3.390373604e-04f, 9.427159093e-04f, 1.850504894e-03f,
+    3.065133933e-03f, 4.590251483e-03f, 6.430429406e-03f, 8.591173217e-03f,
+    1.107893046e-02f, 1.390109956e-02f, 1.706603914e-02f, 2.058308944e-02f,
+    2.446256392e-02f, 2.871578746e-02f, 3.335506842e-02f, 3.839375079e-02f,
+    4.384618625e-02f, 4.972773790e-02f, 5.605479702e-02f, 6.284474581e-02f,
+    7.011596859e-02f, 7.788783312e-02f, 8.618061244e-02f, 9.501547366e-02f,
+    1.044144034e-01f, 1.144001111e-01f, 1.249960512e-01f, 1.362260729e-01f,
+    1.481145173e-01f, 1.606858522e-01f, 1.739646047e-01f, 1.879750937e-01f,
+    2.027409971e-01f, 2.182853520e-01f, 2.346298993e-01f, 2.517947257e-01f,
+    2.697980702e-01f, 2.886553109e-01f, 3.083790541e-01f, 3.289779723e-01f,
+    3.504564464e-01f, 3.728139997e-01f, 3.960442245e-01f, 4.201344550e-01f,
+    4.450648427e-01f, 4.708077908e-01f, 4.973271787e-01f, 5.245777965e-01f,
+    5.525053740e-01f, 5.810450315e-01f, 6.101223826e-01f, 6.396528482e-01f,
+    6.695418358e-01f, 6.996852160e-01f, 7.299703360e-01f, 7.602764964e-01f,
+    7.904762626e-01f, 8.204374313e-01f, 8.500236869e-01f, 8.790976405e-01f,
+    9.075222611e-01f, 9.351627231e-01f, 9.618896842e-01f, 9.875797629e-01f,
+    1.012119174e+00f, 1.035404563e+00f, 1.057344794e+00f, 1.077862978e+00f,
+    1.096896052e+00f, 1.114396811e+00f, 1.130333185e+00f, 1.144688606e+00f,
+    1.157461882e+00f, 1.168665528e+00f, 1.178325653e+00f, 1.186480522e+00f,
+    1.193179011e+00f, 1.198479056e+00f, 1.202446938e+00f, 1.205154777e+00f,
+    1.206679463e+00f, 1.207101703e+00f, 1.206503987e+00f, 1.204969525e+00f,
+    1.202582002e+00f, 1.199423313e+00f, 1.195574284e+00f, 1.191112638e+00f,
+    1.186113358e+00f, 1.180647731e+00f, 1.174783945e+00f, 1.168585896e+00f,
+    1.162113309e+00f, 1.155422568e+00f, 1.148565173e+00f, 1.141589403e+00f,
+    1.134539604e+00f, 1.127455831e+00f, 1.120375633e+00f, 1.113332391e+00f,
+    1.106356740e+00f, 1.099476457e+00f, 1.092716336e+00f, 1.086099029e+00f,
+    1.079644322e+00f, 1.073370337e+00f, 1.067292929e+00f, 1.061426401e+00f,
+    1.055783510e+00f, 1.050375104e+00f, 1.045210838e+00f, 1.040299535e+00f,
+    1.035648823e+00f, 1.031265020e+00f, 1.027153850e+00f, 1.023320317e+00f,
+    1.019768715e+00f, 1.016502500e+00f, 1.013525009e+00f, 1.010838747e+00f,
+    1.008445978e+00f, 1.006348848e+00f, 1.004548550e+00f, 1.003046393e+00f,
+    1.001843691e+00f, 1.000940919e+00f, 1.000338793e+00f, 1.000037670e+00f,
+    9.412536201e-06f, 8.472345507e-05f, 2.354020107e-04f, 4.615616344e-04f,
+    7.633725181e-04f, 1.141061774e-03f, 1.594913774e-03f, 2.125269268e-03f,
+    2.732526744e-03f, 3.417142434e-03f, 4.179629963e-03f, 5.020559765e-03f,
+    5.940563977e-03f, 6.940327585e-03f, 8.020597510e-03f, 9.182183072e-03f,
+    1.042594574e-02f, 1.175281219e-02f, 1.316376496e-02f, 1.465985179e-02f,
+    1.624217629e-02f, 1.791190542e-02f, 1.967026852e-02f, 2.151855454e-02f,
+    2.345811762e-02f, 2.549036779e-02f, 2.761678770e-02f, 2.983891033e-02f,
+    3.215834498e-02f, 3.457675874e-02f, 3.709587827e-02f, 3.971749172e-02f,
+    4.244346917e-02f, 4.527572915e-02f, 4.821624234e-02f, 5.126707256e-02f,
+    5.443033576e-02f, 5.770818517e-02f, 6.110287458e-02f, 6.461669505e-02f,
+    6.825201213e-02f, 7.201122493e-02f, 7.589684427e-02f, 7.991139591e-02f,
+    8.405743539e-02f, 8.833765984e-02f, 9.275473654e-02f, 9.731144458e-02f,
+    1.020105556e-01f, 1.068549082e-01f, 1.118474156e-01f, 1.169909611e-01f,
+    1.222885624e-01f, 1.277431697e-01f, 1.333578080e-01f, 1.391355097e-01f,
+    1.450793594e-01f, 1.511923820e-01f, 1.574776620e-01f, 1.639382541e-01f,
+    1.705772728e-01f, 1.773976833e-01f, 1.844025403e-01f, 1.915948242e-01f,
+    1.989774257e-01f, 2.065532357e-01f, 2.143250853e-01f, 2.222956419e-01f,
+    2.304676026e-01f, 2.388434708e-01f, 2.474256158e-01f, 2.562163174e-01f,
+    2.652177215e-01f, 2.744317353e-01f, 2.838602066e-01f, 2.935045958e-01f,
+    3.033663332e-01f, 3.134464920e-01f, 3.237458766e-01f, 3.342650831e-01f,
+    3.450043201e-01f, 3.559635878e-01f, 3.671424687e-01f, 3.785401285e-01f,
+    3.901554048e-01f, 4.019867778e-01f, 4.140322208e-01f, 4.262892008e-01f,
+    4.387549162e-01f, 4.514256418e-01f, 4.642976820e-01f, 4.773664176e-01f,
+    4.906268418e-01f, 5.040732622e-01f, 5.176994205e-01f, 5.314986706e-01f,
+    5.454633832e-01f, 5.595856309e-01f, 5.738565922e-01f, 5.882670879e-01f,
+    6.028071046e-01f, 6.174660325e-01f, 6.322327852e-01f, 6.470953822e-01f,
+    6.620415449e-01f, 6.770580411e-01f, 6.921315193e-01f, 7.072477937e-01f,
+    7.223922610e-01f, 7.375497818e-01f, 7.527048588e-01f, 7.678415179e-01f,
+    7.829434872e-01f, 7.979942560e-01f, 8.129768372e-01f, 8.278744221e-01f,
+    8.426697850e-01f, 8.573456407e-01f, 8.718847632e-01f, 8.862699866e-01f,
+    9.004844427e-01f, 9.145110846e-01f, 9.283332825e-01f, 9.419351220e-01f,
+    9.553005099e-01f, 9.684140086e-01f, 9.812608361e-01f, 9.938266873e-01f,
+    1.006098032e+00f, 1.018061876e+00f, 1.029706001e+00f, 1.041018963e+00f,
+    1.051990271e+00f, 1.062610388e+00f, 1.072870493e+00f, 1.082762480e+00f,
+    1.092279911e+00f, 1.101416349e+00f, 1.110167384e+00f, 1.118528485e+00f,
+    1.126496911e+00f, 1.134070516e+00f, 1.141248345e+00f, 1.148030162e+00f,
+    1.154416561e+00f, 1.160409212e+00f, 1.166010618e+00f, 1.171223998e+00f,
+    1.176053405e+00f, 1.180503726e+00f, 1.184580445e+00f, 1.188289642e+00f,
+    1.191637874e+00f, 1.194632649e+00f, 1.197281599e+00f, 1.199593186e+00f,
+    1.201575994e+00f, 1.203239083e+00f, 1.204591751e+00f, 1.205643773e+00f,
+    1.206404924e+00f, 1.206885219e+00f, 1.207095146e+00f, 1.207044721e+00f,
+    1.206744432e+00f, 1.206204891e+00f, 1.205436349e+00f, 1.204449534e+00f,
+    1.203254342e+00f, 1.201861382e+00f, 1.200280905e+00f, 1.198522687e+00f,
+    1.196597099e+00f, 1.194513440e+00f, 1.192281365e+00f, 1.189910293e+00f,
+    1.187409639e+00f, 1.184787989e+00f, 1.182054043e+00f, 1.179216623e+00f,
+    1.176283717e+00f, 1.173263431e+00f, 1.170163393e+00f, 1.166991115e+00f,
+    1.163754225e+00f, 1.160459161e+00f, 1.157112956e+00f, 1.153721929e+00f,
+    1.150292516e+00f, 1.146830559e+00f, 1.143342018e+00f, 1.139832258e+00f,
+    1.136306763e+00f, 1.132770300e+00f, 1.129227877e+00f, 1.125684142e+00f,
+    1.122143507e+00f, 1.118610144e+00f, 1.115088105e+00f, 1.111581087e+00f,
+    1.108092785e+00f, 1.104626775e+00f, 1.101186275e+00f, 1.097774267e+00f,
+    1.094393849e+00f, 1.091047883e+00f, 1.087738872e+00f, 1.084469438e+00f,
+    1.081241727e+00f, 1.078058243e+00f, 1.074920893e+00f, 1.071831942e+00f,
+    1.068793178e+00f, 1.065806150e+00f, 1.062872529e+00f, 1.059994459e+00f,
+    1.057172656e+00f, 1.054409027e+00f, 1.051704526e+00f, 1.049060702e+00f,
+    1.046478510e+00f, 1.043959022e+00f, 1.041503429e+00f, 1.039112329e+00f,
+    1.036786675e+00f, 1.034527659e+00f, 1.032335639e+00f, 1.030211449e+00f,
+    1.028155804e+00f, 1.026169300e+00f, 1.024252415e+00f, 1.022405863e+00f,
+    1.020629883e+00f, 1.018925190e+00f, 1.017292023e+00f, 1.015730858e+00f,
+    1.014242053e+00f, 1.012825966e+00f, 1.011482835e+00f, 1.010212898e+00f,
+    1.009016633e+00f, 1.007893920e+00f, 1.006845355e+00f, 1.005870819e+00f,
+    1.004970551e+00f, 1.004145026e+00f, 1.003394008e+00f, 1.002717733e+00f,
+    1.002116323e+00f, 1.001589894e+00f, 1.001138449e+00f, 1.000762224e+00f,
+    1.000461102e+00f, 1.000235319e+00f, 1.000084758e+00f, 1.000009418e+00f,
+};
+
+const uint8_t ShuffleTables[LDAC_WINDOW_TABLE_LEN] = {
+      0,  64,  96,  32,  48, 112,  80,  16,  24,  88, 120,  56,  40, 104,  72,   8,
+     12,  76, 108,  44,  60, 124,  92,  28,  20,  84, 116,  52,  36, 100,  68,   4,
+      6,  70, 102,  38,  54, 118,  86,  22,  30,  94, 126,  62,  46, 110,  78,  14,
+     10,  74, 106,  42,  58, 122,  90,  26,  18,  82, 114,  50,  34,  98,  66,   2,
+      3,  67,  99,  35,  51, 115,  83,  19,  27,  91, 123,  59,  43, 107,  75,  11,
+     15,  79, 111,  47,  63, 127,  95,  31,  23,  87, 119,  55,  39, 103,  71,   7,
+      5,  69, 101,  37,  53, 117,  85,  21,  29,  93, 125,  61,  45, 109,  77,  13,
+      9,  73, 105,  41,  57, 121,  89,  25,  17,  81, 113,  49,  33,  97,  65,   1,
+      0, 128, 192,  64,  96, 224, 160,  32,  48, 176, 240, 112,  80, 208, 144,  16,
+     24, 152, 216,  88, 120, 248, 184,  56,  40, 168, 232, 104,  72, 200, 136,   8,
+     12, 140, 204,  76, 108, 236, 172,  44,  60, 188, 252, 124,  92, 220, 156,  28,
+     20, 148, 212,  84, 116, 244, 180,  52,  36, 164, 228, 100,  68, 196, 132,   4,
+      6, 134, 198,  70, 102, 230, 166,  38,  54, 182, 246, 118,  86, 214, 150,  22,
+     30, 158, 222,  94, 126, 254, 190,  62,  46, 174, 238, 110,  78, 206, 142,  14,
+     10, 138, 202,  74, 106, 234, 170,  42,  58, 186, 250, 122,  90, 218, 154,  26,
+     18, 146, 210,  82, 114, 242, 178,  50,  34, 162, 226,  98,  66, 194, 130,   2,
+      3, 131, 195,  67,  99, 227, 163,  35,  51, 179, 243, 115,  83, 211, 147,  19,
+     27, 155, 219,  91, 123, 251, 187,  59,  43, 171, 235, 107,  75, 203, 139,  11,
+     15, 143, 207,  79, 111, 239, 175,  47,  63, 191, 255, 127,  95, 223, 159,  31,
+     23, 151, 215,  87, 119, 247, 183,  55,  39, 167, 231, 103,  71, 199, 135,   7,
+      5, 133, 197,  69, 101, 229, 165,  37,  53, 181, 245, 117,  85, 213, 149,  21,
+     29, 157, 221,  93, 125, 253, 189,  61,  45, 173, 237, 109,  77, 205, 141,  13,
+      9, 137, 201,  73, 105, 233, 169,  41,  57, 185, 249, 121,  89, 217, 153,  25,
+     17, 145, 209,  81, 113, 241, 177,  49,  33, 161, 225,  97,  65, 193, 129,   1,
+};
+
+const int32_t SinTablesFixed[LDAC_TRIG_TABLE_LEN] = {
+     1518500224,   821806464,  1984016256,   418953280,  1785567360,  2106220288,  1193077888,   210490208,
+     1012316736,  1660027264,  2055013760,  2137142912,  1893911552,  1362349184,   623381696,   105372032,
+      521795968,   918167552,  1279254528,  1591180416,  1841958144,  2021950464,  2124240384,  2144896896,
+     2083126272,  1941302272,  1724875008,  1442162048,  1104027264,   723465344,   315101504,    52701888,
+      262874912,   470516320,   673626432,   870249088,  1058490752,  1236538752,  1402678016,  1555308672,
+     1692961024,  1814309248,  1918184576,  2003586688,  2069693312,  2115867648,  2141664896,  2146836864,
+     2131333504,  2095304448,  2039096192,  1963250432,  1868497664,  1755750016,  1626093568,  1480776960,
+     1321199616,  1148898816,   965533056,   772868736,   572761216,   367137696,   157978448,    26352928,
+      131685280,   236700384,   341145280,   444768288,   547319808,   648552832,   748223424,   846091456,
+      941921216,  1035481728,  1126547840,  1214899712,  1300324992,  1382617728,  1461579520,  1537020288,
+     1608758144,  1676620416,  1740443520,  1800073856,  1855367552,  1906191616,  1952423424,  1993951616,
+     2030676352,  2062508800,  2089372672,  2111202944,  2127947264,  2139565056,  2146028544,  2147321984,
+     2143442304,  2134398976,  2120213632,  2100920576,  2076566144,  2047209216,  2012920192,  1973782016,
+     1929888640,  1881346304,  1828271232,  1770792064,  1709046656,  1643184128,  1573363200,  1499751552,
+     1422527104,  1341875456,  1257991296,  1171076736,  1081340416,   988999488,   894275520,   797397696,
+      698598336,   598116480,   496193696,   393075072,   289009984,   184248144,    79042944,    13176712,
+       65873636,   118530888,   171116736,   223599504,   275947584,   328129472,   380113664,   431868896,
+      483364032,   534567968,   585449920,   635979136,   686125376,   735858304,   785147904,   833964608,
+      882279040,   930061888,   977284544,  1023918592,  1069935744,  1115308544,  1160009472,  1204011648,
+     1247288576,  1289814016,  1331562752,  1372509312,  1412629120,  1451898112,  1490292352,  1527788928,
+     1564365312,  1599999360,  1634669696,  1668355328,  1701035904,  1732691840,  1763304192,  1792854400,
+     1821324544,  1848697600,  1874957184,  1900087296,  1924072960,  1946899456,  1968553216,  1989021312,
+     2008291328,  2026351488,  2043191168,  2058800000,  2073168768,  2086288640,  2098151936,  2108751360,
+     2118080512,  2126133760,  2132906368,  2138394240,  2142593920,  2145503104,  2147119872,  2147443200,
+     2146473088,  2144210048,  2140655232,  2135811200,  2129680512,  2122267008,  2113575040,  2103609984,
+     2092377856,  2079885312,  2066140032,  2051150080,  2034924544,  2017473408,  1998806784,  1978936320,
+     1957873792,  1935631872,  1912224000,  1887664512,  1861967616,  1835149312,  1807225472,  1778213248,
+     1748129664,  1716993152,  1684822528,  1651636864,  1617456256,  1582301696,  1546193664,  1509154304,
+     1471205888,  1432371584,  1392674048,  1352137728,  1310787328,  1268646912,  1225742208,  1182099328,
+     1137744768,  1092704384,  1047005888,  1000677056,   953745088,   906238592,   858186240,   809617344,
+      760560320,   711045184,   661102272,   610760576,   560051008,   509004544,   457651008,   406021824,
+      354148032,   302061440,   249792368,   197372848,   144834944,    92209280,    39528076,     6588387,
+       32940694,    59288040,    85626464,   111951984,   138260640,   164548496,   190811552,   217045872,
+      243247520,   269412512,   295536960,   321616864,   347648384,   373627520,   399550368,   425413088,
+      451211744,   476942400,   502601280,   528184448,   553688064,   579108288,   604441344,   629683392,
+      654830592,   679879104,   704825280,   729665280,   754395456,   779012032,   803511232,   827889408,
+      852142976,   876268160,   900261440,   924119104,   947837632,   971413312,   994842816,  1018122432,
+     1041248768,  1064218240,  1087027584,  1109673088,  1132151552,  1154459520,  1176593536,  1198550400,
+     1220326784,  1241919488,  1263325056,  1284540288,  1305562240,  1326387456,  1347012992,  1367435648,
+     1387652480,  1407660160,  1427455872,  1447036800,  1466399616,  1485541760,  1504460032,  1523151744,
+     1541614208,  1559844352,  1577839744,  1595597440,  1613114880,  1630389376,  1647418240,  1664199168,
+     1680729344,  1697006464,  1713028096,  1728791552,  1744294912,  1759535360,  1774510976,  1789219328,
+     1803658240,  1817825408,  1831719040,  1845336576,  1858676352,  1871736192,  1884514176,  1897008256,
+     1909216768,  1921137792,  1932769408,  1944109952,  1955157760,  1965911040,  1976368384,  1986528128,
+     1996388608,  2005948416,  2015206272,  2024160512,  2032809984,  2041153280,  2049189248,  2056916608,
+     2064334080,  2071440768,  2078235520,  2084717312,  2090885120,  2096738048,  2102275200,  2107495808,
+     2112398976,  2116984064,  2121250304,  2125197056,  2128823808,  2132130048,  2135115136,  2137778688,
+     2140120192,  2142139520,  2143836288,  2145210112,  2146260864,  2146988416,  2147392640,  2147473536,
+     2147230976,  2146665088,  2145775872,  2144563584,  2143028224,  2141170176,  2138989696,  2136487040,
+     2133662720,  2130516992,  2127050496,  2123263616,  2119156992,  2114731264,  2109987072,  2104925056,
+     2099546112,  2093851008,  2087840512,  2081515648,  2074877312,  2067926400,  2060664064,  2053091456,
+     2045209728,  2037020032,  2028523392,  2019721472,  2010615168,  2001206144,  1991495808,  1981485568,
+     1971176960,  1960571392,  1949670656,  1938476160,  1926989824,  1915213312,  1903148288,  1890796928,
+     1878160640,  1865241472,  1852041344,  1838562304,  1824806528,  1810775808,  1796472704,  1781898752,
+     1767056512,  1751948160,  1736575872,  1720942080,  1705049216,  1688899840,  1672495744,  1655839872,
+     1638934656,  1621782528,  1604386176,  1586748288,  1568871680,  1550758528,  1532411904,  1513834368,
+     1495028992,  1475998336,  1456745472,  1437273600,  1417584896,  1397682688,  1377569920,  1357249792,
+     1336725248,  1315999872,  1295075840,  1273956736,  1252645760,  1231146240,  1209461248,  1187594112,
+     1165548672,  1143327104,  1120933504,  1098370944,  1075643136,  1052753216,  1029704832,  1006501760,
+      983146688,   959643584,   935995968,   912207360,   888281344,   864221632,   840032192,   815715776,
+      791276544,   766718144,   742044288,   717258624,   692364992,   667367552,   642269184,   617074048,
+      591785984,   566408768,   540946304,   515402336,   489781248,   464085920,   438320704,   412489472,
+      386596128,   360644576,   334639200,   308582912,   282480160,   256334880,   230150992,   203932432,
+      177683168,   151407664,   125108840,    98791176,    72458632,    46115180,    19764782,
+};
+
+const int32_t CosTablesFixed[LDAC_TRIG_TABLE_LEN] = {
+     1518500224,  1984016128,  -821806336,  2106220288,  1193078016,  -418953280, -1785567488,  2137142912,
+     1893911552,  1362349184,   623381504,  -210490128, -1012316544, -1660027392, -2055013760,  2144896896,
+     2083126272,  1941302272,  1724875008,  1442161920,  1104027392,   723465408,   315101344,  -105371912,
+     -521796000,  -918167552, -1279254656, -1591180288, -1841958144, -2021950592, -2124240384,  2146836864,
+     2131333632,  2095304320,  2039096192,  1963250560,  1868497664,  1755750016,  1626093568,  1480777088,
+     1321199744,  1148898688,   965532928,   772868800,   572761280,   367137792,   157978800,   -52701876,
+     -262874992,  -470516224,  -673626368,  -870249152, -1058490752, -1236538624, -1402678016, -1555308928,
+    -1692961152, -1814309120, -1918184576, -2003586816, -2069693312, -2115867648, -2141665024,  2147321984,
+     2143442304,  2134398976,  2120213632,  2100920576,  2076566144,  2047209088,  2012920192,  1973782016,
+     1929888768,  1881346176,  1828271360,  1770792064,  1709046784,  1643184128,  1573363072,  1499751552,
+     1422526976,  1341875584,  1257991296,  1171076480,  1081340544,   988999360,   894275648,   797397504,
+      698598400,   598116544,   496193568,   393075168,   289009824,   184248240,    79042784,   -26352840,
+     -131685232,  -236700384,  -341145312,  -444768384,  -547319936,  -648552768,  -748223360,  -846091456,
+     -941921216, -1035481600, -1126547840, -1214899712, -1300325248, -1382617728, -1461579392, -1537020288,
+    -1608758016, -1676620544, -1740443520, -1800073728, -1855367552, -1906191488, -1952423424, -1993951616,
+    -2030676352, -2062508800, -2089372544, -2111202944, -2127947136, -2139565056, -2146028416,  2147443200,
+     2146473088,  2144209920,  2140655232,  2135811200,  2129680512,  2122267008,  2113575040,  2103610112,
+     2092377856,  2079885312,  2066140032,  2051150080,  2034924544,  2017473280,  1998806784,  1978936320,
+     1957873792,  1935631872,  1912224128,  1887664384,  1861967616,  1835149312,  1807225600,  1778213120,
+     1748129664,  1716993280,  1684822528,  1651636864,  1617456384,  1582301568,  1546193536,  1509154304,
+     1471206016,  1432371456,  1392674048,  1352137728,  1310787072,  1268646784,  1225742336,  1182099456,
+     1137744640,  1092704512,  1047005952,  1000676928,   953744960,   906238656,   858186560,   809617216,
+      760560448,   711045312,   661102080,   610760640,   560051072,   509004384,   457650848,   406021920,
+      354148128,   302061280,   249792464,   197372944,   144834768,    92209120,    39528168,   -13176587,
+      -65873664,  -118530800,  -171116800,  -223599472,  -275947712,  -328129472,  -380113568,  -431868960,
+     -483363968,  -534568064,  -585449856,  -635979072,  -686125440,  -735858240,  -785147968,  -833964608,
+     -882279104,  -930061888,  -977284672, -1023918336, -1069935744, -1115308544, -1160009600, -1204011520,
+    -1247288448, -1289814272, -1331562624, -1372509312, -1412629248, -1451897856, -1490292352, -1527789056,
+    -1564365440, -1599999360, -1634669696, -1668355328, -1701035776, -1732691840, -1763304320, -1792854528,
+    -1821324544, -1848697728, -1874957312, -1900087168, -1924072832, -1946899456, -1968553344, -1989021312,
+    -2008291328, -2026351616, -2043191040, -2058800000, -2073168768, -2086288640, -2098151936, -2108751360,
+    -2118080512, -2126133760, -2132906368, -2138394240, -2142593920, -2145503104, -2147119872,  2147473536,
+     2147230976,  2146665088,  2145775872,  2144563584,  2143028224,  2141170176,  2138989696,  2136487040,
+     2133662720,  2130516992,  2127050496,  2123263616,  2119156992,  2114731264,  2109987072,  2104925056,
+     2099546112,  2093851008,  2087840512,  2081515648,  2074877184,  2067926400,  2060664192,  2053091584,
+     2045209728,  2037020032,  2028523392,  2019721344,  2010615168,  2001206272,  1991495808,  1981485568,
+     1971176960,  1960571392,  1949670528,  1938476160,  1926989824,  1915213312,  1903148416,  1890796800,
+     1878160512,  1865241472,  1852041344,  1838562432,  1824806528,  1810775936,  1796472576,  1781898624,
+     1767056512,  1751948032,  1736575872,  1720942208,  1705049344,  1688899712,  1672495744,  1655839872,
+     1638934656,  1621782656,  1604386432,  1586748416,  1568871680,  1550758400,  1532411904,  1513834496,
+     1495028992,  1475998464,  1456745600,  1437273472,  1417584768,  1397682560,  1377570048,  1357249920,
+     1336725504,  1315999616,  1295075712,  1273956736,  1252645760,  1231146368,  1209461376,  1187594368,
+     1165548416,  1143326976,  1120933376,  1098371072,  1075643136,  1052753344,  1029704896,  1006501632,
+      983146560,   959643456,   935996032,   912207424,   888281472,   864221952,   840032064,   815715648,
+      791276416,   766718208,   742044352,   717258752,   692365312,   667367424,   642268992,   617073856,
+      591786048,   566408832,   540946368,   515402656,   489781088,   464085760,   438320544,   412489568,
+      386596224,   360644640,   334639040,   308582752,   282480000,   256334976,   230151072,   203932528,
+      177683264,   151407504,   125108672,    98791008,    72458728,    46115272,    19764876,    -6588500,
+      -32940626,   -59288048,   -85626544,  -111951880,  -138260624,  -164548544,  -190811680,  -217045824,
+     -243247536,  -269412608,  -295536864,  -321616864,  -347648448,  -373627392,  -399550336,  -425413120,
+     -451211840,  -476942336,  -502601280,  -528184512,  -553688000,  -579108288,  -604441408,  -629683456,
+     -654830464,  -679879104,  -704825344,  -729665216,  -754395456,  -779012032,  -803511296,  -827889344,
+     -852142976,  -876268224,  -900261312,  -924119040,  -947837632,  -971413440,  -994843008, -1018122240,
+    -1041248640, -1064218240, -1087027584, -1109673088, -1132151680, -1154459648, -1176593408, -1198550272,
+    -1220326784, -1241919488, -1263325056, -1284540416, -1305562368, -1326387328, -1347012864, -1367435648,
+    -1387652480, -1407660288, -1427456128, -1447036928, -1466399488, -1485541632, -1504460032, -1523151872,
+    -1541614208, -1559844480, -1577839872, -1595597312, -1613114752, -1630389248, -1647418240, -1664199168,
+    -1680729472, -1697006336, -1713027968, -1728791552, -1744294784, -1759535488, -1774511104, -1789219456,
+    -1803658112, -1817825408, -1831718912, -1845336576, -1858676352, -1871736320, -1884514304, -1897008256,
+    -1909216768, -1921137792, -1932769408, -1944110080, -1955157888, -1965911296, -1976368384, -1986528128,
+    -1996388608, -2005948544, -2015206272, -2024160640, -2032810112, -2041153280, -2049189248, -2056916608,
+    -2064334080, -2071440896, -2078235648, -2084717312, -2090885120, -2096738048, -2102275200, -2107495808,
+    -2112398976, -2116984064, -2121250304, -2125197056, -2128823808, -2132130048, -2135115136, -2137778688,
+    -2140120192, -2142139520, -2143836288, -2145210112, -2146260864, -2146988416, -2147392640,
+};
+
+const int32_t ImdctWindowsFixed[LDAC_WINDOW_TABLE_LEN] = {
+          40428,      364039,     1012234,     1986965,     3291163,     4928745,     6904621,     9224702,
+       11895911,    14926192,    18324520,    22100924,    26266478,    30833342,    35814732,    41224976,
+       47079484,    53394752,    60188380,    67479032,    75286448,    83631424,    92535728,   102022088,
+      112114112,   122836184,   134213488,   146271632,   159036752,   172535120,   186793072,   201836720,
+      217691488,   234382112,   251931936,   270362528,   289693472,   309941280,   331119488,   353237408,
+      376299744,   400305984,   425249248,   451115936,   477884736,   505526016,   534000992,   563261120,
+      593248128,   623892352,   655113920,   686822016,   718915072,   751281280,   783799680,   816340672,
+      848767424,   880937984,   912705984,   943923904,   974444608,  1004123328,  1032821184,  1060405696,
+     1086754688,  1111757184,  1135315328,  1157346560,  1177783168,  1196574464,  1213686016,  1229100032,
+     1242815232,  1254845056,  1265217536,  1273973760,  1281166208,  1286857088,  1291117568,  1294025088,
+     1295662208,  1296115584,  1295473792,  1293826176,  1291262592,  1287870976,  1283738112,  1278947456,
+     1273579520,  1267710848,  1261414656,  1254759552,  1247809664,  1240625536,  1233262464,  1225772288,
+     1218202624,  1210596480,  1202994176,  1195431552,  1187941504,  1180553856,  1173295232,  1166189952,
+     1159259264,  1152522624,  1145997056,  1139697920,  1133638912,  1127831680,  1122286592,  1117013120,
+     1112019456,  1107312384,  1102898048,  1098781824,  1094968320,  1091461248,  1088264192,  1085379840,
+     1082810624,  1080558848,  1078625792,  1077012864,  1075721472,  1074752128,  1074105600,  1073782272,
+          10107,       90971,      252761,      495598,      819665,     1225206,     1712526,     2281991,
+        2934028,     3669129,     4487844,     5390785,     6378632,     7452120,     8612051,     9859294,
+       11194774,    12619486,    14134485,    15740896,    17439904,    19232762,    21120790,    23105372,
+       25187962,    27370074,    29653300,    32039286,    34529760,    37126512,    39831396,    42646332,
+       45573328,    48614444,    51771796,    55047600,    58444128,    61963692,    65608712,    69381648,
+       73285040,    77321464,    81493616,    85804208,    90255984,    94851840,    99594640,   104487368,
+      109533000,   114734584,   120095248,   125618088,   131306344,   137163184,   143191856,   149395616,
+      155777776,   162341584,   169090352,   176027360,   183155952,   190479312,   198000720,   205723376,
+      213650384,   221784848,   230129808,   238688128,   247462704,   256456224,   265671232,   275110176,
+      284775360,   294668832,   304792576,   315148160,   325737120,   336560608,   347619488,   358914400,
+      370445568,   382212992,   394216224,   406454368,   418926176,   431630016,   444563712,   457724544,
+      471109504,   484714592,   498535840,   512568288,   526806560,   541244544,   555875520,   570692352,
+      585686848,   600850496,   616173824,   631646976,   647259200,   662999104,   678854784,   694813376,
+      710861696,   726985536,   743170560,   759401536,   775662784,   791938048,   808210688,   824463552,
+      840679168,   856839808,   872927232,   888923392,   904809792,   920567872,   936179136,   951625152,
+      966887808,   981948800,   996790272,  1011395136,  1025746112,  1039826624,  1053620800,  1067113280,
+     1080289536,  1093135616,  1105638400,  1117785600,  1129565952,  1140969216,  1151985920,  1162607360,
+     1172826624,  1182636800,  1192033152,  1201010816,  1209566848,  1217698944,  1225406080,  1232688000,
+     1239545344,  1245979904,  1251994368,  1257592192,  1262777728,  1267556224,  1271933568,  1275916288,
+     1279511424,  1282727040,  1285571328,  1288053376,  1290182400,  1291968128,  1293420544,  1294550144,
+     1295367424,  1295883136,  1296108544,  1296054400,  1295731968,  1295152640,  1294327424,  1293267840,
+     1291984512,  1290488832,  1288791808,  1286903936,  1284836352,  1282599040,  1280202368,  1277656448,
+     1274971392,  1272156416,  1269220864,  1266174208,  1263025024,  1259782016,  1256453376,  1253047168,
+     1249571584,  1246033536,  1242440576,  1238799488,  1235117184,  1231399936,  1227654144,  1223885568,
+     1220100096,  1216302848,  1212499200,  1208694144,  1204892416,  1201098496,  1197316736,  1193551104,
+     1189805568,  1186083968,  1182389760,  1178726144,  1175096448,  1171503744,  1167950720,  1164440192,
+     1160974464,  1157556224,  1154187520,  1150870784,  1147607936,  1144400640,  1141250688,  1138160384,
+     1135130496,  1132163072,  1129259136,  1126420352,  1123647744,  1120942464,  1118305792,  1115738368,
+     1113241216,  1110815616,  1108461952,  1106181120,  1103973888,  1101840896,  1099782656,  1097799936,
+     1095892992,  1094062592,  1092308992,  1090632704,  1089034112,  1087513600,  1086071424,  1084707840,
+     1083423360,  1082217856,  1081091968,  1080045568,  1079078912,  1078192512,  1077386112,  1076659968,
+     1076014208,  1075448960,  1074964224,  1074560256,  1074236928,  1073994496,  1073832832,  1073751936,
+};
+
+const uint16_t ScaleFactorsA3Lookup[64] = {
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201,
+    0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x207, 0x207, 0x207, 0x207,
+    0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207,
+    0x306, 0x306, 0x306, 0x306, 0x306, 0x306, 0x306, 0x306, 0x402, 0x402, 0x402, 0x402,
+    0x505, 0x505, 0x603, 0x604,
+};
+
+const uint16_t ScaleFactorsA4Lookup[256] = {
+    0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402,
+    0x402, 0x402, 0x402, 0x402, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E,
+    0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x80B, 0x80A, 0x809, 0x806,
+    0x807, 0x808, 0x705, 0x705, 0x50D, 0x50D, 0x50D, 0x50D, 0x50D, 0x50D, 0x50D, 0x50D,
+    0x503, 0x503, 0x503, 0x503, 0x503, 0x503, 0x503, 0x503, 0x60C, 0x60C, 0x60C, 0x60C,
+    0x604, 0x604, 0x604, 0x604, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x201, 0x201, 0x201, 0x201,
+    0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201,
+    0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201,
+    0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201,
+    0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201,
+    0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201, 0x201,
+    0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F,
+    0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F,
+    0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F,
+    0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F,
+    0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F, 0x20F,
+    0x20F, 0x20F, 0x20F, 0x20F,
+};
+
+const uint16_t ScaleFactorsA5Lookup[256] = {
+    0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F,
+    0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F,
+    0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x71A, 0x71A, 0x707, 0x707, 0x814, 0x815, 0x817, 0x816,
+    0x51D, 0x51D, 0x51D, 0x51D, 0x51D, 0x51D, 0x51D, 0x51D, 0x41E, 0x41E, 0x41E, 0x41E,
+    0x41E, 0x41E, 0x41E, 0x41E, 0x41E, 0x41E, 0x41E, 0x41E, 0x41E, 0x41E, 0x41E, 0x41E,
+    0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x80B, 0x818, 0x809, 0x80A,
+    0x606, 0x606, 0x606, 0x606, 0x719, 0x719, 0x813, 0x80C, 0x61B, 0x61B, 0x61B, 0x61B,
+    0x812, 0x80D, 0x810, 0x811, 0x80E, 0x80F, 0x708, 0x708, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x505, 0x505, 0x505, 0x505, 0x505, 0x505, 0x505, 0x505, 0x51C, 0x51C, 0x51C, 0x51C,
+    0x51C, 0x51C, 0x51C, 0x51C, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403,
+    0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x302, 0x302, 0x302, 0x302,
+    0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302,
+    0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302, 0x302,
+    0x302, 0x302, 0x302, 0x302,
+};
+
+const uint16_t ScaleFactorsA6Lookup[256] = {
+    0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300,
+    0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300,
+    0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402,
+    0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x403, 0x403, 0x403, 0x403,
+    0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403,
+    0x43D, 0x43D, 0x43D, 0x43D, 0x43D, 0x43D, 0x43D, 0x43D, 0x43D, 0x43D, 0x43D, 0x43D,
+    0x43D, 0x43D, 0x43D, 0x43D, 0x43E, 0x43E, 0x43E, 0x43E, 0x43E, 0x43E, 0x43E, 0x43E,
+    0x43E, 0x43E, 0x43E, 0x43E, 0x43E, 0x43E, 0x43E, 0x43E, 0x43F, 0x43F, 0x43F, 0x43F,
+    0x43F, 0x43F, 0x43F, 0x43F, 0x43F, 0x43F, 0x43F, 0x43F, 0x43F, 0x43F, 0x43F, 0x43F,
+    0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x505, 0x505, 0x505, 0x505,
+    0x505, 0x505, 0x505, 0x505, 0x53A, 0x53A, 0x53A, 0x53A, 0x53A, 0x53A, 0x53A, 0x53A,
+    0x53B, 0x53B, 0x53B, 0x53B, 0x53B, 0x53B, 0x53B, 0x53B, 0x53C, 0x53C, 0x53C, 0x53C,
+    0x53C, 0x53C, 0x53C, 0x53C, 0x606, 0x606, 0x606, 0x606, 0x607, 0x607, 0x607, 0x607,
+    0x608, 0x608, 0x608, 0x608, 0x638, 0x638, 0x638, 0x638, 0x639, 0x639, 0x639, 0x639,
+    0x709, 0x709, 0x70A, 0x70A, 0x735, 0x735, 0x736, 0x736, 0x737, 0x737, 0x80B, 0x80C,
+    0x80D, 0x80E, 0x80F, 0x810, 0x811, 0x812, 0x813, 0x814, 0x815, 0x816, 0x817, 0x818,
+    0x819, 0x81A, 0x81B, 0x81C, 0x81D, 0x81E, 0x81F, 0x820, 0x821, 0x822, 0x823, 0x824,
+    0x825, 0x826, 0x827, 0x828, 0x829, 0x82A, 0x82B, 0x82C, 0x82D, 0x82E, 0x82F, 0x830,
+    0x831, 0x832, 0x833, 0x834,
+};
+
+const uint16_t ScaleFactorsB2Lookup[4] = {
+    0x100, 0x100, 0x203, 0x201,
+};
+
+const uint16_t ScaleFactorsB3Lookup[64] = {
+    0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x502, 0x502, 0x605, 0x603,
+    0x406, 0x406, 0x406, 0x406, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207,
+    0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x207, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100,
+};
+
+const uint16_t ScaleFactorsB4Lookup[256] = {
+    0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F,
+    0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F,
+    0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x30F, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402,
+    0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x60D, 0x60D, 0x60D, 0x60D,
+    0x60C, 0x60C, 0x60C, 0x60C, 0x705, 0x705, 0x806, 0x80A, 0x809, 0x807, 0x70B, 0x70B,
+    0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E, 0x40E,
+    0x40E, 0x40E, 0x40E, 0x40E, 0x503, 0x503, 0x503, 0x503, 0x503, 0x503, 0x503, 0x503,
+    0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100,
+};
+
+const uint16_t ScaleFactorsB5Lookup[256] = {
+    0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300,
+    0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300,
+    0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x300, 0x405, 0x405, 0x405, 0x405,
+    0x405, 0x405, 0x405, 0x405, 0x405, 0x405, 0x405, 0x405, 0x405, 0x405, 0x405, 0x405,
+    0x406, 0x406, 0x406, 0x406, 0x406, 0x406, 0x406, 0x406, 0x406, 0x406, 0x406, 0x406,
+    0x406, 0x406, 0x406, 0x406, 0x404, 0x404, 0x404, 0x404, 0x404, 0x404, 0x404, 0x404,
+    0x404, 0x404, 0x404, 0x404, 0x404, 0x404, 0x404, 0x404, 0x407, 0x407, 0x407, 0x407,
+    0x407, 0x407, 0x407, 0x407, 0x407, 0x407, 0x407, 0x407, 0x407, 0x407, 0x407, 0x407,
+    0x80E, 0x811, 0x810, 0x812, 0x813, 0x80F, 0x70B, 0x70B, 0x61E, 0x61E, 0x61E, 0x61E,
+    0x70C, 0x70C, 0x71D, 0x71D, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402,
+    0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x402, 0x509, 0x509, 0x509, 0x509,
+    0x509, 0x509, 0x509, 0x509, 0x71C, 0x71C, 0x71B, 0x71B, 0x60A, 0x60A, 0x60A, 0x60A,
+    0x408, 0x408, 0x408, 0x408, 0x408, 0x408, 0x408, 0x408, 0x408, 0x408, 0x408, 0x408,
+    0x408, 0x408, 0x408, 0x408, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301,
+    0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301, 0x301,
+    0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403, 0x403,
+    0x403, 0x403, 0x403, 0x403, 0x719, 0x719, 0x71A, 0x71A, 0x718, 0x718, 0x717, 0x717,
+    0x716, 0x716, 0x715, 0x715, 0x70D, 0x70D, 0x714, 0x714, 0x31F, 0x31F, 0x31F, 0x31F,
+    0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F,
+    0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F, 0x31F,
+    0x31F, 0x31F, 0x31F, 0x31F,
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Constant tables generated by gen_tables.py into tables.c.
+ *
+ * Trig tables for all sizes 2^0..2^8 are packed back to back, the table for 2^i
+ * starts at offset (1<<i)-1. Window and shuffle tables exist for 2^7 and 2^8 and
+ * the table for 2^i starts at offset (1<<i)-(1<<7). */
+#define LDAC_TRIG_TABLE_LEN     ((1<<9)-1)
+#define LDAC_WINDOW_TABLE_LEN   ((1<<7)+(1<<8))
+
+#define LDAC_TRIG_OFFSET(i)     ((1<<(i))-1)
+#define LDAC_WINDOW_OFFSET(i)   ((1<<(i))-(1<<7))
+
+extern const float SinTables[LDAC_TRIG_TABLE_LEN];
+extern const float CosTables[LDAC_TRIG_TABLE_LEN];
+extern const float ImdctWindows[LDAC_WINDOW_TABLE_LEN];
+extern const uint8_t ShuffleTables[LDAC_WINDOW_TABLE_LEN];
+
+/* Q31 twiddles and Q30 window for the fixed point engine */
+extern const int32_t SinTablesFixed[LDAC_TRIG_TABLE_LEN];
+extern const int32_t CosTablesFixed[LDAC_TRIG_TABLE_LEN];
+extern const int32_t ImdctWindowsFixed[LDAC_WINDOW_TABLE_LEN];
+
+/* Huffman lookups indexed by the next MaxBitSize bits, (code length << 8) | value */
+extern const uint16_t ScaleFactorsA3Lookup[64];
+extern const uint16_t ScaleFactorsA4Lookup[256];
+extern const uint16_t ScaleFactorsA5Lookup[256];
+extern const uint16_t ScaleFactorsA6Lookup[256];
+
+extern const uint16_t ScaleFactorsB2Lookup[4];
+extern const uint16_t ScaleFactorsB3Lookup[64];
+extern const uint16_t ScaleFactorsB4Lookup[256];
+extern const uint16_t ScaleFactorsB5Lookup[256];
@@ -29,9 +29,24 @@ int16_t Clamp16(int value)
 	return (int16_t)value;
 }
 
+int32_t ClampBits(int64_t value, int bits)
+{
+	const int64_t limit = (int64_t)1 << (bits - 1);
+	if (value >= limit)
+		return (int32_t)(limit - 1);
+	if (value < -limit)
+		return (int32_t)-limit;
+	return (int32_t)value;
+}
+
 int Round(float x)
 {
 	x += 0.5;
 	return (int)x - (x < (int)x);
 }
 
+int64_t Round64(float x)
+{
+	return (int64_t)floorf(x + 0.5f);
+}
+
@@ -28,5 +28,7 @@ int Min(int a, int b);
 uint32_t BitReverse32(uint32_t value, int bitCount);
 int32_t SignExtend32(int32_t value, int bits);
 int16_t Clamp16(int value);
+int32_t ClampBits(int64_t value, int bits);
 int Round(float x);
+int64_t Round64(float x);
 
@@ -126,6 +126,74 @@ typedef struct {
 #define DCTIII_8_SHIFT_IN 3
 #define DCTIII_8_SHIFT_OUT 14
 
+/* Xtensa cores with the MAC16 option run the 8-subband synthesis window on it,
+ * see synthesis-8-window.c. Cores with MULSH take the high half of 32x32 bit
+ * products in one instruction. Both give the same output as the C code. */
+#ifdef __XTENSA__
+#include "xtensa/config/core-isa.h"
+
+#if XCHAL_HAVE_MAC16
+#define OI_SBC_SYNTH_MAC16
+#endif
+
+#if XCHAL_HAVE_MUL32_HIGH
+#define OI_SBC_MUL32_HIGH
+#endif
+#endif /* __XTENSA__ */
+
+/**
+ * Default C language implementation of a 32x32->32 multiply. This function may
+ * be replaced by a platform-specific version for speed, see MUL_32S_32S_HI in
+ * synthesis-dct8.c.
+ *
+ * @param u A signed 32-bit multiplicand
+ * @param v A signed 32-bit multiplier
+
+ * @return  A signed 32-bit value corresponding to the 32 most significant bits
+ * of the 64-bit product of u and v.
+ */
+static inline OI_INT32 default_mul_32s_32s_hi(OI_INT32 u, OI_INT32 v)
+{
+    OI_UINT32 u0, v0;
+    OI_INT32 u1, v1, w1, w2, t;
+
+    u0 = u & 0xFFFF; u1 = u >> 16;
+    v0 = v & 0xFFFF; v1 = v >> 16;
+    t = u0 * v0;
+    t = u1 * v0 + ((OI_UINT32)t >> 16);
+    w1 = t & 0xFFFF;
+    w2 = t >> 16;
+    w1 = u0 * v1 + w1;
+    return u1 * v1 + w2 + (w1 >> 16);
+}
+
+/**
+ * Default C language implementation of a 16x32->32 multiply. This function may
+ * be replaced by a platform-specific version for speed, see MUL_16S_32S_HI in
+ * synthesis-sbc.c.
+ *
+ * @param u A signed 16-bit multiplicand
+ * @param v A signed 32-bit multiplier
+
+ * @return  A signed 32-bit value corresponding to the 32 most significant bits
+ * of the 48-bit product of u and v.
+ */
+static inline OI_INT32 default_mul_16s_32s_hi(OI_INT16 u, OI_INT32 v)
+{
+    OI_UINT16 v0;
+    OI_INT16 v1;
+
+    OI_INT32 w, x;
+
+    v0 = (OI_UINT16)(v & 0xffff);
+    v1 = (OI_INT16) (v >> 16);
+
+    w = v1 * u;
+    x = u * v0;
+
+    return w + (x >> 16);
+}
+
 OI_UINT computeBitneed(OI_CODEC_SBC_COMMON_CONTEXT *common,
                        OI_UINT8 *bitneeds,
                        OI_UINT ch,
@@ -184,6 +252,10 @@ PRIVATE OI_UINT8 OI_SBC_CalculateChecksum(OI_CODEC_SBC_FRAME_INFO *frame, OI_BYT
 PRIVATE void shift_buffer(SBC_BUFFER_T *dest, SBC_BUFFER_T *src, OI_UINT wordCount);
 PRIVATE void cosineModulateSynth4(SBC_BUFFER_T *RESTRICT out, OI_INT32 const *RESTRICT in);
 PRIVATE void SynthWindow40_int32_int32_symmetry_with_sum(OI_INT16 *pcm, SBC_BUFFER_T buffer[80], OI_UINT strideShift);
+PRIVATE void SynthWindow80_c(OI_INT16 *pcm, SBC_BUFFER_T const *RESTRICT buffer, OI_UINT strideShift);
+#ifdef OI_SBC_SYNTH_MAC16
+PRIVATE void SynthWindow80_mac16(OI_INT16 *pcm, SBC_BUFFER_T const *RESTRICT buffer, OI_UINT strideShift);
+#endif
 
 void dct3_4(OI_INT32 *RESTRICT out, OI_INT32 const *RESTRICT in);
 PRIVATE void analyze4_generated(SBC_BUFFER_T analysisBuffer[RESTRICT 40],
@@ -39,6 +39,8 @@
   $Revision: #1 $
 ***********************************************************************************/
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -306,12 +308,13 @@ typedef OI_UINT32 OI_ELEMENT_UNION; /**< Type for first element of a union to su
  *  @{
  */
 
-typedef signed char     OI_INT8;   /**< 8-bit signed integer values use native signed character data type for ARM7 processor. */
-typedef signed short    OI_INT16;  /**< 16-bit signed integer values use native signed short integer data type for ARM7 processor. */
-typedef signed long     OI_INT32;  /**< 32-bit signed integer values use native signed long integer data type for ARM7 processor. */
-typedef unsigned char   OI_UINT8;  /**< 8-bit unsigned integer values use native unsigned character data type for ARM7 processor. */
-typedef unsigned short  OI_UINT16; /**< 16-bit unsigned integer values use native unsigned short integer data type for ARM7 processor. */
-typedef unsigned long   OI_UINT32; /**< 32-bit unsigned integer values use native unsigned long integer data type for ARM7 processor. */
+/* fixed width types, long is 64 bit when the codec is built for a 64 bit host */
+typedef int8_t          OI_INT8;   /**< 8-bit signed integer. */
+typedef int16_t         OI_INT16;  /**< 16-bit signed integer. */
+typedef int32_t         OI_INT32;  /**< 32-bit signed integer. */
+typedef uint8_t         OI_UINT8;  /**< 8-bit unsigned integer. */
+typedef uint16_t        OI_UINT16; /**< 16-bit unsigned integer. */
+typedef uint32_t        OI_UINT32; /**< 32-bit unsigned integer. */
 
 typedef void *OI_ELEMENT_UNION;  /**< Type for first element of a union to support all data types up to pointer width. */
 
@@ -314,7 +314,7 @@ OI_STATUS OI_CODEC_SBC_DecodeFrame(OI_CODEC_SBC_DECODER_CONTEXT *context,
         return OI_STATUS_INVALID_PARAMETERS;
     }
     if (context->common.frameInfo.bitpool > OI_SBC_MaxBitpool(&context->common.frameInfo)) {
-        ERROR(("Bitpool too large: %d (must be <= %ld)", context->common.frameInfo.bitpool, OI_SBC_MaxBitpool(&context->common.frameInfo)));
+        ERROR(("Bitpool too large: %d (must be <= %ld)", context->common.frameInfo.bitpool, (long)OI_SBC_MaxBitpool(&context->common.frameInfo)));
         return OI_STATUS_INVALID_PARAMETERS;
     }
 #endif
@@ -0,0 +1,200 @@
+/******************************************************************************
+ *
+ *  Copyright (C) 2014 The Android Open Source Project
+ *  Copyright 2003 - 2004 Open Interface North America, Inc. All rights reserved.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+/** @file
+
+Windowing of the 8-subband synthesis filterbank, see synthesis-sbc.c for the
+layout of the DCT history in the filter buffer.
+
+Output sample j of a block is a sum of 10 taps, two per group of 16 buffer
+entries, buffer[16*p + 4 + j] and buffer[16*p + 12 - j] for p = 0..4.
+
+The coefficients are those of the former synthesis-8-generated.c, 15 bit
+mantissas with a shift each, taken at 2^-4 of their unit: only 13 of the
+smallest taps, below 2^9, lose bits there. Such a coefficient needs up to 21
+bits, so it is split in two 16 bit halves, c = 256 * hi + lo with lo in
+-128..127. Row j of dec_window_8 holds the 10 hi values, then the 10 lo values:
+
+@code
+    hi_sum = sum{p=0..4}(w[2*p]      * buffer[16*p + 4 + j] + w[2*p + 1]  * buffer[16*p + 12 - j])
+    lo_sum = sum{p=0..4}(w[10 + 2*p] * buffer[16*p + 4 + j] + w[11 + 2*p] * buffer[16*p + 12 - j])
+    pcm[j] = (hi_sum + (lo_sum >> 8)) rounded down by SYNTH80_SHIFT bits
+@endcode
+
+Both sums are exact in 32 bits and lo_sum >> 8 loses nothing of the rounded
+result, so the output is the exact window rounded once. This is what the
+multiply-accumulate units of the cores need, and the output is closer to the
+exact window than with the per-product shifts: 0.29 LSB RMS against 0.58 LSB,
+at any level up to full scale. It differs from the former output by 1 LSB at
+most, except near full scale where the former 32 bit sums could wrap. The taps
+which don't exist (buffer[4] for pcm[0], the second one of pcm[4]) are zero.
+
+SynthWindow80_c() is the reference. The kernels for the CPU must give the
+same output bit for bit.
+
+@ingroup codec_internal
+*/
+
+/**
+@addtogroup codec_internal
+@{
+*/
+#include "common/bt_target.h"
+#include "oi_codec_sbc_private.h"
+
+#if (defined(SBC_DEC_INCLUDED) && SBC_DEC_INCLUDED == TRUE)
+
+#define SYNTH80_SHIFT 11
+#define SYNTH80_LO_SHIFT 8
+
+/** Scales x by y bits to the right, adding a rounding factor.
+ */
+#ifndef SCALE
+#define SCALE(x, y) (((x) + (1 <<((y)-1))) >> (y))
+#endif
+
+#ifndef CLIP_INT16
+#define CLIP_INT16(x) do { if (x > OI_INT16_MAX) { x = OI_INT16_MAX; } else if (x < OI_INT16_MIN) { x = OI_INT16_MIN; } } while (0)
+#endif
+
+/* Word aligned, the MAC16 kernel loads two coefficients at a time */
+static const OI_INT16 dec_window_8[8][20] __attribute__((aligned(4))) = {
+    {     0,     64,   -181,    414,  -2175,   4700,   2175,    414,    181,     64,
+          0,     86,      2,    -68,     96,   -128,    -96,    -68,     -2,     86 },   /* pcm[0] */
+    {    -6,     57,   -327,    241,  -3378,   3954,   2165,    417,    142,     49,
+        -95,     55,     48,    -26,     96,     32,    -32,   -100,     88,   -125 },   /* pcm[1] */
+    {   -10,     49,   -309,     72,  -2883,   3445,   1155,    397,     49,     36,
+        -36,    -46,      0,   -110,     32,     32,   -128,      8,    -66,     35 },   /* pcm[2] */
+    {   -16,     37,   -369,   -113,  -3222,   3073,    757,    367,      5,     26,
+        -18,     70,   -100,    -87,    -64,   -128,   -104,    -76,     46,     72 },   /* pcm[3] */
+    {    41,      0,   -662,      0,   5575,      0,    663,      0,     37,      0,
+        -51,      0,    -32,      0,    -64,      0,    -80,      0,     67,      0 },   /* pcm[4] */
+    {    -4,     33,   -602,    461,   2564,   3862,    294,   -142,     13,     47,
+        -31,      9,      0,    -32,    -64,    -64,    -24,   -114,    -54,    -40 },   /* pcm[5] */
+    {   -40,     44,   -956,    479,   2388,   4159,    256,     86,      8,     59,
+        -97,    -97,   -104,     64,     64,   -128,     -4,    101,    103,    -18 },   /* pcm[6] */
+    {   -95,     73,  -1446,    624,   2257,   5918,    218,    361,      4,     86,
+        -28,   -102,   -128,   -128,    -32,    -64,     96,   -120,     66,    -96 },   /* pcm[7] */
+};
+
+/* Combines the sums of the hi and lo halves and rounds */
+#define SYNTH80_OUTPUT(hi, lo) SCALE((hi) + ((lo) >> SYNTH80_LO_SHIFT), SYNTH80_SHIFT)
+
+PRIVATE void SynthWindow80_c(OI_INT16 *pcm, SBC_BUFFER_T const *RESTRICT buffer, OI_UINT strideShift)
+{
+    OI_UINT j;
+    OI_UINT p;
+
+    for (j = 0; j < 8; j++) {
+        SBC_BUFFER_T const *a = buffer + 4 + j;
+        SBC_BUFFER_T const *b = buffer + 12 - j;
+        OI_INT16 const *w = dec_window_8[j];
+        OI_INT32 hi = 0;
+        OI_INT32 lo = 0;
+        OI_INT32 acc;
+
+        for (p = 0; p < 5; p++) {
+            hi += w[2 * p] * a[16 * p];
+            hi += w[2 * p + 1] * b[16 * p];
+            lo += w[10 + 2 * p] * a[16 * p];
+            lo += w[11 + 2 * p] * b[16 * p];
+        }
+        acc = SYNTH80_OUTPUT(hi, lo);
+        CLIP_INT16(acc);
+        pcm[j << strideShift] = (OI_INT16)acc;
+    }
+}
+
+#ifdef OI_SBC_SYNTH_MAC16
+
+/*
+ * The 10 taps of output sample j on the MAC16 unit, for the half of the row
+ * at w + 2 (hi first, then lo). The coefficients are streamed two at a time
+ * into m0 and m1 by the loads folded into the multiply-accumulates (LDINC
+ * pre-increments, hence w pointing one word before). Five words are loaded,
+ * which leaves w one word before the lo half. The buffer taps are at byte
+ * offsets 32 * p and 32 * p + 16 - 4 * j from buffer + 4 + j, and alternate
+ * between two registers to hide the load latency.
+ */
+#define SYNTH80_MAC16_TAPS(j)                                               \
+        "ldinc            m0, %[w]\n"                                       \
+        "ldinc            m1, %[w]\n"                                       \
+        "l16si            %[a], %[b], 0\n"                                  \
+        "l16si            %[t], %[b], 16-4*" #j "\n"                        \
+        "mul.da.ll        m0, %[a]\n"                                       \
+        "l16si            %[a], %[b], 32\n"                                 \
+        "mula.da.hl.ldinc m0, %[w], m0, %[t]\n"                             \
+        "l16si            %[t], %[b], 48-4*" #j "\n"                        \
+        "mula.da.ll       m1, %[a]\n"                                       \
+        "l16si            %[a], %[b], 64\n"                                 \
+        "mula.da.hl.ldinc m1, %[w], m1, %[t]\n"                             \
+        "l16si            %[t], %[b], 80-4*" #j "\n"                        \
+        "mula.da.ll       m0, %[a]\n"                                       \
+        "l16si            %[a], %[b], 96\n"                                 \
+        "mula.da.hl.ldinc m0, %[w], m0, %[t]\n"                             \
+        "l16si            %[t], %[b], 112-4*" #j "\n"                       \
+        "mula.da.ll       m1, %[a]\n"                                       \
+        "l16si            %[a], %[b], 128\n"                                \
+        "mula.da.hl       m1, %[t]\n"                                       \
+        "l16si            %[t], %[b], 144-4*" #j "\n"                       \
+        "mula.da.ll       m0, %[a]\n"                                       \
+        "mula.da.hl       m0, %[t]\n"
+
+/*
+ * One output sample, the hi sum is read out of the accumulator before the lo
+ * taps restart it. MAC16 state isn't kept from one block to the next, so
+ * interrupts in between don't matter.
+ */
+#define SYNTH80_MAC16_SAMPLE(j) do {                                        \
+        OI_INT16 const *w = dec_window_8[j] - 2;                            \
+        SBC_BUFFER_T const *b = buffer + 4 + (j);                           \
+        OI_INT32 hi;                                                        \
+        OI_INT32 lo;                                                        \
+        OI_INT32 t;                                                         \
+        __asm__ __volatile__(                                               \
+            SYNTH80_MAC16_TAPS(j)                                           \
+            "rsr              %[h], acclo\n"                                \
+            SYNTH80_MAC16_TAPS(j)                                           \
+            "rsr              %[a], acclo\n"                                \
+            : [w] "+a" (w), [h] "=&a" (hi), [a] "=&a" (lo), [t] "=&a" (t)   \
+            : [b] "a" (b)                                                   \
+            : "memory");                                                    \
+        hi = SYNTH80_OUTPUT(hi, lo);                                        \
+        CLIP_INT16(hi);                                                     \
+        pcm[(j) << strideShift] = (OI_INT16)hi;                             \
+    } while (0)
+
+PRIVATE void SynthWindow80_mac16(OI_INT16 *pcm, SBC_BUFFER_T const *RESTRICT buffer, OI_UINT strideShift)
+{
+    SYNTH80_MAC16_SAMPLE(0);
+    SYNTH80_MAC16_SAMPLE(1);
+    SYNTH80_MAC16_SAMPLE(2);
+    SYNTH80_MAC16_SAMPLE(3);
+    SYNTH80_MAC16_SAMPLE(4);
+    SYNTH80_MAC16_SAMPLE(5);
+    SYNTH80_MAC16_SAMPLE(6);
+    SYNTH80_MAC16_SAMPLE(7);
+}
+
+#endif /* OI_SBC_SYNTH_MAC16 */
+
+/**
+@}
+*/
+#endif /* #if (defined(SBC_DEC_INCLUDED) && SBC_DEC_INCLUDED == TRUE) */
@@ -52,32 +52,12 @@
 #define SCALE(x, y) (((x) + (1 <<((y)-1))) >> (y))
 #endif
 
-/**
- * Default C language implementation of a 32x32->32 multiply. This function may
- * be replaced by a platform-specific version for speed.
- *
- * @param u A signed 32-bit multiplicand
- * @param v A signed 32-bit multiplier
-
- * @return  A signed 32-bit value corresponding to the 32 most significant bits
- * of the 64-bit product of u and v.
- */
-static INLINE OI_INT32 default_mul_32s_32s_hi(OI_INT32 u, OI_INT32 v)
-{
-    OI_UINT32 u0, v0;
-    OI_INT32 u1, v1, w1, w2, t;
-
-    u0 = u & 0xFFFF; u1 = u >> 16;
-    v0 = v & 0xFFFF; v1 = v >> 16;
-    t = u0 * v0;
-    t = u1 * v0 + ((OI_UINT32)t >> 16);
-    w1 = t & 0xFFFF;
-    w2 = t >> 16;
-    w1 = u0 * v1 + w1;
-    return u1 * v1 + w2 + (w1 >> 16);
-}
-
+#ifdef OI_SBC_MUL32_HIGH
+/* A single MULSH */
+#define MUL_32S_32S_HI(_x, _y) ((OI_INT32)(((int64_t)(_x) * (_y)) >> 32))
+#else
 #define MUL_32S_32S_HI(_x, _y) default_mul_32s_32s_hi(_x, _y)
+#endif
 
 
 #ifdef DEBUG_DCT
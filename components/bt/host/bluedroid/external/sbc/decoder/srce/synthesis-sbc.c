@@ -23,7 +23,7 @@
 
 /** @file
 
-This file, along with synthesis-generated.c, contains the synthesis
+This file, along with synthesis-8-window.c, contains the synthesis
 filterbank routines. The operations performed correspond to the
 operations described in A2DP Appendix B, Figure 12.3. Several
 mathematical optimizations are performed, particularly for the
@@ -205,37 +205,15 @@ const OI_INT32 dec_window_4[21] = {
 #define CLIP_INT16(x) do { if (x > OI_INT16_MAX) { x = OI_INT16_MAX; } else if (x < OI_INT16_MIN) { x = OI_INT16_MIN; } } while (0)
 #endif
 
-/**
- * Default C language implementation of a 16x32->32 multiply. This function may
- * be replaced by a platform-specific version for speed.
- *
- * @param u A signed 16-bit multiplicand
- * @param v A signed 32-bit multiplier
-
- * @return  A signed 32-bit value corresponding to the 32 most significant bits
- * of the 48-bit product of u and v.
- */
-static INLINE OI_INT32 default_mul_16s_32s_hi(OI_INT16 u, OI_INT32 v)
-{
-    OI_UINT16 v0;
-    OI_INT16 v1;
-
-    OI_INT32 w, x;
-
-    v0 = (OI_UINT16)(v & 0xffff);
-    v1 = (OI_INT16) (v >> 16);
-
-    w = v1 * u;
-    x = u * v0;
-
-    return w + (x >> 16);
-}
-
+#ifdef OI_SBC_MUL32_HIGH
+/* The high half of (u * 2^16) * v, a single MULSH */
+#define MUL_16S_32S_HI(_x, _y) ((OI_INT32)(((int64_t)((OI_INT32)(_x) * 65536) * (_y)) >> 32))
+#else
 #define MUL_16S_32S_HI(_x, _y) default_mul_16s_32s_hi(_x, _y)
+#endif
 
 #define LONG_MULT_DCT(K, sample) (MUL_16S_32S_HI(K, sample)<<2)
 
-PRIVATE void SynthWindow80_generated(OI_INT16 *pcm, SBC_BUFFER_T const *RESTRICT buffer, OI_UINT strideShift);
 PRIVATE void SynthWindow112_generated(OI_INT16 *pcm, SBC_BUFFER_T const *RESTRICT buffer, OI_UINT strideShift);
 PRIVATE void dct2_8(SBC_BUFFER_T *RESTRICT out, OI_INT32 const *RESTRICT x);
 
@@ -250,7 +228,11 @@ typedef void (*SYNTH_FRAME)(OI_CODEC_SBC_DECODER_CONTEXT *context, OI_INT16 *pcm
 #endif
 
 #ifndef SYNTH80
-#define SYNTH80 SynthWindow80_generated
+#ifdef OI_SBC_SYNTH_MAC16
+#define SYNTH80 SynthWindow80_mac16
+#else
+#define SYNTH80 SynthWindow80_c
+#endif
 #endif
 
 #ifndef SYNTH112
@@ -143,10 +143,9 @@
 #endif
 
 #define MINIMUM_ENC_VX_BUFFER_SIZE (8*10*2)
-#ifndef ENC_VX_BUFFER_SIZE
-#define ENC_VX_BUFFER_SIZE (MINIMUM_ENC_VX_BUFFER_SIZE + 64)
-/*#define ENC_VX_BUFFER_SIZE MINIMUM_ENC_VX_BUFFER_SIZE + 1024*/
-#endif
+/* Analysis filter history: per channel, a ring of the last 10 blocks followed by a copy of it, so
+   the 10 block window always reads contiguous samples and the history never has to be shifted */
+#define ENC_VX_BUFFER_SIZE (MINIMUM_ENC_VX_BUFFER_SIZE * 2)
 
 #ifndef SBC_FOR_EMBEDDED_LINUX
 #define SBC_FOR_EMBEDDED_LINUX FALSE
@@ -194,6 +193,14 @@ typedef struct SBC_ENC_PARAMS_TAG {
     UINT16 FrameHeader;
     UINT16 u16PacketLength;
 
+    /* analysis filter state, set up by SBC_Encoder_Init */
+    SINT16 s16XPos;                                 /* ring position of the newest block */
+    SINT16 s16X[ENC_VX_BUFFER_SIZE];
+    SINT32 s32DCTY[2 * SBC_MAX_NUM_OF_SUBBANDS];
+#if (SBC_JOINT_STE_INCLUDED == TRUE)
+    SINT32 s32LRSum[SBC_MAX_NUM_OF_BLOCKS];
+    SINT32 s32LRDiff[SBC_MAX_NUM_OF_BLOCKS];
+#endif
 } SBC_ENC_PARAMS;
 
 #ifdef __cplusplus
@@ -201,6 +208,7 @@ extern "C"
 {
 #endif
 extern void SBC_Encoder(SBC_ENC_PARAMS *strEncParams);
+extern UINT32 SBC_Encoder_Batch(SBC_ENC_PARAMS *strEncParams, SINT16 *ps16Pcm, UINT8 *pu8Out, UINT8 u8NumFrames);
 extern void SBC_Encoder_Init(SBC_ENC_PARAMS *strEncParams);
 #ifdef __cplusplus
 }
@@ -34,7 +34,7 @@
 #include "stack/bt_types.h"
 
 typedef short SINT16;
-typedef long SINT32;
+typedef int32_t SINT32;
 
 #if (SBC_IPAQ_OPT == TRUE)
 
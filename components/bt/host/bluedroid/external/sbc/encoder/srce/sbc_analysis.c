@@ -26,7 +26,6 @@
 #include <string.h>
 #include "sbc_encoder.h"
 #include "sbc_enc_func_declare.h"
-#include "osi/allocator.h"
 /*#include <math.h>*/
 #if (defined(SBC_ENC_INCLUDED) && SBC_ENC_INCLUDED == TRUE)
 
@@ -156,69 +155,6 @@
 #define WIND_8_SUBBANDS_8_2 (SINT16)0x12CF  /* 40 = 0x12CF6C75 */
 #endif
 
-#if (SBC_USE_ARM_PRAGMA==TRUE)
-#pragma arm section zidata = "sbc_s32_analysis_section"
-#endif
-#if BT_BLE_DYNAMIC_ENV_MEMORY == FALSE
-static SINT32   s32DCTY[16]  = {0};
-static SINT32   s32X[ENC_VX_BUFFER_SIZE / 2];
-static SINT16   *s16X = (SINT16 *) s32X;   /* s16X must be 32 bits aligned cf  SHIFTUP_X8_2*/
-#else
-static SINT32   *s32DCTY;
-static SINT32   *s32X;
-static SINT16   *s16X;   /* s16X must be 32 bits aligned cf  SHIFTUP_X8_2*/
-#endif //BT_BLE_DYNAMIC_ENV_MEMORY == FALSE
-
-#if (SBC_USE_ARM_PRAGMA==TRUE)
-#pragma arm section zidata
-#endif
-
-/* This macro is for 4 subbands */
-#define SHIFTUP_X4                                                               \
-{                                                                                   \
-    ps32X=(SINT32 *)(s16X+EncMaxShiftCounter+38);                                 \
-    for (i=0;i<9;i++)                                                               \
-    {                                                                               \
-        *ps32X=*(ps32X-2-(ShiftCounter>>1));  ps32X--;                                 \
-        *ps32X=*(ps32X-2-(ShiftCounter>>1));  ps32X--;                                 \
-    }                                                                               \
-}
-#define SHIFTUP_X4_2                                                              \
-{                                                                                   \
-    ps32X=(SINT32 *)(s16X+EncMaxShiftCounter+38);                                   \
-    ps32X2=(SINT32 *)(s16X+(EncMaxShiftCounter<<1)+78);                             \
-    for (i=0;i<9;i++)                                                               \
-    {                                                                               \
-        *ps32X=*(ps32X-2-(ShiftCounter>>1));  *(ps32X2)=*(ps32X2-2-(ShiftCounter>>1)); ps32X--;  ps32X2--;                     \
-        *ps32X=*(ps32X-2-(ShiftCounter>>1));  *(ps32X2)=*(ps32X2-2-(ShiftCounter>>1)); ps32X--;  ps32X2--;                     \
-    }                                                                               \
-}
-
-/* This macro is for 8 subbands */
-#define SHIFTUP_X8                                                               \
-{                                                                                   \
-    ps32X=(SINT32 *)(s16X+EncMaxShiftCounter+78);                                 \
-    for (i=0;i<9;i++)                                                               \
-    {                                                                               \
-        *ps32X=*(ps32X-4-(ShiftCounter>>1));  ps32X--;                                 \
-        *ps32X=*(ps32X-4-(ShiftCounter>>1));  ps32X--;                                 \
-        *ps32X=*(ps32X-4-(ShiftCounter>>1));  ps32X--;                                 \
-        *ps32X=*(ps32X-4-(ShiftCounter>>1));  ps32X--;                                 \
-    }                                                                               \
-}
-#define SHIFTUP_X8_2                                                               \
-{                                                                                   \
-    ps32X=(SINT32 *)(s16X+EncMaxShiftCounter+78);                                   \
-    ps32X2=(SINT32 *)(s16X+(EncMaxShiftCounter<<1)+158);                             \
-    for (i=0;i<9;i++)                                                               \
-    {                                                                               \
-        *ps32X=*(ps32X-4-(ShiftCounter>>1));  *(ps32X2)=*(ps32X2-4-(ShiftCounter>>1)); ps32X--;  ps32X2--;                     \
-        *ps32X=*(ps32X-4-(ShiftCounter>>1));  *(ps32X2)=*(ps32X2-4-(ShiftCounter>>1)); ps32X--;  ps32X2--;                     \
-        *ps32X=*(ps32X-4-(ShiftCounter>>1));  *(ps32X2)=*(ps32X2-4-(ShiftCounter>>1)); ps32X--;  ps32X2--;                     \
-        *ps32X=*(ps32X-4-(ShiftCounter>>1));  *(ps32X2)=*(ps32X2-4-(ShiftCounter>>1)); ps32X--;  ps32X2--;                     \
-    }                                                                               \
-}
-
 #if (SBC_ARM_ASM_OPT==TRUE)
 #define WINDOW_ACCU_8_0 \
 {\
@@ -907,11 +843,13 @@ static SINT16   *s16X;   /* s16X must be 32 bits aligned cf  SHIFTUP_X8_2*/
 #endif
 #endif
 
-static SINT16 ShiftCounter = 0;
-extern SINT16 EncMaxShiftCounter;
 /****************************************************************************
 * SbcAnalysisFilter - performs Analysis of the input audio stream
 *
+* The history of each channel is a ring of 10 blocks starting at s16X[s16XPos],
+* newest block first, mirrored right after the ring so the window always reads
+* 10 consecutive blocks.
+*
 * RETURNS : N/A
 */
 void SbcAnalysisFilter4(SBC_ENC_PARAMS *pstrEncParams)
@@ -920,8 +858,11 @@ void SbcAnalysisFilter4(SBC_ENC_PARAMS *pstrEncParams)
     SINT32 *ps32SbBuf;
     SINT32  s32Blk, s32Ch;
     SINT32  s32NumOfChannels, s32NumOfBlocks;
-    SINT32 i, *ps32X, *ps32X2;
+    SINT32 i;
     SINT32 Offset, Offset2, ChOffset;
+    SINT16 *s16X = pstrEncParams->s16X;
+    SINT16 *ps16X;
+    SINT32 *s32DCTY = pstrEncParams->s32DCTY;
 #if (SBC_ARM_ASM_OPT==TRUE)
     register SINT32 s32Hi, s32Hi2;
 #else
@@ -946,24 +887,21 @@ void SbcAnalysisFilter4(SBC_ENC_PARAMS *pstrEncParams)
     ps16PcmBuf = pstrEncParams->ps16NextPcmBuffer;
 
     ps32SbBuf  = pstrEncParams->s32SbBuffer;
-    Offset2 = (SINT32)(EncMaxShiftCounter + 40);
+    Offset = pstrEncParams->s16XPos;
+    Offset2 = (SINT32)(4 * 10 * 2);
     for (s32Blk = 0; s32Blk < s32NumOfBlocks; s32Blk++) {
-        Offset = (SINT32)(EncMaxShiftCounter - ShiftCounter);
-        /* Store new samples */
+        Offset = ((Offset == 0) ? 4 * 10 : Offset) - SUB_BANDS_4;
+        /* Store new samples in the ring and in its mirror */
+        ps16X = s16X + Offset;
         if (s32NumOfChannels == 1) {
-            s16X[3 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
-            s16X[2 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
-            s16X[1 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
-            s16X[0 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
+            for (i = SUB_BANDS_4 - 1; i >= 0; i--) {
+                ps16X[i] = ps16X[i + 4 * 10] = *ps16PcmBuf;   ps16PcmBuf++;
+            }
         } else {
-            s16X[3 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 3 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
-            s16X[2 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 2 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
-            s16X[1 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 1 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
-            s16X[0 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 0 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
+            for (i = SUB_BANDS_4 - 1; i >= 0; i--) {
+                ps16X[i] = ps16X[i + 4 * 10] = *ps16PcmBuf;   ps16PcmBuf++;
+                ps16X[Offset2 + i] = ps16X[Offset2 + i + 4 * 10] = *ps16PcmBuf;   ps16PcmBuf++;
+            }
         }
         for (s32Ch = 0; s32Ch < s32NumOfChannels; s32Ch++) {
             ChOffset = s32Ch * Offset2 + Offset;
@@ -974,22 +912,8 @@ void SbcAnalysisFilter4(SBC_ENC_PARAMS *pstrEncParams)
 
             ps32SbBuf += SUB_BANDS_4;
         }
-        if (s32NumOfChannels == 1) {
-            if (ShiftCounter >= EncMaxShiftCounter) {
-                SHIFTUP_X4;
-                ShiftCounter = 0;
-            } else {
-                ShiftCounter += SUB_BANDS_4;
-            }
-        } else {
-            if (ShiftCounter >= EncMaxShiftCounter) {
-                SHIFTUP_X4_2;
-                ShiftCounter = 0;
-            } else {
-                ShiftCounter += SUB_BANDS_4;
-            }
-        }
     }
+    pstrEncParams->s16XPos = (SINT16)Offset;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////////////////////////////////// */
@@ -1000,8 +924,11 @@ void SbcAnalysisFilter8 (SBC_ENC_PARAMS *pstrEncParams)
     SINT32  s32Blk, s32Ch;                                    /* counter for block*/
     SINT32 Offset, Offset2;
     SINT32  s32NumOfChannels, s32NumOfBlocks;
-    SINT32 i, *ps32X, *ps32X2;
+    SINT32 i;
     SINT32 ChOffset;
+    SINT16 *s16X = pstrEncParams->s16X;
+    SINT16 *ps16X;
+    SINT32 *s32DCTY = pstrEncParams->s32DCTY;
 #if (SBC_ARM_ASM_OPT==TRUE)
     register SINT32 s32Hi, s32Hi2;
 #else
@@ -1024,36 +951,21 @@ void SbcAnalysisFilter8 (SBC_ENC_PARAMS *pstrEncParams)
     ps16PcmBuf = pstrEncParams->ps16NextPcmBuffer;
 
     ps32SbBuf  = pstrEncParams->s32SbBuffer;
-    Offset2 = (SINT32)(EncMaxShiftCounter + 80);
+    Offset = pstrEncParams->s16XPos;
+    Offset2 = (SINT32)(8 * 10 * 2);
     for (s32Blk = 0; s32Blk < s32NumOfBlocks; s32Blk++) {
-        Offset = (SINT32)(EncMaxShiftCounter - ShiftCounter);
-        /* Store new samples */
+        Offset = ((Offset == 0) ? 8 * 10 : Offset) - SUB_BANDS_8;
+        /* Store new samples in the ring and in its mirror */
+        ps16X = s16X + Offset;
         if (s32NumOfChannels == 1) {
-            s16X[7 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
-            s16X[6 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
-            s16X[5 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
-            s16X[4 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
-            s16X[3 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
-            s16X[2 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
-            s16X[1 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
-            s16X[0 + Offset] = *ps16PcmBuf;   ps16PcmBuf++;
+            for (i = SUB_BANDS_8 - 1; i >= 0; i--) {
+                ps16X[i] = ps16X[i + 8 * 10] = *ps16PcmBuf;   ps16PcmBuf++;
+            }
         } else {
-            s16X[7 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 7 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
-            s16X[6 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 6 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
-            s16X[5 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 5 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
-            s16X[4 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 4 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
-            s16X[3 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 3 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
-            s16X[2 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 2 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
-            s16X[1 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 1 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
-            s16X[0 + Offset] = *ps16PcmBuf;        ps16PcmBuf++;
-            s16X[Offset2 + 0 + Offset] = *ps16PcmBuf;     ps16PcmBuf++;
+            for (i = SUB_BANDS_8 - 1; i >= 0; i--) {
+                ps16X[i] = ps16X[i + 8 * 10] = *ps16PcmBuf;   ps16PcmBuf++;
+                ps16X[Offset2 + i] = ps16X[Offset2 + i + 8 * 10] = *ps16PcmBuf;   ps16PcmBuf++;
+            }
         }
         for (s32Ch = 0; s32Ch < s32NumOfChannels; s32Ch++) {
             ChOffset = s32Ch * Offset2 + Offset;
@@ -1064,41 +976,14 @@ void SbcAnalysisFilter8 (SBC_ENC_PARAMS *pstrEncParams)
 
             ps32SbBuf += SUB_BANDS_8;
         }
-        if (s32NumOfChannels == 1) {
-            if (ShiftCounter >= EncMaxShiftCounter) {
-                SHIFTUP_X8;
-                ShiftCounter = 0;
-            } else {
-                ShiftCounter += SUB_BANDS_8;
-            }
-        } else {
-            if (ShiftCounter >= EncMaxShiftCounter) {
-                SHIFTUP_X8_2;
-                ShiftCounter = 0;
-            } else {
-                ShiftCounter += SUB_BANDS_8;
-            }
-        }
     }
+    pstrEncParams->s16XPos = (SINT16)Offset;
 }
 
-void SbcAnalysisInit (void)
+void SbcAnalysisInit (SBC_ENC_PARAMS *pstrEncParams)
 {
-    static bool loaded = false;
-    if (!loaded) {
-        loaded = true;
-#if BT_BLE_DYNAMIC_ENV_MEMORY == TRUE
-        s32X = (SINT32 *)osi_malloc(sizeof(SINT32) * (ENC_VX_BUFFER_SIZE / 2));
-        s32DCTY = (SINT32 *)osi_malloc(sizeof(SINT32) * 16);
-        assert(s32X);
-        assert(s32DCTY);
-        memset(s32X, 0, sizeof(SINT16) * ENC_VX_BUFFER_SIZE);
-        memset(s32DCTY, 0, sizeof(SINT32) * 16);
-        s16X = (SINT16 *) s32X;
-#endif
-    }
-    memset(s16X, 0, ENC_VX_BUFFER_SIZE * sizeof(SINT16));
-    ShiftCounter = 0;
+    memset(pstrEncParams->s16X, 0, sizeof(pstrEncParams->s16X));
+    pstrEncParams->s16XPos = 0;
 }
 
 #endif /* #if (defined(SBC_ENC_INCLUDED) && SBC_ENC_INCLUDED == TRUE) */
@@ -29,14 +29,13 @@
 
 #if (defined(SBC_ENC_INCLUDED) && SBC_ENC_INCLUDED == TRUE)
 
-SINT16 EncMaxShiftCounter;
-
-#if (SBC_JOINT_STE_INCLUDED == TRUE)
-SINT32   s32LRDiff[SBC_MAX_NUM_OF_BLOCKS]    = {0};
-SINT32   s32LRSum[SBC_MAX_NUM_OF_BLOCKS]     = {0};
-#endif
-
-void SBC_Encoder(SBC_ENC_PARAMS *pstrEncParams)
+/****************************************************************************
+* SbcEncodeFrames - encodes u8NumFrames frames of interleaved PCM read from
+* ps16Pcm, back to back from pstrEncParams->pu8Packet
+*
+* RETURNS : N/A
+*/
+static void SbcEncodeFrames(SBC_ENC_PARAMS *pstrEncParams, SINT16 *ps16Pcm, UINT8 u8NumFrames)
 {
     SINT32 s32Ch;                               /* counter for ch*/
     SINT32 s32Sb;                               /* counter for sub-band*/
@@ -55,13 +54,9 @@ void SBC_Encoder(SBC_ENC_PARAMS *pstrEncParams)
     register SINT32  s32NumOfSubBands = pstrEncParams->s16NumOfSubBands;
 
     pstrEncParams->pu8NextPacket = pstrEncParams->pu8Packet;
+    pstrEncParams->ps16NextPcmBuffer = ps16Pcm;
 
-#if (SBC_NO_PCM_CPY_OPTION == TRUE)
-    pstrEncParams->ps16NextPcmBuffer = pstrEncParams->ps16PcmBuffer;
-#else
-    pstrEncParams->ps16NextPcmBuffer  = pstrEncParams->as16PcmBuffer;
-#endif
-    do {
+    while (u8NumFrames--) {
         /* SBC ananlysis filter*/
         if (s32NumOfSubBands == 4) {
             SbcAnalysisFilter4(pstrEncParams);
@@ -108,8 +103,8 @@ void SBC_Encoder(SBC_ENC_PARAMS *pstrEncParams)
                 SbBuffer = pstrEncParams->s32SbBuffer + s32Sb;
                 s32MaxValue2 = 0;
                 s32MaxValue = 0;
-                pSum       = s32LRSum;
-                pDiff      = s32LRDiff;
+                pSum       = pstrEncParams->s32LRSum;
+                pDiff      = pstrEncParams->s32LRDiff;
                 for (s32Blk = 0; s32Blk < s32NumOfBlocks; s32Blk++) {
                     *pSum = (*SbBuffer + * (SbBuffer + s32NumOfSubBands)) >> 1;
                     if (abs32(*pSum) > s32MaxValue) {
@@ -151,8 +146,8 @@ void SBC_Encoder(SBC_ENC_PARAMS *pstrEncParams)
                     *(ps16ScfL + s32NumOfSubBands) = (SINT16)u32CountDiff;
 
                     SbBuffer = pstrEncParams->s32SbBuffer + s32Sb;
-                    pSum       = s32LRSum;
-                    pDiff      = s32LRDiff;
+                    pSum       = pstrEncParams->s32LRSum;
+                    pDiff      = pstrEncParams->s32LRDiff;
 
                     for (s32Blk = 0; s32Blk < s32NumOfBlocks; s32Blk++) {
                         *SbBuffer = *pSum;
@@ -184,10 +179,33 @@ void SBC_Encoder(SBC_ENC_PARAMS *pstrEncParams)
 
         /* Quantize the encoded audio */
         EncPacking(pstrEncParams);
-    } while (--(pstrEncParams->u8NumPacketToEncode));
+    }
+}
+
+void SBC_Encoder(SBC_ENC_PARAMS *pstrEncParams)
+{
+#if (SBC_NO_PCM_CPY_OPTION == TRUE)
+    SbcEncodeFrames(pstrEncParams, pstrEncParams->ps16PcmBuffer, pstrEncParams->u8NumPacketToEncode);
+#else
+    SbcEncodeFrames(pstrEncParams, pstrEncParams->as16PcmBuffer, pstrEncParams->u8NumPacketToEncode);
+#endif
 
     pstrEncParams->u8NumPacketToEncode = 1; /* default is one for retrocompatibility purpose */
+}
+
+/****************************************************************************
+* SBC_Encoder_Batch - encodes u8NumFrames frames of interleaved PCM from
+* ps16Pcm into consecutive SBC frames at pu8Out, without going through the
+* PCM buffer of the parameters. Every frame has u16PacketLength bytes.
+*
+* RETURNS : number of bytes written to pu8Out
+*/
+UINT32 SBC_Encoder_Batch(SBC_ENC_PARAMS *pstrEncParams, SINT16 *ps16Pcm, UINT8 *pu8Out, UINT8 u8NumFrames)
+{
+    pstrEncParams->pu8Packet = pu8Out;
+    SbcEncodeFrames(pstrEncParams, ps16Pcm, u8NumFrames);
 
+    return (UINT32)(pstrEncParams->pu8NextPacket - pu8Out);
 }
 
 /****************************************************************************
@@ -310,24 +328,10 @@ void SBC_Encoder_Init(SBC_ENC_PARAMS *pstrEncParams)
         pstrEncParams->FrameHeader = 0;
     }
 
-    if (pstrEncParams->s16NumOfSubBands == 4) {
-        if (pstrEncParams->s16NumOfChannels == 1) {
-            EncMaxShiftCounter = ((ENC_VX_BUFFER_SIZE - 4 * 10) >> 2) << 2;
-        } else {
-            EncMaxShiftCounter = ((ENC_VX_BUFFER_SIZE - 4 * 10 * 2) >> 3) << 2;
-        }
-    } else {
-        if (pstrEncParams->s16NumOfChannels == 1) {
-            EncMaxShiftCounter = ((ENC_VX_BUFFER_SIZE - 8 * 10) >> 3) << 3;
-        } else {
-            EncMaxShiftCounter = ((ENC_VX_BUFFER_SIZE - 8 * 10 * 2) >> 4) << 3;
-        }
-    }
-
     APPL_TRACE_EVENT("SBC_Encoder_Init : bitrate %d, bitpool %d",
                      pstrEncParams->u16BitRate, pstrEncParams->s16BitPool);
 
-    SbcAnalysisInit();
+    SbcAnalysisInit(pstrEncParams);
 }
 
 #endif /* #if (defined(SBC_ENC_INCLUDED) && SBC_ENC_INCLUDED == TRUE) */
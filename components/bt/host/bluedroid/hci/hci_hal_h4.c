@@ -83,7 +83,7 @@ static void hci_hal_env_init(
     hci_hal_env.buffer_size = buffer_size;
     hci_hal_env.adv_free_num = 0;
 
-    hci_hal_env.rx_q = fixed_queue_new(max_buffer_count);
+    hci_hal_env.rx_q = fixed_queue_new_lockfree(max_buffer_count);
     if (hci_hal_env.rx_q) {
         fixed_queue_register_dequeue(hci_hal_env.rx_q, event_uart_has_bytes);
     } else {
@@ -324,12 +324,14 @@ static int host_recv_pkt_cb(uint8_t *data, uint16_t len)
     }
 
     pkt_size = BT_HDR_SIZE + len;
-    pkt = (BT_HDR *) osi_calloc(pkt_size);
+    /* every field is written below, no need to zero it first */
+    pkt = (BT_HDR *) osi_buf_pool_malloc(pkt_size);
 
     if (!pkt) {
         HCI_TRACE_ERROR("%s couldn't aquire memory for inbound data buffer.\n", __func__);
         return -1;
     }
+    pkt->event = 0;
     pkt->offset = 0;
     pkt->len = len;
     pkt->layer_specific = 0;
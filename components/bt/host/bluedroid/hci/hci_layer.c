@@ -40,6 +40,7 @@
 #define HCI_HOST_TASK_STACK_SIZE        (2048 + BT_TASK_EXTRA_STACK_SIZE)
 #define HCI_HOST_TASK_PRIO              (BT_TASK_MAX_PRIORITIES - 3)
 #define HCI_HOST_TASK_NAME              "hciT"
+#define HCI_HOST_TASK_WORK_QUEUE_NUM    2
 
 typedef struct {
     uint16_t opcode;
@@ -100,6 +101,17 @@ static serial_data_type_t event_to_data_type(uint16_t event);
 static waiting_command_t *get_waiting_command(command_opcode_t opcode);
 static void dispatch_reassembled(BT_HDR *packet);
 
+#if (BT_HCI_QUEUE_WEIGHTS_INCLUDED == TRUE)
+// The queue[0] gets the posts to send commands and ACL data, the queue[1] those
+// of the packets received. They are served in turn, so that streaming out does
+// not hold back the events that return the controller buffers, nor the other
+// way round under a scan. Both queues have the same capacity and neither kind
+// of post should wait longer than the other, so they get the same weight. 4 is
+// half of the batch the thread takes from a queue at once: either queue waits
+// for 4 items of the other at most.
+static const uint8_t hci_host_thread_weights[HCI_HOST_TASK_WORK_QUEUE_NUM] = {4, 4};
+#endif
+
 // Module lifecycle functions
 int hci_start_up(void)
 {
@@ -107,10 +119,13 @@ int hci_start_up(void)
         goto error;
     }
 
-    hci_host_thread = osi_thread_create(HCI_HOST_TASK_NAME, HCI_HOST_TASK_STACK_SIZE, HCI_HOST_TASK_PRIO, HCI_HOST_TASK_PINNED_TO_CORE, 2);
+    hci_host_thread = osi_thread_create(HCI_HOST_TASK_NAME, HCI_HOST_TASK_STACK_SIZE, HCI_HOST_TASK_PRIO, HCI_HOST_TASK_PINNED_TO_CORE, HCI_HOST_TASK_WORK_QUEUE_NUM);
     if (hci_host_thread == NULL) {
         return -2;
     }
+#if (BT_HCI_QUEUE_WEIGHTS_INCLUDED == TRUE)
+    osi_thread_set_queue_weights(hci_host_thread, hci_host_thread_weights);
+#endif
 
     packet_fragmenter->init(&packet_fragmenter_callbacks);
     hal->open(&hal_callbacks, hci_host_thread);
@@ -150,7 +165,7 @@ static int hci_layer_init_env(void)
     // as per the Bluetooth spec, Volume 2, Part E, 4.4 (Command Flow Control)
     // This value can change when you get a command complete or command status event.
     hci_host_env.command_credits = 1;
-    hci_host_env.command_queue = fixed_queue_new(QUEUE_SIZE_MAX);
+    hci_host_env.command_queue = fixed_queue_new_lockfree(QUEUE_SIZE_MAX);
     if (hci_host_env.command_queue) {
         fixed_queue_register_dequeue(hci_host_env.command_queue, event_command_ready);
     } else {
@@ -158,7 +173,7 @@ static int hci_layer_init_env(void)
         return -1;
     }
 
-    hci_host_env.packet_queue = fixed_queue_new(QUEUE_SIZE_MAX);
+    hci_host_env.packet_queue = fixed_queue_new_lockfree(QUEUE_SIZE_MAX);
     if (hci_host_env.packet_queue) {
         fixed_queue_register_dequeue(hci_host_env.packet_queue, event_packet_ready);
     } else {
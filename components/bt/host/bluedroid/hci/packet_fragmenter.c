@@ -170,10 +170,16 @@ static void reassemble_and_dispatch(BT_HDR *packet)
                 callbacks->reassembled(packet);
                 return;
             }
-            partial_packet = (BT_HDR *)osi_calloc(full_length + sizeof(BT_HDR));
+            partial_packet = (BT_HDR *)osi_buf_pool_malloc(full_length + sizeof(BT_HDR));
+            if (partial_packet == NULL) {
+                HCI_TRACE_ERROR("%s couldn't aquire memory for reassembly of %d bytes.\n", __func__, full_length);
+                osi_free(packet);
+                return;
+            }
             partial_packet->event = packet->event;
             partial_packet->len = full_length;
             partial_packet->offset = packet->len;
+            partial_packet->layer_specific = 0;
 
             memcpy(partial_packet->data, packet->data + packet->offset, packet->len);
 
@@ -312,6 +312,21 @@ tA2D_STATUS A2D_FindService(UINT16 service_uuid, BD_ADDR bd_addr,
     return (result ? A2D_SUCCESS : A2D_FAIL);
 }
 
+/******************************************************************************
+**
+** Function         A2D_SetAvdtSdpVer
+**
+** Description      Set the AVDTP version of the SDP records added by
+**                  A2D_AddRecord() afterwards.
+**
+** Returns          void
+**
+******************************************************************************/
+void A2D_SetAvdtSdpVer(UINT16 avdt_sdp_ver)
+{
+    a2d_set_avdt_sdp_ver(avdt_sdp_ver);
+}
+
 /******************************************************************************
 **
 ** Function         A2D_SetTraceLevel
@@ -84,6 +84,12 @@ static const tA2DP_DECODER_INTERFACE a2dp_decoder_interface_sbc = {
     NULL,  // decoder_start
     NULL,  // decoder_suspend
     a2dp_sbc_decoder_configure,
+    a2dp_sbc_decoder_conceal,
+    a2dp_sbc_decoder_get_pcm_format,
+    a2dp_sbc_decoder_get_max_output_size,
+    NULL,  // decoder_supports_pcm_format
+    NULL,  // decoder_set_pcm_format
+    a2dp_sbc_decoder_get_media_timestamp,
 };
 
 static tA2D_STATUS A2DP_CodecInfoMatchesCapabilitySbc(
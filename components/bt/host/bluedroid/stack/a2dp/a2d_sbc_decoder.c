@@ -9,6 +9,7 @@
 #include "esp_log.h"
 #include "stack/a2d_sbc.h"
 #include "stack/a2d_sbc_decoder.h"
+#include "stack/a2dp_decoder_plc.h"
 #include "stack/bt_types.h"
 #include "oi_codec_sbc.h"
 #include "oi_status.h"
@@ -16,16 +17,30 @@
 
 #if (defined(SBC_DEC_INCLUDED) && SBC_DEC_INCLUDED == TRUE)
 
+/* PCM of the largest SBC frame */
+#define A2DP_SBC_DECODER_MAX_OUTPUT (SBC_MAX_SAMPLES_PER_FRAME * SBC_MAX_CHANNELS * sizeof(OI_INT16))
+
 typedef struct {
   OI_CODEC_SBC_DECODER_CONTEXT decoder_context;
   OI_UINT32 context_data[CODEC_DATA_WORDS(2, SBC_CODEC_FAST_FILTER_BUFFERS)];
   OI_UINT8 maxChannels;
   OI_UINT8 pcmStride;
+  uint32_t sample_rate;
   decoded_data_callback_t decode_callback;
+  tA2DP_DECODER_SEQ seq;
+  tA2DP_PLC plc;
 } tA2DP_SBC_DECODER_CB;
 
 static tA2DP_SBC_DECODER_CB a2dp_sbc_decoder_cb;
 
+static void a2dp_sbc_decoder_emit(unsigned char* buf, size_t len) {
+  if (len == 0) {
+    return;
+  }
+  a2dp_plc_good_pcm(&a2dp_sbc_decoder_cb.plc, buf, len);
+  a2dp_sbc_decoder_cb.decode_callback((uint8_t*)buf, len);
+}
+
 bool a2dp_sbc_decoder_init(decoded_data_callback_t decode_callback) {
   a2dp_sbc_decoder_cb.maxChannels = 2;
   a2dp_sbc_decoder_cb.pcmStride = 2;
@@ -49,6 +64,9 @@ bool a2dp_sbc_decoder_reset() {
               __func__, status);
     return false;
   }
+  a2dp_plc_init(&a2dp_sbc_decoder_cb.plc, a2dp_sbc_decoder_cb.maxChannels,
+                sizeof(OI_INT16));
+  a2dp_decoder_seq_reset(&a2dp_sbc_decoder_cb.seq);
   return true;
 }
 
@@ -66,10 +84,42 @@ void a2dp_sbc_decoder_configure(const uint8_t* p_codec_info) {
   } else {
     a2dp_sbc_decoder_cb.maxChannels = 2;
   }
+  /* the decoder refuses a PCM stride above the channel count */
+  a2dp_sbc_decoder_cb.pcmStride = a2dp_sbc_decoder_cb.maxChannels;
+
+  switch (cie.samp_freq) {
+  case A2D_SBC_IE_SAMP_FREQ_16:
+    a2dp_sbc_decoder_cb.sample_rate = 16000;
+    break;
+  case A2D_SBC_IE_SAMP_FREQ_32:
+    a2dp_sbc_decoder_cb.sample_rate = 32000;
+    break;
+  case A2D_SBC_IE_SAMP_FREQ_48:
+    a2dp_sbc_decoder_cb.sample_rate = 48000;
+    break;
+  default:
+    a2dp_sbc_decoder_cb.sample_rate = 44100;
+    break;
+  }
 
   a2dp_sbc_decoder_reset();
 }
 
+bool a2dp_sbc_decoder_get_pcm_format(tA2DP_PCM_FORMAT* p_format) {
+  if (a2dp_sbc_decoder_cb.sample_rate == 0) {
+    return false;
+  }
+  p_format->sample_rate = a2dp_sbc_decoder_cb.sample_rate;
+  p_format->channels = a2dp_sbc_decoder_cb.maxChannels;
+  p_format->bits_per_sample = 16;
+  p_format->valid_bits = 16;
+  return true;
+}
+
+size_t a2dp_sbc_decoder_get_max_output_size(void) {
+  return A2DP_SBC_DECODER_MAX_OUTPUT;
+}
+
 size_t a2dp_sbc_decoder_decode_packet_header(BT_HDR* p_buf) {
   UINT8 *data;
   struct media_packet_header *header;
@@ -103,7 +153,12 @@ size_t a2dp_sbc_decoder_decode_packet_header(BT_HDR* p_buf) {
   /* report sequence number */
   p_buf->layer_specific = ntohs(header->seq);
 
-  return 0;
+  return a2dp_decoder_seq_update(&a2dp_sbc_decoder_cb.seq, p_buf->layer_specific);
+}
+
+bool a2dp_sbc_decoder_get_media_timestamp(const BT_HDR* p_buf, uint32_t* p_timestamp) {
+  *p_timestamp = a2dp_decoder_rtp_timestamp((const UINT8 *)(p_buf + 1) + p_buf->offset);
+  return true;
 }
 
 bool a2dp_sbc_decoder_decode_packet(BT_HDR* p_buf, unsigned char* buf, size_t buf_len) {
@@ -130,6 +185,12 @@ bool a2dp_sbc_decoder_decode_packet(BT_HDR* p_buf, unsigned char* buf, size_t bu
     APPL_TRACE_DEBUG("Number of sbc frames %d, frame_len %d\n", num_frames, src_len);
 
     for (count = 0; count < num_frames && src_len != 0; count ++) {
+        /* pass on the frames decoded so far if the next one may not fit */
+        if (avail < A2DP_SBC_DECODER_MAX_OUTPUT) {
+            a2dp_sbc_decoder_emit(buf, buf_len - avail);
+            dst = (OI_INT16*)buf;
+            avail = buf_len;
+        }
         written = avail;
         status = OI_CODEC_SBC_DecodeFrame(&a2dp_sbc_decoder_cb.decoder_context,
                                           (const OI_BYTE **)&src,
@@ -147,9 +208,26 @@ bool a2dp_sbc_decoder_decode_packet(BT_HDR* p_buf, unsigned char* buf, size_t bu
     p_buf->offset = p_buf->offset + p_buf->len - src_len;
     p_buf->len = src_len;
 
-    size_t out_used = buf_len - avail;
-    a2dp_sbc_decoder_cb.decode_callback((uint8_t*)buf, out_used);
+    a2dp_sbc_decoder_emit(buf, buf_len - avail);
+    a2dp_plc_good_packet_end(&a2dp_sbc_decoder_cb.plc);
     return true;
 }
 
+size_t a2dp_sbc_decoder_conceal(size_t packets, unsigned char* buf, size_t buf_len) {
+    tA2DP_PLC *plc = &a2dp_sbc_decoder_cb.plc;
+    size_t concealed = 0;
+
+    for (size_t i = 0; i < packets; i++) {
+        do {
+            size_t len = a2dp_plc_conceal(plc, buf, buf_len);
+            if (len == 0) {
+                return concealed;
+            }
+            a2dp_sbc_decoder_cb.decode_callback((uint8_t*)buf, len);
+            concealed += len / plc->frame_bytes;
+        } while (a2dp_plc_concealing(plc));
+    }
+    return concealed;
+}
+
 #endif /* #if (defined(SBC_DEC_INCLUDED) && SBC_DEC_INCLUDED == TRUE) */
@@ -118,6 +118,28 @@ const tA2DP_DECODER_INTERFACE* A2DP_GetDecoderInterface(
   return NULL;
 }
 
+const tA2DP_ENCODER_INTERFACE* A2DP_GetEncoderInterface(
+    const uint8_t* p_codec_info) {
+  tA2D_CODEC_TYPE codec_type = A2DP_GetCodecType(p_codec_info);
+
+  switch (codec_type) {
+    case A2D_MEDIA_CT_NON_A2DP:
+      return A2DP_GetVendorEncoderInterface(p_codec_info);
+    default:
+      break;
+  }
+
+  return NULL;
+}
+
+bool A2DP_UsesRtpHeader(const uint8_t* p_codec_info) {
+  tA2D_CODEC_TYPE codec_type = A2DP_GetCodecType(p_codec_info);
+
+  if (codec_type != A2D_MEDIA_CT_NON_A2DP) return true;
+
+  return A2DP_VendorUsesRtpHeader(p_codec_info);
+}
+
 btav_a2dp_codec_index_t A2DP_SinkCodecIndex(const uint8_t* p_codec_info) {
   tA2D_CODEC_TYPE codec_type = A2DP_GetCodecType(p_codec_info);
 
@@ -186,6 +208,22 @@ bool A2DP_BuildCodecConfig(UINT8 *p_src_cap, UINT8 *p_result) {
   }
 }
 
+bool A2DP_BuildSrcCodecConfig(UINT8 *p_snk_cap, UINT8 *p_result) {
+  tA2D_CODEC_TYPE codec_type = A2DP_GetCodecType(p_snk_cap);
+
+  LOG_VERBOSE("%s: codec_type = 0x%x", __func__, codec_type);
+
+  switch (codec_type) {
+    case A2D_MEDIA_CT_SBC:
+      return A2DP_BuildCodecConfigSbc(p_snk_cap, p_result);
+    case A2D_MEDIA_CT_NON_A2DP:
+      return A2DP_VendorBuildSrcCodecConfig(p_snk_cap, p_result);
+    default:
+      LOG_ERROR("%s: unsupported codec type 0x%x", __func__, codec_type);
+      return false;
+  }
+}
+
 const char* A2DP_CodecName(const uint8_t* p_codec_info) {
   tA2D_CODEC_TYPE codec_type = A2DP_GetCodecType(p_codec_info);
 
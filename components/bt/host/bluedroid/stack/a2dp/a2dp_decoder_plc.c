@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "stack/a2dp_decoder_plc.h"
+
+#define A2DP_PLC_UNITY_GAIN     (1 << 15)
+
+static inline int32_t a2dp_plc_get_sample(const uint8_t *p, uint8_t sample_bytes)
+{
+    if (sample_bytes == 4) {
+        return *(const int32_t *)p;
+    }
+    return *(const int16_t *)p;
+}
+
+static inline void a2dp_plc_put_sample(uint8_t *p, uint8_t sample_bytes, int32_t value)
+{
+    if (sample_bytes == 4) {
+        *(int32_t *)p = value;
+    } else {
+        *(int16_t *)p = (int16_t)value;
+    }
+}
+
+static inline int32_t a2dp_plc_scale(int32_t value, int32_t gain)
+{
+    return (int32_t)(((int64_t)value * gain) >> 15);
+}
+
+void a2dp_plc_init(tA2DP_PLC *p_plc, uint8_t channels, uint8_t sample_bytes)
+{
+    memset(p_plc, 0, sizeof(*p_plc));
+    p_plc->sample_bytes = sample_bytes;
+    p_plc->frame_bytes = channels * sample_bytes;
+    p_plc->gain = A2DP_PLC_UNITY_GAIN;
+}
+
+void a2dp_plc_good_pcm(tA2DP_PLC *p_plc, uint8_t *pcm, size_t len)
+{
+    size_t frames = len / p_plc->frame_bytes;
+    size_t keep;
+
+    if (frames == 0) {
+        return;
+    }
+    len = frames * p_plc->frame_bytes;
+
+    if (p_plc->gain < A2DP_PLC_UNITY_GAIN) {
+        /* ramp up from where the concealment left off to avoid a click */
+        int32_t step = (A2DP_PLC_UNITY_GAIN - p_plc->gain) / A2DP_PLC_FADE_IN_FRAMES;
+        size_t ramp = frames < A2DP_PLC_FADE_IN_FRAMES ? frames : A2DP_PLC_FADE_IN_FRAMES;
+        uint8_t *p = pcm;
+
+        for (size_t i = 0; i < ramp; i++) {
+            int32_t gain = p_plc->gain + step * (int32_t)i;
+            for (uint8_t j = 0; j < p_plc->frame_bytes; j += p_plc->sample_bytes) {
+                int32_t value = a2dp_plc_get_sample(p + j, p_plc->sample_bytes);
+                a2dp_plc_put_sample(p + j, p_plc->sample_bytes, a2dp_plc_scale(value, gain));
+            }
+            p += p_plc->frame_bytes;
+        }
+    }
+    p_plc->gain = A2DP_PLC_UNITY_GAIN;
+    p_plc->conceal_pos = 0;
+    p_plc->pending_len += len;
+
+    /* the history is the tail of the audio received, across chunks */
+    keep = A2DP_PLC_HISTORY_BYTES / p_plc->frame_bytes * p_plc->frame_bytes;
+    if (len >= keep) {
+        memcpy(p_plc->history, pcm + len - keep, keep);
+        p_plc->history_len = keep;
+    } else {
+        size_t old = p_plc->history_len + len > keep ? keep - len : p_plc->history_len;
+        memmove(p_plc->history, p_plc->history + p_plc->history_len - old, old);
+        memcpy(p_plc->history + old, pcm, len);
+        p_plc->history_len = old + len;
+    }
+    p_plc->replay_pos = 0;
+}
+
+void a2dp_plc_good_packet_end(tA2DP_PLC *p_plc)
+{
+    if (p_plc->pending_len != 0) {
+        p_plc->packet_len = p_plc->pending_len;
+        p_plc->pending_len = 0;
+    }
+}
+
+size_t a2dp_plc_conceal(tA2DP_PLC *p_plc, uint8_t *out, size_t out_len)
+{
+    size_t packet_frames = p_plc->packet_len / p_plc->frame_bytes;
+    size_t done = p_plc->conceal_pos / p_plc->frame_bytes;
+    size_t frames = (out_len / p_plc->frame_bytes < packet_frames - done) ?
+                    out_len / p_plc->frame_bytes : packet_frames - done;
+    size_t len = frames * p_plc->frame_bytes;
+    int32_t target;
+
+    if (frames == 0) {
+        p_plc->conceal_pos = 0;
+        return 0;
+    }
+    if (done == 0) {
+        p_plc->conceal_gain = p_plc->gain;
+    }
+    target = p_plc->conceal_gain - A2DP_PLC_UNITY_GAIN / A2DP_PLC_FADE_PACKETS;
+    if (target < 0) {
+        target = 0;
+    }
+
+    /* the lost packet is complete once all of its frames are out */
+    p_plc->conceal_pos = (done + frames < packet_frames) ? (done + frames) * p_plc->frame_bytes : 0;
+
+    if (p_plc->history_len == 0 || p_plc->conceal_gain == 0) {
+        memset(out, 0, len);
+        p_plc->gain = 0;
+        return len;
+    }
+
+    for (size_t i = done; i < done + frames; i++) {
+        int32_t gain = p_plc->conceal_gain +
+                       (target - p_plc->conceal_gain) * (int32_t)i / (int32_t)packet_frames;
+        const uint8_t *src = p_plc->history + p_plc->replay_pos;
+        for (uint8_t j = 0; j < p_plc->frame_bytes; j += p_plc->sample_bytes) {
+            int32_t value = a2dp_plc_get_sample(src + j, p_plc->sample_bytes);
+            a2dp_plc_put_sample(out + j, p_plc->sample_bytes, a2dp_plc_scale(value, gain));
+        }
+        out += p_plc->frame_bytes;
+        p_plc->replay_pos += p_plc->frame_bytes;
+        if (p_plc->replay_pos >= p_plc->history_len) {
+            p_plc->replay_pos = 0;
+        }
+    }
+    p_plc->gain = (p_plc->conceal_pos == 0) ? target :
+                  p_plc->conceal_gain + (target - p_plc->conceal_gain) *
+                  (int32_t)(done + frames) / (int32_t)packet_frames;
+    return len;
+}
@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <string.h>
+#include "stack/a2dp_sink_asrc.h"
+
+/* Q15 coefficients, the absolute values of a phase add up to less than 2
+   so that a filter output sums up in 32 bits */
+#define A2DP_ASRC_COEF_BITS     (15)
+#define A2DP_ASRC_COEF_ONE      (1 << A2DP_ASRC_COEF_BITS)
+
+/* cut-off relative to the Nyquist frequency, and Kaiser window shape */
+#define A2DP_ASRC_CUTOFF        (0.9f)
+#define A2DP_ASRC_KAISER_BETA   (8.0f)
+
+/* filter tap aligned with the input frame at a fractional position of 0 */
+#define A2DP_ASRC_CENTER        (A2DP_ASRC_TAPS / 2 - 1)
+
+/* one phase past the last one, so that interpolating never reads past the table */
+static int16_t a2dp_asrc_coefs[A2DP_ASRC_PHASES + 1][A2DP_ASRC_TAPS];
+static bool a2dp_asrc_coefs_ready;
+
+/* zero order modified Bessel function of the first kind */
+static float a2dp_asrc_bessel_i0(float x)
+{
+    float sum = 1.0f, term = 1.0f;
+
+    for (int k = 1; k < 20; k++) {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        sum += term;
+    }
+    return sum;
+}
+
+/* windowed sinc at |A2DP_ASRC_PHASES + 1| fractional positions, each phase
+   scaled to a DC gain of exactly 1 */
+static void a2dp_asrc_build_coefs(void)
+{
+    const float half = A2DP_ASRC_TAPS / 2;
+    const float i0_beta = a2dp_asrc_bessel_i0(A2DP_ASRC_KAISER_BETA);
+    float h[A2DP_ASRC_TAPS];
+
+    for (int p = 0; p <= A2DP_ASRC_PHASES; p++) {
+        float sum = 0.0f;
+        int32_t total = 0, center = 0;
+
+        for (int k = 0; k < A2DP_ASRC_TAPS; k++) {
+            float t = (float)(k - A2DP_ASRC_CENTER) - (float)p / A2DP_ASRC_PHASES;
+            float x = (float)M_PI * A2DP_ASRC_CUTOFF * t;
+            float r = t / half;
+            float w = (r * r < 1.0f) ? a2dp_asrc_bessel_i0(A2DP_ASRC_KAISER_BETA * sqrtf(1.0f - r * r)) / i0_beta : 0.0f;
+
+            h[k] = (x == 0.0f ? 1.0f : sinf(x) / x) * w;
+            sum += h[k];
+        }
+        for (int k = 0; k < A2DP_ASRC_TAPS; k++) {
+            a2dp_asrc_coefs[p][k] = (int16_t)lrintf(h[k] * A2DP_ASRC_COEF_ONE / sum);
+            total += a2dp_asrc_coefs[p][k];
+            if (h[k] > h[center]) {
+                center = k;
+            }
+        }
+        /* rounding must not change the gain */
+        a2dp_asrc_coefs[p][center] += A2DP_ASRC_COEF_ONE - total;
+    }
+    a2dp_asrc_coefs_ready = true;
+}
+
+static inline int16_t a2dp_asrc_sat16(int32_t acc)
+{
+    acc = (acc + (1 << (A2DP_ASRC_COEF_BITS - 1))) >> A2DP_ASRC_COEF_BITS;
+    if (acc > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (acc < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)acc;
+}
+
+/* filter at the Q32 fraction |frac|, interpolated between the two nearest phases */
+static inline void a2dp_asrc_filter_at(uint32_t frac, int16_t *h)
+{
+    const int16_t *c0 = a2dp_asrc_coefs[frac >> (32 - A2DP_ASRC_PHASE_BITS)];
+    const int16_t *c1 = c0 + A2DP_ASRC_TAPS;
+    int32_t f = (int32_t)((frac >> (32 - A2DP_ASRC_PHASE_BITS - 15)) & 0x7FFF);
+
+    for (int k = 0; k < A2DP_ASRC_TAPS; k++) {
+        h[k] = (int16_t)(c0[k] + (((c1[k] - c0[k]) * f) >> 15));
+    }
+}
+
+bool a2dp_asrc_init(tA2DP_ASRC *p_asrc, uint8_t channels)
+{
+    if (channels != 1 && channels != 2) {
+        return false;
+    }
+    if (!a2dp_asrc_coefs_ready) {
+        a2dp_asrc_build_coefs();
+    }
+
+    memset(p_asrc, 0, sizeof(*p_asrc));
+    p_asrc->channels = channels;
+    p_asrc->step = 1ULL << 32;
+    /* silence in front of the stream, so that the first output frame is
+       the first input frame */
+    p_asrc->in_frames = A2DP_ASRC_CENTER;
+    return true;
+}
+
+void a2dp_asrc_set_ratio(tA2DP_ASRC *p_asrc, int32_t ppb)
+{
+    if (ppb > A2DP_ASRC_MAX_PPB) {
+        ppb = A2DP_ASRC_MAX_PPB;
+    } else if (ppb < -A2DP_ASRC_MAX_PPB) {
+        ppb = -A2DP_ASRC_MAX_PPB;
+    }
+    p_asrc->step = (1ULL << 32) + (int64_t)ppb * (1LL << 32) / 1000000000;
+}
+
+size_t a2dp_asrc_process(tA2DP_ASRC *p_asrc, const int16_t *in, size_t frames, int16_t *out)
+{
+    const uint8_t ch = p_asrc->channels;
+    uint32_t avail, taken;
+    size_t n = 0;
+    int16_t h[A2DP_ASRC_TAPS];
+
+    if (frames > A2DP_ASRC_BLOCK_FRAMES) {
+        frames = A2DP_ASRC_BLOCK_FRAMES;
+    }
+    memcpy(p_asrc->in + p_asrc->in_frames * ch, in, frames * ch * sizeof(int16_t));
+    avail = p_asrc->in_frames + frames;
+
+    /*
+     * The filter is the same for all channels of a frame, the taps run over
+     * a fixed count without branches so that the compiler unrolls them into
+     * back to back multiply-accumulates.
+     */
+    if (ch == 2) {
+        while ((uint32_t)(p_asrc->pos >> 32) + A2DP_ASRC_TAPS <= avail) {
+            const int16_t *x = p_asrc->in + (uint32_t)(p_asrc->pos >> 32) * 2;
+            int32_t l = 0, r = 0;
+
+            a2dp_asrc_filter_at((uint32_t)p_asrc->pos, h);
+            for (int k = 0; k < A2DP_ASRC_TAPS; k++) {
+                l += h[k] * x[2 * k];
+                r += h[k] * x[2 * k + 1];
+            }
+            out[2 * n] = a2dp_asrc_sat16(l);
+            out[2 * n + 1] = a2dp_asrc_sat16(r);
+            n++;
+            p_asrc->pos += p_asrc->step;
+        }
+    } else {
+        while ((uint32_t)(p_asrc->pos >> 32) + A2DP_ASRC_TAPS <= avail) {
+            const int16_t *x = p_asrc->in + (uint32_t)(p_asrc->pos >> 32);
+            int32_t acc = 0;
+
+            a2dp_asrc_filter_at((uint32_t)p_asrc->pos, h);
+            for (int k = 0; k < A2DP_ASRC_TAPS; k++) {
+                acc += h[k] * x[k];
+            }
+            out[n++] = a2dp_asrc_sat16(acc);
+            p_asrc->pos += p_asrc->step;
+        }
+    }
+
+    /* keep the frames the next outputs still need */
+    taken = (uint32_t)(p_asrc->pos >> 32);
+    if (taken > avail) {
+        taken = avail;
+    }
+    memmove(p_asrc->in, p_asrc->in + taken * ch, (avail - taken) * ch * sizeof(int16_t));
+    p_asrc->in_frames = avail - taken;
+    p_asrc->pos -= (uint64_t)taken << 32;
+    p_asrc->advance += (int32_t)taken - (int32_t)n;
+    return n;
+}
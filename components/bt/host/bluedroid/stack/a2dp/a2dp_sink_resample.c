@@ -0,0 +1,323 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <string.h>
+#include "osi/allocator.h"
+#include "stack/a2dp_sink_resample.h"
+
+/* Q15 coefficients, the absolute values of a filter add up to less than 2
+   so that a 16-bit filter output sums up in 32 bits */
+#define A2DP_RESAMPLE_COEF_BITS     (15)
+#define A2DP_RESAMPLE_COEF_ONE      (1 << A2DP_RESAMPLE_COEF_BITS)
+
+/* polyphase cut-off relative to the lower Nyquist frequency, and Kaiser
+   window shape */
+#define A2DP_RESAMPLE_CUTOFF        (0.88f)
+#define A2DP_RESAMPLE_KAISER_BETA   (6.0f)
+
+/* Half-band filter, Kaiser window of beta 6: flat to 0.2 fs, -62 dB from
+   0.296 fs so that 88.2 kHz decimates with no alias below 18 kHz. Every
+   second tap is zero, only the taps on one side of the center are listed */
+#define A2DP_RESAMPLE_HB_CENTER     (A2DP_RESAMPLE_HB_TAPS / 2)
+#define A2DP_RESAMPLE_HB_SIDE       ((A2DP_RESAMPLE_HB_TAPS + 1) / 4)
+#define A2DP_RESAMPLE_HB_MID_COEF   (16388)
+
+static const int16_t a2dp_resample_hb_coefs[A2DP_RESAMPLE_HB_SIDE] = {
+    10377, -3318, 1830, -1150, 750, -489, 311, -189, 107, -55, 23, -7
+};
+
+/* history kept in front of a block, in sample frames */
+#define A2DP_RESAMPLE_HB_IN_FRAMES  (A2DP_RESAMPLE_HB_TAPS + A2DP_RESAMPLE_BLOCK_FRAMES)
+#define A2DP_RESAMPLE_PP_IN_FRAMES  (A2DP_RESAMPLE_TAPS_LONG + A2DP_RESAMPLE_BLOCK_FRAMES)
+
+static uint32_t a2dp_resample_gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/* zero order modified Bessel function of the first kind */
+static float a2dp_resample_bessel_i0(float x)
+{
+    float sum = 1.0f, term = 1.0f;
+
+    for (int k = 1; k < 20; k++) {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        sum += term;
+    }
+    return sum;
+}
+
+/*
+ * Windowed sinc of up * taps coefficients at the interpolated rate, split in
+ * |up| phases. Phase p holds the coefficients p, p + up, ... in reverse
+ * order so that it runs forward over the input history, and is scaled to a
+ * DC gain of exactly 1.
+ */
+static void a2dp_resample_build_bank(tA2DP_RESAMPLER *p_rs)
+{
+    const uint32_t len = (uint32_t)p_rs->up * p_rs->taps;
+    const float center = (len - 1) / 2.0f;
+    const float half = len / 2.0f;
+    const float fc = A2DP_RESAMPLE_CUTOFF / (p_rs->up > p_rs->down ? p_rs->up : p_rs->down);
+    const float i0_beta = a2dp_resample_bessel_i0(A2DP_RESAMPLE_KAISER_BETA);
+    float h[A2DP_RESAMPLE_TAPS_LONG];
+
+    for (uint16_t p = 0; p < p_rs->up; p++) {
+        int16_t *c = p_rs->bank + p * p_rs->taps;
+        float sum = 0.0f;
+        int32_t total = 0;
+        uint8_t peak = 0;
+
+        for (uint8_t k = 0; k < p_rs->taps; k++) {
+            float t = (float)((p_rs->taps - 1 - k) * p_rs->up + p) - center;
+            float x = (float)M_PI * fc * t;
+            float r = t / half;
+            float w = (r * r < 1.0f) ? a2dp_resample_bessel_i0(A2DP_RESAMPLE_KAISER_BETA * sqrtf(1.0f - r * r)) / i0_beta : 0.0f;
+
+            h[k] = (x == 0.0f ? 1.0f : sinf(x) / x) * w;
+            sum += h[k];
+        }
+        for (uint8_t k = 0; k < p_rs->taps; k++) {
+            c[k] = (int16_t)lrintf(h[k] * A2DP_RESAMPLE_COEF_ONE / sum);
+            total += c[k];
+            if (h[k] > h[peak]) {
+                peak = k;
+            }
+        }
+        /* rounding must not change the gain */
+        c[peak] += A2DP_RESAMPLE_COEF_ONE - total;
+    }
+}
+
+static inline int32_t a2dp_resample_sat(int64_t acc, int32_t max)
+{
+    acc = (acc + (1 << (A2DP_RESAMPLE_COEF_BITS - 1))) >> A2DP_RESAMPLE_COEF_BITS;
+    if (acc > max) {
+        return max;
+    }
+    if (acc < -(int64_t)max - 1) {
+        return -max - 1;
+    }
+    return (int32_t)acc;
+}
+
+/* largest sample value of the stream */
+static inline int32_t a2dp_resample_max(const tA2DP_RESAMPLER *p_rs)
+{
+    return p_rs->sample_bytes == 2 ? INT16_MAX : INT32_MAX;
+}
+
+/* Decimate |avail| frames of hb_in by 2 into |out|, keep the history the
+   next outputs need */
+static size_t a2dp_resample_halfband(tA2DP_RESAMPLER *p_rs, uint32_t avail, int32_t *out)
+{
+    const uint8_t ch = p_rs->channels;
+    const int32_t max = a2dp_resample_max(p_rs);
+    uint32_t pos = 0;
+    size_t n = 0;
+
+    for (; pos + A2DP_RESAMPLE_HB_TAPS <= avail; pos += 2, n++) {
+        const int32_t *x = p_rs->hb_in + (pos + A2DP_RESAMPLE_HB_CENTER) * ch;
+
+        for (uint8_t c = 0; c < ch; c++) {
+            if (p_rs->sample_bytes == 2) {
+                int32_t acc = A2DP_RESAMPLE_HB_MID_COEF * x[c];
+
+                for (int j = 0; j < A2DP_RESAMPLE_HB_SIDE; j++) {
+                    int d = (2 * j + 1) * ch;
+                    acc += a2dp_resample_hb_coefs[j] * (x[c - d] + x[c + d]);
+                }
+                out[n * ch + c] = a2dp_resample_sat(acc, max);
+            } else {
+                int64_t acc = (int64_t)A2DP_RESAMPLE_HB_MID_COEF * x[c];
+
+                for (int j = 0; j < A2DP_RESAMPLE_HB_SIDE; j++) {
+                    int d = (2 * j + 1) * ch;
+                    acc += a2dp_resample_hb_coefs[j] * ((int64_t)x[c - d] + x[c + d]);
+                }
+                out[n * ch + c] = a2dp_resample_sat(acc, max);
+            }
+        }
+    }
+
+    memmove(p_rs->hb_in, p_rs->hb_in + pos * ch, (avail - pos) * ch * sizeof(int32_t));
+    p_rs->hb_frames = avail - pos;
+    return n;
+}
+
+/* Run the polyphase bank over |avail| frames of pp_in into out, keep the
+   history the next outputs need */
+static size_t a2dp_resample_polyphase(tA2DP_RESAMPLER *p_rs, uint32_t avail)
+{
+    const uint8_t ch = p_rs->channels;
+    const uint8_t taps = p_rs->taps;
+    const int32_t max = a2dp_resample_max(p_rs);
+    int16_t *out16 = (int16_t *)p_rs->out;
+    int32_t *out32 = (int32_t *)p_rs->out;
+    uint32_t pos = 0, phase = p_rs->phase;
+    size_t n = 0;
+
+    while (pos + taps <= avail) {
+        const int16_t *h = p_rs->bank + phase * taps;
+        const int32_t *x = p_rs->pp_in + pos * ch;
+
+        if (p_rs->sample_bytes == 2) {
+            /* 16-bit samples, the common case, sum up in 32 bits */
+            if (ch == 2) {
+                int32_t l = 0, r = 0;
+
+                for (uint8_t k = 0; k < taps; k++) {
+                    l += h[k] * x[2 * k];
+                    r += h[k] * x[2 * k + 1];
+                }
+                out16[2 * n] = (int16_t)a2dp_resample_sat(l, max);
+                out16[2 * n + 1] = (int16_t)a2dp_resample_sat(r, max);
+            } else {
+                int32_t acc = 0;
+
+                for (uint8_t k = 0; k < taps; k++) {
+                    acc += h[k] * x[k];
+                }
+                out16[n] = (int16_t)a2dp_resample_sat(acc, max);
+            }
+        } else {
+            for (uint8_t c = 0; c < ch; c++) {
+                int64_t acc = 0;
+
+                for (uint8_t k = 0; k < taps; k++) {
+                    acc += (int64_t)h[k] * x[k * ch + c];
+                }
+                out32[n * ch + c] = a2dp_resample_sat(acc, max);
+            }
+        }
+        n++;
+        phase += p_rs->down;
+        pos += phase / p_rs->up;
+        phase %= p_rs->up;
+    }
+
+    p_rs->phase = (uint16_t)phase;
+    memmove(p_rs->pp_in, p_rs->pp_in + pos * ch, (avail - pos) * ch * sizeof(int32_t));
+    p_rs->pp_frames = avail - pos;
+    return n;
+}
+
+bool a2dp_resample_init(tA2DP_RESAMPLER *p_rs, uint32_t in_rate, uint32_t out_rate,
+                        uint8_t channels, uint8_t sample_bytes)
+{
+    uint32_t rate = in_rate, g;
+
+    if ((channels != 1 && channels != 2) || (sample_bytes != 2 && sample_bytes != 4) ||
+            in_rate == 0 || out_rate == 0 || in_rate == out_rate) {
+        return false;
+    }
+
+    memset(p_rs, 0, sizeof(*p_rs));
+    p_rs->in_rate = in_rate;
+    p_rs->out_rate = out_rate;
+    p_rs->channels = channels;
+    p_rs->sample_bytes = sample_bytes;
+
+    /* 88.2 and 96 kHz are halved first, cheaply and with a sharp filter */
+    if (in_rate > 48000 && (in_rate & 1) == 0 && in_rate / 2 >= out_rate * 3 / 4) {
+        p_rs->decimate = true;
+        rate = in_rate / 2;
+    }
+    if (rate != out_rate) {
+        g = a2dp_resample_gcd(out_rate, rate);
+        if (out_rate / g > A2DP_RESAMPLE_MAX_PHASES || rate / g > A2DP_RESAMPLE_MAX_PHASES ||
+                out_rate > rate * 3 || rate > out_rate * 3) {
+            return false;
+        }
+        p_rs->up = (uint16_t)(out_rate / g);
+        p_rs->down = (uint16_t)(rate / g);
+        p_rs->taps = p_rs->up > A2DP_RESAMPLE_MAX_PHASES_LONG ? A2DP_RESAMPLE_TAPS_SHORT : A2DP_RESAMPLE_TAPS_LONG;
+        p_rs->bank = (int16_t *)osi_malloc(p_rs->up * p_rs->taps * sizeof(int16_t));
+    }
+    if (p_rs->decimate) {
+        p_rs->hb_in = (int32_t *)osi_malloc(A2DP_RESAMPLE_HB_IN_FRAMES * channels * sizeof(int32_t));
+    }
+    p_rs->pp_in = (int32_t *)osi_malloc(A2DP_RESAMPLE_PP_IN_FRAMES * channels * sizeof(int32_t));
+    p_rs->out = (uint8_t *)osi_malloc(A2DP_RESAMPLE_MAX_OUT_FRAMES * channels * sizeof(int32_t));
+    if ((p_rs->up != 0 && p_rs->bank == NULL) || (p_rs->decimate && p_rs->hb_in == NULL) ||
+            p_rs->pp_in == NULL || p_rs->out == NULL) {
+        a2dp_resample_cleanup(p_rs);
+        return false;
+    }
+
+    if (p_rs->up != 0) {
+        a2dp_resample_build_bank(p_rs);
+    }
+    a2dp_resample_reset(p_rs);
+    return true;
+}
+
+void a2dp_resample_reset(tA2DP_RESAMPLER *p_rs)
+{
+    /* silence in front of the stream, so that every filter has a full history */
+    p_rs->phase = 0;
+    if (p_rs->decimate) {
+        p_rs->hb_frames = A2DP_RESAMPLE_HB_TAPS - 1;
+        memset(p_rs->hb_in, 0, p_rs->hb_frames * p_rs->channels * sizeof(int32_t));
+    }
+    p_rs->pp_frames = p_rs->up != 0 ? p_rs->taps - 1 : 0;
+    memset(p_rs->pp_in, 0, A2DP_RESAMPLE_PP_IN_FRAMES * p_rs->channels * sizeof(int32_t));
+}
+
+void a2dp_resample_cleanup(tA2DP_RESAMPLER *p_rs)
+{
+    osi_free(p_rs->bank);
+    osi_free(p_rs->hb_in);
+    osi_free(p_rs->pp_in);
+    osi_free(p_rs->out);
+    memset(p_rs, 0, sizeof(*p_rs));
+}
+
+size_t a2dp_resample_process(tA2DP_RESAMPLER *p_rs, const void *in, size_t frames, const uint8_t **pp_out)
+{
+    const uint8_t ch = p_rs->channels;
+    int32_t *dst;
+    size_t n;
+
+    if (frames > A2DP_RESAMPLE_BLOCK_FRAMES) {
+        frames = A2DP_RESAMPLE_BLOCK_FRAMES;
+    }
+    *pp_out = p_rs->out;
+
+    /* widen to 32 bits behind the history of the first stage */
+    dst = p_rs->decimate ? p_rs->hb_in + p_rs->hb_frames * ch : p_rs->pp_in + p_rs->pp_frames * ch;
+    if (p_rs->sample_bytes == 2) {
+        const int16_t *src = (const int16_t *)in;
+        for (size_t i = 0; i < frames * ch; i++) {
+            dst[i] = src[i];
+        }
+    } else {
+        memcpy(dst, in, frames * ch * sizeof(int32_t));
+    }
+
+    if (!p_rs->decimate) {
+        return a2dp_resample_polyphase(p_rs, p_rs->pp_frames + frames);
+    }
+    n = a2dp_resample_halfband(p_rs, p_rs->hb_frames + frames, p_rs->pp_in + p_rs->pp_frames * ch);
+    if (p_rs->up != 0) {
+        return a2dp_resample_polyphase(p_rs, p_rs->pp_frames + n);
+    }
+
+    /* decimation only, narrow the half-band output */
+    if (p_rs->sample_bytes == 2) {
+        int16_t *out16 = (int16_t *)p_rs->out;
+        for (size_t i = 0; i < n * ch; i++) {
+            out16[i] = (int16_t)p_rs->pp_in[i];
+        }
+    } else {
+        memcpy(p_rs->out, p_rs->pp_in, n * ch * sizeof(int32_t));
+    }
+    return n;
+}
@@ -34,7 +34,7 @@ tA2D_STATUS A2DP_VendorParseInfo(uint8_t* p_ie, const uint8_t* p_codec_info,
   uint32_t vendor_id = A2DP_VendorCodecGetVendorId(p_codec_info);
   uint16_t codec_id = A2DP_VendorCodecGetCodecId(p_codec_info);
 
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
   // Check for aptX
   if (vendor_id == A2DP_APTX_VENDOR_ID &&
       codec_id == A2DP_APTX_CODEC_ID_BLUETOOTH) {
@@ -50,7 +50,7 @@ tA2D_STATUS A2DP_VendorParseInfo(uint8_t* p_ie, const uint8_t* p_codec_info,
       codec_id == A2DP_APTX_LL_CODEC_ID_BLUETOOTH) {
     return A2DP_ParseInfoAptxLl((tA2DP_APTX_LL_CIE*)p_ie, p_codec_info, is_capability);
   }
-#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+#endif /* defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE) */
 
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
   // Check for LDAC
@@ -71,7 +71,7 @@ bool A2DP_IsVendorPeerSinkCodecValid(const uint8_t* p_codec_info) {
   uint32_t vendor_id = A2DP_VendorCodecGetVendorId(p_codec_info);
   uint16_t codec_id = A2DP_VendorCodecGetCodecId(p_codec_info);
 
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
   // Check for aptX
   if (vendor_id == A2DP_APTX_VENDOR_ID &&
       codec_id == A2DP_APTX_CODEC_ID_BLUETOOTH) {
@@ -87,7 +87,7 @@ bool A2DP_IsVendorPeerSinkCodecValid(const uint8_t* p_codec_info) {
       codec_id == A2DP_APTX_LL_CODEC_ID_BLUETOOTH) {
     return A2DP_IsVendorPeerSinkCodecValidAptxLl(p_codec_info);
   }
-#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+#endif /* defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE) */
 
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
   // Check for LDAC
@@ -108,11 +108,23 @@ bool A2DP_IsVendorSinkCodecSupported(const uint8_t* p_codec_info) {
   uint32_t vendor_id = A2DP_VendorCodecGetVendorId(p_codec_info);
   uint16_t codec_id = A2DP_VendorCodecGetCodecId(p_codec_info);
 
-  UNUSED(vendor_id);
-  UNUSED(codec_id);
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+  // Check for aptX
+  if (vendor_id == A2DP_APTX_VENDOR_ID &&
+      codec_id == A2DP_APTX_CODEC_ID_BLUETOOTH) {
+    return A2DP_IsVendorSinkCodecSupportedAptx(p_codec_info);
+  }
+  // Check for aptX-HD
+  if (vendor_id == A2DP_APTX_HD_VENDOR_ID &&
+      codec_id == A2DP_APTX_HD_CODEC_ID_BLUETOOTH) {
+    return A2DP_IsVendorSinkCodecSupportedAptxHd(p_codec_info);
+  }
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
 
   // Add checks based on <vendor_id, codec_id>
   // NOTE: Should be done only for local Sink codecs.
+  (void)vendor_id;
+  (void)codec_id;
 
   return false;
 }
@@ -179,7 +191,7 @@ btav_a2dp_codec_index_t A2DP_VendorSinkCodecIndex(
   uint32_t vendor_id = A2DP_VendorCodecGetVendorId(p_codec_info);
   uint16_t codec_id = A2DP_VendorCodecGetCodecId(p_codec_info);
 
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
   // Check for aptX
   if (vendor_id == A2DP_APTX_VENDOR_ID &&
       codec_id == A2DP_APTX_CODEC_ID_BLUETOOTH) {
@@ -195,7 +207,7 @@ btav_a2dp_codec_index_t A2DP_VendorSinkCodecIndex(
       codec_id == A2DP_APTX_LL_CODEC_ID_BLUETOOTH) {
     return A2DP_VendorSinkCodecIndexAptxLl(p_codec_info);
   }
-#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+#endif /* defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE) */
 
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
   // Check for LDAC
@@ -217,7 +229,7 @@ btav_a2dp_codec_index_t A2DP_VendorSourceCodecIndex(
   uint32_t vendor_id = A2DP_VendorCodecGetVendorId(p_codec_info);
   uint16_t codec_id = A2DP_VendorCodecGetCodecId(p_codec_info);
 
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
   // Check for aptX
   if (vendor_id == A2DP_APTX_VENDOR_ID &&
       codec_id == A2DP_APTX_CODEC_ID_BLUETOOTH) {
@@ -233,7 +245,7 @@ btav_a2dp_codec_index_t A2DP_VendorSourceCodecIndex(
       codec_id == A2DP_APTX_LL_CODEC_ID_BLUETOOTH) {
     return A2DP_VendorSourceCodecIndexAptxLl(p_codec_info);
   }
-#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+#endif /* defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE) */
 
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
   // Check for LDAC
@@ -252,7 +264,7 @@ btav_a2dp_codec_index_t A2DP_VendorSourceCodecIndex(
 
 bool A2DP_VendorInitCodecConfig(btav_a2dp_codec_index_t codec_index, UINT8 *p_result) {
 
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
   // Check for aptX
   if (A2DP_VendorInitCodecConfigAptx(codec_index, p_result)) {
     return true;
@@ -265,7 +277,7 @@ bool A2DP_VendorInitCodecConfig(btav_a2dp_codec_index_t codec_index, UINT8 *p_re
   if (A2DP_VendorInitCodecConfigAptxLl(codec_index, p_result)) {
     return true;
   }
-#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+#endif /* defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE) */
 
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
   // Check for LDAC
@@ -318,11 +330,37 @@ bool A2DP_VendorBuildCodecConfig(UINT8 *p_src_cap, UINT8 *p_result) {
   return false;
 }
 
+// Build codec info from a sink config
+bool A2DP_VendorBuildSrcCodecConfig(UINT8 *p_snk_cap, UINT8 *p_result) {
+  uint32_t vendor_id = A2DP_VendorCodecGetVendorId(p_snk_cap);
+  uint16_t codec_id = A2DP_VendorCodecGetCodecId(p_snk_cap);
+
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+  // Check for aptX
+  if (vendor_id == A2DP_APTX_VENDOR_ID &&
+      codec_id == A2DP_APTX_CODEC_ID_BLUETOOTH) {
+    return A2DP_VendorBuildSrcCodecConfigAptx(p_snk_cap, p_result);
+  }
+  // Check for aptX-HD
+  if (vendor_id == A2DP_APTX_HD_VENDOR_ID &&
+      codec_id == A2DP_APTX_HD_CODEC_ID_BLUETOOTH) {
+    return A2DP_VendorBuildSrcCodecConfigAptxHd(p_snk_cap, p_result);
+  }
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
+
+  // Add checks based on <vendor_id, codec_id>
+  (void)vendor_id;
+  (void)codec_id;
+  (void)p_result;
+
+  return false;
+}
+
 const char* A2DP_VendorCodecName(const uint8_t* p_codec_info) {
   uint32_t vendor_id = A2DP_VendorCodecGetVendorId(p_codec_info);
   uint16_t codec_id = A2DP_VendorCodecGetCodecId(p_codec_info);
 
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
   // Check for aptX
   if (vendor_id == A2DP_APTX_VENDOR_ID &&
       codec_id == A2DP_APTX_CODEC_ID_BLUETOOTH) {
@@ -338,7 +376,7 @@ const char* A2DP_VendorCodecName(const uint8_t* p_codec_info) {
       codec_id == A2DP_APTX_LL_CODEC_ID_BLUETOOTH) {
     return A2DP_VendorCodecNameAptxLl(p_codec_info);
   }
-#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+#endif /* defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE) */
 
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
   // Check for LDAC
@@ -372,7 +410,7 @@ bool A2DP_VendorCodecTypeEquals(const uint8_t* p_codec_info_a,
 
   if (vendor_id_a != vendor_id_b || codec_id_a != codec_id_b) return false;
 
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
   // Check for aptX
   if (vendor_id_a == A2DP_APTX_VENDOR_ID &&
       codec_id_a == A2DP_APTX_CODEC_ID_BLUETOOTH) {
@@ -388,7 +426,7 @@ bool A2DP_VendorCodecTypeEquals(const uint8_t* p_codec_info_a,
       codec_id_a == A2DP_APTX_LL_CODEC_ID_BLUETOOTH) {
     return A2DP_VendorCodecTypeEqualsAptxLl(p_codec_info_a, p_codec_info_b);
   }
-#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+#endif /* defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE) */
 
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
   // Check for LDAC
@@ -442,4 +480,39 @@ const tA2DP_DECODER_INTERFACE* A2DP_GetVendorDecoderInterface(
   return NULL;
 }
 
+const tA2DP_ENCODER_INTERFACE* A2DP_GetVendorEncoderInterface(
+    const uint8_t* p_codec_info) {
+  uint32_t vendor_id = A2DP_VendorCodecGetVendorId(p_codec_info);
+  uint16_t codec_id = A2DP_VendorCodecGetCodecId(p_codec_info);
+
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+  if (vendor_id == A2DP_APTX_VENDOR_ID &&
+      codec_id == A2DP_APTX_CODEC_ID_BLUETOOTH) {
+    return A2DP_GetVendorEncoderInterfaceAptx(p_codec_info);
+  }
+  if (vendor_id == A2DP_APTX_HD_VENDOR_ID &&
+      codec_id == A2DP_APTX_HD_CODEC_ID_BLUETOOTH) {
+    return A2DP_GetVendorEncoderInterfaceAptxHd(p_codec_info);
+  }
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
+
+  (void)vendor_id;
+  (void)codec_id;
+
+  return NULL;
+}
+
+bool A2DP_VendorUsesRtpHeader(const uint8_t* p_codec_info) {
+  uint32_t vendor_id = A2DP_VendorCodecGetVendorId(p_codec_info);
+  uint16_t codec_id = A2DP_VendorCodecGetCodecId(p_codec_info);
+
+  // aptX media packets are the bare codec payload, aptX-HD has an RTP header
+  if (vendor_id == A2DP_APTX_VENDOR_ID &&
+      codec_id == A2DP_APTX_CODEC_ID_BLUETOOTH) {
+    return false;
+  }
+
+  return true;
+}
+
 #endif  ///A2D_INCLUDED
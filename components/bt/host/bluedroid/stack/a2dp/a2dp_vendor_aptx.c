@@ -12,14 +12,15 @@
 #include "stack/a2d_sbc.h"
 #include "stack/a2dp_vendor_aptx.h"
 #include "stack/a2dp_vendor_aptx_decoder.h"
+#include "stack/a2dp_vendor_aptx_encoder.h"
 
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
 
-/* aptX Source codec capabilities */
+/* aptX Source codec capabilities, btc_a2dp_source feeds 44.1 kHz PCM */
 static const tA2DP_APTX_CIE a2dp_aptx_source_caps = {
     A2DP_APTX_VENDOR_ID,                                       /* vendorId */
     A2DP_APTX_CODEC_ID_BLUETOOTH,                              /* codecId */
-    (A2DP_APTX_SAMPLERATE_44100 | A2DP_APTX_SAMPLERATE_48000), /* sampleRate */
+    A2DP_APTX_SAMPLERATE_44100,                                /* sampleRate */
     A2DP_APTX_CHANNELS_STEREO,                                 /* channelMode */
     A2DP_APTX_FUTURE_1,                                        /* future1 */
     A2DP_APTX_FUTURE_2,                                        /* future2 */
@@ -48,6 +49,7 @@ static const tA2DP_APTX_CIE a2dp_aptx_default_config = {
     BTAV_A2DP_CODEC_BITS_PER_SAMPLE_16 /* bits_per_sample */
 };
 
+#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
 static const tA2DP_DECODER_INTERFACE a2dp_decoder_interface_aptx = {
     a2dp_aptx_decoder_init,
     a2dp_aptx_decoder_cleanup,
@@ -57,7 +59,24 @@ static const tA2DP_DECODER_INTERFACE a2dp_decoder_interface_aptx = {
     NULL,  // decoder_start
     NULL,  // decoder_suspend
     a2dp_aptx_decoder_configure,
+    a2dp_aptx_decoder_conceal,
+    a2dp_aptx_decoder_get_pcm_format,
+    a2dp_aptx_decoder_get_max_output_size,
+    a2dp_aptx_decoder_supports_pcm_format,
+    a2dp_aptx_decoder_set_pcm_format,
+    a2dp_aptx_decoder_get_media_timestamp,
+};
+#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+static const tA2DP_ENCODER_INTERFACE a2dp_encoder_interface_aptx = {
+    a2dp_aptx_encoder_init,
+    a2dp_aptx_encoder_cleanup,
+    a2dp_aptx_encoder_feeding_reset,
+    a2dp_aptx_encoder_feeding_flush,
+    a2dp_aptx_encoder_send_frames,
 };
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
 
 tA2D_STATUS A2DP_BuildInfoAptx(uint8_t media_type,
                                        const tA2DP_APTX_CIE* p_ie,
@@ -153,6 +172,13 @@ bool A2DP_IsVendorPeerSinkCodecValidAptx(const uint8_t* p_codec_info) {
          (A2DP_ParseInfoAptx(&cfg_cie, p_codec_info, true) == A2D_SUCCESS);
 }
 
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+bool A2DP_IsVendorSinkCodecSupportedAptx(const uint8_t* p_codec_info) {
+  return A2DP_CodecInfoMatchesCapabilityAptx(&a2dp_aptx_source_caps,
+                                             p_codec_info, false) == A2D_SUCCESS;
+}
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
+
 tA2D_STATUS A2DP_CodecInfoMatchesCapabilityAptx(
     const tA2DP_APTX_CIE* p_cap, const uint8_t* p_codec_info,
     bool is_capability) {
@@ -224,8 +250,14 @@ bool A2DP_VendorCodecTypeEqualsAptx(const uint8_t* p_codec_info_a,
 
 bool A2DP_VendorInitCodecConfigAptx(btav_a2dp_codec_index_t codec_index, UINT8 *p_result) {
   switch(codec_index) {
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+    case BTAV_A2DP_CODEC_INDEX_SOURCE_APTX:
+      return A2DP_VendorInitCodecConfigAptxSrc(p_result);
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
+#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
     case BTAV_A2DP_CODEC_INDEX_SINK_APTX:
       return A2DP_VendorInitCodecConfigAptxSink(p_result);
+#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
     default:
       break;
   }
@@ -238,6 +270,47 @@ bool A2DP_VendorInitCodecConfigAptxSink(uint8_t* p_codec_info) {
   return sts == A2D_SUCCESS;
 }
 
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+bool A2DP_VendorInitCodecConfigAptxSrc(uint8_t* p_codec_info) {
+  tA2D_STATUS sts = A2D_FAIL;
+  sts = A2DP_BuildInfoAptx(A2D_MEDIA_TYPE_AUDIO, &a2dp_aptx_source_caps, p_codec_info);
+  return sts == A2D_SUCCESS;
+}
+
+bool A2DP_VendorBuildSrcCodecConfigAptx(UINT8 *p_snk_cap, UINT8 *p_result) {
+  tA2DP_APTX_CIE snk_cap;
+  tA2DP_APTX_CIE pref_cap = a2dp_aptx_default_config;
+  tA2D_STATUS status;
+
+  if ((status = A2DP_ParseInfoAptx(&snk_cap, p_snk_cap, TRUE)) != 0) {
+    APPL_TRACE_ERROR("%s: Cant parse snk cap ret = %d", __func__, status);
+    return false;
+  }
+
+  if (snk_cap.sampleRate & a2dp_aptx_source_caps.sampleRate & A2DP_APTX_SAMPLERATE_44100) {
+    pref_cap.sampleRate = A2DP_APTX_SAMPLERATE_44100;
+  } else if (snk_cap.sampleRate & a2dp_aptx_source_caps.sampleRate & A2DP_APTX_SAMPLERATE_48000) {
+    pref_cap.sampleRate = A2DP_APTX_SAMPLERATE_48000;
+  } else {
+    APPL_TRACE_WARNING("%s: Unsupported sample rate 0x%x", __func__,
+                       snk_cap.sampleRate);
+    return false;
+  }
+
+  /* the encoder is stereo only */
+  if (snk_cap.channelMode & A2DP_APTX_CHANNELS_STEREO) {
+    pref_cap.channelMode = A2DP_APTX_CHANNELS_STEREO;
+  } else {
+    APPL_TRACE_WARNING("%s: Unsupported channel mode 0x%x", __func__,
+                       snk_cap.channelMode);
+    return false;
+  }
+
+  A2DP_BuildInfoAptx(A2D_MEDIA_TYPE_AUDIO, (tA2DP_APTX_CIE *) &pref_cap, p_result);
+  return true;
+}
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
+
 bool A2DP_VendorBuildCodecConfigAptx(UINT8 *p_src_cap, UINT8 *p_result) {
   tA2DP_APTX_CIE src_cap;
   tA2DP_APTX_CIE pref_cap = a2dp_aptx_default_config;
@@ -272,11 +345,22 @@ bool A2DP_VendorBuildCodecConfigAptx(UINT8 *p_src_cap, UINT8 *p_result) {
   return true;
 }
 
+#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
 const tA2DP_DECODER_INTERFACE* A2DP_GetVendorDecoderInterfaceAptx(
     const uint8_t* p_codec_info) {
   if (!A2DP_IsVendorPeerSinkCodecValidAptx(p_codec_info)) return NULL;
 
   return &a2dp_decoder_interface_aptx;
 }
-
 #endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+const tA2DP_ENCODER_INTERFACE* A2DP_GetVendorEncoderInterfaceAptx(
+    const uint8_t* p_codec_info) {
+  if (!A2DP_IsVendorPeerSinkCodecValidAptx(p_codec_info)) return NULL;
+
+  return &a2dp_encoder_interface_aptx;
+}
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
+
+#endif /* defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE) */
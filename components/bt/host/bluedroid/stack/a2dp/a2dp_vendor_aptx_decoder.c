@@ -2,8 +2,14 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <arpa/inet.h>
 #include "common/bt_trace.h"
+#include "stack/a2dp_vendor_aptx.h"
+#include "stack/a2dp_vendor_aptx_hd.h"
+#include "stack/a2dp_vendor_aptx_ll.h"
+#include "stack/a2dp_vendor_aptx_constants.h"
 #include "stack/a2dp_vendor_aptx_decoder.h"
+#include "stack/a2dp_decoder_plc.h"
 
 
 #if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
@@ -35,6 +41,10 @@ extern size_t aptx_decode32(struct aptx_context *ctx,
                             size_t output_size,
                             size_t *written);
 
+/* libfreeaptx produces a few codewords of 4 stereo samples at a time,
+   keep room for 16 samples in the widest (S32) format */
+#define A2DP_APTX_DECODER_MAX_OUTPUT (16 * 2 * sizeof(int32_t))
+
 typedef enum
 {
     APTX_STANDARD,
@@ -45,11 +55,30 @@ typedef enum
 typedef struct {
   struct aptx_context* decoder_context;
   tA2DP_APTX_TYPE aptx_type;
+  uint32_t sample_rate;
+  uint8_t bits_per_sample;      /* 16 or 32 */
+  uint8_t valid_bits;
+  tA2DP_PCM_FORMAT pcm_request; /* applied by the next configure */
   decoded_data_callback_t decode_callback;
+  tA2DP_DECODER_SEQ seq;
+  tA2DP_PLC plc;
 } tA2DP_APTX_DECODER_CB;
 
 static tA2DP_APTX_DECODER_CB a2dp_aptx_decoder_cb;
 
+static void a2dp_aptx_decoder_emit(unsigned char* buf, size_t len) {
+    if (len == 0) {
+        return;
+    }
+    a2dp_plc_good_pcm(&a2dp_aptx_decoder_cb.plc, buf, len);
+    a2dp_aptx_decoder_cb.decode_callback((uint8_t*)buf, len);
+}
+
+static void a2dp_aptx_decoder_plc_init(void) {
+    a2dp_plc_init(&a2dp_aptx_decoder_cb.plc, 2, a2dp_aptx_decoder_cb.bits_per_sample / 8);
+    a2dp_decoder_seq_reset(&a2dp_aptx_decoder_cb.seq);
+}
+
 
 bool a2dp_aptx_decoder_init(decoded_data_callback_t decode_callback) {
     struct aptx_context* decoder_context = aptx_init(0);
@@ -60,6 +89,11 @@ bool a2dp_aptx_decoder_init(decoded_data_callback_t decode_callback) {
     a2dp_aptx_decoder_cb.decoder_context = decoder_context;
     a2dp_aptx_decoder_cb.decode_callback = decode_callback;
     a2dp_aptx_decoder_cb.aptx_type = APTX_STANDARD;
+    a2dp_aptx_decoder_cb.bits_per_sample = 16;
+    a2dp_aptx_decoder_cb.valid_bits = 16;
+    a2dp_aptx_decoder_cb.pcm_request.bits_per_sample = 16;
+    a2dp_aptx_decoder_cb.pcm_request.valid_bits = 16;
+    a2dp_aptx_decoder_plc_init();
     return true;
 }
 
@@ -82,17 +116,35 @@ bool a2dp_aptx_decoder_reset(void) {
     }
 
     aptx_reset(decoder_context);
+    a2dp_aptx_decoder_plc_init();
     return true;
 }
 
 size_t a2dp_aptx_decoder_decode_packet_header(BT_HDR* p_buf) {
+    /* only aptX-HD packets carry an RTP header */
     if (a2dp_aptx_decoder_cb.aptx_type != APTX_HD) {
         return 0;
     }
+    struct media_packet_header *header =
+        (struct media_packet_header *)((UINT8 *)(p_buf + 1) + p_buf->offset);
     size_t header_len = sizeof(struct media_packet_header);
+    uint16_t seq = ntohs(header->seq);
+
     p_buf->offset += header_len;
     p_buf->len -= header_len;
-    return 0;
+
+    /* report sequence number */
+    p_buf->layer_specific = seq;
+
+    return a2dp_decoder_seq_update(&a2dp_aptx_decoder_cb.seq, seq);
+}
+
+bool a2dp_aptx_decoder_get_media_timestamp(const BT_HDR* p_buf, uint32_t* p_timestamp) {
+    if (a2dp_aptx_decoder_cb.aptx_type != APTX_HD) {
+        return false;
+    }
+    *p_timestamp = a2dp_decoder_rtp_timestamp((const UINT8 *)(p_buf + 1) + p_buf->offset);
+    return true;
 }
 
 bool a2dp_aptx_decoder_decode_packet(BT_HDR* p_buf, unsigned char* buf, size_t buf_len) {
@@ -105,11 +157,23 @@ bool a2dp_aptx_decoder_decode_packet(BT_HDR* p_buf, unsigned char* buf, size_t b
 
     while (src_size > 0) {
         size_t processed, written;
-        if (a2dp_aptx_decoder_cb.aptx_type == APTX_LL) {
+
+        /* pass on the audio decoded so far once the buffer is nearly full */
+        if (avail < A2DP_APTX_DECODER_MAX_OUTPUT) {
+            a2dp_aptx_decoder_emit(buf, buf_len - avail);
+            dst = buf;
+            avail = buf_len;
+        }
+
+        if (a2dp_aptx_decoder_cb.bits_per_sample == 32) {
             processed = aptx_decode32(decoder_context, src, src_size, dst, avail, &written);
         } else {
             processed = aptx_decode16(decoder_context, src, src_size, dst, avail, &written);
         }
+        if (processed == 0 && written == 0) {
+            /* trailing bytes shorter than a codeword */
+            break;
+        }
 
         src += processed;
         src_size -= processed;
@@ -120,11 +184,81 @@ bool a2dp_aptx_decoder_decode_packet(BT_HDR* p_buf, unsigned char* buf, size_t b
         p_buf->len -= processed;
     }
 
-    size_t len = buf_len - avail;
-    a2dp_aptx_decoder_cb.decode_callback((uint8_t*)buf, len);
+    a2dp_aptx_decoder_emit(buf, buf_len - avail);
+    a2dp_plc_good_packet_end(&a2dp_aptx_decoder_cb.plc);
+    return true;
+}
+
+size_t a2dp_aptx_decoder_conceal(size_t packets, unsigned char* buf, size_t buf_len) {
+    tA2DP_PLC *plc = &a2dp_aptx_decoder_cb.plc;
+    size_t concealed = 0;
+
+    for (size_t i = 0; i < packets; i++) {
+        do {
+            size_t len = a2dp_plc_conceal(plc, buf, buf_len);
+            if (len == 0) {
+                return concealed;
+            }
+            a2dp_aptx_decoder_cb.decode_callback((uint8_t*)buf, len);
+            concealed += len / plc->frame_bytes;
+        } while (a2dp_plc_concealing(plc));
+    }
+    return concealed;
+}
+
+bool a2dp_aptx_decoder_get_pcm_format(tA2DP_PCM_FORMAT* p_format) {
+    if (a2dp_aptx_decoder_cb.sample_rate == 0) {
+        return false;
+    }
+    p_format->sample_rate = a2dp_aptx_decoder_cb.sample_rate;
+    p_format->channels = 2;
+    p_format->bits_per_sample = a2dp_aptx_decoder_cb.bits_per_sample;
+    p_format->valid_bits = a2dp_aptx_decoder_cb.valid_bits;
     return true;
 }
 
+size_t a2dp_aptx_decoder_get_max_output_size(void) {
+    return A2DP_APTX_DECODER_MAX_OUTPUT;
+}
+
+/* libfreeaptx decodes 24 bit samples, aptx_decode32 places them MSB aligned
+   in 32 bit slots, S24 and S32 are the same output */
+bool a2dp_aptx_decoder_supports_pcm_format(const tA2DP_PCM_FORMAT* p_format) {
+    if (p_format->bits_per_sample == 16) {
+        return p_format->valid_bits == 16;
+    }
+    return p_format->bits_per_sample == 32 &&
+           (p_format->valid_bits == 24 || p_format->valid_bits == 32);
+}
+
+void a2dp_aptx_decoder_set_pcm_format(const tA2DP_PCM_FORMAT* p_format) {
+    a2dp_aptx_decoder_cb.pcm_request = *p_format;
+}
+
+static uint32_t a2dp_aptx_decoder_parse_sample_rate(btav_a2dp_codec_index_t index,
+                                                    const uint8_t* p_codec_info) {
+    uint8_t sample_rate = 0;
+
+    /* the sampling frequency bits are the same for all aptX flavours */
+    if (index == BTAV_A2DP_CODEC_INDEX_SINK_APTX_HD) {
+        tA2DP_APTX_HD_CIE cie;
+        if (A2DP_ParseInfoAptxHd(&cie, p_codec_info, false) == A2D_SUCCESS) {
+            sample_rate = cie.sampleRate;
+        }
+    } else if (index == BTAV_A2DP_CODEC_INDEX_SINK_APTX_LL) {
+        tA2DP_APTX_LL_CIE cie;
+        if (A2DP_ParseInfoAptxLl(&cie, p_codec_info, false) == A2D_SUCCESS) {
+            sample_rate = cie.sampleRate;
+        }
+    } else {
+        tA2DP_APTX_CIE cie;
+        if (A2DP_ParseInfoAptx(&cie, p_codec_info, false) == A2D_SUCCESS) {
+            sample_rate = cie.sampleRate;
+        }
+    }
+    return (sample_rate == A2DP_APTX_SAMPLERATE_48000) ? 48000 : 44100;
+}
+
 void a2dp_aptx_decoder_configure(const uint8_t* p_codec_info) {
     struct aptx_context* decoder_context = a2dp_aptx_decoder_cb.decoder_context;
     btav_a2dp_codec_index_t index = A2DP_SinkCodecIndex(p_codec_info);
@@ -141,9 +275,13 @@ void a2dp_aptx_decoder_configure(const uint8_t* p_codec_info) {
     } else {
         a2dp_aptx_decoder_cb.aptx_type = APTX_STANDARD;
     }
+    a2dp_aptx_decoder_cb.sample_rate = a2dp_aptx_decoder_parse_sample_rate(index, p_codec_info);
+    a2dp_aptx_decoder_cb.bits_per_sample = a2dp_aptx_decoder_cb.pcm_request.bits_per_sample;
+    a2dp_aptx_decoder_cb.valid_bits = a2dp_aptx_decoder_cb.pcm_request.valid_bits;
 
     aptx_finish(decoder_context);
     a2dp_aptx_decoder_cb.decoder_context = aptx_init(a2dp_aptx_decoder_cb.aptx_type == APTX_HD);
+    a2dp_aptx_decoder_plc_init();
 }
 
 #endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
@@ -0,0 +1,239 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "common/bt_trace.h"
+#include "osi/allocator.h"
+#include "stack/avdt_api.h"
+#include "stack/a2dp_vendor_aptx.h"
+#include "stack/a2dp_vendor_aptx_hd.h"
+#include "stack/a2dp_vendor_aptx_constants.h"
+#include "stack/a2dp_vendor_aptx_hd_constants.h"
+#include "stack/a2dp_vendor_aptx_encoder.h"
+
+
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+
+/* libfreeaptx API */
+extern struct aptx_context *aptx_init(int hd);
+extern void aptx_reset(struct aptx_context *ctx);
+extern void aptx_finish(struct aptx_context *ctx);
+extern size_t aptx_encode(struct aptx_context *ctx,
+                          const unsigned char *input,
+                          size_t input_size,
+                          unsigned char *output,
+                          size_t output_size,
+                          size_t *written);
+
+/* keep room for the AVDTP media header and the content protection header */
+#if (BTA_AV_CO_CP_SCMS_T == TRUE)
+#define A2DP_APTX_ENCODER_OFFSET        (AVDT_MEDIA_OFFSET + 1)
+#else
+#define A2DP_APTX_ENCODER_OFFSET        AVDT_MEDIA_OFFSET
+#endif
+
+/* a multiple of both codeword sizes */
+#define A2DP_APTX_ENCODER_MAX_PAYLOAD   1008
+
+/* a codeword codes 4 stereo frames in 4 octets, 6 octets for aptX-HD */
+#define A2DP_APTX_FRAMES_PER_CODEWORD   4
+#define A2DP_APTX_CODEWORD_SIZE         4
+#define A2DP_APTX_HD_CODEWORD_SIZE      6
+
+/* PCM frames read from the feeding at a time */
+#define A2DP_APTX_ENCODER_PCM_FRAMES    128
+
+/* bound the catch-up after a stall of the media task */
+#define A2DP_APTX_ENCODER_MAX_INTERVAL_US 100000
+
+typedef struct {
+  struct aptx_context* encoder_context;
+  bool is_hd;
+  uint32_t sample_rate;
+  uint16_t payload_max;
+  uint8_t codeword_size;
+  a2dp_source_read_callback_t read_callback;
+  a2dp_source_enqueue_callback_t enqueue_callback;
+  uint64_t last_frame_us;
+  uint64_t frames_due_us;       /* PCM frames due, times 1000000 */
+  uint32_t timestamp;           /* in PCM frames */
+  int16_t pcm[A2DP_APTX_ENCODER_PCM_FRAMES * 2];
+  uint8_t pcm24[A2DP_APTX_ENCODER_PCM_FRAMES * 2 * 3];
+} tA2DP_APTX_ENCODER_CB;
+
+static tA2DP_APTX_ENCODER_CB a2dp_aptx_encoder_cb;
+
+static uint32_t a2dp_aptx_encoder_parse_sample_rate(bool is_hd, const uint8_t* p_codec_info) {
+    if (is_hd) {
+        tA2DP_APTX_HD_CIE cie;
+        if (A2DP_ParseInfoAptxHd(&cie, p_codec_info, false) == A2D_SUCCESS &&
+            cie.sampleRate == A2DP_APTX_HD_SAMPLERATE_48000) {
+            return 48000;
+        }
+    } else {
+        tA2DP_APTX_CIE cie;
+        if (A2DP_ParseInfoAptx(&cie, p_codec_info, false) == A2D_SUCCESS &&
+            cie.sampleRate == A2DP_APTX_SAMPLERATE_48000) {
+            return 48000;
+        }
+    }
+    return 44100;
+}
+
+bool a2dp_aptx_encoder_init(const uint8_t* p_codec_info, uint16_t peer_mtu,
+                            a2dp_source_read_callback_t read_callback,
+                            a2dp_source_enqueue_callback_t enqueue_callback) {
+    bool is_hd = A2DP_SourceCodecIndex(p_codec_info) == BTAV_A2DP_CODEC_INDEX_SOURCE_APTX_HD;
+    uint16_t payload_max = peer_mtu;
+
+    if (a2dp_aptx_encoder_cb.encoder_context) {
+        aptx_finish(a2dp_aptx_encoder_cb.encoder_context);
+    }
+    memset(&a2dp_aptx_encoder_cb, 0, sizeof(a2dp_aptx_encoder_cb));
+
+    a2dp_aptx_encoder_cb.encoder_context = aptx_init(is_hd);
+    if (!a2dp_aptx_encoder_cb.encoder_context) {
+        APPL_TRACE_ERROR("%s encoder init failed", __func__);
+        return false;
+    }
+    a2dp_aptx_encoder_cb.is_hd = is_hd;
+    a2dp_aptx_encoder_cb.sample_rate = a2dp_aptx_encoder_parse_sample_rate(is_hd, p_codec_info);
+    a2dp_aptx_encoder_cb.codeword_size = is_hd ? A2DP_APTX_HD_CODEWORD_SIZE : A2DP_APTX_CODEWORD_SIZE;
+    if (payload_max > A2DP_APTX_ENCODER_MAX_PAYLOAD) {
+        payload_max = A2DP_APTX_ENCODER_MAX_PAYLOAD;
+    }
+    a2dp_aptx_encoder_cb.payload_max = payload_max - payload_max % a2dp_aptx_encoder_cb.codeword_size;
+    a2dp_aptx_encoder_cb.read_callback = read_callback;
+    a2dp_aptx_encoder_cb.enqueue_callback = enqueue_callback;
+
+    APPL_TRACE_EVENT("%s %s %u Hz, peer mtu %u, payload %u", __func__, is_hd ? "aptX-HD" : "aptX",
+                     a2dp_aptx_encoder_cb.sample_rate, peer_mtu, a2dp_aptx_encoder_cb.payload_max);
+    return a2dp_aptx_encoder_cb.payload_max > 0;
+}
+
+void a2dp_aptx_encoder_cleanup(void) {
+    if (!a2dp_aptx_encoder_cb.encoder_context) {
+        return;
+    }
+
+    aptx_finish(a2dp_aptx_encoder_cb.encoder_context);
+    a2dp_aptx_encoder_cb.encoder_context = NULL;
+}
+
+void a2dp_aptx_encoder_feeding_reset(void) {
+    if (a2dp_aptx_encoder_cb.encoder_context) {
+        aptx_reset(a2dp_aptx_encoder_cb.encoder_context);
+    }
+    a2dp_aptx_encoder_cb.last_frame_us = 0;
+    a2dp_aptx_encoder_cb.frames_due_us = 0;
+}
+
+void a2dp_aptx_encoder_feeding_flush(void) {
+    a2dp_aptx_encoder_cb.frames_due_us = 0;
+}
+
+/* Reads up to |frames| PCM frames, pads a short read with silence. Returns 0 if the feeding has no data */
+static uint32_t a2dp_aptx_encoder_read_pcm(uint32_t frames) {
+    uint32_t len = frames * 2 * sizeof(int16_t);
+    uint32_t nb_byte_read = a2dp_aptx_encoder_cb.read_callback((uint8_t *)a2dp_aptx_encoder_cb.pcm, len);
+
+    if (nb_byte_read == 0) {
+        return 0;
+    }
+    if (nb_byte_read < len) {
+        memset((uint8_t *)a2dp_aptx_encoder_cb.pcm + nb_byte_read, 0, len - nb_byte_read);
+    }
+
+    /* libfreeaptx takes 24-bit little endian samples */
+    uint8_t *p = a2dp_aptx_encoder_cb.pcm24;
+    for (uint32_t i = 0; i < frames * 2; i++) {
+        uint16_t s = (uint16_t)a2dp_aptx_encoder_cb.pcm[i];
+        *p++ = 0;
+        *p++ = (uint8_t)s;
+        *p++ = (uint8_t)(s >> 8);
+    }
+    return frames;
+}
+
+static void a2dp_aptx_encoder_enqueue(BT_HDR *p_buf, uint32_t frames) {
+    a2dp_aptx_encoder_cb.timestamp += frames;
+    a2dp_aptx_encoder_cb.enqueue_callback(p_buf, frames);
+}
+
+void a2dp_aptx_encoder_send_frames(uint64_t timestamp_us) {
+    tA2DP_APTX_ENCODER_CB *p_cb = &a2dp_aptx_encoder_cb;
+    BT_HDR *p_buf = NULL;
+    uint32_t packet_frames = 0;
+
+    if (!p_cb->encoder_context) {
+        return;
+    }
+
+    if (p_cb->last_frame_us != 0) {
+        uint64_t elapsed_us = timestamp_us - p_cb->last_frame_us;
+        if (elapsed_us > A2DP_APTX_ENCODER_MAX_INTERVAL_US) {
+            elapsed_us = A2DP_APTX_ENCODER_MAX_INTERVAL_US;
+        }
+        p_cb->frames_due_us += elapsed_us * p_cb->sample_rate;
+    }
+    p_cb->last_frame_us = timestamp_us;
+
+    /* whole codewords only, the rest is due at the next call */
+    uint32_t frames_due = (uint32_t)(p_cb->frames_due_us / 1000000);
+    frames_due -= frames_due % A2DP_APTX_FRAMES_PER_CODEWORD;
+
+    while (frames_due > 0) {
+        if (p_buf == NULL) {
+            p_buf = (BT_HDR *)osi_malloc(sizeof(BT_HDR) + A2DP_APTX_ENCODER_OFFSET + p_cb->payload_max);
+            if (p_buf == NULL) {
+                APPL_TRACE_ERROR("%s out of memory", __func__);
+                break;
+            }
+            p_buf->offset = A2DP_APTX_ENCODER_OFFSET;
+            p_buf->len = 0;
+            p_buf->layer_specific = 0;
+            *((UINT32 *) (p_buf + 1)) = p_cb->timestamp;
+            packet_frames = 0;
+        }
+
+        uint32_t room = (p_cb->payload_max - p_buf->len) / p_cb->codeword_size * A2DP_APTX_FRAMES_PER_CODEWORD;
+        uint32_t frames = frames_due;
+        if (frames > room) {
+            frames = room;
+        }
+        if (frames > A2DP_APTX_ENCODER_PCM_FRAMES) {
+            frames = A2DP_APTX_ENCODER_PCM_FRAMES;
+        }
+        if (a2dp_aptx_encoder_read_pcm(frames) == 0) {
+            /* the feeding has nothing, don't build up a backlog */
+            p_cb->frames_due_us = 0;
+            break;
+        }
+
+        size_t written = 0;
+        uint8_t *p_out = (uint8_t *)(p_buf + 1) + p_buf->offset + p_buf->len;
+        aptx_encode(p_cb->encoder_context, p_cb->pcm24, frames * 2 * 3,
+                    p_out, p_cb->payload_max - p_buf->len, &written);
+        p_buf->len += written;
+        p_buf->layer_specific += frames / A2DP_APTX_FRAMES_PER_CODEWORD;
+        packet_frames += frames;
+        frames_due -= frames;
+        p_cb->frames_due_us -= (uint64_t)frames * 1000000;
+
+        if (p_cb->payload_max - p_buf->len < p_cb->codeword_size) {
+            a2dp_aptx_encoder_enqueue(p_buf, packet_frames);
+            p_buf = NULL;
+        }
+    }
+
+    if (p_buf != NULL) {
+        if (p_buf->len > 0) {
+            a2dp_aptx_encoder_enqueue(p_buf, packet_frames);
+        } else {
+            osi_free(p_buf);
+        }
+    }
+}
+
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
@@ -11,17 +11,17 @@
 #include "stack/a2d_api.h"
 #include "stack/a2d_sbc.h"
 #include "stack/a2dp_vendor_aptx_decoder.h"
+#include "stack/a2dp_vendor_aptx_encoder.h"
 #include "stack/a2dp_vendor_aptx_hd.h"
 #include "stack/a2dp_vendor_aptx_hd_constants.h"
 
 #if (defined(A2D_INCLUDED) && A2D_INCLUDED == TRUE)
 
-/* aptX-HD Source codec capabilities */
+/* aptX-HD Source codec capabilities, btc_a2dp_source feeds 44.1 kHz PCM */
 static const tA2DP_APTX_HD_CIE a2dp_aptx_hd_source_caps = {
     A2DP_APTX_HD_VENDOR_ID,          /* vendorId */
     A2DP_APTX_HD_CODEC_ID_BLUETOOTH, /* codecId */
-    (A2DP_APTX_HD_SAMPLERATE_44100 |
-     A2DP_APTX_HD_SAMPLERATE_48000),   /* sampleRate */
+    A2DP_APTX_HD_SAMPLERATE_44100,     /* sampleRate */
     A2DP_APTX_HD_CHANNELS_STEREO,      /* channelMode */
     A2DP_APTX_HD_ACL_SPRINT_RESERVED0, /* acl_sprint_reserved0 */
     A2DP_APTX_HD_ACL_SPRINT_RESERVED1, /* acl_sprint_reserved1 */
@@ -57,6 +57,7 @@ static const tA2DP_APTX_HD_CIE a2dp_aptx_hd_default_config = {
     BTAV_A2DP_CODEC_BITS_PER_SAMPLE_16 /* bits_per_sample */
 };
 
+#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
 static const tA2DP_DECODER_INTERFACE a2dp_decoder_interface_aptx_hd = {
     a2dp_aptx_decoder_init,
     a2dp_aptx_decoder_cleanup,
@@ -66,7 +67,24 @@ static const tA2DP_DECODER_INTERFACE a2dp_decoder_interface_aptx_hd = {
     NULL,  // decoder_start
     NULL,  // decoder_suspend
     a2dp_aptx_decoder_configure,
+    a2dp_aptx_decoder_conceal,
+    a2dp_aptx_decoder_get_pcm_format,
+    a2dp_aptx_decoder_get_max_output_size,
+    a2dp_aptx_decoder_supports_pcm_format,
+    a2dp_aptx_decoder_set_pcm_format,
+    a2dp_aptx_decoder_get_media_timestamp,
+};
+#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+static const tA2DP_ENCODER_INTERFACE a2dp_encoder_interface_aptx_hd = {
+    a2dp_aptx_encoder_init,
+    a2dp_aptx_encoder_cleanup,
+    a2dp_aptx_encoder_feeding_reset,
+    a2dp_aptx_encoder_feeding_flush,
+    a2dp_aptx_encoder_send_frames,
 };
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
 
 // Builds the aptX-HD Media Codec Capabilities byte sequence beginning from the
 // LOSC octet. |media_type| is the media type |AVDT_MEDIA_TYPE_*|.
@@ -185,6 +203,13 @@ bool A2DP_IsVendorPeerSinkCodecValidAptxHd(const uint8_t* p_codec_info) {
          (A2DP_ParseInfoAptxHd(&cfg_cie, p_codec_info, true) == A2DP_SUCCESS);
 }
 
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+bool A2DP_IsVendorSinkCodecSupportedAptxHd(const uint8_t* p_codec_info) {
+  return A2DP_CodecInfoMatchesCapabilityAptxHd(&a2dp_aptx_hd_source_caps,
+                                               p_codec_info, false) == A2D_SUCCESS;
+}
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
+
 // Checks whether A2DP aptX-HD codec configuration matches with a device's
 // codec capabilities. |p_cap| is the aptX-HD codec configuration.
 // |p_codec_info| is the device's codec capabilities.
@@ -263,8 +288,14 @@ bool A2DP_VendorCodecTypeEqualsAptxHd(const uint8_t* p_codec_info_a,
 
 bool A2DP_VendorInitCodecConfigAptxHd(btav_a2dp_codec_index_t codec_index, UINT8 *p_result) {
   switch(codec_index) {
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+    case BTAV_A2DP_CODEC_INDEX_SOURCE_APTX_HD:
+      return A2DP_VendorInitCodecConfigAptxHdSrc(p_result);
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
+#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
     case BTAV_A2DP_CODEC_INDEX_SINK_APTX_HD:
       return A2DP_VendorInitCodecConfigAptxHdSink(p_result);
+#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
     default:
       break;
   }
@@ -277,6 +308,47 @@ bool A2DP_VendorInitCodecConfigAptxHdSink(uint8_t* p_codec_info) {
   return sts == A2D_SUCCESS;
 }
 
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+bool A2DP_VendorInitCodecConfigAptxHdSrc(uint8_t* p_codec_info) {
+  tA2D_STATUS sts = A2D_FAIL;
+  sts = A2DP_BuildInfoAptxHd(A2D_MEDIA_TYPE_AUDIO, &a2dp_aptx_hd_source_caps, p_codec_info);
+  return sts == A2D_SUCCESS;
+}
+
+bool A2DP_VendorBuildSrcCodecConfigAptxHd(UINT8 *p_snk_cap, UINT8 *p_result) {
+  tA2DP_APTX_HD_CIE snk_cap;
+  tA2DP_APTX_HD_CIE pref_cap = a2dp_aptx_hd_default_config;
+  tA2D_STATUS status;
+
+  if ((status = A2DP_ParseInfoAptxHd(&snk_cap, p_snk_cap, TRUE)) != 0) {
+    APPL_TRACE_ERROR("%s: Cant parse snk cap ret = %d", __func__, status);
+    return false;
+  }
+
+  if (snk_cap.sampleRate & a2dp_aptx_hd_source_caps.sampleRate & A2DP_APTX_HD_SAMPLERATE_44100) {
+    pref_cap.sampleRate = A2DP_APTX_HD_SAMPLERATE_44100;
+  } else if (snk_cap.sampleRate & a2dp_aptx_hd_source_caps.sampleRate & A2DP_APTX_HD_SAMPLERATE_48000) {
+    pref_cap.sampleRate = A2DP_APTX_HD_SAMPLERATE_48000;
+  } else {
+    APPL_TRACE_WARNING("%s: Unsupported sample rate 0x%x", __func__,
+                       snk_cap.sampleRate);
+    return false;
+  }
+
+  /* the encoder is stereo only */
+  if (snk_cap.channelMode & A2DP_APTX_HD_CHANNELS_STEREO) {
+    pref_cap.channelMode = A2DP_APTX_HD_CHANNELS_STEREO;
+  } else {
+    APPL_TRACE_WARNING("%s: Unsupported channel mode 0x%x", __func__,
+                       snk_cap.channelMode);
+    return false;
+  }
+
+  A2DP_BuildInfoAptxHd(A2D_MEDIA_TYPE_AUDIO, (tA2DP_APTX_HD_CIE *) &pref_cap, p_result);
+  return true;
+}
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
+
 bool A2DP_VendorBuildCodecConfigAptxHd(UINT8 *p_src_cap, UINT8 *p_result) {
   tA2DP_APTX_HD_CIE src_cap;
   tA2DP_APTX_HD_CIE pref_cap = a2dp_aptx_hd_default_config;
@@ -311,11 +383,22 @@ bool A2DP_VendorBuildCodecConfigAptxHd(UINT8 *p_src_cap, UINT8 *p_result) {
   return true;
 }
 
+#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
 const tA2DP_DECODER_INTERFACE* A2DP_GetVendorDecoderInterfaceAptxHd(
     const uint8_t* p_codec_info) {
   if (!A2DP_IsVendorPeerSinkCodecValidAptxHd(p_codec_info)) return NULL;
 
   return &a2dp_decoder_interface_aptx_hd;
 }
+#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
+
+#if (defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE)
+const tA2DP_ENCODER_INTERFACE* A2DP_GetVendorEncoderInterfaceAptxHd(
+    const uint8_t* p_codec_info) {
+  if (!A2DP_IsVendorPeerSinkCodecValidAptxHd(p_codec_info)) return NULL;
+
+  return &a2dp_encoder_interface_aptx_hd;
+}
+#endif /* defined(APTX_ENC_INCLUDED) && APTX_ENC_INCLUDED == TRUE) */
 
 #endif /* #if (defined(A2D_INCLUDED) && A2D_INCLUDED == TRUE) */
@@ -49,6 +49,7 @@ static const tA2DP_APTX_LL_CIE a2dp_aptx_ll_default_config = {
     BTAV_A2DP_CODEC_BITS_PER_SAMPLE_16 /* bits_per_sample */
 };
 
+#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
 static const tA2DP_DECODER_INTERFACE a2dp_decoder_interface_aptx_ll = {
     a2dp_aptx_decoder_init,
     a2dp_aptx_decoder_cleanup,
@@ -58,7 +59,14 @@ static const tA2DP_DECODER_INTERFACE a2dp_decoder_interface_aptx_ll = {
     NULL,  // decoder_start
     NULL,  // decoder_suspend
     a2dp_aptx_decoder_configure,
+    a2dp_aptx_decoder_conceal,
+    a2dp_aptx_decoder_get_pcm_format,
+    a2dp_aptx_decoder_get_max_output_size,
+    a2dp_aptx_decoder_supports_pcm_format,
+    a2dp_aptx_decoder_set_pcm_format,
+    a2dp_aptx_decoder_get_media_timestamp,
 };
+#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
 
 // Builds the aptX-LL Media Codec Capabilities byte sequence beginning from the
 // LOSC octet. |media_type| is the media type |AVDT_MEDIA_TYPE_*|.
@@ -252,8 +260,10 @@ bool A2DP_VendorCodecTypeEqualsAptxLl(const uint8_t* p_codec_info_a,
 
 bool A2DP_VendorInitCodecConfigAptxLl(btav_a2dp_codec_index_t codec_index, UINT8 *p_result) {
   switch(codec_index) {
+#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
     case BTAV_A2DP_CODEC_INDEX_SINK_APTX_LL:
       return A2DP_VendorInitCodecConfigAptxLlSink(p_result);
+#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
     default:
       break;
   }
@@ -300,11 +310,13 @@ bool A2DP_VendorBuildCodecConfigAptxLl(UINT8 *p_src_cap, UINT8 *p_result) {
   return true;
 }
 
+#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
 const tA2DP_DECODER_INTERFACE* A2DP_GetVendorDecoderInterfaceAptxLl(
     const uint8_t* p_codec_info) {
   if (!A2DP_IsVendorPeerSinkCodecValidAptxLl(p_codec_info)) return NULL;
 
   return &a2dp_decoder_interface_aptx_ll;
 }
+#endif /* defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE) */
 
 #endif /* #if (defined(A2D_INCLUDED) && A2D_INCLUDED == TRUE) */
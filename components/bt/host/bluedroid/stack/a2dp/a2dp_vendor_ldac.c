@@ -52,12 +52,18 @@ static const tA2DP_LDAC_CIE a2dp_ldac_default_config = {
 static const tA2DP_DECODER_INTERFACE a2dp_decoder_interface_ldac = {
     a2dp_ldac_decoder_init,
     NULL,  // decoder_cleanup,
-    NULL,  // decoder_reset,
+    a2dp_ldac_decoder_reset,
     a2dp_ldac_decoder_decode_packet_header,
     a2dp_ldac_decoder_decode_packet,
     NULL,  // decoder_start
     NULL,  // decoder_suspend
-    NULL,  // decoder_configure
+    a2dp_ldac_decoder_configure,
+    a2dp_ldac_decoder_conceal,
+    a2dp_ldac_decoder_get_pcm_format,
+    a2dp_ldac_decoder_get_max_output_size,
+    a2dp_ldac_decoder_supports_pcm_format,
+    a2dp_ldac_decoder_set_pcm_format,
+    a2dp_ldac_decoder_get_media_timestamp,
 };
 
 tA2D_STATUS A2DP_BuildInfoLdac(uint8_t media_type,
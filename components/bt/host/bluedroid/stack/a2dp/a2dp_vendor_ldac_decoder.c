@@ -2,7 +2,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <arpa/inet.h>
 #include "common/bt_trace.h"
+#include "stack/a2dp_vendor_ldac.h"
 #include "stack/a2dp_vendor_ldac_constants.h"
 #include "stack/a2dp_vendor_ldac_decoder.h"
 #include "ldacdec.h"
@@ -10,13 +12,29 @@
 
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
 
+/* PCM of the largest LDAC frame in the widest sample format */
+#define A2DP_LDAC_DECODER_MAX_OUTPUT (MAX_FRAME_SAMPLES * 2 * sizeof(int32_t))
+
 typedef struct {
   ldacdec_t decoder;
   decoded_data_callback_t decode_callback;
+  tA2DP_DECODER_SEQ seq;
+  int frames_per_packet;
+  tA2DP_PCM_FORMAT pcm_format;
+  tA2DP_PCM_FORMAT pcm_request; /* applied by the next configure */
+  bool half_rate;               /* 88.2 and 96 kHz decoded at 44.1 and 48 kHz */
 } tA2DP_LDAC_DECODER_CB;
 
 static tA2DP_LDAC_DECODER_CB a2dp_ldac_decoder_cb;
 
+/* bytes of PCM one frame decodes to */
+static int a2dp_ldac_decoder_frame_bytes(void) {
+    frame_t *frame = &a2dp_ldac_decoder_cb.decoder.frame;
+
+    return frame->frameSamples * frame->channelCount *
+           (a2dp_ldac_decoder_cb.pcm_format.bits_per_sample / 8);
+}
+
 
 bool a2dp_ldac_decoder_init(decoded_data_callback_t decode_callback) {
     int res;
@@ -27,15 +45,122 @@ bool a2dp_ldac_decoder_init(decoded_data_callback_t decode_callback) {
         return false;
     }
     a2dp_ldac_decoder_cb.decode_callback = decode_callback;
+    a2dp_ldac_decoder_cb.frames_per_packet = 0;
+    a2dp_ldac_decoder_cb.pcm_format.bits_per_sample = 16;
+    a2dp_ldac_decoder_cb.pcm_format.valid_bits = 16;
+    a2dp_ldac_decoder_cb.pcm_format.sample_rate = 0;
+    a2dp_ldac_decoder_cb.pcm_request = a2dp_ldac_decoder_cb.pcm_format;
+    a2dp_ldac_decoder_cb.half_rate = false;
+    a2dp_decoder_seq_reset(&a2dp_ldac_decoder_cb.seq);
+    return true;
+}
+
+bool a2dp_ldac_decoder_reset(void) {
+    int res = ldacdecInit(&a2dp_ldac_decoder_cb.decoder);
+    if (res) {
+        APPL_TRACE_ERROR("%s: decoder reset failed %d", __func__, res);
+        return false;
+    }
+    a2dp_ldac_decoder_cb.frames_per_packet = 0;
+    a2dp_decoder_seq_reset(&a2dp_ldac_decoder_cb.seq);
+    return true;
+}
+
+void a2dp_ldac_decoder_configure(const uint8_t* p_codec_info) {
+    tA2DP_PCM_FORMAT* p_format = &a2dp_ldac_decoder_cb.pcm_format;
+    tA2DP_LDAC_CIE cie;
+
+    if (A2DP_ParseInfoLdac(&cie, p_codec_info, false) != A2D_SUCCESS) {
+        APPL_TRACE_ERROR("%s: failed parsing codec info", __func__);
+        p_format->sample_rate = 0;
+        return;
+    }
+
+    switch (cie.sampleRate) {
+    case A2DP_LDAC_SAMPLING_FREQ_44100:
+        p_format->sample_rate = 44100;
+        break;
+    case A2DP_LDAC_SAMPLING_FREQ_88200:
+        p_format->sample_rate = 88200;
+        break;
+    case A2DP_LDAC_SAMPLING_FREQ_96000:
+        p_format->sample_rate = 96000;
+        break;
+    case A2DP_LDAC_SAMPLING_FREQ_176400:
+        p_format->sample_rate = 176400;
+        break;
+    case A2DP_LDAC_SAMPLING_FREQ_192000:
+        p_format->sample_rate = 192000;
+        break;
+    default:
+        p_format->sample_rate = 48000;
+        break;
+    }
+    p_format->channels = (cie.channelMode == A2DP_LDAC_CHANNEL_MODE_MONO) ? 1 : 2;
+    p_format->bits_per_sample = a2dp_ldac_decoder_cb.pcm_request.bits_per_sample;
+    p_format->valid_bits = a2dp_ldac_decoder_cb.pcm_request.valid_bits;
+    ldacdecSetSampleBits(&a2dp_ldac_decoder_cb.decoder, p_format->valid_bits);
+
+    /* an output of half the rate or less needs only the lower half of the
+       spectrum, synthesized with the IMDCT of half the size */
+    a2dp_ldac_decoder_cb.half_rate = a2dp_ldac_decoder_cb.pcm_request.sample_rate != 0 &&
+                                     (p_format->sample_rate == 88200 || p_format->sample_rate == 96000) &&
+                                     a2dp_ldac_decoder_cb.pcm_request.sample_rate <= p_format->sample_rate / 2;
+    ldacdecSetHalfRate(&a2dp_ldac_decoder_cb.decoder, a2dp_ldac_decoder_cb.half_rate);
+    if (a2dp_ldac_decoder_cb.half_rate) {
+        p_format->sample_rate /= 2;
+    }
+}
+
+bool a2dp_ldac_decoder_get_pcm_format(tA2DP_PCM_FORMAT* p_format) {
+    if (a2dp_ldac_decoder_cb.pcm_format.sample_rate == 0) {
+        return false;
+    }
+    *p_format = a2dp_ldac_decoder_cb.pcm_format;
     return true;
 }
 
+size_t a2dp_ldac_decoder_get_max_output_size(void) {
+    return A2DP_LDAC_DECODER_MAX_OUTPUT;
+}
+
+/* the synthesis writes 16 bit samples, or 24 and 32 bit ones MSB aligned
+   in 32 bit slots */
+bool a2dp_ldac_decoder_supports_pcm_format(const tA2DP_PCM_FORMAT* p_format) {
+    if (p_format->bits_per_sample == 16) {
+        return p_format->valid_bits == 16;
+    }
+    return p_format->bits_per_sample == 32 &&
+           (p_format->valid_bits == 24 || p_format->valid_bits == 32);
+}
+
+void a2dp_ldac_decoder_set_pcm_format(const tA2DP_PCM_FORMAT* p_format) {
+    a2dp_ldac_decoder_cb.pcm_request = *p_format;
+}
+
 size_t a2dp_ldac_decoder_decode_packet_header(BT_HDR* p_buf) {
+    struct media_packet_header *header =
+        (struct media_packet_header *)((UINT8 *)(p_buf + 1) + p_buf->offset);
     size_t header_len = sizeof(struct media_packet_header) +
                         A2DP_LDAC_MPL_HDR_LEN;
+    uint16_t seq = ntohs(header->seq);
+
     p_buf->offset += header_len;
     p_buf->len -= header_len;
-    return 0;
+
+    /* report sequence number */
+    p_buf->layer_specific = seq;
+
+    return a2dp_decoder_seq_update(&a2dp_ldac_decoder_cb.seq, seq);
+}
+
+bool a2dp_ldac_decoder_get_media_timestamp(const BT_HDR* p_buf, uint32_t* p_timestamp) {
+    *p_timestamp = a2dp_decoder_rtp_timestamp((const UINT8 *)(p_buf + 1) + p_buf->offset);
+    /* counts the frames of the stream rate, wraps at 2^31 at half rate */
+    if (a2dp_ldac_decoder_cb.half_rate) {
+        *p_timestamp >>= 1;
+    }
+    return true;
 }
 
 static bool find_sync_word(unsigned char** buf, int *size) {
@@ -57,10 +182,20 @@ bool a2dp_ldac_decoder_decode_packet(BT_HDR* p_buf, unsigned char* buf, size_t b
     unsigned char* dst = buf;
     uint32_t dst_size = 0;
     int bytes_used;
+    int frames = 0;
 
-    while (src_size > 0 && dst_size < buf_len) {
+    while (src_size > 0) {
         int out_size;
 
+        /* pass on the frames decoded so far if the next one may not fit */
+        if (buf_len - dst_size < A2DP_LDAC_DECODER_MAX_OUTPUT) {
+            if (dst_size != 0) {
+                a2dp_ldac_decoder_cb.decode_callback((uint8_t*)buf, dst_size);
+            }
+            dst = buf;
+            dst_size = 0;
+        }
+
         if (!find_sync_word(&src, &src_size)) {
             break;
         }
@@ -73,14 +208,51 @@ bool a2dp_ldac_decoder_decode_packet(BT_HDR* p_buf, unsigned char* buf, size_t b
         src += bytes_used;
         src_size -= bytes_used;
 
-        frame_t *frame = &decoder->frame;
-        out_size = frame->frameSamples * frame->channelCount * sizeof(int16_t);
+        out_size = a2dp_ldac_decoder_frame_bytes();
         dst += out_size;
         dst_size += out_size;
+        frames++;
     }
 
-    a2dp_ldac_decoder_cb.decode_callback((uint8_t*)buf, dst_size);
-    return true;    
+    a2dp_ldac_decoder_cb.frames_per_packet = frames;
+    if (dst_size != 0) {
+        a2dp_ldac_decoder_cb.decode_callback((uint8_t*)buf, dst_size);
+    }
+    return true;
+}
+
+size_t a2dp_ldac_decoder_conceal(size_t packets, unsigned char* buf, size_t buf_len) {
+    ldacdec_t* decoder = &a2dp_ldac_decoder_cb.decoder;
+    frame_t *frame = &decoder->frame;
+    size_t concealed = 0;
+
+    for (size_t i = 0; i < packets; i++) {
+        unsigned char* dst = buf;
+        uint32_t dst_size = 0;
+
+        /* one LDAC null frame for every frame the lost packet carried */
+        for (int f = 0; f < a2dp_ldac_decoder_cb.frames_per_packet; f++) {
+            int out_size = a2dp_ldac_decoder_frame_bytes();
+            if (dst_size + out_size > buf_len && dst_size != 0) {
+                a2dp_ldac_decoder_cb.decode_callback((uint8_t*)buf, dst_size);
+                dst = buf;
+                dst_size = 0;
+            }
+            if (dst_size + out_size > buf_len ||
+                ldacdecConceal(decoder, dst) != 0) {
+                break;
+            }
+            dst += out_size;
+            dst_size += out_size;
+            concealed += frame->frameSamples;
+        }
+
+        if (dst_size == 0) {
+            break;
+        }
+        a2dp_ldac_decoder_cb.decode_callback((uint8_t*)buf, dst_size);
+    }
+    return concealed;
 }
 
 #endif /* defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE) */
@@ -19,11 +19,11 @@ typedef enum {
 
   // Add an entry for each source codec here.
   BTAV_A2DP_CODEC_INDEX_SOURCE_SBC = 0,
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
   BTAV_A2DP_CODEC_INDEX_SOURCE_APTX,
   BTAV_A2DP_CODEC_INDEX_SOURCE_APTX_HD,
   BTAV_A2DP_CODEC_INDEX_SOURCE_APTX_LL,
-#endif /* APTX_DEC_INCLUDED */
+#endif /* APTX_INCLUDED */
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
   BTAV_A2DP_CODEC_INDEX_SOURCE_LDAC,
 #endif /* LDAC_DEC_INCLUDED */
@@ -34,11 +34,11 @@ typedef enum {
 
   // Add an entry for each sink codec here
   BTAV_A2DP_CODEC_INDEX_SINK_SBC = BTAV_A2DP_CODEC_INDEX_SINK_MIN,
-#if (defined(APTX_DEC_INCLUDED) && APTX_DEC_INCLUDED == TRUE)
+#if (defined(APTX_INCLUDED) && APTX_INCLUDED == TRUE)
   BTAV_A2DP_CODEC_INDEX_SINK_APTX,
   BTAV_A2DP_CODEC_INDEX_SINK_APTX_HD,
   BTAV_A2DP_CODEC_INDEX_SINK_APTX_LL,
-#endif /* APTX_DEC_INCLUDED */
+#endif /* APTX_INCLUDED */
 #if (defined(LDAC_DEC_INCLUDED) && LDAC_DEC_INCLUDED == TRUE)
   BTAV_A2DP_CODEC_INDEX_SINK_LDAC,
 #endif /* LDAC_DEC_INCLUDED */
@@ -206,6 +206,19 @@ extern tA2D_STATUS A2D_AddRecord(UINT16 service_uuid, char *p_service_name, char
 extern tA2D_STATUS A2D_FindService(UINT16 service_uuid, BD_ADDR bd_addr,
                                    tA2D_SDP_DB_PARAMS *p_db, tA2D_FIND_CBACK *p_cback);
 
+/******************************************************************************
+**
+** Function         A2D_SetAvdtSdpVer
+**
+** Description      Set the AVDTP version of the SDP records added by
+**                  A2D_AddRecord() afterwards: AVDT_VERSION, or
+**                  AVDT_VERSION_SYNC when delay reporting is supported.
+**
+** Returns          void
+**
+******************************************************************************/
+extern void A2D_SetAvdtSdpVer(UINT16 avdt_sdp_ver);
+
 /******************************************************************************
 **
 ** Function         A2D_SetTraceLevel
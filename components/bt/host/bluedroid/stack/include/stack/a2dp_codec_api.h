@@ -20,6 +20,16 @@
 // |len| is the number of octets pointed to by |buf|.
 typedef void (*decoded_data_callback_t)(uint8_t* buf, uint32_t len);
 
+//
+// Format of the PCM a decoder passes to |decoded_data_callback_t|.
+//
+typedef struct {
+  uint32_t sample_rate;     // in Hz
+  uint8_t channels;         // interleaved channels
+  uint8_t bits_per_sample;  // storage width of one sample
+  uint8_t valid_bits;       // significant bits, MSB aligned in the sample
+} tA2DP_PCM_FORMAT;
+
 //
 // A2DP decoder callbacks interface.
 //
@@ -33,11 +43,14 @@ typedef struct {
   // Reset the A2DP decoder.
   bool (*decoder_reset)();
 
-  // Decodes codec header in |p_buf|.
+  // Decodes codec header in |p_buf|. Returns the number of media packets
+  // the RTP sequence number shows to be missing in front of |p_buf|, or 0 if
+  // the codec carries no sequence number.
   size_t (*decode_packet_header)(BT_HDR* p_buf);
 
-  // Decodes |p_buf| and calls |decode_callback| passed into init for the
-  // decoded data.
+  // Decodes |p_buf| into |buf| and calls |decode_callback| passed into init
+  // for the decoded data. Audio exceeding |buf_len| is passed in several
+  // chunks, |buf| is reused once |decode_callback| returned.
   bool (*decode_packet)(BT_HDR* p_buf, unsigned char* buf, size_t buf_len);
 
   // Start the A2DP decoder.
@@ -48,8 +61,80 @@ typedef struct {
 
   // A2DP decoder configuration.
   void (*decoder_configure)(const uint8_t* p_codec_info);
+
+  // Conceals |packets| lost media packets, using |buf| as output buffer and
+  // calling |decode_callback| for the synthesized audio. Returns the number
+  // of PCM frames produced.
+  size_t (*decoder_conceal)(size_t packets, unsigned char* buf, size_t buf_len);
+
+  // Gets the format of the decoded PCM. Returns false if the decoder has not
+  // been configured yet.
+  bool (*decoder_get_pcm_format)(tA2DP_PCM_FORMAT* p_format);
+
+  // Gets the size of the largest PCM chunk the decoder produces at once, in
+  // bytes. The |buf_len| passed to decode_packet and decoder_conceal must be
+  // at least this large.
+  size_t (*decoder_get_max_output_size)();
+
+  // Checks the decoder can produce samples of the |bits_per_sample| and
+  // |valid_bits| of |p_format|, the other fields are ignored. Does not
+  // depend on the decoder state.
+  bool (*decoder_supports_pcm_format)(const tA2DP_PCM_FORMAT* p_format);
+
+  // Selects the sample format of the decoded PCM, one the decoder supports,
+  // from the next decoder_configure on. Decoders produce 16 bit samples
+  // until then. A non zero |sample_rate| is the highest rate the output
+  // needs, a decoder may then decode at a lower rate than the stream's,
+  // down to that one.
+  void (*decoder_set_pcm_format)(const tA2DP_PCM_FORMAT* p_format);
+
+  // Gets the media timestamp of |p_buf|, in PCM frames, before its codec
+  // header is decoded. Returns false if the codec carries no timestamp.
+  // May be called from the context the media is received in.
+  bool (*decoder_get_media_timestamp)(const BT_HDR* p_buf, uint32_t* p_timestamp);
 } tA2DP_DECODER_INTERFACE;
 
+// Prototype for a callback to read the PCM audio a |tA2DP_ENCODER_INTERFACE|
+// encodes.
+// |buf| is the buffer to fill.
+// |len| is the number of octets requested.
+// Returns the number of octets read, less than |len| on an underflow.
+typedef uint32_t (*a2dp_source_read_callback_t)(uint8_t* buf, uint32_t len);
+
+// Prototype for a callback to enqueue a media packet produced by a
+// |tA2DP_ENCODER_INTERFACE| for transmission.
+// |p_buf| is the packet, its first word holds the media timestamp.
+// |frames_n| is the number of PCM frames encoded in the packet.
+// The callback takes the ownership of |p_buf|. Returns false if the packet
+// was dropped.
+typedef bool (*a2dp_source_enqueue_callback_t)(BT_HDR* p_buf, size_t frames_n);
+
+//
+// A2DP encoder callbacks interface.
+//
+typedef struct {
+  // Initialize the encoder for the codec configuration |p_codec_info|. Media
+  // packets carry at most |peer_mtu| octets after the media header. Can be
+  // called multiple times, will reinitalize.
+  bool (*encoder_init)(const uint8_t* p_codec_info, uint16_t peer_mtu,
+                       a2dp_source_read_callback_t read_callback,
+                       a2dp_source_enqueue_callback_t enqueue_callback);
+
+  // Cleanup the A2DP encoder.
+  void (*encoder_cleanup)();
+
+  // Reset the feeding of the encoder, before the streaming starts.
+  void (*feeding_reset)();
+
+  // Drop the PCM the encoder has been asked for but has not read yet.
+  void (*feeding_flush)();
+
+  // Reads the PCM due since the previous call, |timestamp_us| being the
+  // current time in microseconds, encodes it and passes the media packets
+  // to |enqueue_callback|.
+  void (*send_frames)(uint64_t timestamp_us);
+} tA2DP_ENCODER_INTERFACE;
+
 
 /******************************************************************************
 **
@@ -144,6 +229,36 @@ bool A2DP_IsPeerSourceCodecSupported(const uint8_t* p_codec_info);
 const tA2DP_DECODER_INTERFACE* A2DP_GetDecoderInterface(
     const uint8_t* p_codec_info);
 
+/******************************************************************************
+**
+** Function         A2DP_GetEncoderInterface
+**
+** Description      Gets the A2DP encoder interface that can be used to encode and prepare
+**                  A2DP packets for transmission - see |tA2DP_ENCODER_INTERFACE|.
+**                  SBC is encoded by btc_a2dp_source itself and has none.
+**
+**                      p_codec_info:  contains the codec information.
+**
+** Returns          the A2DP encoder interface if the |p_codec_info| is valid and
+**                  supported, otherwise NULL.
+**
+******************************************************************************/
+const tA2DP_ENCODER_INTERFACE* A2DP_GetEncoderInterface(
+    const uint8_t* p_codec_info);
+
+/******************************************************************************
+**
+** Function         A2DP_UsesRtpHeader
+**
+** Description      Checks whether the media packets of a codec start with an RTP header.
+**
+**                      p_codec_info:  contains the codec information.
+**
+** Returns          true if the media packets carry an RTP header, otherwise false.
+**
+******************************************************************************/
+bool A2DP_UsesRtpHeader(const uint8_t* p_codec_info);
+
 /******************************************************************************
 **
 ** Function         A2DP_SinkCodecIndex
@@ -205,6 +320,24 @@ bool A2DP_InitCodecConfig(btav_a2dp_codec_index_t codec_index, UINT8 *p_result);
 ******************************************************************************/
 bool A2DP_BuildCodecConfig(UINT8 *p_src_cap, UINT8 *p_result);
 
+/******************************************************************************
+**
+** Function         A2DP_BuildSrcCodecConfig
+**
+** Description      Build the codec info the local A2DP source streams with
+**                  to a sink
+**
+**                      p_snk_cap:  Codec capabilities of the A2DP sink.
+**
+**                  Output Parameters:
+**                      p_result:  The resulting codec configuration.
+**
+** Returns          true on success, false if the codec can't be encoded
+**                  for this sink.
+**
+******************************************************************************/
+bool A2DP_BuildSrcCodecConfig(UINT8 *p_snk_cap, UINT8 *p_result);
+
 /******************************************************************************
 **
 ** Function         A2DP_CodecName
@@ -5,6 +5,16 @@
 #ifndef A2DP_DECODER_H
 #define A2DP_DECODER_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+**  Constants
+*****************************************************************************/
+/* Sequence number jumps larger than this are treated as a stream restart
+   rather than as lost packets */
+#define A2DP_DECODER_MAX_SEQ_GAP        (32)
+
 /*****************************************************************************
 **  Type Definitions
 *****************************************************************************/
@@ -24,4 +34,42 @@ struct __attribute__ ((packed)) media_packet_header {
     uint32_t csrc[0];
 };
 
+/* RTP sequence number state of a decoder, used to spot lost media packets */
+typedef struct {
+    uint16_t last_seq;
+    bool valid;
+} tA2DP_DECODER_SEQ;
+
+/*****************************************************************************
+**  Inline functions
+*****************************************************************************/
+static inline void a2dp_decoder_seq_reset(tA2DP_DECODER_SEQ *p_seq)
+{
+    p_seq->valid = false;
+}
+
+/* Records |seq| and returns the number of packets missing in front of it */
+static inline uint16_t a2dp_decoder_seq_update(tA2DP_DECODER_SEQ *p_seq, uint16_t seq)
+{
+    uint16_t gap = 0;
+
+    if (p_seq->valid) {
+        gap = (uint16_t)(seq - p_seq->last_seq - 1);
+        if (gap > A2DP_DECODER_MAX_SEQ_GAP) {
+            /* reordered, duplicated or restarted stream */
+            gap = 0;
+        }
+    }
+    p_seq->last_seq = seq;
+    p_seq->valid = true;
+    return gap;
+}
+
+/* Reads the RTP timestamp of the media packet header at |p_header| */
+static inline uint32_t a2dp_decoder_rtp_timestamp(const uint8_t *p_header)
+{
+    return ((uint32_t)p_header[4] << 24) | ((uint32_t)p_header[5] << 16) |
+           ((uint32_t)p_header[6] << 8) | p_header[7];
+}
+
 #endif // A2DP_DECODER_H
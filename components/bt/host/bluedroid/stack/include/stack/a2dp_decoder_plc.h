@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//
+// Waveform repeat packet loss concealment for the A2DP sink decoders
+//
+
+#ifndef A2DP_DECODER_PLC_H
+#define A2DP_DECODER_PLC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+**  Constants
+*****************************************************************************/
+/* PCM kept from the last good packet to be replayed over a gap */
+#define A2DP_PLC_HISTORY_BYTES          (1024)
+
+/* Number of consecutive concealed packets it takes to fade out to silence */
+#define A2DP_PLC_FADE_PACKETS           (4)
+
+/* Sample frames the first good packet after a gap fades back in over */
+#define A2DP_PLC_FADE_IN_FRAMES         (64)
+
+/*****************************************************************************
+**  Type Definitions
+*****************************************************************************/
+typedef struct {
+    uint8_t history[A2DP_PLC_HISTORY_BYTES];
+    size_t history_len;     /* valid bytes in |history|, whole sample frames */
+    size_t replay_pos;      /* next byte of |history| to replay */
+    size_t packet_len;      /* PCM bytes produced by the last good packet */
+    size_t pending_len;     /* PCM bytes of the good packet being decoded */
+    size_t conceal_pos;     /* bytes synthesized of the lost packet in progress */
+    uint8_t frame_bytes;    /* bytes of one interleaved sample frame */
+    uint8_t sample_bytes;   /* 2 for S16, 4 for S32 samples */
+    int32_t gain;           /* Q15 gain of the next concealed sample */
+    int32_t conceal_gain;   /* Q15 gain at the start of the lost packet in progress */
+} tA2DP_PLC;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************
+**
+** Function         a2dp_plc_init
+**
+** Description      Reset the concealment state for a stream of |channels|
+**                  interleaved samples of |sample_bytes| bytes each.
+**
+******************************************************************************/
+void a2dp_plc_init(tA2DP_PLC *p_plc, uint8_t channels, uint8_t sample_bytes);
+
+/******************************************************************************
+**
+** Function         a2dp_plc_good_pcm
+**
+** Description      Record |len| bytes of PCM decoded from a received packet,
+**                  a packet may be recorded in several chunks. After a gap
+**                  the start of |pcm| is faded back in place.
+**
+******************************************************************************/
+void a2dp_plc_good_pcm(tA2DP_PLC *p_plc, uint8_t *pcm, size_t len);
+
+/******************************************************************************
+**
+** Function         a2dp_plc_good_packet_end
+**
+** Description      Mark the end of the received packet recorded through
+**                  a2dp_plc_good_pcm(), its length is the length of the
+**                  lost packets synthesized next.
+**
+******************************************************************************/
+void a2dp_plc_good_packet_end(tA2DP_PLC *p_plc);
+
+/******************************************************************************
+**
+** Function         a2dp_plc_conceal
+**
+** Description      Synthesize the PCM of a lost packet into |out| by
+**                  replaying the history with a decaying gain. A packet
+**                  larger than |out_len| is synthesized over several calls,
+**                  a2dp_plc_concealing() tells whether it is complete.
+**
+** Returns          number of bytes written to |out|
+**
+******************************************************************************/
+size_t a2dp_plc_conceal(tA2DP_PLC *p_plc, uint8_t *out, size_t out_len);
+
+/* A lost packet is partially synthesized */
+static inline bool a2dp_plc_concealing(const tA2DP_PLC *p_plc)
+{
+    return p_plc->conceal_pos != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // A2DP_DECODER_PLC_H
@@ -0,0 +1,95 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//
+// Asynchronous sample rate converter of the A2DP sink, follows the clock
+// drift between the source and the local audio output
+//
+
+#ifndef A2DP_SINK_ASRC_H
+#define A2DP_SINK_ASRC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+**  Constants
+*****************************************************************************/
+/* Length of the interpolation filter, in sample frames */
+#define A2DP_ASRC_TAPS                  (16)
+
+/* The filter is tabulated at 2^A2DP_ASRC_PHASE_BITS fractional positions,
+   positions in between are interpolated */
+#define A2DP_ASRC_PHASE_BITS            (7)
+#define A2DP_ASRC_PHASES                (1 << A2DP_ASRC_PHASE_BITS)
+
+/* Largest rate correction, in parts per billion */
+#define A2DP_ASRC_MAX_PPB               (500000)
+
+/* Sample frames taken by one a2dp_asrc_process() call */
+#define A2DP_ASRC_BLOCK_FRAMES          (256)
+
+/* Sample frames one a2dp_asrc_process() call may produce */
+#define A2DP_ASRC_MAX_OUT_FRAMES        (A2DP_ASRC_BLOCK_FRAMES + 2)
+
+/*****************************************************************************
+**  Type Definitions
+*****************************************************************************/
+typedef struct {
+    int16_t in[(A2DP_ASRC_BLOCK_FRAMES + A2DP_ASRC_TAPS) * 2];
+    uint32_t in_frames;     /* sample frames held in |in| */
+    uint64_t pos;           /* Q32 position in |in| of the next output frame */
+    uint64_t step;          /* Q32 input frames per output frame */
+    int32_t advance;        /* input frames taken minus output frames produced */
+    uint8_t channels;       /* 1 or 2 interleaved S16 samples per frame */
+} tA2DP_ASRC;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************
+**
+** Function         a2dp_asrc_init
+**
+** Description      Reset the converter for a stream of |channels| interleaved
+**                  16-bit samples, at a ratio of 1. Builds the filter table
+**                  on first use.
+**
+** Returns          false if |channels| is not supported
+**
+******************************************************************************/
+bool a2dp_asrc_init(tA2DP_ASRC *p_asrc, uint8_t channels);
+
+/******************************************************************************
+**
+** Function         a2dp_asrc_set_ratio
+**
+** Description      Take |ppb| parts per billion more (or fewer, if negative)
+**                  input frames per output frame. Clamped to
+**                  +/-A2DP_ASRC_MAX_PPB.
+**
+******************************************************************************/
+void a2dp_asrc_set_ratio(tA2DP_ASRC *p_asrc, int32_t ppb);
+
+/******************************************************************************
+**
+** Function         a2dp_asrc_process
+**
+** Description      Resample |frames| sample frames of |in|, at most
+**                  A2DP_ASRC_BLOCK_FRAMES, into |out| which has room for
+**                  A2DP_ASRC_MAX_OUT_FRAMES.
+**
+** Returns          The number of sample frames written to |out|
+**
+******************************************************************************/
+size_t a2dp_asrc_process(tA2DP_ASRC *p_asrc, const int16_t *in, size_t frames, int16_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // A2DP_SINK_ASRC_H
@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//
+// Fixed ratio sample rate converter of the A2DP sink, brings the decoded
+// audio of any negotiated rate to the one rate of the local audio output
+//
+
+#ifndef A2DP_SINK_RESAMPLE_H
+#define A2DP_SINK_RESAMPLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+**  Constants
+*****************************************************************************/
+/* Length of the half-band decimation filter, in sample frames */
+#define A2DP_RESAMPLE_HB_TAPS           (47)
+
+/* Length of a polyphase filter, in input sample frames. Banks of more than
+   A2DP_RESAMPLE_MAX_PHASES_LONG phases use the short filter to bound their size */
+#define A2DP_RESAMPLE_TAPS_LONG         (32)
+#define A2DP_RESAMPLE_TAPS_SHORT        (16)
+#define A2DP_RESAMPLE_MAX_PHASES_LONG   (160)
+
+/* Largest interpolation and decimation factors of the polyphase stage */
+#define A2DP_RESAMPLE_MAX_PHASES        (441)
+
+/* Sample frames taken by one a2dp_resample_process() call */
+#define A2DP_RESAMPLE_BLOCK_FRAMES      (128)
+
+/* Sample frames one a2dp_resample_process() call may produce, the largest
+   ratio is 16 kHz to 48 kHz */
+#define A2DP_RESAMPLE_MAX_OUT_FRAMES    (A2DP_RESAMPLE_BLOCK_FRAMES * 3 + 1)
+
+/*****************************************************************************
+**  Type Definitions
+*****************************************************************************/
+typedef struct {
+    uint32_t in_rate;
+    uint32_t out_rate;
+    uint8_t channels;       /* 1 or 2 interleaved samples per frame */
+    uint8_t sample_bytes;   /* 2 for S16, 4 for S32 */
+    bool decimate;          /* half-band decimation by 2 first */
+    uint16_t up;            /* polyphase interpolation factor, 0 without that stage */
+    uint16_t down;          /* polyphase decimation factor */
+    uint8_t taps;           /* polyphase filter length */
+    uint16_t phase;         /* polyphase filter of the next output frame */
+    int16_t *bank;          /* |up| filters of |taps| Q15 coefficients */
+    int32_t *hb_in;         /* half-band input history */
+    uint32_t hb_frames;
+    int32_t *pp_in;         /* polyphase input history */
+    uint32_t pp_frames;
+    uint8_t *out;           /* A2DP_RESAMPLE_MAX_OUT_FRAMES sample frames */
+} tA2DP_RESAMPLER;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************
+**
+** Function         a2dp_resample_init
+**
+** Description      Set up |p_rs| to convert |channels| interleaved samples
+**                  of |sample_bytes| from |in_rate| to |out_rate|. Rates of
+**                  88.2 and 96 kHz go through the half-band decimator, the
+**                  remaining ratio through a polyphase bank computed here.
+**                  |p_rs| must be zeroed or cleaned up before.
+**
+** Returns          false if the conversion is not supported or out of memory
+**
+******************************************************************************/
+bool a2dp_resample_init(tA2DP_RESAMPLER *p_rs, uint32_t in_rate, uint32_t out_rate,
+                        uint8_t channels, uint8_t sample_bytes);
+
+/******************************************************************************
+**
+** Function         a2dp_resample_reset
+**
+** Description      Forget the input history, for a new stream with the same
+**                  conversion.
+**
+******************************************************************************/
+void a2dp_resample_reset(tA2DP_RESAMPLER *p_rs);
+
+/******************************************************************************
+**
+** Function         a2dp_resample_cleanup
+**
+** Description      Free the memory of |p_rs| and zero it.
+**
+******************************************************************************/
+void a2dp_resample_cleanup(tA2DP_RESAMPLER *p_rs);
+
+/******************************************************************************
+**
+** Function         a2dp_resample_process
+**
+** Description      Convert |frames| sample frames of |in|, at most
+**                  A2DP_RESAMPLE_BLOCK_FRAMES. |*pp_out| is set to the
+**                  output, valid until the next call.
+**
+** Returns          The number of sample frames in |*pp_out|
+**
+******************************************************************************/
+size_t a2dp_resample_process(tA2DP_RESAMPLER *p_rs, const void *in, size_t frames, const uint8_t **pp_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // A2DP_SINK_RESAMPLE_H
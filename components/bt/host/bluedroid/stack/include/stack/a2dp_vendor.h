@@ -204,6 +204,24 @@ bool A2DP_VendorInitCodecConfig(btav_a2dp_codec_index_t codec_index, UINT8 *p_re
 ******************************************************************************/
 bool A2DP_VendorBuildCodecConfig(UINT8 *p_src_cap, UINT8 *p_result);
 
+/******************************************************************************
+**
+** Function         A2DP_VendorBuildSrcCodecConfig
+**
+** Description      Build the vendor codec info the local A2DP source streams
+**                  with to a sink
+**
+**                      p_snk_cap:  Codec capabilities of the A2DP sink.
+**
+**                  Output Parameters:
+**                      p_result:  The resulting codec configuration.
+**
+** Returns          true on success, false if the codec can't be encoded
+**                  for this sink.
+**
+******************************************************************************/
+bool A2DP_VendorBuildSrcCodecConfig(UINT8 *p_snk_cap, UINT8 *p_result);
+
 /******************************************************************************
 **
 ** Function         A2DP_VendorCodecName
@@ -250,6 +268,36 @@ bool A2DP_VendorCodecTypeEquals(const uint8_t* p_codec_info_a,
 const tA2DP_DECODER_INTERFACE* A2DP_GetVendorDecoderInterface(
     const uint8_t* p_codec_info);
 
+/******************************************************************************
+**
+** Function         A2DP_GetVendorEncoderInterface
+**
+** Description      Gets the A2DP vendor encoder interface that can be used to encode and
+**                  prepare A2DP packets for transmission - see |tA2DP_ENCODER_INTERFACE|.
+**
+**                      p_codec_info:  contains the codec information.
+**
+** Returns          the A2DP vendor encoder interface if the |p_codec_info| is valid and
+**                  supported, otherwise NULL.
+**
+******************************************************************************/
+const tA2DP_ENCODER_INTERFACE* A2DP_GetVendorEncoderInterface(
+    const uint8_t* p_codec_info);
+
+/******************************************************************************
+**
+** Function         A2DP_VendorUsesRtpHeader
+**
+** Description      Checks whether the media packets of a vendor codec start with an
+**                  RTP header.
+**
+**                      p_codec_info:  contains the codec information.
+**
+** Returns          true if the media packets carry an RTP header, otherwise false.
+**
+******************************************************************************/
+bool A2DP_VendorUsesRtpHeader(const uint8_t* p_codec_info);
+
 #ifdef __cplusplus
 }
 #endif
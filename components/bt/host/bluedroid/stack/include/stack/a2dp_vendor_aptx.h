@@ -260,6 +260,67 @@ bool A2DP_VendorBuildCodecConfigAptx(UINT8 *p_src_cap, UINT8 *p_result);
 const tA2DP_DECODER_INTERFACE* A2DP_GetVendorDecoderInterfaceAptx(
     const uint8_t* p_codec_info);
 
+/******************************************************************************
+**
+** Function         A2DP_IsVendorSinkCodecSupportedAptx
+**
+** Description      Checks whether an A2DP aptX configuration set by a peer Sink
+**                  can be encoded by the local Source.
+**
+**                      p_codec_info:  contains the codec configuration.
+**
+** Returns          true if the configuration is supported, otherwise false.
+**
+******************************************************************************/
+bool A2DP_IsVendorSinkCodecSupportedAptx(const uint8_t* p_codec_info);
+
+/******************************************************************************
+**
+** Function         A2DP_VendorInitCodecConfigAptxSrc
+**
+** Description      Initializes the A2DP aptX Source codec capabilities into |p_codec_info|.
+**
+**                      p_codec_info:  The resulting codec information element.
+**
+** Returns          true on success, otherwise false.
+**
+******************************************************************************/
+bool A2DP_VendorInitCodecConfigAptxSrc(uint8_t* p_codec_info);
+
+/******************************************************************************
+**
+** Function         A2DP_VendorBuildSrcCodecConfigAptx
+**
+** Description      Builds the aptX configuration the local Source streams with
+**                  to a peer Sink of capabilities |p_snk_cap|.
+**
+**                      p_snk_cap:  Contains information about the Sink codec capabilities.
+**
+**                  Output Parameters:
+**                      p_result:  The resulting codec configuration.
+**
+** Returns          true on success, false if the Sink and the Source have no
+**                  configuration in common.
+**
+******************************************************************************/
+bool A2DP_VendorBuildSrcCodecConfigAptx(UINT8 *p_snk_cap, UINT8 *p_result);
+
+/******************************************************************************
+**
+** Function         A2DP_GetVendorEncoderInterfaceAptx
+**
+** Description      Gets the A2DP aptX encoder interface that can be used to encode and
+**                  prepare A2DP packets for transmission
+**
+**                      p_codec_info:  contains the codec information.
+**
+** Returns          the A2DP aptX encoder interface if the |p_codec_info| is valid and
+**                  supported, otherwise NULL.
+**
+******************************************************************************/
+const tA2DP_ENCODER_INTERFACE* A2DP_GetVendorEncoderInterfaceAptx(
+    const uint8_t* p_codec_info);
+
 #ifdef __cplusplus
 }
 #endif
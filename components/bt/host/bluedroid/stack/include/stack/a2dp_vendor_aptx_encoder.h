@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//
+// Interface to the A2DP aptX Encoder
+//
+
+#ifndef A2DP_VENDOR_APTX_ENCODER_H
+#define A2DP_VENDOR_APTX_ENCODER_H
+
+#include "a2dp_codec_api.h"
+#include "stack/bt_types.h"
+
+/*****************************************************************************
+**  External Function Declarations
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************
+**
+** Function         a2dp_aptx_encoder_init
+**
+** Description      Initialize the A2DP aptX or aptX-HD encoder for the codec
+**                  configuration |p_codec_info|. The encoder reads 16-bit
+**                  stereo PCM with |read_callback| and passes media packets
+**                  of at most |peer_mtu| octets of payload to |enqueue_callback|.
+**
+** Returns          true on success, false otherwise
+**
+******************************************************************************/
+bool a2dp_aptx_encoder_init(const uint8_t* p_codec_info, uint16_t peer_mtu,
+                            a2dp_source_read_callback_t read_callback,
+                            a2dp_source_enqueue_callback_t enqueue_callback);
+
+/******************************************************************************
+**
+** Function         a2dp_aptx_encoder_cleanup
+**
+** Description      Cleanup the A2DP aptX encoder.
+**
+** Returns          void
+**
+******************************************************************************/
+void a2dp_aptx_encoder_cleanup(void);
+
+/******************************************************************************
+**
+** Function         a2dp_aptx_encoder_feeding_reset
+**
+** Description      Reset the feeding of the encoder, before the streaming
+**                  starts.
+**
+** Returns          void
+**
+******************************************************************************/
+void a2dp_aptx_encoder_feeding_reset(void);
+
+/******************************************************************************
+**
+** Function         a2dp_aptx_encoder_feeding_flush
+**
+** Description      Drop the PCM due but not read yet.
+**
+** Returns          void
+**
+******************************************************************************/
+void a2dp_aptx_encoder_feeding_flush(void);
+
+/******************************************************************************
+**
+** Function         a2dp_aptx_encoder_send_frames
+**
+** Description      Reads the PCM due since the previous call, |timestamp_us|
+**                  being the current time in microseconds, encodes it and
+**                  enqueues the media packets.
+**
+** Returns          void
+**
+******************************************************************************/
+void a2dp_aptx_encoder_send_frames(uint64_t timestamp_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // A2DP_VENDOR_APTX_ENCODER_H
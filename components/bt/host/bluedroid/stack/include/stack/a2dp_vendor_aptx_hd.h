@@ -266,6 +266,67 @@ bool A2DP_VendorBuildCodecConfigAptxHd(UINT8 *p_src_cap, UINT8 *p_result);
 const tA2DP_DECODER_INTERFACE* A2DP_GetVendorDecoderInterfaceAptxHd(
     const uint8_t* p_codec_info);
 
+/******************************************************************************
+**
+** Function         A2DP_IsVendorSinkCodecSupportedAptxHd
+**
+** Description      Checks whether an A2DP aptX-HD configuration set by a peer Sink
+**                  can be encoded by the local Source.
+**
+**                      p_codec_info:  contains the codec configuration.
+**
+** Returns          true if the configuration is supported, otherwise false.
+**
+******************************************************************************/
+bool A2DP_IsVendorSinkCodecSupportedAptxHd(const uint8_t* p_codec_info);
+
+/******************************************************************************
+**
+** Function         A2DP_VendorInitCodecConfigAptxHdSrc
+**
+** Description      Initializes the A2DP aptX-HD Source codec capabilities into |p_codec_info|.
+**
+**                      p_codec_info:  The resulting codec information element.
+**
+** Returns          true on success, otherwise false.
+**
+******************************************************************************/
+bool A2DP_VendorInitCodecConfigAptxHdSrc(uint8_t* p_codec_info);
+
+/******************************************************************************
+**
+** Function         A2DP_VendorBuildSrcCodecConfigAptxHd
+**
+** Description      Builds the aptX-HD configuration the local Source streams with
+**                  to a peer Sink of capabilities |p_snk_cap|.
+**
+**                      p_snk_cap:  Contains information about the Sink codec capabilities.
+**
+**                  Output Parameters:
+**                      p_result:  The resulting codec configuration.
+**
+** Returns          true on success, false if the Sink and the Source have no
+**                  configuration in common.
+**
+******************************************************************************/
+bool A2DP_VendorBuildSrcCodecConfigAptxHd(UINT8 *p_snk_cap, UINT8 *p_result);
+
+/******************************************************************************
+**
+** Function         A2DP_GetVendorEncoderInterfaceAptxHd
+**
+** Description      Gets the A2DP aptX-HD encoder interface that can be used to encode and
+**                  prepare A2DP packets for transmission
+**
+**                      p_codec_info:  contains the codec information.
+**
+** Returns          the A2DP aptX-HD encoder interface if the |p_codec_info| is valid and
+**                  supported, otherwise NULL.
+**
+******************************************************************************/
+const tA2DP_ENCODER_INTERFACE* A2DP_GetVendorEncoderInterfaceAptxHd(
+    const uint8_t* p_codec_info);
+
 
 #endif // A2D_INCLUDED == TRUE
 #endif // A2DP_VENDOR_APTX_HD_H
@@ -34,17 +34,96 @@ extern "C"
 ******************************************************************************/
 bool a2dp_ldac_decoder_init(decoded_data_callback_t decode_callback);
 
+/******************************************************************************
+**
+** Function         a2dp_ldac_decoder_reset
+**
+** Description      Reset the A2DP LDAC decoder.
+**
+******************************************************************************/
+bool a2dp_ldac_decoder_reset(void);
+
+/******************************************************************************
+**
+** Function         a2dp_ldac_decoder_configure
+**
+** Description      Configure the LDAC decoder.
+**
+**                      p_codec_info:  Codec capabilities
+**
+******************************************************************************/
+void a2dp_ldac_decoder_configure(const uint8_t* p_codec_info);
+
+/******************************************************************************
+**
+** Function         a2dp_ldac_decoder_get_pcm_format
+**
+** Description      Get the format of the PCM the LDAC decoder produces.
+**
+** Returns          true once the decoder is configured, false otherwise
+**
+******************************************************************************/
+bool a2dp_ldac_decoder_get_pcm_format(tA2DP_PCM_FORMAT* p_format);
+
+/******************************************************************************
+**
+** Function         a2dp_ldac_decoder_get_max_output_size
+**
+** Description      Get the size of the largest PCM chunk the LDAC decoder
+**                  produces at once.
+**
+** Returns          size in bytes
+**
+******************************************************************************/
+size_t a2dp_ldac_decoder_get_max_output_size(void);
+
+/******************************************************************************
+**
+** Function         a2dp_ldac_decoder_supports_pcm_format
+**
+** Description      Check the LDAC decoder can produce samples of the
+**                  storage width and valid bits of |p_format|.
+**
+** Returns          true if the sample format is supported
+**
+******************************************************************************/
+bool a2dp_ldac_decoder_supports_pcm_format(const tA2DP_PCM_FORMAT* p_format);
+
+/******************************************************************************
+**
+** Function         a2dp_ldac_decoder_set_pcm_format
+**
+** Description      Select the sample format of the decoded PCM, applied by
+**                  the next a2dp_ldac_decoder_configure.
+**
+** Returns          void
+**
+******************************************************************************/
+void a2dp_ldac_decoder_set_pcm_format(const tA2DP_PCM_FORMAT* p_format);
+
 /******************************************************************************
 **
 ** Function         a2dp_ldac_decoder_decode_packet_header
 **
 ** Description      Decode the LDAC packet header.
 **
-** Returns          
+** Returns          number of media packets missing in front of |p_data|
 **
 ******************************************************************************/
 size_t a2dp_ldac_decoder_decode_packet_header(BT_HDR* p_data);
 
+/******************************************************************************
+**
+** Function         a2dp_ldac_decoder_get_media_timestamp
+**
+** Description      Get the RTP timestamp of the LDAC packet |p_data|, before
+**                  its header is decoded.
+**
+** Returns          true if |p_timestamp| was set
+**
+******************************************************************************/
+bool a2dp_ldac_decoder_get_media_timestamp(const BT_HDR* p_data, uint32_t* p_timestamp);
+
 /******************************************************************************
 **
 ** Function         a2dp_ldac_decoder_decode_packet
@@ -59,6 +138,19 @@ size_t a2dp_ldac_decoder_decode_packet_header(BT_HDR* p_data);
 ******************************************************************************/
 bool a2dp_ldac_decoder_decode_packet(BT_HDR* p_buf, unsigned char* buf, size_t buf_len);
 
+/******************************************************************************
+**
+** Function         a2dp_ldac_decoder_conceal
+**
+** Description      Conceals |packets| lost packets by decoding LDAC null frames.
+**                  Calls |decode_callback| passed into |a2dp_ldac_decoder_init|
+**                  for the synthesized audio.
+**
+** Returns          number of PCM frames produced
+**
+******************************************************************************/
+size_t a2dp_ldac_decoder_conceal(size_t packets, unsigned char* buf, size_t buf_len);
+
 #ifdef __cplusplus
 }
 #endif
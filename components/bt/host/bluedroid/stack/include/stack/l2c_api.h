@@ -713,6 +713,21 @@ extern UINT16 L2CA_LocalLoopbackReq (UINT16 psm, UINT16 handle, BD_ADDR p_bd_add
 *******************************************************************************/
 extern UINT16   L2CA_FlushChannel (UINT16 lcid, UINT16 num_to_flush);
 
+/*******************************************************************************
+**
+** Function     L2CA_GetAclTxCredits
+**
+** Description  This function reads the HCI flow control state of the BR/EDR
+**              ACL data sent to the controller. It only reads counters and
+**              may be called from any task.
+**
+** Returns      Number of ACL packets the controller can still accept.
+**              If p_total is not NULL it is set to the number of ACL
+**              buffers of the controller.
+**
+*******************************************************************************/
+extern UINT16   L2CA_GetAclTxCredits (UINT16 *p_total);
+
 
 /*******************************************************************************
 **
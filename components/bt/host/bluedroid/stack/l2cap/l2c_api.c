@@ -2271,6 +2271,27 @@ UINT16 L2CA_FlushChannel (UINT16 lcid, UINT16 num_to_flush)
     return (num_left);
 }
 
+/*******************************************************************************
+**
+** Function     L2CA_GetAclTxCredits
+**
+** Description  This function reads the HCI flow control state of the BR/EDR
+**              ACL data sent to the controller. It only reads counters and
+**              may be called from any task.
+**
+** Returns      Number of ACL packets the controller can still accept.
+**              If p_total is not NULL it is set to the number of ACL
+**              buffers of the controller.
+**
+*******************************************************************************/
+UINT16 L2CA_GetAclTxCredits (UINT16 *p_total)
+{
+    if (p_total != NULL) {
+        *p_total = l2cb.num_lm_acl_bufs;
+    }
+    return (l2cb.controller_xmit_window);
+}
+
 /******************************************************************************
 **
 ** Function         update_acl_pkt_num
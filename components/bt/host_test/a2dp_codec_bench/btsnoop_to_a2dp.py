@@ -0,0 +1,184 @@
+#!/usr/bin/env python
+#
+# Extracts the A2DP media packets of a btsnoop HCI log into packet files of the A2DP codec benchmark
+#
+# SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+from __future__ import print_function
+
+import argparse
+import os
+import struct
+import sys
+from typing import BinaryIO, Dict, Iterator, List, Optional, Tuple
+
+BTSNOOP_MAGIC = b'btsnoop\0'
+DATALINK_HCI = 1001     # HCI packets without the H4 packet type
+DATALINK_H4 = 1002      # HCI packets with the H4 packet type
+H4_ACL = 0x02
+
+L2CAP_SIGNALING_CID = 0x0001
+L2CAP_CONNECTION_REQ = 0x02
+L2CAP_CONNECTION_RSP = 0x03
+AVDTP_PSM = 0x0019
+
+AVDTP_SET_CONFIGURATION = 0x03
+AVDTP_RECONFIGURE = 0x07
+AVDTP_MEDIA_CODEC = 0x07
+
+PACKET_FILE_VERSION = 1
+CODEC_INFO_MAX = 32
+
+
+def read_acl(f):  # type: (BinaryIO) -> Iterator[Tuple[bool, bytes]]
+    """ Yields (received, ACL packet) for the ACL data packets of a btsnoop log """
+    header = f.read(16)
+    if len(header) != 16 or header[:8] != BTSNOOP_MAGIC:
+        raise ValueError('not a btsnoop file')
+    version, datalink = struct.unpack('>II', header[8:])
+    if version != 1 or datalink not in (DATALINK_HCI, DATALINK_H4):
+        raise ValueError('unsupported btsnoop version {} or datalink {}'.format(version, datalink))
+    while True:
+        record = f.read(24)
+        if len(record) < 24:
+            return
+        _, length, flags, _, _ = struct.unpack('>IIIIq', record)
+        data = f.read(length)
+        if len(data) < length:
+            return
+        received = bool(flags & 1)
+        if datalink == DATALINK_H4:
+            if data[:1] != bytes([H4_ACL]):
+                continue
+            data = data[1:]
+        elif flags & 2:
+            # commands and events
+            continue
+        yield received, data
+
+
+class L2capReassembler(object):
+    """ Joins ACL fragments into L2CAP basic frames, per connection handle and direction """
+
+    def __init__(self):  # type: () -> None
+        self.partial = {}  # type: Dict[Tuple[int, bool], bytearray]
+
+    def feed(self, received, acl):  # type: (bool, bytes) -> Optional[Tuple[int, int, bytes]]
+        if len(acl) < 4:
+            return None
+        handle_flags, length = struct.unpack('<HH', acl[:4])
+        handle = handle_flags & 0x0fff
+        boundary = (handle_flags >> 12) & 0x3
+        key = (handle, received)
+        if boundary == 0x1:
+            if key not in self.partial:
+                return None
+            self.partial[key] += acl[4:4 + length]
+        else:
+            self.partial[key] = bytearray(acl[4:4 + length])
+        frame = self.partial[key]
+        if len(frame) < 4:
+            return None
+        pdu_length, cid = struct.unpack('<HH', bytes(frame[:4]))
+        if len(frame) < 4 + pdu_length:
+            return None
+        del self.partial[key]
+        return handle, cid, bytes(frame[4:4 + pdu_length])
+
+
+class AvdtpStream(object):
+    """ Media packets sent with one codec configuration """
+
+    def __init__(self, codec_info):  # type: (bytes) -> None
+        self.codec_info = codec_info
+        self.packets = []  # type: List[bytes]
+
+    def write(self, path):  # type: (str) -> None
+        with open(path, 'wb') as f:
+            f.write(b'A2DP' + struct.pack('<BB', PACKET_FILE_VERSION, len(self.codec_info)) + self.codec_info)
+            for packet in self.packets:
+                f.write(struct.pack('<H', len(packet)) + packet)
+
+
+def codec_info_of(signal):  # type: (bytes) -> Optional[bytes]
+    """ Codec information element, LOSC octet first, of a SET CONFIGURATION or RECONFIGURE command """
+    if len(signal) < 2 or signal[0] & 0x0f != 0:
+        # only single packet commands, configurations are far too short to be fragmented
+        return None
+    signal_id = signal[1] & 0x3f
+    if signal_id == AVDTP_SET_CONFIGURATION:
+        offset = 4
+    elif signal_id == AVDTP_RECONFIGURE:
+        offset = 3
+    else:
+        return None
+    while offset + 2 <= len(signal):
+        category, losc = signal[offset], signal[offset + 1]
+        if category == AVDTP_MEDIA_CODEC and 0 < losc < CODEC_INFO_MAX:
+            return bytes(signal[offset + 1:offset + 2 + losc])
+        offset += 2 + losc
+    return None
+
+
+def extract(f):  # type: (BinaryIO) -> List[AvdtpStream]
+    reassembler = L2capReassembler()
+    # AVDTP channel ids per connection handle, in the order of connection: signaling, then media
+    pending = {}  # type: Dict[Tuple[int, int], bool]
+    channels = {}  # type: Dict[int, List[Tuple[int, int]]]
+    streams = []  # type: List[AvdtpStream]
+
+    for received, acl in read_acl(f):
+        frame = reassembler.feed(received, acl)
+        if frame is None:
+            continue
+        handle, cid, pdu = frame
+
+        if cid == L2CAP_SIGNALING_CID:
+            offset = 0
+            while offset + 4 <= len(pdu):
+                code, _, length = struct.unpack('<BBH', pdu[offset:offset + 4])
+                data = pdu[offset + 4:offset + 4 + length]
+                if code == L2CAP_CONNECTION_REQ and len(data) >= 4:
+                    psm, scid = struct.unpack('<HH', data[:4])
+                    if psm == AVDTP_PSM:
+                        pending[(handle, scid)] = True
+                elif code == L2CAP_CONNECTION_RSP and len(data) >= 8:
+                    dcid, scid, result = struct.unpack('<HHH', data[:6])
+                    if pending.pop((handle, scid), False) and result == 0:
+                        channels.setdefault(handle, []).append((scid, dcid))
+                offset += 4 + length
+            continue
+
+        avdtp = channels.get(handle, [])
+        if len(avdtp) > 0 and cid in avdtp[0]:
+            codec_info = codec_info_of(pdu)
+            if codec_info is not None:
+                streams.append(AvdtpStream(codec_info))
+        elif len(avdtp) > 1 and cid in avdtp[1] and len(streams) > 0:
+            streams[-1].packets.append(pdu)
+
+    return [stream for stream in streams if len(stream.packets) > 0]
+
+
+def main():  # type: () -> None
+    parser = argparse.ArgumentParser(description='Extracts A2DP media packets from a btsnoop HCI log')
+    parser.add_argument('btsnoop', help='btsnoop HCI log')
+    parser.add_argument('output', help='packet file to write, streams after the first one get a _<n> suffix')
+    args = parser.parse_args()
+
+    with open(args.btsnoop, 'rb') as f:
+        streams = extract(f)
+    if len(streams) == 0:
+        print('no A2DP media packets found', file=sys.stderr)
+        sys.exit(1)
+
+    base, ext = os.path.splitext(args.output)
+    for index, stream in enumerate(streams):
+        path = args.output if index == 0 else '{}_{}{}'.format(base, index, ext)
+        stream.write(path)
+        print('{}: codec type 0x{:02x}, {} packets'.format(path, stream.codec_info[2], len(stream.packets)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,22 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Bits of the Bluedroid stack the A2DP codec sources use, for building them without the rest of it */
+
+#include "common/bt_target.h"
+#include "common/bt_trace.h"
+#include "stack/a2d_api.h"
+
+UINT8 appl_trace_level = APPL_INITIAL_TRACE_LEVEL;
+
+/* same as in a2d_api.c, which can't be built without SDP */
+uint8_t A2D_BitsSet(uint64_t num)
+{
+    if (num == 0) {
+        return A2D_SET_ZERO_BIT;
+    }
+    return ((num & (num - 1)) == 0) ? A2D_SET_ONE_BIT : A2D_SET_MULTL_BIT;
+}
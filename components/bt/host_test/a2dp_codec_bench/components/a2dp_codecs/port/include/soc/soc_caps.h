@@ -0,0 +1,8 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* The linux target has no SoC, none of the capabilities checked by bt_target.h apply */
+#pragma once
@@ -0,0 +1,531 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Benchmark and conformance check of the A2DP sink decoders. Media packets are fed through the
+ * tA2DP_DECODER_INTERFACE of the codec the way btc_a2dp_sink does, the decode time, the stack
+ * and heap the decoder needs and the difference of the PCM to a reference are reported.
+ */
+
+#include <getopt.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sbc_encoder.h"
+#include "stack/a2dp_codec_api.h"
+#include "stack/bt_types.h"
+#include "bench_io.h"
+#include "bench_mem.h"
+#include "bench_sbc_source.h"
+#include "bench_sbc_synth.h"
+
+/* the sink never decodes into less, see A2DP_SNK_DECODE_BUF_SIZE */
+#define BENCH_DECODE_BUF_SIZE   4096
+#define BENCH_STACK_SIZE        (256 * 1024)
+#define BENCH_DEFAULT_PASSES    10
+/* codec delay searched when comparing to the encoded signal */
+#define BENCH_MAX_LAG           1024
+#define BENCH_SELF_TEST_MS      5000
+/* every Nth packet is dropped in the concealment check */
+#define BENCH_DROP_INTERVAL     20
+
+typedef struct {
+    const tA2DP_DECODER_INTERFACE *decoder;
+    const bench_stream_t *stream;
+    const tA2DP_PCM_FORMAT *request;    /* sample format to ask for, NULL for the default */
+    bench_pcm_t *pcm;                   /* collects the decoded audio if set */
+    tA2DP_PCM_FORMAT format;
+    size_t buf_len;
+    size_t lost;
+    size_t errors;
+    uint64_t pcm_bytes;
+    uint64_t ns;
+    uint64_t max_packet_ns;
+    bool ok;
+} bench_pass_t;
+
+typedef struct {
+    size_t packets;
+    size_t frames;
+    size_t lost;
+    size_t errors;
+    size_t buf_len;
+    size_t stack;
+    size_t heap;
+    double ns_per_packet;
+    double ns_per_frame;
+    double max_packet_us;
+    double realtime;
+} bench_result_t;
+
+typedef struct {
+    size_t frames;
+    double psnr;
+    double max_diff;    /* in LSBs of the decoded samples */
+    bool exact;
+} bench_diff_t;
+
+static bench_pass_t *s_pass;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void bench_decoded(uint8_t *buf, uint32_t len)
+{
+    s_pass->pcm_bytes += len;
+    if (s_pass->pcm) {
+        bench_mem_track(false);
+        if (!bench_pcm_append(s_pass->pcm, buf, len)) {
+            s_pass->ok = false;
+        }
+        bench_mem_track(true);
+    }
+}
+
+/* Decodes the whole stream once, the heap used by the decoder is tracked meanwhile */
+static void bench_pass(void *arg)
+{
+    bench_pass_t *pass = arg;
+    const tA2DP_DECODER_INTERFACE *decoder = pass->decoder;
+    const bench_stream_t *stream = pass->stream;
+    size_t max_len = 0;
+
+    for (size_t i = 0; i < stream->count; i++) {
+        if (stream->packets[i].len > max_len) {
+            max_len = stream->packets[i].len;
+        }
+    }
+
+    s_pass = pass;
+    pass->ok = true;
+    bench_mem_track(true);
+    bench_mem_reset_peak();
+
+    if (decoder->decoder_init && !decoder->decoder_init(bench_decoded)) {
+        pass->ok = false;
+        bench_mem_track(false);
+        return;
+    }
+    if (pass->request && decoder->decoder_set_pcm_format) {
+        decoder->decoder_set_pcm_format(pass->request);
+    }
+    decoder->decoder_configure(pass->stream->codec_info);
+    memset(&pass->format, 0, sizeof(pass->format));
+    if (!decoder->decoder_get_pcm_format || !decoder->decoder_get_pcm_format(&pass->format)) {
+        pass->ok = false;
+    }
+    pass->buf_len = BENCH_DECODE_BUF_SIZE;
+    if (decoder->decoder_get_max_output_size && decoder->decoder_get_max_output_size() > pass->buf_len) {
+        pass->buf_len = decoder->decoder_get_max_output_size();
+    }
+
+    /* the buffers belong to the sink, not to the decoder */
+    bench_mem_track(false);
+    unsigned char *buf = malloc(pass->buf_len);
+    BT_HDR *p_buf = malloc(sizeof(BT_HDR) + max_len);
+    bench_mem_track(true);
+
+    for (size_t i = 0; pass->ok && buf && p_buf && i < stream->count; i++) {
+        memcpy(p_buf->data, stream->packets[i].data, stream->packets[i].len);
+        p_buf->event = 0;
+        p_buf->len = stream->packets[i].len;
+        p_buf->offset = 0;
+        p_buf->layer_specific = 0;
+
+        uint64_t start = now_ns();
+        size_t lost = 0;
+        if (decoder->decode_packet_header) {
+            lost = decoder->decode_packet_header(p_buf);
+        }
+        if (lost > 0 && decoder->decoder_conceal) {
+            decoder->decoder_conceal(lost, buf, pass->buf_len);
+        }
+        bool decoded = decoder->decode_packet(p_buf, buf, pass->buf_len);
+        uint64_t ns = now_ns() - start;
+
+        pass->ns += ns;
+        if (ns > pass->max_packet_ns) {
+            pass->max_packet_ns = ns;
+        }
+        pass->lost += lost;
+        if (!decoded) {
+            pass->errors++;
+        }
+    }
+    if (buf == NULL || p_buf == NULL) {
+        pass->ok = false;
+    }
+
+    if (decoder->decoder_cleanup) {
+        decoder->decoder_cleanup();
+    }
+    bench_mem_track(false);
+    free(buf);
+    free(p_buf);
+}
+
+static size_t format_frame_bytes(const tA2DP_PCM_FORMAT *format)
+{
+    return format->channels * (format->bits_per_sample / 8);
+}
+
+/*
+ * Decodes |stream| once collecting the PCM into |pcm| and measuring stack and heap, then |passes|
+ * more times for the timing.
+ */
+static bool bench_run(const bench_stream_t *stream, const tA2DP_PCM_FORMAT *request, int passes,
+                      bench_pcm_t *pcm, bench_result_t *result)
+{
+    const tA2DP_DECODER_INTERFACE *decoder = A2DP_GetDecoderInterface(stream->codec_info);
+    bench_pass_t pass;
+
+    memset(result, 0, sizeof(*result));
+    if (decoder == NULL || decoder->decoder_configure == NULL || decoder->decode_packet == NULL) {
+        fprintf(stderr, "no decoder for %s\n", A2DP_CodecName(stream->codec_info));
+        return false;
+    }
+    if (request && (!decoder->decoder_supports_pcm_format || !decoder->decoder_supports_pcm_format(request))) {
+        fprintf(stderr, "%s can't produce %u bit samples in %u bits\n", A2DP_CodecName(stream->codec_info),
+                request->valid_bits, request->bits_per_sample);
+        return false;
+    }
+
+    memset(&pass, 0, sizeof(pass));
+    pass.decoder = decoder;
+    pass.stream = stream;
+    pass.request = request;
+    pass.pcm = pcm;
+    if (!bench_mem_run(bench_pass, &pass, BENCH_STACK_SIZE, &result->stack) || !pass.ok) {
+        fprintf(stderr, "%s: decoding failed\n", A2DP_CodecName(stream->codec_info));
+        return false;
+    }
+    result->heap = bench_mem_peak();
+    result->packets = stream->count;
+    result->frames = pass.pcm_bytes / format_frame_bytes(&pass.format);
+    result->lost = pass.lost;
+    result->errors = pass.errors;
+    result->buf_len = pass.buf_len;
+    pcm->sample_rate = pass.format.sample_rate;
+    pcm->channels = pass.format.channels;
+    pcm->bits_per_sample = pass.format.bits_per_sample;
+    pcm->valid_bits = pass.format.valid_bits;
+
+    uint64_t ns = pass.ns, max_packet_ns = pass.max_packet_ns;
+    if (passes > 0) {
+        ns = 0;
+        for (int i = 0; i < passes; i++) {
+            memset(&pass, 0, sizeof(pass));
+            pass.decoder = decoder;
+            pass.stream = stream;
+            pass.request = request;
+            bench_pass(&pass);
+            ns += pass.ns;
+            if (pass.max_packet_ns > max_packet_ns) {
+                max_packet_ns = pass.max_packet_ns;
+            }
+        }
+    } else {
+        passes = 1;
+    }
+    if (result->packets > 0 && result->frames > 0) {
+        result->ns_per_packet = (double)ns / passes / result->packets;
+        result->ns_per_frame = (double)ns / passes / result->frames;
+        result->realtime = (double)result->frames / pcm->sample_rate * 1e9 / ((double)ns / passes);
+    }
+    result->max_packet_us = max_packet_ns / 1000.0;
+    return true;
+}
+
+static bool bench_compare(const bench_pcm_t *pcm, const bench_pcm_t *ref, size_t lag, bench_diff_t *diff)
+{
+    const size_t pcm_frames = bench_pcm_frames(pcm), ref_frames = bench_pcm_frames(ref);
+    double sum = 0, max = 0;
+
+    memset(diff, 0, sizeof(*diff));
+    if (pcm->channels != ref->channels || pcm->sample_rate != ref->sample_rate) {
+        fprintf(stderr, "reference is %u Hz %u ch, decoded %u Hz %u ch\n", ref->sample_rate, ref->channels,
+                pcm->sample_rate, pcm->channels);
+        return false;
+    }
+    if (pcm_frames <= lag) {
+        return false;
+    }
+    diff->frames = pcm_frames - lag < ref_frames ? pcm_frames - lag : ref_frames;
+    const size_t samples = diff->frames * pcm->channels;
+    for (size_t i = 0; i < samples; i++) {
+        double d = fabs(bench_pcm_sample(pcm, i + lag * pcm->channels) - bench_pcm_sample(ref, i));
+        sum += d * d;
+        if (d > max) {
+            max = d;
+        }
+    }
+    diff->psnr = sum > 0 ? 10 * log10(samples / sum) : INFINITY;
+    diff->max_diff = ldexp(max, pcm->valid_bits - 1);
+    diff->exact = lag == 0 && pcm_frames == ref_frames && pcm->bits_per_sample == ref->bits_per_sample &&
+                  pcm->valid_bits == ref->valid_bits && memcmp(pcm->data, ref->data, pcm->bytes) == 0;
+    return true;
+}
+
+/*
+ * Codec delay of |pcm| against |ref|, from the cross correlation summed over the channels. A single
+ * low frequency channel has too flat a peak to find the delay to the sample.
+ */
+static size_t bench_find_lag(const bench_pcm_t *pcm, const bench_pcm_t *ref)
+{
+    const size_t frames = bench_pcm_frames(ref) < 16384 ? bench_pcm_frames(ref) : 16384;
+    const unsigned channels = pcm->channels < ref->channels ? pcm->channels : ref->channels;
+    double best = -INFINITY;
+    size_t best_lag = 0;
+
+    for (size_t lag = 0; lag < BENCH_MAX_LAG && lag + frames <= bench_pcm_frames(pcm); lag++) {
+        double sum = 0;
+        for (size_t i = 0; i < frames; i++) {
+            for (unsigned ch = 0; ch < channels; ch++) {
+                sum += bench_pcm_sample(pcm, (i + lag) * pcm->channels + ch) *
+                       bench_pcm_sample(ref, i * ref->channels + ch);
+            }
+        }
+        if (sum > best) {
+            best = sum;
+            best_lag = lag;
+        }
+    }
+    return best_lag;
+}
+
+static void print_result(const char *name, const bench_pcm_t *pcm, const bench_result_t *result)
+{
+    printf("%s: %u Hz %u ch %u/%u bit, %zu packets, %zu frames, %zu lost, %zu errors\n", name,
+           pcm->sample_rate, pcm->channels, pcm->valid_bits, pcm->bits_per_sample, result->packets,
+           result->frames, result->lost, result->errors);
+    printf("    %.0f ns/packet, %.1f ns/frame, %.1f us slowest packet, %.1fx realtime\n",
+           result->ns_per_packet, result->ns_per_frame, result->max_packet_us, result->realtime);
+    printf("    peak stack %zu bytes, peak heap %zu bytes, output buffer %zu bytes\n",
+           result->stack, result->heap, result->buf_len);
+}
+
+static void print_diff(const bench_diff_t *diff, size_t lag)
+{
+    printf("    %zu frames compared", diff->frames);
+    if (lag > 0) {
+        printf(" at a delay of %zu", lag);
+    }
+    if (diff->exact) {
+        printf(", bit exact\n");
+    } else {
+        printf(", PSNR %.2f dB, max difference %.0f LSB\n", diff->psnr, diff->max_diff);
+    }
+}
+
+static const bench_sbc_config_t self_test_configs[] = {
+    {"sbc 44.1 kHz joint stereo", SBC_sf44100, SBC_JOINT_STEREO, 16, SUB_BANDS_8, SBC_LOUDNESS, 328, 60.0},
+    {"sbc 48 kHz stereo", SBC_sf48000, SBC_STEREO, 16, SUB_BANDS_8, SBC_LOUDNESS, 345, 60.0},
+    {"sbc 32 kHz dual channel", SBC_sf32000, SBC_DUAL, 12, SUB_BANDS_8, SBC_SNR, 256, 60.0},
+    {"sbc 16 kHz mono 4 subbands", SBC_sf16000, SBC_MONO, 8, SUB_BANDS_4, SBC_SNR, 64, 40.0},
+};
+
+/* Writes the packet file and the source audio of a self test stream to |dir| */
+static bool bench_save_stream(const char *dir, size_t index, const bench_stream_t *stream,
+                              const bench_pcm_t *source)
+{
+    char path[PATH_MAX];
+
+    snprintf(path, sizeof(path), "%s/sbc_%zu.a2dp", dir, index);
+    if (!bench_stream_write(path, stream)) {
+        return false;
+    }
+    snprintf(path, sizeof(path), "%s/sbc_%zu.wav", dir, index);
+    return bench_wav_write(path, source);
+}
+
+/*
+ * Checks the SBC synthesis against its references, then decodes SBC streams of the stack's encoder
+ * and checks the audio comes back
+ */
+static int bench_self_test(int passes, const char *save_dir)
+{
+    int failures = 0;
+    bool pass = bench_sbc_synth_check();
+
+    printf("    %s\n", pass ? "PASS" : "FAIL");
+    failures += !pass;
+
+    for (size_t i = 0; i < sizeof(self_test_configs) / sizeof(self_test_configs[0]); i++) {
+        const bench_sbc_config_t *config = &self_test_configs[i];
+        bench_stream_t stream;
+        bench_pcm_t source, pcm;
+        bench_result_t result;
+        bench_diff_t diff;
+
+        pass = false;
+        memset(&pcm, 0, sizeof(pcm));
+        if (bench_sbc_source_generate(config, BENCH_SELF_TEST_MS, &stream, &source) &&
+            (save_dir == NULL || bench_save_stream(save_dir, i, &stream, &source)) &&
+            bench_run(&stream, NULL, passes, &pcm, &result)) {
+            print_result(config->name, &pcm, &result);
+            size_t lag = bench_find_lag(&pcm, &source);
+            if (bench_compare(&pcm, &source, lag, &diff)) {
+                print_diff(&diff, lag);
+                pass = result.errors == 0 && result.lost == 0 && diff.psnr >= config->min_psnr &&
+                       bench_pcm_frames(&pcm) == bench_pcm_frames(&source);
+            }
+        }
+        printf("    %s\n", pass ? "PASS" : "FAIL");
+        failures += !pass;
+
+        /* missing packets have to be filled in by the concealment */
+        if (i == 0 && stream.count > BENCH_DROP_INTERVAL) {
+            size_t dropped = 0, kept = 0;
+            for (size_t j = 0; j < stream.count; j++) {
+                if (j % BENCH_DROP_INTERVAL == BENCH_DROP_INTERVAL - 1 && j + 1 < stream.count) {
+                    free(stream.packets[j].data);
+                    dropped++;
+                } else {
+                    stream.packets[kept++] = stream.packets[j];
+                }
+            }
+            stream.count = kept;
+            bench_pcm_free(&pcm);
+            pass = bench_run(&stream, NULL, 0, &pcm, &result);
+            if (pass) {
+                print_result("    with lost packets", &pcm, &result);
+                pass = result.lost == dropped && bench_pcm_frames(&pcm) == bench_pcm_frames(&source);
+            }
+            printf("    %s\n", pass ? "PASS" : "FAIL");
+            failures += !pass;
+        }
+
+        bench_stream_free(&stream);
+        bench_pcm_free(&source);
+        bench_pcm_free(&pcm);
+    }
+    return failures;
+}
+
+static void usage(const char *name)
+{
+    printf("Usage: %s [options] [packets.a2dp]\n"
+           "Without a packet file, SBC streams made with the encoder of the stack are checked.\n"
+           "  -f s16|s24|s32  PCM sample format to ask the decoder for\n"
+           "  -m rate         highest sample rate the output needs, LDAC decodes 88.2/96 kHz at half rate\n"
+           "  -n passes       timed decoding passes, %d by default\n"
+           "  -o out.wav      write the decoded audio\n"
+           "  -r ref.wav      compare the decoded audio to a reference\n"
+           "  -s dir          save the self test packet files and their source audio\n"
+           "  -p dB           fail below this PSNR to the reference\n"
+           "  -x              fail unless the decoded audio is bit exact to the reference\n",
+           name, BENCH_DEFAULT_PASSES);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *out_path = NULL, *ref_path = NULL, *save_dir = NULL;
+    tA2DP_PCM_FORMAT request, *p_request = NULL;
+    int passes = BENCH_DEFAULT_PASSES;
+    double min_psnr = -INFINITY;
+    bool exact = false;
+    int opt;
+
+    memset(&request, 0, sizeof(request));
+    request.bits_per_sample = 16;
+    request.valid_bits = 16;
+    while ((opt = getopt(argc, argv, "f:m:n:o:r:s:p:xh")) != -1) {
+        switch (opt) {
+        case 'f':
+            if (strcmp(optarg, "s16") == 0) {
+                request.bits_per_sample = 16;
+                request.valid_bits = 16;
+            } else if (strcmp(optarg, "s24") == 0) {
+                request.bits_per_sample = 32;
+                request.valid_bits = 24;
+            } else if (strcmp(optarg, "s32") == 0) {
+                request.bits_per_sample = 32;
+                request.valid_bits = 32;
+            } else {
+                usage(argv[0]);
+                return 2;
+            }
+            p_request = &request;
+            break;
+        case 'm':
+            request.sample_rate = (uint32_t)atoi(optarg);
+            p_request = &request;
+            break;
+        case 'n':
+            passes = atoi(optarg);
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        case 'r':
+            ref_path = optarg;
+            break;
+        case 's':
+            save_dir = optarg;
+            break;
+        case 'p':
+            min_psnr = atof(optarg);
+            break;
+        case 'x':
+            exact = true;
+            break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    if (optind == argc) {
+        int failures = bench_self_test(passes, save_dir);
+        printf("%d failures\n", failures);
+        return failures ? 1 : 0;
+    }
+
+    const char *path = argv[optind];
+    bench_stream_t stream;
+    bench_pcm_t pcm, ref;
+    bench_result_t result;
+    bench_diff_t diff;
+
+    memset(&pcm, 0, sizeof(pcm));
+    if (!bench_stream_read(path, &stream)) {
+        return 1;
+    }
+    bool pass = bench_run(&stream, p_request, passes, &pcm, &result);
+    if (pass) {
+        print_result(A2DP_CodecName(stream.codec_info), &pcm, &result);
+        pass = result.errors == 0;
+    }
+    if (pass && out_path && !bench_wav_write(out_path, &pcm)) {
+        pass = false;
+    }
+    if (pass && ref_path) {
+        /* a reference of another decoder is aligned, the source audio of an encoder is not */
+        size_t lag = 0;
+        pass = bench_wav_read(ref_path, &ref);
+        if (pass && !exact) {
+            lag = bench_find_lag(&pcm, &ref);
+        }
+        pass = pass && bench_compare(&pcm, &ref, lag, &diff);
+        if (pass) {
+            print_diff(&diff, lag);
+            pass = diff.psnr >= min_psnr && (!exact || diff.exact);
+            bench_pcm_free(&ref);
+        }
+    }
+    printf("%s: %s\n", path, pass ? "PASS" : "FAIL");
+
+    bench_stream_free(&stream);
+    bench_pcm_free(&pcm);
+    return pass ? 0 : 1;
+}
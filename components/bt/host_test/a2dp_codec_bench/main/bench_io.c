@@ -0,0 +1,289 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_io.h"
+
+#define WAV_FORMAT_PCM          0x0001
+#define WAV_FORMAT_EXTENSIBLE   0xFFFE
+
+static const uint8_t packet_file_magic[4] = {'A', '2', 'D', 'P'};
+
+static uint16_t get_le16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put_le16(uint8_t *p, uint16_t value)
+{
+    p[0] = value;
+    p[1] = value >> 8;
+}
+
+static void put_le32(uint8_t *p, uint32_t value)
+{
+    put_le16(p, value);
+    put_le16(p + 2, value >> 16);
+}
+
+bool bench_stream_add(bench_stream_t *stream, const uint8_t *data, uint16_t len)
+{
+    if (stream->count == stream->capacity) {
+        size_t capacity = stream->capacity ? stream->capacity * 2 : 256;
+        bench_packet_t *packets = realloc(stream->packets, capacity * sizeof(bench_packet_t));
+        if (packets == NULL) {
+            return false;
+        }
+        stream->packets = packets;
+        stream->capacity = capacity;
+    }
+    bench_packet_t *packet = &stream->packets[stream->count];
+    packet->data = malloc(len);
+    if (packet->data == NULL) {
+        return false;
+    }
+    memcpy(packet->data, data, len);
+    packet->len = len;
+    stream->count++;
+    return true;
+}
+
+void bench_stream_free(bench_stream_t *stream)
+{
+    for (size_t i = 0; i < stream->count; i++) {
+        free(stream->packets[i].data);
+    }
+    free(stream->packets);
+    memset(stream, 0, sizeof(*stream));
+}
+
+bool bench_stream_read(const char *path, bench_stream_t *stream)
+{
+    uint8_t header[6], len[2];
+    uint8_t packet[UINT16_MAX];
+    bool ok = false;
+
+    memset(stream, 0, sizeof(*stream));
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "%s: can't open\n", path);
+        return false;
+    }
+    if (fread(header, 1, sizeof(header), f) != sizeof(header) ||
+        memcmp(header, packet_file_magic, sizeof(packet_file_magic)) != 0 ||
+        header[4] != BENCH_PACKET_FILE_VERSION) {
+        fprintf(stderr, "%s: not an A2DP packet file\n", path);
+        goto done;
+    }
+    if (header[5] == 0 || header[5] > BENCH_CODEC_INFO_MAX ||
+        fread(stream->codec_info, 1, header[5], f) != header[5]) {
+        fprintf(stderr, "%s: bad codec info\n", path);
+        goto done;
+    }
+    while (fread(len, 1, sizeof(len), f) == sizeof(len)) {
+        uint16_t packet_len = get_le16(len);
+        if (fread(packet, 1, packet_len, f) != packet_len) {
+            fprintf(stderr, "%s: truncated packet %zu\n", path, stream->count);
+            goto done;
+        }
+        if (!bench_stream_add(stream, packet, packet_len)) {
+            goto done;
+        }
+    }
+    ok = true;
+
+done:
+    fclose(f);
+    if (!ok) {
+        bench_stream_free(stream);
+    }
+    return ok;
+}
+
+bool bench_stream_write(const char *path, const bench_stream_t *stream)
+{
+    uint8_t header[6], len[2];
+
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "%s: can't create\n", path);
+        return false;
+    }
+    memcpy(header, packet_file_magic, sizeof(packet_file_magic));
+    header[4] = BENCH_PACKET_FILE_VERSION;
+    header[5] = stream->codec_info[0] + 1;
+    bool ok = fwrite(header, 1, sizeof(header), f) == sizeof(header) &&
+              fwrite(stream->codec_info, 1, header[5], f) == header[5];
+    for (size_t i = 0; ok && i < stream->count; i++) {
+        put_le16(len, stream->packets[i].len);
+        ok = fwrite(len, 1, sizeof(len), f) == sizeof(len) &&
+             fwrite(stream->packets[i].data, 1, stream->packets[i].len, f) == stream->packets[i].len;
+    }
+    if (fclose(f) != 0) {
+        ok = false;
+    }
+    return ok;
+}
+
+bool bench_pcm_append(bench_pcm_t *pcm, const uint8_t *data, size_t len)
+{
+    if (pcm->bytes + len > pcm->capacity) {
+        size_t capacity = pcm->capacity ? pcm->capacity : 64 * 1024;
+        while (capacity < pcm->bytes + len) {
+            capacity *= 2;
+        }
+        uint8_t *buf = realloc(pcm->data, capacity);
+        if (buf == NULL) {
+            return false;
+        }
+        pcm->data = buf;
+        pcm->capacity = capacity;
+    }
+    memcpy(pcm->data + pcm->bytes, data, len);
+    pcm->bytes += len;
+    return true;
+}
+
+size_t bench_pcm_frames(const bench_pcm_t *pcm)
+{
+    if (pcm->channels == 0 || pcm->bits_per_sample == 0) {
+        return 0;
+    }
+    return pcm->bytes / (pcm->channels * (pcm->bits_per_sample / 8));
+}
+
+double bench_pcm_sample(const bench_pcm_t *pcm, size_t index)
+{
+    const uint8_t *p = pcm->data + index * (pcm->bits_per_sample / 8);
+
+    switch (pcm->bits_per_sample) {
+    case 16:
+        return (int16_t)get_le16(p) / 32768.0;
+    case 24:
+        return (int32_t)((p[0] << 8) | (p[1] << 16) | ((uint32_t)p[2] << 24)) / 2147483648.0;
+    default:
+        return (int32_t)get_le32(p) / 2147483648.0;
+    }
+}
+
+void bench_pcm_free(bench_pcm_t *pcm)
+{
+    free(pcm->data);
+    memset(pcm, 0, sizeof(*pcm));
+}
+
+bool bench_wav_read(const char *path, bench_pcm_t *pcm)
+{
+    uint8_t chunk[8], fmt[40];
+    bool have_fmt = false;
+
+    memset(pcm, 0, sizeof(*pcm));
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "%s: can't open\n", path);
+        return false;
+    }
+    if (fread(chunk, 1, 8, f) != 8 || memcmp(chunk, "RIFF", 4) != 0 ||
+        fread(chunk, 1, 4, f) != 4 || memcmp(chunk, "WAVE", 4) != 0) {
+        goto fail;
+    }
+    while (fread(chunk, 1, 8, f) == 8) {
+        uint32_t size = get_le32(chunk + 4);
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            if (size < 16 || size > sizeof(fmt) || fread(fmt, 1, size, f) != size) {
+                goto fail;
+            }
+            uint16_t tag = get_le16(fmt);
+            pcm->channels = get_le16(fmt + 2);
+            pcm->sample_rate = get_le32(fmt + 4);
+            pcm->bits_per_sample = get_le16(fmt + 14);
+            pcm->valid_bits = pcm->bits_per_sample;
+            if (tag == WAV_FORMAT_EXTENSIBLE && size >= 24) {
+                tag = get_le16(fmt + 24);
+                pcm->valid_bits = get_le16(fmt + 18);
+            }
+            if (tag != WAV_FORMAT_PCM || pcm->channels == 0 ||
+                (pcm->bits_per_sample != 16 && pcm->bits_per_sample != 24 &&
+                 pcm->bits_per_sample != 32)) {
+                fprintf(stderr, "%s: unsupported WAV format\n", path);
+                fclose(f);
+                return false;
+            }
+            have_fmt = true;
+        } else if (memcmp(chunk, "data", 4) == 0 && have_fmt) {
+            pcm->data = malloc(size ? size : 1);
+            if (pcm->data == NULL) {
+                goto fail;
+            }
+            pcm->bytes = fread(pcm->data, 1, size, f);
+            pcm->capacity = size;
+            fclose(f);
+            return true;
+        } else if (fseek(f, size + (size & 1), SEEK_CUR) != 0) {
+            goto fail;
+        }
+    }
+
+fail:
+    fprintf(stderr, "%s: not a PCM WAV file\n", path);
+    fclose(f);
+    bench_pcm_free(pcm);
+    return false;
+}
+
+bool bench_wav_write(const char *path, const bench_pcm_t *pcm)
+{
+    /* 24 bit samples in 32 bit containers need the extensible format to tell the valid bits */
+    bool extensible = pcm->valid_bits != pcm->bits_per_sample || pcm->channels > 2;
+    uint16_t block_align = pcm->channels * (pcm->bits_per_sample / 8);
+    uint32_t fmt_size = extensible ? 40 : 16;
+    uint8_t header[68];
+    size_t header_len = 20 + fmt_size + 8;
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, "RIFF", 4);
+    put_le32(header + 4, header_len - 8 + pcm->bytes);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    put_le32(header + 16, fmt_size);
+    put_le16(header + 20, extensible ? WAV_FORMAT_EXTENSIBLE : WAV_FORMAT_PCM);
+    put_le16(header + 22, pcm->channels);
+    put_le32(header + 24, pcm->sample_rate);
+    put_le32(header + 28, pcm->sample_rate * block_align);
+    put_le16(header + 32, block_align);
+    put_le16(header + 34, pcm->bits_per_sample);
+    if (extensible) {
+        static const uint8_t pcm_guid_tail[14] = {
+            0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71
+        };
+        put_le16(header + 36, 22);
+        put_le16(header + 38, pcm->valid_bits);
+        put_le32(header + 40, 0);
+        put_le16(header + 44, WAV_FORMAT_PCM);
+        memcpy(header + 46, pcm_guid_tail, sizeof(pcm_guid_tail));
+    }
+    memcpy(header + header_len - 8, "data", 4);
+    put_le32(header + header_len - 4, pcm->bytes);
+
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "%s: can't create\n", path);
+        return false;
+    }
+    bool ok = fwrite(header, 1, header_len, f) == header_len &&
+              fwrite(pcm->data, 1, pcm->bytes, f) == pcm->bytes;
+    if (fclose(f) != 0) {
+        ok = false;
+    }
+    return ok;
+}
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A2DP packet files hold the media packets of one stream as the sink receives them:
+ *
+ *   "A2DP"          magic
+ *   uint8_t         version, BENCH_PACKET_FILE_VERSION
+ *   uint8_t         codec info length, LOSC octet included
+ *   uint8_t[]       codec info, as passed to A2DP_GetDecoderInterface()
+ *   then per media packet:
+ *   uint16_t        packet length, little endian
+ *   uint8_t[]       packet, starting with the RTP header
+ */
+#define BENCH_PACKET_FILE_VERSION   1
+#define BENCH_CODEC_INFO_MAX        32
+
+typedef struct {
+    uint8_t *data;
+    uint16_t len;
+} bench_packet_t;
+
+typedef struct {
+    uint8_t codec_info[BENCH_CODEC_INFO_MAX];
+    bench_packet_t *packets;
+    size_t count;
+    size_t capacity;
+} bench_stream_t;
+
+/* Interleaved PCM with samples MSB aligned in |bits_per_sample| wide containers */
+typedef struct {
+    uint32_t sample_rate;
+    uint8_t channels;
+    uint8_t bits_per_sample;
+    uint8_t valid_bits;
+    uint8_t *data;
+    size_t bytes;
+    size_t capacity;
+} bench_pcm_t;
+
+bool bench_stream_add(bench_stream_t *stream, const uint8_t *data, uint16_t len);
+void bench_stream_free(bench_stream_t *stream);
+bool bench_stream_read(const char *path, bench_stream_t *stream);
+bool bench_stream_write(const char *path, const bench_stream_t *stream);
+
+bool bench_pcm_append(bench_pcm_t *pcm, const uint8_t *data, size_t len);
+size_t bench_pcm_frames(const bench_pcm_t *pcm);
+/* Sample |index| of the interleaved data, scaled to [-1, 1) */
+double bench_pcm_sample(const bench_pcm_t *pcm, size_t index);
+void bench_pcm_free(bench_pcm_t *pcm);
+bool bench_wav_read(const char *path, bench_pcm_t *pcm);
+bool bench_wav_write(const char *path, const bench_pcm_t *pcm);
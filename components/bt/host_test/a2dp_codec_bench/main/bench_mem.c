@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <malloc.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "bench_mem.h"
+
+#define STACK_PAINT     0xA5
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+static volatile bool s_tracking;
+static size_t s_current;
+static size_t s_base;
+static size_t s_peak;
+
+static void account_alloc(void *ptr)
+{
+    if (ptr != NULL && s_tracking) {
+        size_t current = __atomic_add_fetch(&s_current, malloc_usable_size(ptr), __ATOMIC_RELAXED);
+        if (current > s_peak) {
+            s_peak = current;
+        }
+    }
+}
+
+static void account_free(void *ptr)
+{
+    if (ptr != NULL && s_tracking) {
+        __atomic_sub_fetch(&s_current, malloc_usable_size(ptr), __ATOMIC_RELAXED);
+    }
+}
+
+void *__wrap_malloc(size_t size)
+{
+    void *ptr = __real_malloc(size);
+    account_alloc(ptr);
+    return ptr;
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    void *ptr = __real_calloc(nmemb, size);
+    account_alloc(ptr);
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    account_free(ptr);
+    ptr = __real_realloc(ptr, size);
+    account_alloc(ptr);
+    return ptr;
+}
+
+void __wrap_free(void *ptr)
+{
+    account_free(ptr);
+    __real_free(ptr);
+}
+
+void bench_mem_track(bool enable)
+{
+    s_tracking = enable;
+}
+
+void bench_mem_reset_peak(void)
+{
+    s_base = s_current;
+    s_peak = s_current;
+}
+
+size_t bench_mem_peak(void)
+{
+    return s_peak - s_base;
+}
+
+typedef struct {
+    void (*fn)(void *);
+    void *arg;
+} bench_mem_thread_t;
+
+static void *bench_mem_thread(void *arg)
+{
+    bench_mem_thread_t *thread = arg;
+    if (thread->fn) {
+        thread->fn(thread->arg);
+    }
+    return NULL;
+}
+
+static bool run_painted(void (*fn)(void *), void *arg, size_t stack_size, size_t *stack_used)
+{
+    bench_mem_thread_t thread = { fn, arg };
+    pthread_attr_t attr;
+    pthread_t tid;
+    uint8_t *stack;
+    bool ok = false;
+
+    if (posix_memalign((void **)&stack, sysconf(_SC_PAGESIZE), stack_size) != 0) {
+        return false;
+    }
+    memset(stack, STACK_PAINT, stack_size);
+
+    /* stacks grow down on all hosts this runs on, the untouched paint is at the start */
+    if (pthread_attr_init(&attr) == 0) {
+        if (pthread_attr_setstack(&attr, stack, stack_size) == 0 &&
+            pthread_create(&tid, &attr, bench_mem_thread, &thread) == 0) {
+            pthread_join(tid, NULL);
+            size_t untouched = 0;
+            while (untouched < stack_size && stack[untouched] == STACK_PAINT) {
+                untouched++;
+            }
+            *stack_used = stack_size - untouched;
+            ok = true;
+        }
+        pthread_attr_destroy(&attr);
+    }
+    free(stack);
+    return ok;
+}
+
+bool bench_mem_run(void (*fn)(void *), void *arg, size_t stack_size, size_t *stack_used)
+{
+    size_t base, used;
+
+    /* the thread descriptor and TLS live at the top of a user supplied stack */
+    if (!run_painted(NULL, NULL, stack_size, &base) ||
+        !run_painted(fn, arg, stack_size, &used)) {
+        return false;
+    }
+    *stack_used = used > base ? used - base : 0;
+    return true;
+}
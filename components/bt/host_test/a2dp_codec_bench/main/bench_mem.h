@@ -0,0 +1,26 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Heap accounting hooks malloc() and friends with the linker's --wrap option, see main/CMakeLists.txt.
+ * Only allocations made while tracking is enabled are counted.
+ */
+void bench_mem_track(bool enable);
+/* Starts a new peak measurement from the current heap use */
+void bench_mem_reset_peak(void);
+/* Largest heap use above the one at bench_mem_reset_peak(), in bytes */
+size_t bench_mem_peak(void);
+
+/*
+ * Runs |fn| on a thread with a painted stack of |stack_size| bytes. |stack_used| is set to the
+ * stack |fn| touched, minus what the thread needs to start.
+ */
+bool bench_mem_run(void (*fn)(void *), void *arg, size_t stack_size, size_t *stack_used);
@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <string.h>
+#include "sbc_encoder.h"
+#include "stack/a2d_api.h"
+#include "stack/a2d_sbc.h"
+#include "bench_sbc_source.h"
+
+/* media packet size of a typical 2-DH5 link, the same the sink has to expect */
+#define BENCH_SBC_MTU           895
+#define BENCH_RTP_HDR_LEN       12
+#define BENCH_RTP_PAYLOAD_TYPE  96
+#define BENCH_SBC_MAX_FRAMES    15
+/* largest SBC frame, 8 subbands, 16 blocks, stereo at bitpool 250 */
+#define BENCH_SBC_MAX_FRAME_LEN 512
+/* frames handed to the encoder per call */
+#define BENCH_SBC_BATCH_FRAMES  4
+
+static const uint32_t sbc_rates[] = {16000, 32000, 44100, 48000};
+static const uint8_t sbc_ie_rates[] = {
+    A2D_SBC_IE_SAMP_FREQ_16, A2D_SBC_IE_SAMP_FREQ_32, A2D_SBC_IE_SAMP_FREQ_44, A2D_SBC_IE_SAMP_FREQ_48
+};
+
+/* Log sweep on the first channel, a chord of three tones on the second one */
+static int16_t test_signal(uint32_t n, uint32_t total, uint32_t rate, int channel)
+{
+    const double t = (double)n / rate;
+    double value;
+
+    if (channel == 0) {
+        const double f0 = 40.0, f1 = 0.45 * rate, duration = (double)total / rate;
+        const double k = log(f1 / f0);
+        value = 0.5 * sin(2 * M_PI * f0 * duration / k * (exp(t / duration * k) - 1));
+    } else {
+        value = 0.2 * sin(2 * M_PI * 440.0 * t) + 0.2 * sin(2 * M_PI * 1250.0 * t + 1.0) +
+                0.2 * sin(2 * M_PI * 5100.0 * t + 2.0);
+    }
+    return (int16_t)lrint(value * 32767.0);
+}
+
+static void put_rtp_header(uint8_t *p, uint16_t seq, uint32_t timestamp)
+{
+    p[0] = 0x80;                    /* version 2, no padding, extension or CSRC */
+    p[1] = BENCH_RTP_PAYLOAD_TYPE;
+    p[2] = seq >> 8;
+    p[3] = seq;
+    p[4] = timestamp >> 24;
+    p[5] = timestamp >> 16;
+    p[6] = timestamp >> 8;
+    p[7] = timestamp;
+    p[8] = p[9] = p[10] = 0;
+    p[11] = 1;                      /* SSRC */
+}
+
+bool bench_sbc_source_generate(const bench_sbc_config_t *config, uint32_t duration_ms,
+                               bench_stream_t *stream, bench_pcm_t *source)
+{
+    static SBC_ENC_PARAMS enc;
+    static int16_t pcm[BENCH_SBC_BATCH_FRAMES * SBC_MAX_NUM_OF_BLOCKS * SBC_MAX_NUM_OF_SUBBANDS *
+                       SBC_MAX_NUM_OF_CHANNELS];
+    static uint8_t frames[BENCH_SBC_BATCH_FRAMES * BENCH_SBC_MAX_FRAME_LEN];
+    uint8_t packet[BENCH_SBC_MTU];
+    tA2D_SBC_CIE cie;
+
+    memset(stream, 0, sizeof(*stream));
+    memset(source, 0, sizeof(*source));
+    memset(&enc, 0, sizeof(enc));
+    enc.sbc_mode = SBC_MODE_STD;
+    enc.s16SamplingFreq = config->sampling_freq;
+    enc.s16ChannelMode = config->channel_mode;
+    enc.s16NumOfBlocks = config->blocks;
+    enc.s16NumOfSubBands = config->subbands;
+    enc.s16AllocationMethod = config->allocation;
+    enc.u16BitRate = config->bitrate;
+    SBC_Encoder_Init(&enc);
+
+    cie.samp_freq = sbc_ie_rates[config->sampling_freq];
+    cie.ch_mode = A2D_SBC_IE_CH_MD_MONO >> config->channel_mode;
+    cie.block_len = A2D_SBC_IE_BLOCKS_4 >> (config->blocks / 4 - 1);
+    cie.num_subbands = config->subbands == SUB_BANDS_8 ? A2D_SBC_IE_SUBBAND_8 : A2D_SBC_IE_SUBBAND_4;
+    cie.alloc_mthd = config->allocation == SBC_SNR ? A2D_SBC_IE_ALLOC_MD_S : A2D_SBC_IE_ALLOC_MD_L;
+    cie.min_bitpool = A2D_SBC_IE_MIN_BITPOOL;
+    cie.max_bitpool = enc.s16BitPool;
+    if (A2D_BldSbcInfo(A2D_MEDIA_TYPE_AUDIO, &cie, stream->codec_info) != A2D_SUCCESS) {
+        return false;
+    }
+
+    const uint32_t rate = sbc_rates[config->sampling_freq];
+    const int channels = enc.s16NumOfChannels;
+    const uint32_t frame_samples = config->blocks * config->subbands;
+    const uint32_t total_frames = (uint64_t)rate * duration_ms / 1000 / frame_samples;
+    const uint32_t total_samples = total_frames * frame_samples;
+    source->sample_rate = rate;
+    source->channels = channels;
+    source->bits_per_sample = 16;
+    source->valid_bits = 16;
+
+    uint16_t seq = 0;
+    uint32_t timestamp = 0;
+    size_t packet_len = BENCH_RTP_HDR_LEN + 1;
+    int packet_frames = 0;
+
+    uint32_t batch;
+    for (uint32_t f = 0; f < total_frames; f += batch) {
+        batch = total_frames - f < BENCH_SBC_BATCH_FRAMES ? total_frames - f : BENCH_SBC_BATCH_FRAMES;
+        for (uint32_t i = 0; i < batch * frame_samples; i++) {
+            for (int ch = 0; ch < channels; ch++) {
+                pcm[i * channels + ch] = test_signal(f * frame_samples + i, total_samples, rate, ch);
+            }
+        }
+        if (!bench_pcm_append(source, (uint8_t *)pcm, batch * frame_samples * channels * sizeof(int16_t))) {
+            return false;
+        }
+        SBC_Encoder_Batch(&enc, pcm, frames, batch);
+
+        for (uint32_t b = 0; b < batch; b++) {
+            if (packet_frames == BENCH_SBC_MAX_FRAMES || packet_len + enc.u16PacketLength > sizeof(packet)) {
+                put_rtp_header(packet, seq++, timestamp);
+                packet[BENCH_RTP_HDR_LEN] = packet_frames;
+                if (!bench_stream_add(stream, packet, packet_len)) {
+                    return false;
+                }
+                timestamp += packet_frames * frame_samples;
+                packet_len = BENCH_RTP_HDR_LEN + 1;
+                packet_frames = 0;
+            }
+            memcpy(packet + packet_len, frames + b * enc.u16PacketLength, enc.u16PacketLength);
+            packet_len += enc.u16PacketLength;
+            packet_frames++;
+        }
+    }
+    if (packet_frames > 0) {
+        put_rtp_header(packet, seq, timestamp);
+        packet[BENCH_RTP_HDR_LEN] = packet_frames;
+        if (!bench_stream_add(stream, packet, packet_len)) {
+            return false;
+        }
+    }
+    return true;
+}
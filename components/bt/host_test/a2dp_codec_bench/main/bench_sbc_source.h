@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "bench_io.h"
+
+/* SBC stream settings, the SBC_xxx values of sbc_encoder.h */
+typedef struct {
+    const char *name;
+    int16_t sampling_freq;
+    int16_t channel_mode;
+    int16_t blocks;
+    int16_t subbands;
+    int16_t allocation;
+    uint16_t bitrate;       /* kbit/s, the encoder derives the bitpool from it */
+    double min_psnr;        /* dB against the source signal */
+} bench_sbc_config_t;
+
+/*
+ * Encodes |duration_ms| of a test signal with the SBC encoder of the stack and packs the frames
+ * into RTP media packets the way an A2DP source does. |source| gets the encoded PCM.
+ */
+bool bench_sbc_source_generate(const bench_sbc_config_t *config, uint32_t duration_ms,
+                               bench_stream_t *stream, bench_pcm_t *source);
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Reference checks of the SBC synthesis filterbank. The decoder self test only sees the PSNR of
+ * the whole decoder, these catch a change of the window or the multiplies down to one LSB.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_sbc_synth.h"
+
+#define BENCH_SYNTH_BLOCKS      100000
+#define BENCH_SYNTH_GOLDEN_BLOCKS 20000
+/*
+ * FNV-1a of the SynthWindow80_c() output for the blocks of bench_synth_golden(). Taken when the
+ * window was checked against the former one, a change of the window has to update it.
+ */
+#define BENCH_SYNTH_GOLDEN      0xabff1d57u
+#define BENCH_MUL_PAIRS         2000000
+
+static uint32_t s_seed;
+
+/* The same pseudo random numbers on every host */
+static uint32_t bench_rand(void)
+{
+    s_seed = s_seed * 1664525u + 1013904223u;
+    return s_seed;
+}
+
+static SBC_BUFFER_T bench_rand_sample(int32_t amp)
+{
+    return (SBC_BUFFER_T)((int64_t)bench_rand() * (2 * amp + 1) / 0x100000000ll - amp);
+}
+
+/*
+ * The former window sums every product with a shift of its own and truncates, the new one is
+ * exact and rounds once, so the two may differ by 1 LSB. The former 32 bit sums can wrap around
+ * for buffer values above 12112, the levels stay below that.
+ */
+static bool bench_synth_against_ref(void)
+{
+    static const int32_t amps[] = {300, 7000, 12000};
+    SBC_BUFFER_T buffer[80];
+    OI_INT16 ref[8], pcm[8];
+    uint32_t differ = 0, outputs = 0;
+    int max_diff = 0;
+
+    s_seed = 18;
+    for (size_t a = 0; a < sizeof(amps) / sizeof(amps[0]); a++) {
+        for (int n = 0; n < BENCH_SYNTH_BLOCKS; n++) {
+            for (int i = 0; i < 80; i++) {
+                buffer[i] = bench_rand_sample(amps[a]);
+            }
+            bench_sbc_synth_ref_window80(ref, buffer, 0);
+            SynthWindow80_c(pcm, buffer, 0);
+            for (int j = 0; j < 8; j++) {
+                int diff = abs(pcm[j] - ref[j]);
+                max_diff = diff > max_diff ? diff : max_diff;
+                differ += diff != 0;
+            }
+            outputs += 8;
+        }
+    }
+    printf("sbc synthesis window: %" PRIu32 " outputs against the former window, %.1f%% differ, "
+           "max difference %d LSB\n", outputs, 100.0 * differ / outputs, max_diff);
+    return max_diff <= 1;
+}
+
+/* Loud and quiet blocks, clipping and the PCM stride included */
+static bool bench_synth_golden(void)
+{
+    static const int32_t amps[] = {32767, 16000, 300};
+    SBC_BUFFER_T buffer[80];
+    OI_INT16 pcm[16];
+    uint32_t hash = 2166136261u;
+
+    s_seed = 80;
+    for (int n = 0; n < BENCH_SYNTH_GOLDEN_BLOCKS; n++) {
+        OI_UINT stride_shift = n & 1;
+        for (int i = 0; i < 80; i++) {
+            buffer[i] = bench_rand_sample(amps[n % 3]);
+        }
+        SynthWindow80_c(pcm, buffer, stride_shift);
+        for (int j = 0; j < 8; j++) {
+            uint16_t s = (uint16_t)pcm[j << stride_shift];
+            hash = (hash ^ (s & 0xff)) * 16777619u;
+            hash = (hash ^ (s >> 8)) * 16777619u;
+        }
+    }
+    printf("sbc synthesis window: output hash 0x%08" PRIx32 ", expected 0x%08" PRIx32 "\n",
+           hash, (uint32_t)BENCH_SYNTH_GOLDEN);
+    return hash == BENCH_SYNTH_GOLDEN;
+}
+
+/* Operands of every magnitude, the extremes more often than uniform numbers would give them */
+static int32_t bench_rand_operand(void)
+{
+    static const int32_t edges[] = {0, 1, -1, 0x7fff, -0x8000, 0xffff, 0x10000, -0x10000,
+                                    INT32_MAX, INT32_MIN, INT32_MIN + 1};
+    uint32_t r = bench_rand();
+
+    if ((r & 7) == 0) {
+        return edges[(r >> 3) % (sizeof(edges) / sizeof(edges[0]))];
+    }
+    return (int32_t)bench_rand() >> (r >> 27);
+}
+
+/* What MULSH computes, the MUL_xxx_HI of synthesis-dct8.c and synthesis-sbc.c on such cores */
+static bool bench_synth_mul(void)
+{
+    uint32_t wrong32 = 0, wrong16 = 0;
+
+    s_seed = 32;
+    for (int n = 0; n < BENCH_MUL_PAIRS; n++) {
+        int32_t u = bench_rand_operand();
+        int32_t v = bench_rand_operand();
+        int16_t u16 = (int16_t)u;
+
+        wrong32 += default_mul_32s_32s_hi(u, v) != (OI_INT32)(((int64_t)u * v) >> 32);
+        wrong16 += default_mul_16s_32s_hi(u16, v) != (OI_INT32)(((int64_t)((OI_INT32)u16 * 65536) * v) >> 32);
+    }
+    printf("sbc high half multiplies: %d operand pairs, %" PRIu32 " wrong 32x32, %" PRIu32 " wrong 16x32\n",
+           BENCH_MUL_PAIRS, wrong32, wrong16);
+    return wrong32 == 0 && wrong16 == 0;
+}
+
+bool bench_sbc_synth_check(void)
+{
+    bool pass = bench_synth_against_ref();
+    pass &= bench_synth_golden();
+    pass &= bench_synth_mul();
+    return pass;
+}
@@ -0,0 +1,20 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "oi_codec_sbc_private.h"
+
+/*
+ * Checks the synthesis filterbank of the SBC decoder piece by piece: SynthWindow80_c() against
+ * the generated window it replaced and against its own output when this check was written, the
+ * C high half multiplies against the MULSH they stand in for. Prints what it finds.
+ */
+bool bench_sbc_synth_check(void);
+
+/* The former generated 8-subband window, see bench_sbc_synth_ref.c */
+void bench_sbc_synth_ref_window80(OI_INT16 *pcm, SBC_BUFFER_T const *buffer, OI_UINT strideShift);
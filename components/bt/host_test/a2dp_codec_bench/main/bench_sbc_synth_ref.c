@@ -17,23 +17,14 @@
  *
  ******************************************************************************/
 
-/**
- @file
-
- DO NOT EDIT THIS FILE DIRECTLY
-
- This file is automatically generated by the "synthesis-gen.pl" script.
- Any changes to this generated file will be lost when the script is re-run.
-
- These functions are called by functions in synthesis.c to perform the synthesis
- filterbank computations for the SBC decoder.
-
-
+/*
+ * The 8-subband synthesis window of the SBC decoder as it was generated by "synthesis-gen.pl",
+ * before synthesis-8-window.c replaced it. Kept unchanged as the reference the new window is
+ * checked against, see bench_sbc_synth.c.
  */
-#include "common/bt_target.h"
-#include <oi_codec_sbc_private.h>
 
-#if (defined(SBC_DEC_INCLUDED) && SBC_DEC_INCLUDED == TRUE)
+#include "oi_codec_sbc_private.h"
+#include "bench_sbc_synth.h"
 
 #ifndef CLIP_INT16
 #define CLIP_INT16(x) do { if (x > OI_INT16_MAX) { x = OI_INT16_MAX; } else if (x < OI_INT16_MIN) { x = OI_INT16_MIN; } } while (0)
@@ -41,7 +32,7 @@
 
 #define MUL_16S_16S(_x, _y) ((_x) * (_y))
 
-PRIVATE void SynthWindow80_generated(OI_INT16 *pcm, SBC_BUFFER_T const *RESTRICT buffer, OI_UINT strideShift)
+void bench_sbc_synth_ref_window80(OI_INT16 *pcm, SBC_BUFFER_T const *buffer, OI_UINT strideShift)
 {
     OI_INT32 pcm_a, pcm_b;
     /* 1 - stage 0 */ pcm_b = 0;
@@ -135,5 +126,3 @@ PRIVATE void SynthWindow80_generated(OI_INT16 *pcm, SBC_BUFFER_T const *RESTRICT
     /* 1 - stage 4 */ pcm_a += (MUL_16S_16S(9539, buffer[ 72])) >> 4;
     /* 1 - stage 4 */ pcm_a /= 32768; CLIP_INT16(pcm_a); pcm[4 << strideShift] = (OI_INT16)pcm_a;
 }
-
-#endif /* #if (defined(SBC_DEC_INCLUDED) && SBC_DEC_INCLUDED == TRUE) */
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The semaphores and mutexes of the OSI layer on POSIX threads, for running fixed_queue.c on the host.
+ * The linux target only has the FreeRTOS headers, the handles point to the struct defined here.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include "osi/mutex.h"
+#include "osi/semaphore.h"
+
+struct QueueDefinition {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t max_count;
+};
+
+static struct QueueDefinition *port_sem_new(uint32_t max_count, uint32_t init_count)
+{
+    struct QueueDefinition *sem = calloc(1, sizeof(*sem));
+    pthread_condattr_t attr;
+
+    if (sem == NULL) {
+        return NULL;
+    }
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&sem->lock, NULL);
+    pthread_cond_init(&sem->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    sem->count = init_count;
+    sem->max_count = max_count;
+    return sem;
+}
+
+static void port_sem_free(struct QueueDefinition *sem)
+{
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->lock);
+    free(sem);
+}
+
+static int port_sem_take(struct QueueDefinition *sem, uint32_t timeout)
+{
+    struct timespec deadline;
+    int ret = 0;
+
+    if (timeout != OSI_SEM_MAX_TIMEOUT) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout / 1000;
+        deadline.tv_nsec += (long)(timeout % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+
+    pthread_mutex_lock(&sem->lock);
+    while (sem->count == 0 && ret == 0) {
+        if (timeout == OSI_SEM_MAX_TIMEOUT) {
+            pthread_cond_wait(&sem->cond, &sem->lock);
+        } else if (timeout == 0) {
+            ret = -1;
+        } else if (pthread_cond_timedwait(&sem->cond, &sem->lock, &deadline) == ETIMEDOUT) {
+            ret = sem->count ? 0 : -2;
+        }
+    }
+    if (ret == 0) {
+        sem->count--;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return ret;
+}
+
+static void port_sem_give(struct QueueDefinition *sem)
+{
+    pthread_mutex_lock(&sem->lock);
+    if (sem->count < sem->max_count) {
+        sem->count++;
+        pthread_cond_signal(&sem->cond);
+    }
+    pthread_mutex_unlock(&sem->lock);
+}
+
+int osi_sem_new(osi_sem_t *sem, uint32_t max_count, uint32_t init_count)
+{
+    *sem = port_sem_new(max_count, init_count);
+    return *sem ? 0 : -1;
+}
+
+void osi_sem_free(osi_sem_t *sem)
+{
+    port_sem_free(*sem);
+    *sem = NULL;
+}
+
+int osi_sem_take(osi_sem_t *sem, uint32_t timeout)
+{
+    return port_sem_take(*sem, timeout);
+}
+
+void osi_sem_give(osi_sem_t *sem)
+{
+    port_sem_give(*sem);
+}
+
+int osi_mutex_new(osi_mutex_t *mutex)
+{
+    *mutex = port_sem_new(1, 1);
+    return *mutex ? 0 : -1;
+}
+
+int osi_mutex_lock(osi_mutex_t *mutex, uint32_t timeout)
+{
+    return port_sem_take(*mutex, timeout);
+}
+
+void osi_mutex_unlock(osi_mutex_t *mutex)
+{
+    port_sem_give(*mutex);
+}
+
+void osi_mutex_free(osi_mutex_t *mutex)
+{
+    port_sem_free(*mutex);
+    *mutex = NULL;
+}
@@ -0,0 +1,285 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Contention benchmark of the fixed_queue of the OSI layer. Producer threads post to one queue
+ * while consumer threads drain it, as the tasks of the stack do on the HCI and work queues. The
+ * list based queue and the lock-free one are compared on throughput and on the time an enqueue
+ * takes, and every element is checked to come out once and in order.
+ */
+
+#include <getopt.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "osi/fixed_queue.h"
+
+#define BENCH_MAX_PRODUCERS     4
+#define BENCH_MAX_CONSUMERS     4
+#define BENCH_MAX_BATCH         64
+#define BENCH_DEFAULT_ITEMS     200000
+#define BENCH_DEFAULT_CAPACITY  QUEUE_SIZE_MAX
+#define BENCH_DEFAULT_BATCH     16
+
+/* elements carry their producer in the low bits and their sequence number above, never 0 */
+#define BENCH_ITEM(producer, seq)       ((void *)(uintptr_t)(((uintptr_t)(seq) + 1) * BENCH_MAX_PRODUCERS + (producer)))
+#define BENCH_ITEM_PRODUCER(item)       ((size_t)((uintptr_t)(item) % BENCH_MAX_PRODUCERS))
+#define BENCH_ITEM_SEQ(item)            ((size_t)((uintptr_t)(item) / BENCH_MAX_PRODUCERS - 1))
+
+typedef struct {
+    bool lockfree;
+    size_t producers;
+    size_t consumers;
+    size_t items;       /* per producer */
+    size_t capacity;
+    size_t batch;       /* elements a consumer takes at once, 1 for fixed_queue_dequeue() */
+} bench_config_t;
+
+typedef struct bench_run bench_run_t;
+
+typedef struct {
+    bench_run_t *run;
+    size_t id;
+    uint32_t *enqueue_ns;               /* producers, time of each enqueue */
+    size_t next[BENCH_MAX_PRODUCERS];   /* consumers, next sequence number expected per producer */
+    size_t received;
+    size_t errors;
+} bench_thread_t;
+
+struct bench_run {
+    const bench_config_t *config;
+    fixed_queue_t *queue;
+    pthread_barrier_t start;
+    bench_thread_t producers[BENCH_MAX_PRODUCERS];
+    bench_thread_t consumers[BENCH_MAX_CONSUMERS];
+};
+
+typedef struct {
+    double mitems_per_s;
+    uint32_t p50_ns;
+    uint32_t p99_ns;
+    uint32_t p999_ns;
+    uint32_t max_ns;
+} bench_result_t;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void *bench_producer(void *arg)
+{
+    bench_thread_t *self = (bench_thread_t *)arg;
+    const bench_config_t *config = self->run->config;
+
+    pthread_barrier_wait(&self->run->start);
+    for (size_t i = 0; i < config->items; i++) {
+        uint64_t start = now_ns();
+        if (!fixed_queue_enqueue(self->run->queue, BENCH_ITEM(self->id, i), FIXED_QUEUE_MAX_TIMEOUT)) {
+            self->errors++;
+        }
+        self->enqueue_ns[i] = (uint32_t)(now_ns() - start);
+    }
+    return NULL;
+}
+
+static void bench_check(bench_thread_t *self, void *item)
+{
+    size_t producer = BENCH_ITEM_PRODUCER(item);
+    size_t seq = BENCH_ITEM_SEQ(item);
+
+    /* a consumer may miss the elements another one took, it never sees them go backwards */
+    if (producer >= self->run->config->producers || seq < self->next[producer] ||
+            (self->run->config->consumers == 1 && seq != self->next[producer])) {
+        self->errors++;
+    }
+    self->next[producer] = seq + 1;
+    self->received++;
+}
+
+static void *bench_consumer(void *arg)
+{
+    bench_thread_t *self = (bench_thread_t *)arg;
+    const bench_config_t *config = self->run->config;
+    void *items[BENCH_MAX_BATCH];
+
+    pthread_barrier_wait(&self->run->start);
+    for (;;) {
+        size_t n;
+        if (config->batch > 1) {
+            n = fixed_queue_dequeue_batch(self->run->queue, items, config->batch, FIXED_QUEUE_MAX_TIMEOUT);
+        } else {
+            items[0] = fixed_queue_dequeue(self->run->queue, FIXED_QUEUE_MAX_TIMEOUT);
+            n = items[0] != NULL;
+        }
+        for (size_t i = 0; i < n; i++) {
+            /* one stop marker per consumer is queued after the producers are done */
+            if (items[i] == (void *)self->run) {
+                /* nothing but the markers of the other consumers can follow, hand them back */
+                for (size_t j = i + 1; j < n; j++) {
+                    if (items[j] == (void *)self->run) {
+                        fixed_queue_enqueue(self->run->queue, items[j], FIXED_QUEUE_MAX_TIMEOUT);
+                    } else {
+                        self->errors++;
+                    }
+                }
+                return NULL;
+            }
+            bench_check(self, items[i]);
+        }
+    }
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static bool bench_run(const bench_config_t *config, bench_result_t *result)
+{
+    bench_run_t run;
+    pthread_t producers[BENCH_MAX_PRODUCERS], consumers[BENCH_MAX_CONSUMERS];
+    size_t total = config->items * config->producers;
+    size_t received = 0, errors = 0;
+    uint32_t *enqueue_ns = malloc(total * sizeof(uint32_t));
+    bool ok;
+
+    memset(&run, 0, sizeof(run));
+    memset(result, 0, sizeof(*result));
+    run.config = config;
+    run.queue = config->lockfree ? fixed_queue_new_lockfree(config->capacity) : fixed_queue_new(config->capacity);
+    if (run.queue == NULL || enqueue_ns == NULL) {
+        printf("no memory\n");
+        free(enqueue_ns);
+        return false;
+    }
+    pthread_barrier_init(&run.start, NULL, config->producers + config->consumers + 1);
+
+    for (size_t i = 0; i < config->consumers; i++) {
+        run.consumers[i].run = &run;
+        run.consumers[i].id = i;
+        pthread_create(&consumers[i], NULL, bench_consumer, &run.consumers[i]);
+    }
+    for (size_t i = 0; i < config->producers; i++) {
+        run.producers[i].run = &run;
+        run.producers[i].id = i;
+        run.producers[i].enqueue_ns = &enqueue_ns[i * config->items];
+        pthread_create(&producers[i], NULL, bench_producer, &run.producers[i]);
+    }
+
+    pthread_barrier_wait(&run.start);
+    uint64_t start = now_ns();
+    for (size_t i = 0; i < config->producers; i++) {
+        pthread_join(producers[i], NULL);
+        errors += run.producers[i].errors;
+    }
+    for (size_t i = 0; i < config->consumers; i++) {
+        fixed_queue_enqueue(run.queue, &run, FIXED_QUEUE_MAX_TIMEOUT);
+    }
+    for (size_t i = 0; i < config->consumers; i++) {
+        pthread_join(consumers[i], NULL);
+        received += run.consumers[i].received;
+        errors += run.consumers[i].errors;
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    ok = errors == 0 && received == total && fixed_queue_is_empty(run.queue);
+    if (!ok) {
+        printf("    %zu of %zu elements received, %zu errors\n", received, total, errors);
+    }
+
+    qsort(enqueue_ns, total, sizeof(uint32_t), compare_u32);
+    result->mitems_per_s = total * 1000.0 / elapsed;
+    result->p50_ns = enqueue_ns[total / 2];
+    result->p99_ns = enqueue_ns[total - total / 100 - 1];
+    result->p999_ns = enqueue_ns[total - total / 1000 - 1];
+    result->max_ns = enqueue_ns[total - 1];
+
+    pthread_barrier_destroy(&run.start);
+    fixed_queue_free(run.queue, NULL);
+    free(enqueue_ns);
+    return ok;
+}
+
+static void print_result(const bench_config_t *config, const bench_result_t *result, bool ok)
+{
+    printf("%-8s %zu producers, %zu consumers, batch %2zu: %6.2f Mitems/s, enqueue p50 %5u ns, "
+           "p99 %6u ns, p99.9 %7u ns, max %8u ns  %s\n",
+           config->lockfree ? "lockfree" : "list", config->producers, config->consumers, config->batch,
+           result->mitems_per_s, result->p50_ns, result->p99_ns, result->p999_ns, result->max_ns,
+           ok ? "PASS" : "FAIL");
+}
+
+static void usage(const char *name)
+{
+    printf("Usage: %s [options]\n"
+           "Runs 1 to %d producers against each queue, with single and batch dequeue.\n"
+           "  -n items     elements per producer, %d by default\n"
+           "  -c capacity  queue capacity, %d by default\n"
+           "  -b batch     elements per batch dequeue, up to %d, %d by default\n"
+           "  -k consumers consumer threads, up to %d, 1 by default\n",
+           name, BENCH_MAX_PRODUCERS, BENCH_DEFAULT_ITEMS, BENCH_DEFAULT_CAPACITY,
+           BENCH_MAX_BATCH, BENCH_DEFAULT_BATCH, BENCH_MAX_CONSUMERS);
+}
+
+int main(int argc, char *argv[])
+{
+    bench_config_t config = {
+        .items = BENCH_DEFAULT_ITEMS,
+        .capacity = BENCH_DEFAULT_CAPACITY,
+        .consumers = 1,
+    };
+    size_t batch = BENCH_DEFAULT_BATCH;
+    int failures = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:c:b:k:h")) != -1) {
+        switch (opt) {
+        case 'n':
+            config.items = (size_t)atol(optarg);
+            break;
+        case 'c':
+            config.capacity = (size_t)atol(optarg);
+            break;
+        case 'b':
+            batch = (size_t)atol(optarg);
+            break;
+        case 'k':
+            config.consumers = (size_t)atol(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (config.items == 0 || config.capacity == 0 || batch < 2 || batch > BENCH_MAX_BATCH ||
+            config.consumers == 0 || config.consumers > BENCH_MAX_CONSUMERS) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    for (int lockfree = 0; lockfree <= 1; lockfree++) {
+        config.lockfree = lockfree;
+        for (config.producers = 1; config.producers <= BENCH_MAX_PRODUCERS; config.producers++) {
+            for (config.batch = 1; config.batch <= batch; config.batch = config.batch == 1 ? batch : batch + 1) {
+                bench_result_t result;
+                bool ok = bench_run(&config, &result);
+                print_result(&config, &result, ok);
+                failures += !ok;
+            }
+        }
+    }
+
+    printf("%d failures\n", failures);
+    return failures ? 1 : 0;
+}
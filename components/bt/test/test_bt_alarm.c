@@ -0,0 +1,239 @@
+/*
+ Tests for the OSI alarms on the timer wheel
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "unity.h"
+#include "test_utils.h"
+#include "sdkconfig.h"
+#include "hal/cpu_hal.h"
+#include "esp_timer.h"
+
+#if CONFIG_BT_ALARM_WHEEL
+
+#include "osi/alarm.h"
+#include "btc/btc_task.h"
+
+#define BT_ALARM_TEST_NUM           (32)
+#define BT_ALARM_BENCH_ROUNDS       (100)
+/* long enough never to fire during the test */
+#define BT_ALARM_TEST_TIMEOUT_MS    (60000)
+/* the firing test is timed in units of at least 10 ticks, which go on the wheel */
+#define BT_ALARM_TEST_TICK_MS       (CONFIG_BT_ALARM_WHEEL_TICK_MS)
+#define BT_ALARM_TEST_UNIT_MS       (BT_ALARM_TEST_TICK_MS * 10)
+#define BT_ALARM_TEST_FIRED_MAX     (16)
+
+/* firings in the order the callbacks ran on the BTC task */
+static SemaphoreHandle_t s_fired_sem;
+static int s_fired_id[BT_ALARM_TEST_FIRED_MAX];
+static int64_t s_fired_us[BT_ALARM_TEST_FIRED_MAX];
+static volatile int s_fired_num;
+
+static void bt_alarm_test_cb(void *arg)
+{
+}
+
+static void bt_alarm_test_fired_cb(void *arg)
+{
+    if (s_fired_num < BT_ALARM_TEST_FIRED_MAX) {
+        s_fired_id[s_fired_num] = (int)(intptr_t)arg;
+        s_fired_us[s_fired_num] = esp_timer_get_time();
+    }
+    s_fired_num++;
+    xSemaphoreGive(s_fired_sem);
+}
+
+/* waits for the firings up to |num|, each within |timeout_ms| */
+static void bt_alarm_test_wait_fired(int num, uint32_t timeout_ms)
+{
+    while (s_fired_num < num) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(s_fired_sem, pdMS_TO_TICKS(timeout_ms)));
+    }
+}
+
+/* checks that firing |n| is alarm |id|, |timeout_ms| or later after |set_us| */
+static void bt_alarm_test_check_fired(int n, int id, int64_t set_us, uint32_t timeout_ms)
+{
+    TEST_ASSERT_EQUAL(id, s_fired_id[n]);
+    TEST_ASSERT_GREATER_OR_EQUAL(timeout_ms * 1000, (int)(s_fired_us[n] - set_us));
+}
+
+static void bt_alarm_test_setup(osi_alarm_t **alarms, int num)
+{
+    TEST_ASSERT_EQUAL(0, osi_alarm_create_mux());
+    osi_alarm_init();
+    for (int i = 0; i < num; i++) {
+        alarms[i] = osi_alarm_new("bt_alarm_test", bt_alarm_test_cb, NULL, 0);
+        TEST_ASSERT_NOT_NULL(alarms[i]);
+    }
+}
+
+static void bt_alarm_test_teardown(osi_alarm_t **alarms, int num)
+{
+    for (int i = 0; i < num; i++) {
+        osi_alarm_free(alarms[i]);
+    }
+    osi_alarm_deinit();
+    TEST_ASSERT_EQUAL(0, osi_alarm_delete_mux());
+}
+
+TEST_CASE("bt alarm set, move and cancel on the wheel", "[bt_alarm]")
+{
+    osi_alarm_t *alarms[3];
+
+    bt_alarm_test_setup(alarms, 3);
+
+    TEST_ASSERT_FALSE(osi_alarm_is_active(alarms[0]));
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_FAIL, osi_alarm_cancel(alarms[0]));
+
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[0], BT_ALARM_TEST_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[1], BT_ALARM_TEST_TIMEOUT_MS));
+    TEST_ASSERT_TRUE(osi_alarm_is_active(alarms[0]));
+    TEST_ASSERT_UINT32_WITHIN(100, BT_ALARM_TEST_TIMEOUT_MS, (uint32_t)osi_alarm_get_remaining_ms(alarms[0]));
+
+    /* setting it again moves it */
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[0], BT_ALARM_TEST_TIMEOUT_MS * 2));
+    TEST_ASSERT_UINT32_WITHIN(100, BT_ALARM_TEST_TIMEOUT_MS * 2, (uint32_t)osi_alarm_get_remaining_ms(alarms[0]));
+
+    /* a short timeout is not rounded to the wheel */
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[2], 1));
+    TEST_ASSERT_TRUE(osi_alarm_is_active(alarms[2]));
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_cancel(alarms[2]));
+
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_cancel(alarms[0]));
+    TEST_ASSERT_FALSE(osi_alarm_is_active(alarms[0]));
+    TEST_ASSERT_TRUE(osi_alarm_is_active(alarms[1]));
+
+    /* freed while set */
+    bt_alarm_test_teardown(alarms, 3);
+}
+
+TEST_CASE("bt alarm firing on the wheel and on esp_timer", "[bt_alarm]")
+{
+    const uint32_t unit = BT_ALARM_TEST_UNIT_MS;
+    /* below the 10 ticks of the wheel, on an esp_timer */
+    const uint32_t short_ms = BT_ALARM_TEST_TICK_MS * 5;
+    osi_alarm_t *alarms[5];
+    int64_t set_us[5];
+
+    s_fired_sem = xSemaphoreCreateCounting(BT_ALARM_TEST_FIRED_MAX, 0);
+    TEST_ASSERT_NOT_NULL(s_fired_sem);
+    s_fired_num = 0;
+    /* the callbacks are posted to the BTC task */
+    TEST_ASSERT_EQUAL(BT_STATUS_SUCCESS, btc_init());
+    TEST_ASSERT_EQUAL(0, osi_alarm_create_mux());
+    osi_alarm_init();
+    for (int i = 0; i < 5; i++) {
+        alarms[i] = osi_alarm_new("bt_alarm_test", bt_alarm_test_fired_cb, (void *)(intptr_t)i, 0);
+        TEST_ASSERT_NOT_NULL(alarms[i]);
+    }
+
+    /*
+     * 0 short one-shot, 1 and 2 one-shots on the same tick, 3 a later one-shot,
+     * 4 periodic: they fire 0, 4, 1 and 2 together, 4, 3.
+     */
+    set_us[0] = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[0], short_ms));
+    set_us[1] = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[1], unit * 3 / 2));
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[2], unit * 3 / 2));
+    set_us[2] = set_us[1];
+    set_us[3] = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[3], unit * 5 / 2));
+    set_us[4] = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set_periodic(alarms[4], unit));
+
+    bt_alarm_test_wait_fired(5, unit * 4);
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_cancel(alarms[4]));
+    TEST_ASSERT_EQUAL(5, s_fired_num);
+    bt_alarm_test_check_fired(0, 0, set_us[0], short_ms);
+    bt_alarm_test_check_fired(1, 4, set_us[4], unit);
+    TEST_ASSERT_EQUAL(3, s_fired_id[2] + s_fired_id[3]);
+    bt_alarm_test_check_fired(2, s_fired_id[2], set_us[s_fired_id[2]], unit * 3 / 2);
+    bt_alarm_test_check_fired(3, s_fired_id[3], set_us[s_fired_id[3]], unit * 3 / 2);
+    bt_alarm_test_check_fired(4, 4, set_us[4], unit * 2);
+    bt_alarm_test_wait_fired(6, unit * 4);
+    bt_alarm_test_check_fired(5, 3, set_us[3], unit * 5 / 2);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_FALSE(osi_alarm_is_active(alarms[i]));
+    }
+
+    /*
+     * Set again after they fired: 1 is moved from a later tick to an earlier
+     * one, 0 goes from its esp_timer onto the wheel.
+     */
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[1], unit * 3));
+    set_us[1] = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[1], unit));
+    set_us[0] = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(OSI_ALARM_ERR_PASS, osi_alarm_set(alarms[0], unit * 3 / 2));
+    bt_alarm_test_wait_fired(8, unit * 4);
+    bt_alarm_test_check_fired(6, 1, set_us[1], unit);
+    bt_alarm_test_check_fired(7, 0, set_us[0], unit * 3 / 2);
+
+    /* nothing fires again, the periodic alarm was cancelled */
+    vTaskDelay(pdMS_TO_TICKS(unit * 4));
+    TEST_ASSERT_EQUAL(8, s_fired_num);
+
+    for (int i = 0; i < 5; i++) {
+        osi_alarm_free(alarms[i]);
+    }
+    osi_alarm_deinit();
+    TEST_ASSERT_EQUAL(0, osi_alarm_delete_mux());
+    btc_deinit();
+    vSemaphoreDelete(s_fired_sem);
+}
+
+TEST_CASE("bt alarm performance", "[bt_alarm][timing]")
+{
+    static osi_alarm_t *alarms[BT_ALARM_TEST_NUM];
+    static esp_timer_handle_t timers[BT_ALARM_TEST_NUM];
+    esp_timer_create_args_t tca = {
+        .callback = bt_alarm_test_cb,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "bt_alarm_test",
+    };
+    uint32_t start, end;
+
+    bt_alarm_test_setup(alarms, BT_ALARM_TEST_NUM);
+    for (int i = 0; i < BT_ALARM_TEST_NUM; i++) {
+        TEST_ESP_OK(esp_timer_create(&tca, &timers[i]));
+    }
+
+    /* one esp_timer per alarm, as without the wheel */
+    start = cpu_hal_get_cycle_count();
+    for (int r = 0; r < BT_ALARM_BENCH_ROUNDS; r++) {
+        for (int i = 0; i < BT_ALARM_TEST_NUM; i++) {
+            esp_timer_start_once(timers[i], (BT_ALARM_TEST_TIMEOUT_MS + i * 10) * 1000ULL);
+        }
+        for (int i = 0; i < BT_ALARM_TEST_NUM; i++) {
+            esp_timer_stop(timers[i]);
+        }
+    }
+    end = cpu_hal_get_cycle_count();
+    printf("esp_timer start/stop: %d cycles/alarm\n", (end - start) / (BT_ALARM_BENCH_ROUNDS * BT_ALARM_TEST_NUM));
+
+    start = cpu_hal_get_cycle_count();
+    for (int r = 0; r < BT_ALARM_BENCH_ROUNDS; r++) {
+        for (int i = 0; i < BT_ALARM_TEST_NUM; i++) {
+            osi_alarm_set(alarms[i], BT_ALARM_TEST_TIMEOUT_MS + i * 10);
+        }
+        for (int i = 0; i < BT_ALARM_TEST_NUM; i++) {
+            osi_alarm_cancel(alarms[i]);
+        }
+    }
+    end = cpu_hal_get_cycle_count();
+    TEST_PERFORMANCE_LESS_THAN(BT_ALARM_SET_CANCEL_CYCLES, "%d cycles/alarm", (end - start) / (BT_ALARM_BENCH_ROUNDS * BT_ALARM_TEST_NUM));
+
+    for (int i = 0; i < BT_ALARM_TEST_NUM; i++) {
+        TEST_ESP_OK(esp_timer_delete(timers[i]));
+    }
+    bt_alarm_test_teardown(alarms, BT_ALARM_TEST_NUM);
+}
+
+#endif /* CONFIG_BT_ALARM_WHEEL */
@@ -0,0 +1,84 @@
+/*
+ Tests for the Bluetooth packet buffer pool
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_BT_BUF_POOL
+
+#include "osi/allocator.h"
+#include "osi/buf_pool.h"
+
+TEST_CASE("bt buf pool serves its classes and falls back to the heap", "[bt_buf_pool]")
+{
+    static void *bufs[CONFIG_BT_BUF_POOL_SMALL_NUM];
+    osi_buf_pool_stats_t stats;
+
+    TEST_ASSERT_TRUE(osi_buf_pool_init());
+
+    for (int i = 0; i < CONFIG_BT_BUF_POOL_SMALL_NUM; i++) {
+        bufs[i] = osi_buf_pool_malloc(OSI_BUF_POOL_SMALL_SIZE);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        TEST_ASSERT_TRUE(osi_buf_pool_owns(bufs[i]));
+        memset(bufs[i], i, OSI_BUF_POOL_SMALL_SIZE);
+    }
+
+    /* the class is empty, the next one comes from the heap */
+    void *heap = osi_buf_pool_malloc(16);
+    TEST_ASSERT_NOT_NULL(heap);
+    TEST_ASSERT_FALSE(osi_buf_pool_owns(heap));
+    osi_free(heap);
+
+    /* larger than any class */
+    heap = osi_buf_pool_malloc(OSI_BUF_POOL_LARGE_SIZE + 1);
+    TEST_ASSERT_NOT_NULL(heap);
+    TEST_ASSERT_FALSE(osi_buf_pool_owns(heap));
+    osi_free(heap);
+
+    TEST_ASSERT_TRUE(osi_buf_pool_get_stats(OSI_BUF_POOL_SMALL, &stats));
+    TEST_ASSERT_EQUAL(CONFIG_BT_BUF_POOL_SMALL_NUM, stats.in_use);
+    TEST_ASSERT_EQUAL(CONFIG_BT_BUF_POOL_SMALL_NUM, stats.in_use_max);
+    TEST_ASSERT_EQUAL(1, stats.exhausted);
+    TEST_ASSERT_EQUAL(1, osi_buf_pool_get_oversize());
+
+    for (int i = 0; i < CONFIG_BT_BUF_POOL_SMALL_NUM; i++) {
+        const uint8_t *p = bufs[i];
+        /* no buffer overlaps another one */
+        TEST_ASSERT_EQUAL(i & 0xff, p[OSI_BUF_POOL_SMALL_SIZE - 1]);
+        osi_free(bufs[i]);
+    }
+
+    TEST_ASSERT_TRUE(osi_buf_pool_get_stats(OSI_BUF_POOL_SMALL, &stats));
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(CONFIG_BT_BUF_POOL_SMALL_NUM, stats.in_use_max);
+    TEST_ASSERT_EQUAL(CONFIG_BT_BUF_POOL_SMALL_NUM, stats.allocs);
+
+    osi_buf_pool_deinit();
+}
+
+TEST_CASE("bt buf pool outlives deinit until its last buffer is freed", "[bt_buf_pool]")
+{
+    osi_buf_pool_stats_t stats;
+
+    TEST_ASSERT_TRUE(osi_buf_pool_init());
+    void *buf = osi_buf_pool_malloc(OSI_BUF_POOL_SMALL_SIZE);
+    TEST_ASSERT_TRUE(osi_buf_pool_owns(buf));
+
+    osi_buf_pool_deinit();
+    TEST_ASSERT_TRUE(osi_buf_pool_owns(buf));
+
+    /* no new buffer while draining */
+    void *heap = osi_buf_pool_malloc(OSI_BUF_POOL_SMALL_SIZE);
+    TEST_ASSERT_FALSE(osi_buf_pool_owns(heap));
+    osi_free(heap);
+
+    osi_free(buf);
+    TEST_ASSERT_FALSE(osi_buf_pool_owns(buf));
+    TEST_ASSERT_FALSE(osi_buf_pool_get_stats(OSI_BUF_POOL_SMALL, &stats));
+}
+
+#endif /* CONFIG_BT_BUF_POOL */
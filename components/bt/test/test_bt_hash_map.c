@@ -0,0 +1,142 @@
+/*
+ Tests for the OSI hash map
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "test_utils.h"
+#include "sdkconfig.h"
+#include "hal/cpu_hal.h"
+
+#include "osi/hash_map.h"
+#include "osi/hash_functions.h"
+
+#define BT_HASH_MAP_TEST_KEYS       (200)
+#define BT_HASH_MAP_TEST_OPS        (20000)
+#define BT_HASH_MAP_BENCH_ROUNDS    (1000)
+
+static int s_freed;
+
+static void bt_hash_map_test_free(void *data)
+{
+    s_freed++;
+}
+
+static bool bt_hash_map_test_count(hash_map_entry_t *hash_entry, void *context)
+{
+    (*(int *)context)++;
+    return true;
+}
+
+TEST_CASE("bt hash map matches a reference table through growth and erase", "[bt_hash_map]")
+{
+    static void *ref[BT_HASH_MAP_TEST_KEYS];
+    int live = 0, expect_freed = 0, count = 0;
+
+    /* sized far too small so that it grows */
+    hash_map_t *map = hash_map_new(4, hash_function_naive, NULL, bt_hash_map_test_free, NULL);
+    TEST_ASSERT_NOT_NULL(map);
+    memset(ref, 0, sizeof(ref));
+    s_freed = 0;
+    srand(25);
+
+    for (int op = 0; op < BT_HASH_MAP_TEST_OPS; op++) {
+        int k = rand() % BT_HASH_MAP_TEST_KEYS;
+        const void *key = (const void *)(intptr_t)k;
+
+        switch (rand() % 3) {
+        case 0:
+            TEST_ASSERT_TRUE(hash_map_set(map, key, (void *)(intptr_t)(op + 1)));
+            /* a replaced entry is released */
+            if (ref[k] != NULL) {
+                expect_freed++;
+            } else {
+                live++;
+            }
+            ref[k] = (void *)(intptr_t)(op + 1);
+            break;
+        case 1:
+            TEST_ASSERT_EQUAL_PTR(ref[k], hash_map_get(map, key));
+            TEST_ASSERT_EQUAL(ref[k] != NULL, hash_map_has_key(map, key));
+            break;
+        default:
+            TEST_ASSERT_EQUAL(ref[k] != NULL, hash_map_erase(map, key));
+            if (ref[k] != NULL) {
+                expect_freed++;
+                live--;
+            }
+            ref[k] = NULL;
+            break;
+        }
+    }
+
+    hash_map_foreach(map, bt_hash_map_test_count, &count);
+    TEST_ASSERT_EQUAL(live, count);
+    TEST_ASSERT_EQUAL(expect_freed, s_freed);
+
+    hash_map_clear(map);
+    TEST_ASSERT_EQUAL(expect_freed + live, s_freed);
+    count = 0;
+    hash_map_foreach(map, bt_hash_map_test_count, &count);
+    TEST_ASSERT_EQUAL(0, count);
+    hash_map_free(map);
+}
+
+static bool bt_hash_map_test_str_eq(const void *x, const void *y)
+{
+    return strcmp((const char *)x, (const char *)y) == 0;
+}
+
+TEST_CASE("bt hash map compares keys with the equality function", "[bt_hash_map]")
+{
+    char key[8];
+
+    hash_map_t *map = hash_map_new(8, hash_function_string, NULL, NULL, bt_hash_map_test_str_eq);
+    TEST_ASSERT_NOT_NULL(map);
+
+    TEST_ASSERT_TRUE(hash_map_set(map, "one", "1"));
+    TEST_ASSERT_TRUE(hash_map_set(map, "two", "2"));
+    strcpy(key, "one");
+    TEST_ASSERT_EQUAL_STRING("1", hash_map_get(map, key));
+    TEST_ASSERT_TRUE(hash_map_erase(map, key));
+    TEST_ASSERT_FALSE(hash_map_has_key(map, "one"));
+    TEST_ASSERT_EQUAL_STRING("2", hash_map_get(map, "two"));
+    hash_map_free(map);
+}
+
+TEST_CASE("bt hash map performance", "[bt_hash_map][timing]")
+{
+    /* ACL handle to partial packet, as in the packet fragmenter */
+    static const uint16_t handles[] = {0x0001, 0x0002, 0x0080, 0x0081, 0x0082};
+    const int num = sizeof(handles) / sizeof(handles[0]);
+    uint32_t start, end;
+
+    hash_map_t *map = hash_map_new(42, hash_function_naive, NULL, NULL, NULL);
+    TEST_ASSERT_NOT_NULL(map);
+    for (int i = 0; i < num; i++) {
+        TEST_ASSERT_TRUE(hash_map_set(map, (void *)(uintptr_t)handles[i], (void *)&handles[i]));
+    }
+
+    start = cpu_hal_get_cycle_count();
+    for (int r = 0; r < BT_HASH_MAP_BENCH_ROUNDS; r++) {
+        for (int i = 0; i < num; i++) {
+            hash_map_get(map, (void *)(uintptr_t)handles[i]);
+        }
+    }
+    end = cpu_hal_get_cycle_count();
+    TEST_PERFORMANCE_LESS_THAN(HASH_MAP_GET_CYCLES, "%d cycles/lookup", (end - start) / (BT_HASH_MAP_BENCH_ROUNDS * num));
+
+    start = cpu_hal_get_cycle_count();
+    for (int r = 0; r < BT_HASH_MAP_BENCH_ROUNDS; r++) {
+        hash_map_erase(map, (void *)(uintptr_t)handles[r % num]);
+        hash_map_set(map, (void *)(uintptr_t)handles[r % num], (void *)&handles[r % num]);
+    }
+    end = cpu_hal_get_cycle_count();
+    TEST_PERFORMANCE_LESS_THAN(HASH_MAP_ERASE_SET_CYCLES, "%d cycles/pair", (end - start) / BT_HASH_MAP_BENCH_ROUNDS);
+
+    hash_map_free(map);
+}
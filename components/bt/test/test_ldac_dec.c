@@ -0,0 +1,111 @@
+/*
+ Tests for the LDAC decoder IMDCT engines
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "unity.h"
+#include "sdkconfig.h"
+#include "hal/cpu_hal.h"
+#include "test_utils.h"
+
+#if CONFIG_BT_A2DP_LDAC_DECODER
+
+#include "ldacdec.h"
+
+/* Largest allowed difference between the float and fixed engines after rounding to 16 bit PCM */
+#define LDAC_FIXED_MAX_PCM_DIFF     (1)
+#define LDAC_FIXED_TEST_FRAMES      (64)
+#define LDAC_IMDCT_BENCH_FRAMES     (1000)
+
+static void ldac_fixed_vs_float_imdct(int bits)
+{
+    const int size = 1 << bits;
+    static Mdct mdct_float;
+    static MdctFixed mdct_fixed;
+    static float spectra_float[MAX_FRAME_SAMPLES], pcm_float[MAX_FRAME_SAMPLES];
+    static int32_t spectra_fixed[MAX_FRAME_SAMPLES], pcm_fixed[MAX_FRAME_SAMPLES];
+
+    memset(&mdct_float, 0, sizeof(mdct_float));
+    memset(&mdct_fixed, 0, sizeof(mdct_fixed));
+    mdct_float.Bits = bits;
+    mdct_fixed.Bits = bits;
+
+    srand(bits);
+    for (int frame = 0; frame < LDAC_FIXED_TEST_FRAMES; frame++) {
+        for (int i = 0; i < size; i++) {
+            /* pink-ish spectrum that keeps the output within 16 bit PCM */
+            float value = ((float)rand() / RAND_MAX - 0.5f) * 2000.0f / (1.0f + i * 0.05f);
+            spectra_float[i] = value;
+            spectra_fixed[i] = lrintf(value * (1 << LDAC_FIXED_FRAC_BITS));
+        }
+
+        RunImdct(&mdct_float, spectra_float, pcm_float);
+        RunImdctFixed(&mdct_fixed, spectra_fixed, pcm_fixed);
+
+        for (int i = 0; i < size; i++) {
+            int expected = lrintf(pcm_float[i]);
+            int actual = (pcm_fixed[i] + (1 << (LDAC_FIXED_FRAC_BITS - 1))) >> LDAC_FIXED_FRAC_BITS;
+            TEST_ASSERT_INT_WITHIN(LDAC_FIXED_MAX_PCM_DIFF, expected, actual);
+        }
+    }
+}
+
+TEST_CASE("ldac fixed point imdct matches float", "[ldac]")
+{
+    ldac_fixed_vs_float_imdct(7);
+    ldac_fixed_vs_float_imdct(8);
+}
+
+static void ldac_imdct_benchmark(int bits)
+{
+    const int size = 1 << bits;
+    static Mdct mdct_float;
+    static MdctFixed mdct_fixed;
+    static float spectra_float[MAX_FRAME_SAMPLES], pcm_float[MAX_FRAME_SAMPLES];
+    static int32_t spectra_fixed[MAX_FRAME_SAMPLES], pcm_fixed[MAX_FRAME_SAMPLES];
+    uint32_t start, end;
+    int float_cycles, fixed_cycles;
+
+    memset(&mdct_float, 0, sizeof(mdct_float));
+    memset(&mdct_fixed, 0, sizeof(mdct_fixed));
+    mdct_float.Bits = bits;
+    mdct_fixed.Bits = bits;
+    for (int i = 0; i < size; i++) {
+        spectra_float[i] = (float)((i * 37) % 101 - 50);
+        spectra_fixed[i] = (int32_t)spectra_float[i] << LDAC_FIXED_FRAC_BITS;
+    }
+
+    start = cpu_hal_get_cycle_count();
+    for (int i = 0; i < LDAC_IMDCT_BENCH_FRAMES; i++) {
+        RunImdct(&mdct_float, spectra_float, pcm_float);
+    }
+    end = cpu_hal_get_cycle_count();
+    float_cycles = (end - start) / LDAC_IMDCT_BENCH_FRAMES;
+
+    start = cpu_hal_get_cycle_count();
+    for (int i = 0; i < LDAC_IMDCT_BENCH_FRAMES; i++) {
+        RunImdctFixed(&mdct_fixed, spectra_fixed, pcm_fixed);
+    }
+    end = cpu_hal_get_cycle_count();
+    fixed_cycles = (end - start) / LDAC_IMDCT_BENCH_FRAMES;
+
+    if (bits == 7) {
+        TEST_PERFORMANCE_LESS_THAN(LDAC_IMDCT_128_CYCLES, "%d cycles/frame float", float_cycles);
+        TEST_PERFORMANCE_LESS_THAN(LDAC_IMDCT_128_CYCLES, "%d cycles/frame fixed", fixed_cycles);
+    } else {
+        TEST_PERFORMANCE_LESS_THAN(LDAC_IMDCT_256_CYCLES, "%d cycles/frame float", float_cycles);
+        TEST_PERFORMANCE_LESS_THAN(LDAC_IMDCT_256_CYCLES, "%d cycles/frame fixed", fixed_cycles);
+    }
+}
+
+TEST_CASE("ldac imdct performance", "[ldac][timing]")
+{
+    ldac_imdct_benchmark(7);
+    ldac_imdct_benchmark(8);
+}
+
+#endif /* CONFIG_BT_A2DP_LDAC_DECODER */
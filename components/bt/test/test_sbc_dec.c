@@ -0,0 +1,88 @@
+/*
+ Tests for the SBC decoder synthesis kernels
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "sdkconfig.h"
+#include "hal/cpu_hal.h"
+#include "test_utils.h"
+
+#if CONFIG_BT_A2DP_ENABLE
+
+#include "oi_codec_sbc_private.h"
+
+#define SBC_SYNTH_TEST_BLOCKS       (4096)
+#define SBC_SYNTH_BENCH_BLOCKS      (10000)
+
+static void sbc_synth_random_buffer(SBC_BUFFER_T *buffer, int block)
+{
+    for (int i = 0; i < 80; i++) {
+        switch (block % 4) {
+        case 0:
+            /* full scale, the output clips */
+            buffer[i] = (SBC_BUFFER_T)(rand() & 0xffff);
+            break;
+        case 1:
+            buffer[i] = (rand() & 1) ? OI_INT16_MAX : OI_INT16_MIN;
+            break;
+        default:
+            buffer[i] = (SBC_BUFFER_T)(rand() % 12001 - 6000);
+            break;
+        }
+    }
+}
+
+TEST_CASE("sbc synthesis window kernel matches C reference", "[sbc]")
+{
+#ifdef OI_SBC_SYNTH_MAC16
+    static SBC_BUFFER_T buffer[80];
+    OI_INT16 expected[16], actual[16];
+
+    srand(80);
+    for (int block = 0; block < SBC_SYNTH_TEST_BLOCKS; block++) {
+        OI_UINT strideShift = block & 1;
+
+        sbc_synth_random_buffer(buffer, block);
+        memset(expected, 0, sizeof(expected));
+        memset(actual, 0, sizeof(actual));
+        SynthWindow80_c(expected, buffer, strideShift);
+        SynthWindow80_mac16(actual, buffer, strideShift);
+        TEST_ASSERT_EQUAL_INT16_ARRAY(expected, actual, 16);
+    }
+#else
+    TEST_IGNORE_MESSAGE("no synthesis kernel for this CPU");
+#endif
+}
+
+TEST_CASE("sbc synthesis window performance", "[sbc][timing]")
+{
+    static SBC_BUFFER_T buffer[80];
+    OI_INT16 pcm[8];
+    uint32_t start, end;
+
+    sbc_synth_random_buffer(buffer, 2);
+
+    start = cpu_hal_get_cycle_count();
+    for (int i = 0; i < SBC_SYNTH_BENCH_BLOCKS; i++) {
+        SynthWindow80_c(pcm, buffer, 0);
+    }
+    end = cpu_hal_get_cycle_count();
+    TEST_PERFORMANCE_LESS_THAN(SBC_SYNTH_WINDOW_C_CYCLES, "%d cycles/block",
+                               (int)((end - start) / SBC_SYNTH_BENCH_BLOCKS));
+
+#ifdef OI_SBC_SYNTH_MAC16
+    start = cpu_hal_get_cycle_count();
+    for (int i = 0; i < SBC_SYNTH_BENCH_BLOCKS; i++) {
+        SynthWindow80_mac16(pcm, buffer, 0);
+    }
+    end = cpu_hal_get_cycle_count();
+    TEST_PERFORMANCE_LESS_THAN(SBC_SYNTH_WINDOW_MAC16_CYCLES, "%d cycles/block",
+                               (int)((end - start) / SBC_SYNTH_BENCH_BLOCKS));
+#endif
+}
+
+#endif /* CONFIG_BT_A2DP_ENABLE */
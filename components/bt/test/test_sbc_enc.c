@@ -0,0 +1,149 @@
+/*
+ Tests for the SBC encoder state and batch encoding
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "sdkconfig.h"
+#include "hal/cpu_hal.h"
+#include "test_utils.h"
+
+#if CONFIG_BT_A2DP_ENABLE
+
+#include "common/bt_target.h"
+#include "sbc_encoder.h"
+
+#define SBC_ENC_TEST_FRAMES         (48)
+#define SBC_ENC_MAX_FRAME_LEN       (512)
+#define SBC_ENC_FRAME_SAMPLES       (SBC_MAX_NUM_OF_BLOCKS * SBC_MAX_NUM_OF_SUBBANDS * SBC_MAX_NUM_OF_CHANNELS)
+#define SBC_ENC_BENCH_FRAMES        (200)
+
+static SINT16 s_pcm[2][SBC_ENC_TEST_FRAMES * SBC_ENC_FRAME_SAMPLES];
+static UINT8 s_ref[SBC_ENC_TEST_FRAMES * SBC_ENC_MAX_FRAME_LEN];
+static UINT8 s_out[SBC_ENC_TEST_FRAMES * SBC_ENC_MAX_FRAME_LEN];
+
+static void sbc_enc_setup(SBC_ENC_PARAMS *enc, SINT16 channel_mode, SINT16 subbands)
+{
+    memset(enc, 0, sizeof(*enc));
+    enc->sbc_mode = SBC_MODE_STD;
+    enc->s16SamplingFreq = SBC_sf44100;
+    enc->s16ChannelMode = channel_mode;
+    enc->s16NumOfBlocks = 16;
+    enc->s16NumOfSubBands = subbands;
+    enc->s16AllocationMethod = SBC_LOUDNESS;
+    enc->u16BitRate = 328;
+    SBC_Encoder_Init(enc);
+}
+
+static void sbc_enc_random_pcm(void)
+{
+    for (int s = 0; s < 2; s++) {
+        for (int i = 0; i < SBC_ENC_TEST_FRAMES * SBC_ENC_FRAME_SAMPLES; i++) {
+            s_pcm[s][i] = (SINT16)(rand() % 40001 - 20000);
+        }
+    }
+}
+
+/* Encodes |frames| frames of s_pcm[0] one at a time through the PCM buffer of |enc| */
+static size_t sbc_enc_frame_by_frame(SBC_ENC_PARAMS *enc, int frames, UINT8 *out)
+{
+    const int frame_samples = enc->s16NumOfBlocks * enc->s16NumOfSubBands * enc->s16NumOfChannels;
+    size_t len = 0;
+
+    for (int f = 0; f < frames; f++) {
+        memcpy(enc->as16PcmBuffer, &s_pcm[0][f * frame_samples], frame_samples * sizeof(SINT16));
+        enc->pu8Packet = out + len;
+        SBC_Encoder(enc);
+        len += enc->u16PacketLength;
+    }
+    return len;
+}
+
+TEST_CASE("sbc encoder instances do not share state", "[sbc]")
+{
+    static SBC_ENC_PARAMS enc_a, enc_b;
+    static UINT8 other[SBC_ENC_MAX_FRAME_LEN];
+    size_t len = 0;
+
+    srand(19);
+    sbc_enc_random_pcm();
+    sbc_enc_setup(&enc_a, SBC_JOINT_STEREO, SUB_BANDS_8);
+    const size_t ref_len = sbc_enc_frame_by_frame(&enc_a, SBC_ENC_TEST_FRAMES, s_ref);
+
+    /* the same stream again, with a second encoder running on other audio in between */
+    sbc_enc_setup(&enc_a, SBC_JOINT_STEREO, SUB_BANDS_8);
+    sbc_enc_setup(&enc_b, SBC_MONO, SUB_BANDS_4);
+    const int frame_samples = enc_a.s16NumOfBlocks * enc_a.s16NumOfSubBands * enc_a.s16NumOfChannels;
+    for (int f = 0; f < SBC_ENC_TEST_FRAMES; f++) {
+        memcpy(enc_a.as16PcmBuffer, &s_pcm[0][f * frame_samples], frame_samples * sizeof(SINT16));
+        enc_a.pu8Packet = s_out + len;
+        SBC_Encoder(&enc_a);
+        len += enc_a.u16PacketLength;
+
+        SBC_Encoder_Batch(&enc_b, &s_pcm[1][f * SBC_ENC_FRAME_SAMPLES], other, 1);
+    }
+    TEST_ASSERT_EQUAL(ref_len, len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(s_ref, s_out, ref_len);
+}
+
+TEST_CASE("sbc batch encode matches frame by frame encode", "[sbc]")
+{
+    static SBC_ENC_PARAMS enc;
+    const SINT16 modes[] = {SBC_MONO, SBC_DUAL, SBC_STEREO, SBC_JOINT_STEREO};
+
+    srand(20);
+    sbc_enc_random_pcm();
+    for (int m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        for (SINT16 subbands = SUB_BANDS_4; subbands <= SUB_BANDS_8; subbands += SUB_BANDS_4) {
+            sbc_enc_setup(&enc, modes[m], subbands);
+            const size_t ref_len = sbc_enc_frame_by_frame(&enc, SBC_ENC_TEST_FRAMES, s_ref);
+
+            /* uneven batches, so the history wraps at every possible position */
+            const int frame_samples = enc.s16NumOfBlocks * enc.s16NumOfSubBands * enc.s16NumOfChannels;
+            size_t len = 0;
+            int batch;
+            sbc_enc_setup(&enc, modes[m], subbands);
+            for (int f = 0; f < SBC_ENC_TEST_FRAMES; f += batch) {
+                batch = f % 5 + 1;
+                if (batch > SBC_ENC_TEST_FRAMES - f) {
+                    batch = SBC_ENC_TEST_FRAMES - f;
+                }
+                len += SBC_Encoder_Batch(&enc, &s_pcm[0][f * frame_samples], s_out + len, batch);
+            }
+            TEST_ASSERT_EQUAL(ref_len, len);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(s_ref, s_out, ref_len);
+        }
+    }
+}
+
+TEST_CASE("sbc encoder performance", "[sbc][timing]")
+{
+    static SBC_ENC_PARAMS enc;
+    uint32_t start, end;
+
+    srand(21);
+    sbc_enc_random_pcm();
+    sbc_enc_setup(&enc, SBC_JOINT_STEREO, SUB_BANDS_8);
+
+    start = cpu_hal_get_cycle_count();
+    for (int i = 0; i < SBC_ENC_BENCH_FRAMES; i++) {
+        enc.pu8Packet = s_out;
+        SBC_Encoder(&enc);
+    }
+    end = cpu_hal_get_cycle_count();
+    TEST_PERFORMANCE_LESS_THAN(SBC_ENCODER_CYCLES, "%d cycles/frame SBC_Encoder",
+                               (int)((end - start) / SBC_ENC_BENCH_FRAMES));
+
+    start = cpu_hal_get_cycle_count();
+    for (int i = 0; i < SBC_ENC_BENCH_FRAMES; i += 8) {
+        SBC_Encoder_Batch(&enc, s_pcm[0], s_out, 8);
+    }
+    end = cpu_hal_get_cycle_count();
+    TEST_PERFORMANCE_LESS_THAN(SBC_ENCODER_CYCLES, "%d cycles/frame SBC_Encoder_Batch",
+                               (int)((end - start) / SBC_ENC_BENCH_FRAMES));
+}
+
+#endif /* CONFIG_BT_A2DP_ENABLE */
@@ -113,3 +113,35 @@
 #ifndef IDF_PERFORMANCE_MAX_FREE_DEFAULT_AVERAGE_TIME
 #define IDF_PERFORMANCE_MAX_FREE_DEFAULT_AVERAGE_TIME                           950
 #endif
+
+// Bluedroid codec and OSI microbenchmarks of components/bt/test, in CPU cycles. A fraction of the
+// real time budget of a stream at 160 MHz, they catch gross regressions.
+// LDAC IMDCT per frame, float and fixed point: 96 kHz stereo leaves 427k cycles per frame
+#ifndef IDF_PERFORMANCE_MAX_LDAC_IMDCT_128_CYCLES
+#define IDF_PERFORMANCE_MAX_LDAC_IMDCT_128_CYCLES                               20000
+#endif
+#ifndef IDF_PERFORMANCE_MAX_LDAC_IMDCT_256_CYCLES
+#define IDF_PERFORMANCE_MAX_LDAC_IMDCT_256_CYCLES                               40000
+#endif
+// SBC 8-subband synthesis window per block: 44.1 kHz stereo leaves 14.5k cycles per block
+#ifndef IDF_PERFORMANCE_MAX_SBC_SYNTH_WINDOW_C_CYCLES
+#define IDF_PERFORMANCE_MAX_SBC_SYNTH_WINDOW_C_CYCLES                           2000
+#endif
+#ifndef IDF_PERFORMANCE_MAX_SBC_SYNTH_WINDOW_MAC16_CYCLES
+#define IDF_PERFORMANCE_MAX_SBC_SYNTH_WINDOW_MAC16_CYCLES                       1000
+#endif
+// SBC encoder per frame of 16 blocks, 8 subbands, joint stereo: 44.1 kHz leaves 465k cycles
+#ifndef IDF_PERFORMANCE_MAX_SBC_ENCODER_CYCLES
+#define IDF_PERFORMANCE_MAX_SBC_ENCODER_CYCLES                                  200000
+#endif
+// OSI alarm set and cancel on the timer wheel, per alarm
+#ifndef IDF_PERFORMANCE_MAX_BT_ALARM_SET_CANCEL_CYCLES
+#define IDF_PERFORMANCE_MAX_BT_ALARM_SET_CANCEL_CYCLES                          5000
+#endif
+// OSI hash map lookup, and erase then set of an entry, with the handful of ACL handles of the fragmenter
+#ifndef IDF_PERFORMANCE_MAX_HASH_MAP_GET_CYCLES
+#define IDF_PERFORMANCE_MAX_HASH_MAP_GET_CYCLES                                 300
+#endif
+#ifndef IDF_PERFORMANCE_MAX_HASH_MAP_ERASE_SET_CYCLES
+#define IDF_PERFORMANCE_MAX_HASH_MAP_ERASE_SET_CYCLES                           1000
+#endif
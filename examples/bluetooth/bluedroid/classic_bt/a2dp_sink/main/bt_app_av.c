@@ -50,6 +50,7 @@ static _lock_t s_volume_lock;
 static xTaskHandle s_vcs_task_hdl = NULL;
 static uint8_t s_volume = 0;
 static bool s_volume_notify;
+static uint32_t s_i2s_sample_rate = 0;
 
 /* callback for A2DP sink */
 void bt_app_a2d_cb(esp_a2d_cb_event_t event, esp_a2d_cb_param_t *param)
@@ -154,6 +155,15 @@ static void bt_av_hdl_a2d_evt(uint16_t event, void *p_param)
     case ESP_A2D_AUDIO_CFG_EVT: {
         a2d = (esp_a2d_cb_param_t *)(p_param);
         ESP_LOGI(BT_AV_TAG, "A2DP audio stream configuration, codec type %d", a2d->audio_cfg.mcc.type);
+        // the stack converts every stream to one sample rate, the I2S clock only changes once
+        if (a2d->audio_cfg.pcm_rate != 0) {
+            if (a2d->audio_cfg.pcm_rate != s_i2s_sample_rate) {
+                s_i2s_sample_rate = a2d->audio_cfg.pcm_rate;
+                i2s_set_clk(0, s_i2s_sample_rate, 16, 2);
+            }
+            ESP_LOGI(BT_AV_TAG, "Audio player configured, sample rate=%u", (unsigned int)s_i2s_sample_rate);
+            break;
+        }
         // for now only SBC stream is supported
         if (a2d->audio_cfg.mcc.type == ESP_A2D_MCT_SBC) {
             int sample_rate = 16000;
@@ -166,6 +176,7 @@ static void bt_av_hdl_a2d_evt(uint16_t event, void *p_param)
                 sample_rate = 48000;
             }
             i2s_set_clk(0, sample_rate, 16, 2);
+            s_i2s_sample_rate = sample_rate;
 
             ESP_LOGI(BT_AV_TAG, "Configure audio player %x-%x-%x-%x",
                      a2d->audio_cfg.mcc.cie.sbc[0],
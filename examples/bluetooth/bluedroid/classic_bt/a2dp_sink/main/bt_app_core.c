@@ -18,6 +18,7 @@
 #include "bt_app_core.h"
 #include "driver/i2s.h"
 #include "freertos/ringbuf.h"
+#include "esp_a2dp_api.h"
 
 static void bt_app_task_handler(void *arg);
 static bool bt_app_send_msg(bt_app_msg_t *msg);
@@ -116,6 +117,19 @@ void bt_app_task_shut_down(void)
     }
 }
 
+#if CONFIG_BT_A2DP_SINK_PCM_RING
+/* pull mode: read the decoded audio straight from the A2DP sink, i2s_write() paces the loop */
+static void bt_i2s_task_handler(void *arg)
+{
+    static uint8_t data[1024];
+    size_t bytes_written = 0;
+
+    for (;;) {
+        esp_a2d_sink_read_pcm(data, sizeof(data), NULL);
+        i2s_write(0, data, sizeof(data), &bytes_written, portMAX_DELAY);
+    }
+}
+#else
 static void bt_i2s_task_handler(void *arg)
 {
     uint8_t *data = NULL;
@@ -130,13 +144,16 @@ static void bt_i2s_task_handler(void *arg)
         }
     }
 }
+#endif /* CONFIG_BT_A2DP_SINK_PCM_RING */
 
 void bt_i2s_task_start_up(void)
 {
+#if !CONFIG_BT_A2DP_SINK_PCM_RING
     s_ringbuf_i2s = xRingbufferCreate(8 * 1024, RINGBUF_TYPE_BYTEBUF);
     if(s_ringbuf_i2s == NULL){
         return;
     }
+#endif
 
     xTaskCreate(bt_i2s_task_handler, "BtI2ST", 1024, NULL, configMAX_PRIORITIES - 3, &s_bt_i2s_task_handle);
     return;
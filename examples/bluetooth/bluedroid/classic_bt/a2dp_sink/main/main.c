@@ -196,7 +196,9 @@ static void bt_av_hdl_stack_evt(uint16_t event, void *p_param)
 
         /* initialize A2DP sink */
         esp_a2d_register_callback(&bt_app_a2d_cb);
+#if !CONFIG_BT_A2DP_SINK_PCM_RING
         esp_a2d_sink_register_data_callback(bt_app_a2d_data_cb);
+#endif
         esp_a2d_sink_init();
 
         /* set discoverable and connectable mode, wait to be connected */